@@ -1,4 +1,5 @@
 #include "sha1.hpp"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -38,6 +39,24 @@ void SHA1::update(std::istream& is) {
     }
 }
 
+void SHA1::update(char const* data, size_t size) {
+    while (size > 0) {
+        size_t const num_bytes = std::min(Block_bytes - buffer_.size(), size);
+
+        buffer_.append(data, num_bytes);
+
+        data += num_bytes;
+        size -= num_bytes;
+
+        if (Block_bytes == buffer_.size()) {
+            uint32_t block[Block_ints];
+            buffer_to_block(buffer_, block);
+            transform(block);
+            buffer_.clear();
+        }
+    }
+}
+
 // Add padding and return the message digest.
 std::vector<uint8_t> SHA1::final() {
     // Total number of hashed bits
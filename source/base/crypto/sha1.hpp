@@ -15,6 +15,7 @@ class SHA1 {
 
     void update(std::string const& s);
     void update(std::istream& is);
+    void update(char const* data, size_t size);
 
     std::vector<uint8_t> final();
 
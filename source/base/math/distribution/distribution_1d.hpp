@@ -187,6 +187,51 @@ class Distribution_implicit_pdf_lut_lin_1D {
     float lut_range_;
 };
 
+// Alias method after Vose, "A Linear Algorithm For Generating Random Numbers
+// With a Given Distribution". Sampling takes constant time, independent of the number of entries.
+
+class Distribution_alias_1D {
+  public:
+    void init(float const* data, uint32_t len) noexcept;
+
+    float integral() const noexcept;
+
+    uint32_t sample(float r) const noexcept;
+
+    struct Discrete {
+        uint32_t offset;
+        float    pdf;
+    };
+    Discrete sample_discrete(float r) const noexcept;
+
+    struct Continuous {
+        float offset;
+        float pdf;
+    };
+    Continuous sample_continuous(float r) const noexcept;
+
+    float pdf(uint32_t index) const noexcept;
+    float pdf(float u) const noexcept;
+
+    size_t num_bytes() const noexcept;
+
+  private:
+    // The alias pdf is duplicated, so that a sample only touches a single bin
+    struct Bin {
+        float    threshold;
+        uint32_t alias;
+        float    pdf;
+        float    alias_pdf;
+    };
+
+    std::vector<Bin> bins_;
+
+    float integral_;
+    float size_;
+
+    uint32_t max_;
+};
+
 }  // namespace math
 
 #endif
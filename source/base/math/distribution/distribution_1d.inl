@@ -568,6 +568,146 @@ inline void Distribution_implicit_pdf_lut_lin_1D::init_lut(uint32_t lut_size) no
     }
 }
 
+//==================================================================================================
+
+inline void Distribution_alias_1D::init(float const* data, uint32_t len) noexcept {
+    float integral = 0.f;
+    for (uint32_t i = 0; i < len; ++i) {
+        integral += data[i];
+    }
+
+    if (0.f == integral) {
+        bins_.assign(1, Bin{1.f, 0, 0.f, 0.f});
+
+        integral_ = 0.f;
+        size_     = 1.f;
+        max_      = 0;
+
+        return;
+    }
+
+    bins_.resize(len);
+
+    // Scaled probabilities, in double precision so that the residuals do not drift
+    std::vector<double> q(len);
+
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+
+    double const n = static_cast<double>(len);
+
+    for (uint32_t i = 0; i < len; ++i) {
+        double const p = static_cast<double>(data[i]) / static_cast<double>(integral);
+
+        bins_[i].pdf = static_cast<float>(p);
+
+        q[i] = p * n;
+
+        if (q[i] < 1.) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+
+    while (!small.empty() && !large.empty()) {
+        uint32_t const s = small.back();
+        small.pop_back();
+
+        uint32_t const l = large.back();
+
+        bins_[s].threshold = static_cast<float>(q[s]);
+        bins_[s].alias     = l;
+
+        q[l] = (q[l] + q[s]) - 1.;
+
+        if (q[l] < 1.) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Whatever remains is 1 up to rounding
+    for (uint32_t const i : large) {
+        bins_[i].threshold = 1.f;
+        bins_[i].alias     = i;
+    }
+
+    for (uint32_t const i : small) {
+        bins_[i].threshold = 1.f;
+        bins_[i].alias     = i;
+    }
+
+    for (auto& b : bins_) {
+        b.alias_pdf = bins_[b.alias].pdf;
+    }
+
+    integral_ = integral;
+    size_     = static_cast<float>(len);
+    max_      = len - 1;
+}
+
+inline float Distribution_alias_1D::integral() const noexcept {
+    return integral_;
+}
+
+inline uint32_t Distribution_alias_1D::sample(float r) const noexcept {
+    return sample_discrete(r).offset;
+}
+
+inline Distribution_alias_1D::Discrete Distribution_alias_1D::sample_discrete(float r) const
+    noexcept {
+    float const    s = r * size_;
+    uint32_t const i = std::min(static_cast<uint32_t>(s), max_);
+
+    Bin const& b = bins_[i];
+
+    if (s - static_cast<float>(i) < b.threshold) {
+        return {i, b.pdf};
+    }
+
+    return {b.alias, b.alias_pdf};
+}
+
+inline Distribution_alias_1D::Continuous Distribution_alias_1D::sample_continuous(float r) const
+    noexcept {
+    float const    s = r * size_;
+    uint32_t const i = std::min(static_cast<uint32_t>(s), max_);
+
+    Bin const& b = bins_[i];
+
+    // The remainder of the bin selection is reused for the position inside of the chosen bin
+    float const u = s - static_cast<float>(i);
+
+    if (u < b.threshold) {
+        float const t = u / b.threshold;
+
+        return {(static_cast<float>(i) + t) / size_, b.pdf};
+    }
+
+    if (0.f == b.alias_pdf) {
+        return {0.f, 0.f};
+    }
+
+    float const t = std::min((u - b.threshold) / (1.f - b.threshold), 0.99999994f);
+
+    return {(static_cast<float>(b.alias) + t) / size_, b.alias_pdf};
+}
+
+inline float Distribution_alias_1D::pdf(uint32_t index) const noexcept {
+    return bins_[index].pdf;
+}
+
+inline float Distribution_alias_1D::pdf(float u) const noexcept {
+    uint32_t const offset = std::min(static_cast<uint32_t>(u * size_), max_);
+
+    return bins_[offset].pdf;
+}
+
+inline size_t Distribution_alias_1D::num_bytes() const noexcept {
+    return sizeof(*this) + sizeof(Bin) * bins_.size();
+}
+
 }  // namespace math
 
 #endif
@@ -38,7 +38,7 @@ class Distribution_t_2D {
     uint32_t conditional_max_;
 };
 
-using Distribution_2D = Distribution_t_2D<Distribution_implicit_pdf_lut_lin_1D>;
+using Distribution_2D = Distribution_t_2D<Distribution_alias_1D>;
 
 }  // namespace math
 
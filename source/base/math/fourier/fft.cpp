@@ -0,0 +1,654 @@
+#include "fft.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "math/simd_vector.inl"
+#include "math/vector2.inl"
+#include "memory/align.hpp"
+#include "simd/simd.inl"
+#include "thread/thread_pool.hpp"
+
+namespace math::fft {
+
+static double constexpr Two_pi = 6.283185307179586476925;
+
+static float2 root_of_unity(int64_t numerator, int64_t denominator) noexcept {
+    // In double precision, because the roots of large transforms are very close together
+    double const angle = -Two_pi * static_cast<double>(numerator % denominator) /
+                         static_cast<double>(denominator);
+
+    return float2(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+}
+
+Plan::Plan(int32_t size) noexcept : size_(size) {
+    std::vector<int32_t> radices;
+
+    int32_t rest = size;
+
+    for (; 0 == rest % 4 && rest > 1; rest /= 4) {
+        radices.push_back(4);
+    }
+
+    for (; 0 == rest % 2 && rest > 1; rest /= 2) {
+        radices.push_back(2);
+    }
+
+    for (int32_t p = 3; rest > 1; p += 2) {
+        if (p * p > rest) {
+            p = rest;
+        }
+
+        for (; 0 == rest % p; rest /= p) {
+            radices.push_back(p);
+        }
+    }
+
+    int32_t span = 1;
+
+    for (int32_t const radix : radices) {
+        stages_.push_back(Stage{radix, span, static_cast<uint32_t>(twiddles_.size())});
+
+        for (int32_t j = 0; j < span; ++j) {
+            for (int32_t r = 0; r < radix; ++r) {
+                twiddles_.push_back(root_of_unity(j * r, span * radix));
+            }
+        }
+
+        if (radix > 4 && (static_cast<int32_t>(root_offsets_.size()) <= radix ||
+                          root_offsets_[radix] < 0)) {
+            root_offsets_.resize(std::max(static_cast<int32_t>(root_offsets_.size()), radix + 1),
+                                 -1);
+
+            root_offsets_[radix] = static_cast<int32_t>(roots_.size());
+
+            for (int32_t r = 0; r < radix; ++r) {
+                roots_.push_back(root_of_unity(r, radix));
+            }
+        }
+
+        span *= radix;
+    }
+}
+
+int32_t Plan::size() const noexcept {
+    return size_;
+}
+
+std::vector<Plan::Stage> const& Plan::stages() const noexcept {
+    return stages_;
+}
+
+float2 const* Plan::twiddles() const noexcept {
+    return twiddles_.data();
+}
+
+float2 const* Plan::roots(int32_t radix) const noexcept {
+    return roots_.data() + root_offsets_[radix];
+}
+
+// Real transforms of even sizes are done as complex transforms of half the size
+class Real_plan {
+  public:
+    Real_plan(int32_t num) noexcept : plan_(fft::plan(0 == num % 2 ? num / 2 : num)) {
+        for (int32_t k = 0, len = num / 2; k <= len; ++k) {
+            twiddles_.push_back(root_of_unity(k, num));
+        }
+    }
+
+    Plan const& plan() const noexcept {
+        return plan_;
+    }
+
+    float2 const* twiddles() const noexcept {
+        return twiddles_.data();
+    }
+
+  private:
+    Plan const& plan_;
+
+    std::vector<float2> twiddles_;
+};
+
+int32_t fast_size(int32_t size) noexcept {
+    for (int32_t candidate = std::max(size, 1);; ++candidate) {
+        int32_t rest = candidate;
+
+        for (int32_t const p : {2, 3, 5}) {
+            while (0 == rest % p) {
+                rest /= p;
+            }
+        }
+
+        if (1 == rest) {
+            return candidate;
+        }
+    }
+}
+
+template <typename P>
+static P const& cached(int32_t size) noexcept {
+    static std::mutex mutex;
+
+    static std::map<int32_t, std::unique_ptr<P>> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& plan = plans[size];
+
+    if (!plan) {
+        plan = std::make_unique<P>(size);
+    }
+
+    return *plan;
+}
+
+Plan const& plan(int32_t size) noexcept {
+    return cached<Plan>(size);
+}
+
+// The butterflies are written for one complex value (float), or for four at once (Lanes)
+
+// Wrapped, because the attributes of Vector are lost when it is used as a template argument
+struct Lanes {
+    Vector v;
+};
+
+template <typename T>
+struct Complex {
+    T r;
+    T i;
+};
+
+static inline float broadcast(float s, float /*tag*/) noexcept {
+    return s;
+}
+
+static inline Lanes broadcast(float s, Lanes /*tag*/) noexcept {
+    return {simd::set_float4(s)};
+}
+
+static inline float add(float a, float b) noexcept {
+    return a + b;
+}
+
+static inline Lanes add(Lanes a, Lanes b) noexcept {
+    return {math::add(a.v, b.v)};
+}
+
+static inline float sub(float a, float b) noexcept {
+    return a - b;
+}
+
+static inline Lanes sub(Lanes a, Lanes b) noexcept {
+    return {math::sub(a.v, b.v)};
+}
+
+static inline float mul(float a, float b) noexcept {
+    return a * b;
+}
+
+static inline Lanes mul(Lanes a, Lanes b) noexcept {
+    return {math::mul(a.v, b.v)};
+}
+
+template <typename T>
+static inline Complex<T> operator+(Complex<T> a, Complex<T> b) noexcept {
+    return {add(a.r, b.r), add(a.i, b.i)};
+}
+
+template <typename T>
+static inline Complex<T> operator-(Complex<T> a, Complex<T> b) noexcept {
+    return {sub(a.r, b.r), sub(a.i, b.i)};
+}
+
+template <typename T>
+static inline Complex<T> scale(Complex<T> a, float s) noexcept {
+    T const st = broadcast(s, a.r);
+
+    return {mul(a.r, st), mul(a.i, st)};
+}
+
+template <typename T>
+static inline Complex<T> conjugate(Complex<T> a) noexcept {
+    return {a.r, sub(broadcast(0.f, a.r), a.i)};
+}
+
+template <typename T>
+static inline Complex<T> mul_minus_i(Complex<T> a) noexcept {
+    return {a.i, sub(broadcast(0.f, a.r), a.r)};
+}
+
+template <typename T>
+static inline Complex<T> mul_i(Complex<T> a) noexcept {
+    return {sub(broadcast(0.f, a.i), a.i), a.r};
+}
+
+template <typename T>
+static inline Complex<T> rotate(Complex<T> a, float2 w) noexcept {
+    T const wr = broadcast(w[0], a.r);
+    T const wi = broadcast(w[1], a.r);
+
+    return {sub(mul(a.r, wr), mul(a.i, wi)), add(mul(a.r, wi), mul(a.i, wr))};
+}
+
+static inline float2 mul_complex(float2 a, float2 b) noexcept {
+    return float2(a[0] * b[0] - a[1] * b[1], a[0] * b[1] + a[1] * b[0]);
+}
+
+template <typename T>
+static inline void butterfly_2(Complex<T> const* in, int32_t stride, float2 const* w,
+                               Complex<T>* out, int32_t span) noexcept {
+    Complex<T> const x0 = in[0];
+    Complex<T> const x1 = rotate(in[stride], w[1]);
+
+    out[0]    = x0 + x1;
+    out[span] = x0 - x1;
+}
+
+template <typename T>
+static inline void butterfly_3(Complex<T> const* in, int32_t stride, float2 const* w,
+                               Complex<T>* out, int32_t span) noexcept {
+    // sin(2 * pi / 3)
+    static float constexpr S = 0.866025403784438646763f;
+
+    Complex<T> const x0 = in[0];
+    Complex<T> const x1 = rotate(in[stride], w[1]);
+    Complex<T> const x2 = rotate(in[2 * stride], w[2]);
+
+    Complex<T> const t1 = x1 + x2;
+    Complex<T> const t2 = x0 - scale(t1, 0.5f);
+    Complex<T> const t3 = mul_minus_i(scale(x1 - x2, S));
+
+    out[0]        = x0 + t1;
+    out[span]     = t2 + t3;
+    out[2 * span] = t2 - t3;
+}
+
+template <typename T>
+static inline void butterfly_4(Complex<T> const* in, int32_t stride, float2 const* w,
+                               Complex<T>* out, int32_t span) noexcept {
+    Complex<T> const x0 = in[0];
+    Complex<T> const x1 = rotate(in[stride], w[1]);
+    Complex<T> const x2 = rotate(in[2 * stride], w[2]);
+    Complex<T> const x3 = rotate(in[3 * stride], w[3]);
+
+    Complex<T> const t0 = x0 + x2;
+    Complex<T> const t1 = x0 - x2;
+    Complex<T> const t2 = x1 + x3;
+    Complex<T> const t3 = mul_minus_i(x1 - x3);
+
+    out[0]        = t0 + t2;
+    out[span]     = t1 + t3;
+    out[2 * span] = t0 - t2;
+    out[3 * span] = t1 - t3;
+}
+
+template <typename T>
+static inline void butterfly(int32_t radix, float2 const* roots, Complex<T> const* in,
+                             int32_t stride, float2 const* w, Complex<T>* out,
+                             int32_t span) noexcept {
+    for (int32_t o = 0; o < radix; ++o) {
+        Complex<T> sum = in[0];
+
+        for (int32_t q = 1; q < radix; ++q) {
+            sum = sum + rotate(in[q * stride], mul_complex(w[q], roots[(o * q) % radix]));
+        }
+
+        out[o * span] = sum;
+    }
+}
+
+// Stockham autosort, which alternates between data and scratch instead of reordering the input
+template <typename T>
+static void transform(Plan const& plan, Complex<T>* data, Complex<T>* scratch) noexcept {
+    int32_t const n = plan.size();
+
+    Complex<T>* source = data;
+    Complex<T>* target = scratch;
+
+    for (auto const& stage : plan.stages()) {
+        int32_t const radix  = stage.radix;
+        int32_t const span   = stage.span;
+        int32_t const stride = n / radix;
+
+        float2 const* twiddles = plan.twiddles() + stage.twiddles;
+        float2 const* roots    = radix > 4 ? plan.roots(radix) : nullptr;
+
+        for (int32_t j = 0; j < stride; ++j) {
+            int32_t const k = j % span;
+
+            float2 const*     w   = twiddles + k * radix;
+            Complex<T> const* in  = source + j;
+            Complex<T>*       out = target + (j - k) * radix + k;
+
+            switch (radix) {
+                case 2:
+                    butterfly_2(in, stride, w, out, span);
+                    break;
+                case 3:
+                    butterfly_3(in, stride, w, out, span);
+                    break;
+                case 4:
+                    butterfly_4(in, stride, w, out, span);
+                    break;
+                default:
+                    butterfly(radix, roots, in, stride, w, out, span);
+            }
+        }
+
+        std::swap(source, target);
+    }
+
+    if (source != data) {
+        std::copy(source, source + n, data);
+    }
+}
+
+template <typename T>
+static void inverse_transform(Plan const& plan, Complex<T>* data, Complex<T>* scratch) noexcept {
+    int32_t const n = plan.size();
+
+    for (int32_t i = 0; i < n; ++i) {
+        data[i] = conjugate(data[i]);
+    }
+
+    transform(plan, data, scratch);
+
+    for (int32_t i = 0; i < n; ++i) {
+        data[i] = conjugate(data[i]);
+    }
+}
+
+// packed holds the real values as complex pairs for even num, and with zero imaginary parts
+// for odd num. It is overwritten.
+template <typename T>
+static void forward_real(Real_plan const& plan, Complex<T>* packed, Complex<T>* scratch,
+                         Complex<T>* result, int32_t num) noexcept {
+    transform(plan.plan(), packed, scratch);
+
+    if (0 != num % 2) {
+        std::copy(packed, packed + real_size(num), result);
+        return;
+    }
+
+    int32_t const h = num / 2;
+
+    float2 const* twiddles = plan.twiddles();
+
+    for (int32_t k = 0; k <= h; ++k) {
+        Complex<T> const a = packed[k % h];
+        Complex<T> const b = conjugate(packed[(h - k) % h]);
+
+        Complex<T> const even = scale(a + b, 0.5f);
+        Complex<T> const odd  = scale(mul_minus_i(a - b), 0.5f);
+
+        result[k] = even + rotate(odd, twiddles[k]);
+    }
+}
+
+// The inverse of forward_real(), the result is packed the same way
+template <typename T>
+static void inverse_real(Real_plan const& plan, Complex<T> const* source, Complex<T>* packed,
+                         Complex<T>* scratch, int32_t num) noexcept {
+    if (0 != num % 2) {
+        for (int32_t k = 0, len = real_size(num); k < len; ++k) {
+            packed[k] = source[k];
+        }
+
+        for (int32_t k = 1, len = real_size(num); k < len; ++k) {
+            packed[num - k] = conjugate(source[k]);
+        }
+    } else {
+        int32_t const h = num / 2;
+
+        float2 const* twiddles = plan.twiddles();
+
+        for (int32_t k = 0; k < h; ++k) {
+            Complex<T> const a = source[k];
+            Complex<T> const b = conjugate(source[h - k]);
+
+            float2 const w = twiddles[k];
+
+            packed[k] = (a + b) + mul_i(rotate(a - b, float2(w[0], -w[1])));
+        }
+    }
+
+    inverse_transform(plan.plan(), packed, scratch);
+}
+
+void forward(Plan const& plan, float2* data, float2* scratch) noexcept {
+    transform(plan, reinterpret_cast<Complex<float>*>(data),
+              reinterpret_cast<Complex<float>*>(scratch));
+}
+
+void inverse(Plan const& plan, float2* data, float2* scratch) noexcept {
+    inverse_transform(plan, reinterpret_cast<Complex<float>*>(data),
+                      reinterpret_cast<Complex<float>*>(scratch));
+}
+
+int32_t real_size(int32_t num) noexcept {
+    return num / 2 + 1;
+}
+
+void forward_real(float2* result, float const* source, int32_t num) noexcept {
+    Real_plan const& plan = cached<Real_plan>(num);
+
+    int32_t const n = plan.plan().size();
+
+    auto packed  = memory::allocate_aligned<Complex<float>>(n);
+    auto scratch = memory::allocate_aligned<Complex<float>>(n);
+
+    bool const even = 0 == num % 2;
+
+    for (int32_t k = 0; k < n; ++k) {
+        packed[k] = even ? Complex<float>{source[2 * k], source[2 * k + 1]}
+                         : Complex<float>{source[k], 0.f};
+    }
+
+    forward_real(plan, packed, scratch, reinterpret_cast<Complex<float>*>(result), num);
+
+    memory::free_aligned(scratch);
+    memory::free_aligned(packed);
+}
+
+void inverse_real(float* result, float2 const* source, int32_t num) noexcept {
+    Real_plan const& plan = cached<Real_plan>(num);
+
+    int32_t const n = plan.plan().size();
+
+    auto packed  = memory::allocate_aligned<Complex<float>>(n);
+    auto scratch = memory::allocate_aligned<Complex<float>>(n);
+
+    inverse_real(plan, reinterpret_cast<Complex<float> const*>(source), packed, scratch, num);
+
+    bool const even = 0 == num % 2;
+
+    for (int32_t k = 0; k < n; ++k) {
+        if (even) {
+            result[2 * k]     = packed[k].r;
+            result[2 * k + 1] = packed[k].i;
+        } else {
+            result[k] = packed[k].r;
+        }
+    }
+
+    memory::free_aligned(scratch);
+    memory::free_aligned(packed);
+}
+
+// Up to four values that are stride apart, as the lanes of a vector
+
+static inline Lanes load_lanes(float const* source, int32_t stride, int32_t num_lanes) noexcept {
+    alignas(16) float lanes[4] = {0.f, 0.f, 0.f, 0.f};
+
+    for (int32_t l = 0; l < num_lanes; ++l) {
+        lanes[l] = source[l * stride];
+    }
+
+    return {simd::load_float4(lanes)};
+}
+
+static inline Complex<Lanes> load_lanes(float2 const* source, int32_t stride,
+                                        int32_t num_lanes) noexcept {
+    alignas(16) float r[4] = {0.f, 0.f, 0.f, 0.f};
+    alignas(16) float i[4] = {0.f, 0.f, 0.f, 0.f};
+
+    for (int32_t l = 0; l < num_lanes; ++l) {
+        r[l] = source[l * stride][0];
+        i[l] = source[l * stride][1];
+    }
+
+    return {{simd::load_float4(r)}, {simd::load_float4(i)}};
+}
+
+static inline void store_lanes(float* destination, int32_t stride, int32_t num_lanes,
+                               Lanes v) noexcept {
+    alignas(16) float lanes[4];
+    simd::store_float4(lanes, v.v);
+
+    for (int32_t l = 0; l < num_lanes; ++l) {
+        destination[l * stride] = lanes[l];
+    }
+}
+
+static inline void store_lanes(float2* destination, int32_t stride, int32_t num_lanes,
+                               Complex<Lanes> const& v) noexcept {
+    alignas(16) float r[4];
+    alignas(16) float i[4];
+    simd::store_float4(r, v.r.v);
+    simd::store_float4(i, v.i.v);
+
+    for (int32_t l = 0; l < num_lanes; ++l) {
+        destination[l * stride] = float2(r[l], i[l]);
+    }
+}
+
+// Transforms the columns of data in place, four at a time
+static void transform_columns(float2* data, int32_t row_size, int32_t height, bool inverse,
+                              thread::Pool& pool) noexcept {
+    Plan const& columns = plan(height);
+
+    pool.run_range(
+        [data, row_size, height, inverse, &columns](uint32_t /*id*/, int32_t begin, int32_t end) {
+            auto column  = memory::allocate_aligned<Complex<Lanes>>(height);
+            auto scratch = memory::allocate_aligned<Complex<Lanes>>(height);
+
+            for (int32_t x = begin; x < end; x += 4) {
+                int32_t const num_lanes = std::min(end - x, 4);
+
+                for (int32_t y = 0; y < height; ++y) {
+                    column[y] = load_lanes(data + y * row_size + x, 1, num_lanes);
+                }
+
+                if (inverse) {
+                    inverse_transform(columns, column, scratch);
+                } else {
+                    transform(columns, column, scratch);
+                }
+
+                for (int32_t y = 0; y < height; ++y) {
+                    store_lanes(data + y * row_size + x, 1, num_lanes, column[y]);
+                }
+            }
+
+            memory::free_aligned(scratch);
+            memory::free_aligned(column);
+        },
+        0, row_size);
+}
+
+void forward_real_2d(float2* result, float const* source, int32_t width, int32_t height,
+                     thread::Pool& pool) noexcept {
+    Real_plan const& rows = cached<Real_plan>(width);
+
+    int32_t const row_size = real_size(width);
+
+    pool.run_range(
+        [result, source, width, row_size, &rows](uint32_t /*id*/, int32_t begin, int32_t end) {
+            int32_t const n = rows.plan().size();
+
+            bool const even = 0 == width % 2;
+
+            auto packed  = memory::allocate_aligned<Complex<Lanes>>(n);
+            auto scratch = memory::allocate_aligned<Complex<Lanes>>(n);
+            auto line    = memory::allocate_aligned<Complex<Lanes>>(row_size);
+
+            for (int32_t y = begin; y < end; y += 4) {
+                int32_t const num_lanes = std::min(end - y, 4);
+
+                float const* row = source + y * width;
+
+                for (int32_t k = 0; k < n; ++k) {
+                    if (even) {
+                        packed[k] = {load_lanes(row + 2 * k, width, num_lanes),
+                                     load_lanes(row + 2 * k + 1, width, num_lanes)};
+                    } else {
+                        packed[k] = {load_lanes(row + k, width, num_lanes), {simd::Zero}};
+                    }
+                }
+
+                forward_real(rows, packed, scratch, line, width);
+
+                for (int32_t k = 0; k < row_size; ++k) {
+                    store_lanes(result + y * row_size + k, row_size, num_lanes, line[k]);
+                }
+            }
+
+            memory::free_aligned(line);
+            memory::free_aligned(scratch);
+            memory::free_aligned(packed);
+        },
+        0, height);
+
+    transform_columns(result, row_size, height, false, pool);
+}
+
+void inverse_real_2d(float* result, float2* source, int32_t width, int32_t height,
+                     thread::Pool& pool) noexcept {
+    Real_plan const& rows = cached<Real_plan>(width);
+
+    int32_t const row_size = real_size(width);
+
+    transform_columns(source, row_size, height, true, pool);
+
+    pool.run_range(
+        [result, source, width, row_size, &rows](uint32_t /*id*/, int32_t begin, int32_t end) {
+            int32_t const n = rows.plan().size();
+
+            bool const even = 0 == width % 2;
+
+            auto packed  = memory::allocate_aligned<Complex<Lanes>>(n);
+            auto scratch = memory::allocate_aligned<Complex<Lanes>>(n);
+            auto line    = memory::allocate_aligned<Complex<Lanes>>(row_size);
+
+            for (int32_t y = begin; y < end; y += 4) {
+                int32_t const num_lanes = std::min(end - y, 4);
+
+                for (int32_t k = 0; k < row_size; ++k) {
+                    line[k] = load_lanes(source + y * row_size + k, row_size, num_lanes);
+                }
+
+                inverse_real(rows, line, packed, scratch, width);
+
+                float* row = result + y * width;
+
+                for (int32_t k = 0; k < n; ++k) {
+                    if (even) {
+                        store_lanes(row + 2 * k, width, num_lanes, packed[k].r);
+                        store_lanes(row + 2 * k + 1, width, num_lanes, packed[k].i);
+                    } else {
+                        store_lanes(row + k, width, num_lanes, packed[k].r);
+                    }
+                }
+            }
+
+            memory::free_aligned(line);
+            memory::free_aligned(scratch);
+            memory::free_aligned(packed);
+        },
+        0, height);
+}
+
+}  // namespace math::fft
@@ -0,0 +1,80 @@
+#ifndef SU_BASE_MATH_FOURIER_FFT_HPP
+#define SU_BASE_MATH_FOURIER_FFT_HPP
+
+#include <vector>
+#include "math/vector.hpp"
+
+namespace thread {
+class Pool;
+}
+
+namespace math::fft {
+
+// Factorization and twiddle factors of a complex FFT of one size.
+// Sizes are factored into radix 4, 2 and 3 stages, other prime factors use a generic butterfly.
+class Plan {
+  public:
+    Plan(int32_t size) noexcept;
+
+    int32_t size() const noexcept;
+
+    struct Stage {
+        int32_t radix;
+
+        // Product of the radices of the previous stages
+        int32_t span;
+
+        uint32_t twiddles;
+    };
+
+    std::vector<Stage> const& stages() const noexcept;
+
+    float2 const* twiddles() const noexcept;
+
+    // Roots of unity of the generic butterflies, indexed by the radix
+    float2 const* roots(int32_t radix) const noexcept;
+
+  private:
+    int32_t size_;
+
+    std::vector<Stage> stages_;
+
+    std::vector<float2> twiddles_;
+
+    std::vector<int32_t> root_offsets_;
+
+    std::vector<float2> roots_;
+};
+
+// Smallest size of at least size, that only has the prime factors 2, 3 and 5
+int32_t fast_size(int32_t size) noexcept;
+
+// Plans are created on first use and then cached for the lifetime of the program
+Plan const& plan(int32_t size) noexcept;
+
+// Unnormalized complex transforms in place, scratch must have room for plan.size() elements
+void forward(Plan const& plan, float2* data, float2* scratch) noexcept;
+
+void inverse(Plan const& plan, float2* data, float2* scratch) noexcept;
+
+// Number of complex values of the transform of num real values
+int32_t real_size(int32_t num) noexcept;
+
+// Transforms num real values into real_size(num) complex values
+void forward_real(float2* result, float const* source, int32_t num) noexcept;
+
+// Unnormalized counterpart of forward_real()
+void inverse_real(float* result, float2 const* source, int32_t num) noexcept;
+
+// The 2D transforms store real_size(width) * height complex values,
+// the rows and columns are processed in groups of four with SIMD
+void forward_real_2d(float2* result, float const* source, int32_t width, int32_t height,
+                     thread::Pool& pool) noexcept;
+
+// Unnormalized counterpart of forward_real_2d(), that overwrites source
+void inverse_real_2d(float* result, float2* source, int32_t width, int32_t height,
+                     thread::Pool& pool) noexcept;
+
+}  // namespace math::fft
+
+#endif
@@ -1,5 +1,5 @@
 target_sources(base
   PRIVATE
-  "${CMAKE_CURRENT_LIST_DIR}/dft.cpp"
-  "${CMAKE_CURRENT_LIST_DIR}/dft.hpp"
+  "${CMAKE_CURRENT_LIST_DIR}/fft.cpp"
+  "${CMAKE_CURRENT_LIST_DIR}/fft.hpp"
 ) 
@@ -24,6 +24,8 @@ target_sources(base
 	"${CMAKE_CURRENT_LIST_DIR}/quaternion.inl"
 	"${CMAKE_CURRENT_LIST_DIR}/ray.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/ray.inl"
+	"${CMAKE_CURRENT_LIST_DIR}/ray_packet.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/ray_packet.inl"
     "${CMAKE_CURRENT_LIST_DIR}/sample_distribution.inl"
     "${CMAKE_CURRENT_LIST_DIR}/sampling.inl"
 	"${CMAKE_CURRENT_LIST_DIR}/simd_aabb.hpp"
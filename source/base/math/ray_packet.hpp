@@ -0,0 +1,46 @@
+#ifndef SU_BASE_MATH_RAY_PACKET_HPP
+#define SU_BASE_MATH_RAY_PACKET_HPP
+
+#include "simd/simd.hpp"
+#include "vector3.hpp"
+
+namespace math {
+
+struct Ray;
+
+// Rays in structure of arrays layout, so that they can be tested against a node at once.
+// Every ray occupies one lane, the lanes that take part in a query are selected by a bit mask.
+struct alignas(16) Ray_packet {
+    static uint32_t constexpr Size = 4;
+
+    static uint32_t constexpr All = (1u << Size) - 1;
+
+    void set(uint32_t lane, Ray const& ray) noexcept;
+
+    void set(uint32_t lane, FVector origin, FVector direction, FVector inv_direction, float min_t,
+             float max_t) noexcept;
+
+    void get(uint32_t lane, Vector& origin, Vector& direction, Vector& inv_direction) const
+        noexcept;
+
+    Vector origin_v(uint32_t axis) const noexcept;
+    Vector direction_v(uint32_t axis) const noexcept;
+    Vector inv_direction_v(uint32_t axis) const noexcept;
+
+    Vector min_t_v() const noexcept;
+    Vector max_t_v() const noexcept;
+
+    // The direction of the ray in the given lane decides the traversal order for the packet
+    uint32_t sign(uint32_t lane, uint32_t axis) const noexcept;
+
+    float origin[3][Size];
+    float direction[3][Size];
+    float inv_direction[3][Size];
+
+    float min_t[Size];
+    float max_t[Size];
+};
+
+}  // namespace math
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SU_BASE_MATH_RAY_PACKET_INL
+#define SU_BASE_MATH_RAY_PACKET_INL
+
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "simd/simd.inl"
+#include "vector3.inl"
+
+namespace math {
+
+inline void Ray_packet::set(uint32_t lane, Ray const& ray) noexcept {
+    for (uint32_t i = 0; i < 3; ++i) {
+        origin[i][lane]        = ray.origin[i];
+        direction[i][lane]     = ray.direction[i];
+        inv_direction[i][lane] = ray.inv_direction[i];
+    }
+
+    min_t[lane] = ray.min_t;
+    max_t[lane] = ray.max_t;
+}
+
+inline void Ray_packet::set(uint32_t lane, FVector origin, FVector direction,
+                            FVector inv_direction, float min_t, float max_t) noexcept {
+    float3 o;
+    float3 d;
+    float3 id;
+    simd::store_float4(o.v, origin);
+    simd::store_float4(d.v, direction);
+    simd::store_float4(id.v, inv_direction);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        this->origin[i][lane]        = o[i];
+        this->direction[i][lane]     = d[i];
+        this->inv_direction[i][lane] = id[i];
+    }
+
+    this->min_t[lane] = min_t;
+    this->max_t[lane] = max_t;
+}
+
+inline void Ray_packet::get(uint32_t lane, Vector& origin, Vector& direction,
+                            Vector& inv_direction) const noexcept {
+    float3 const o(this->origin[0][lane], this->origin[1][lane], this->origin[2][lane]);
+    float3 const d(this->direction[0][lane], this->direction[1][lane], this->direction[2][lane]);
+    float3 const id(this->inv_direction[0][lane], this->inv_direction[1][lane],
+                    this->inv_direction[2][lane]);
+
+    origin        = simd::load_float4(o.v);
+    direction     = simd::load_float4(d.v);
+    inv_direction = simd::load_float4(id.v);
+}
+
+inline Vector Ray_packet::origin_v(uint32_t axis) const noexcept {
+    return simd::load_float4(origin[axis]);
+}
+
+inline Vector Ray_packet::direction_v(uint32_t axis) const noexcept {
+    return simd::load_float4(direction[axis]);
+}
+
+inline Vector Ray_packet::inv_direction_v(uint32_t axis) const noexcept {
+    return simd::load_float4(inv_direction[axis]);
+}
+
+inline Vector Ray_packet::min_t_v() const noexcept {
+    return simd::load_float4(min_t);
+}
+
+inline Vector Ray_packet::max_t_v() const noexcept {
+    return simd::load_float4(max_t);
+}
+
+inline uint32_t Ray_packet::sign(uint32_t lane, uint32_t axis) const noexcept {
+    return inv_direction[axis][lane] < 0.f ? 1 : 0;
+}
+
+}  // namespace math
+
+#endif
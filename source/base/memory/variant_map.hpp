@@ -27,6 +27,8 @@ class Variant_map {
     void inherit(const Variant_map& other, std::string const& key);
     void inherit_except(const Variant_map& other, std::string_view key);
 
+    void erase(std::string_view key);
+
     bool operator<(const Variant_map& other) const;
 
   private:
@@ -135,6 +135,12 @@ inline void Variant_map::inherit_except(const Variant_map& other, std::string_vi
     }
 }
 
+inline void Variant_map::erase(std::string_view key) {
+    if (auto const i = map_.find(key); map_.end() != i) {
+        map_.erase(i);
+    }
+}
+
 }  // namespace memory
 
 #endif
@@ -1,7 +1,5 @@
 target_sources(base
 	PRIVATE
-	"${CMAKE_CURRENT_LIST_DIR}/task_queue.hpp"	
-	"${CMAKE_CURRENT_LIST_DIR}/task_queue.inl"
 	"${CMAKE_CURRENT_LIST_DIR}/thread_pool.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/thread_pool.hpp"
 	)   
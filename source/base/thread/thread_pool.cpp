@@ -1,23 +1,21 @@
 #include "thread_pool.hpp"
 
-#ifdef GRANULAR_TASKS
-#include "task_queue.inl"
-#endif
-
 #include <algorithm>
-#include <cmath>
 
 namespace thread {
 
+// Identifies the threads of a pool, so that nested calls can push to their own deque
+static thread_local Pool const* current_pool = nullptr;
+static thread_local uint32_t    current_id   = 0;
+
+// Number of sub-ranges per thread that run_range() will at most create
+static int32_t constexpr Num_range_splits = 16;
+
+// How often an idle thread looks for work before going to sleep
+static uint32_t constexpr Num_idle_spins = 64;
+
 Pool::Pool(uint32_t num_threads) noexcept
-    : num_threads_(num_threads),
-      uniques_(num_threads),
-      threads_(num_threads)
-#ifdef GRANULAR_TASKS
-      ,
-      tasks_(num_threads * 64)
-#endif
-{
+    : num_threads_(num_threads), uniques_(num_threads), threads_(num_threads) {
     for (uint32_t i = 0; i < num_threads; ++i) {
         threads_[i] = std::thread(&Pool::loop, this, i);
     }
@@ -26,9 +24,13 @@ Pool::Pool(uint32_t num_threads) noexcept
 }
 
 Pool::~Pool() noexcept {
-    quit_ = true;
+    {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        quit_ = true;
+        ++wake_epoch_;
+    }
 
-    wake_all();
+    wake_signal_.notify_all();
 
     for (auto& t : threads_) {
         t.join();
@@ -46,23 +48,99 @@ uint32_t Pool::num_threads() const noexcept {
 }
 
 void Pool::run_parallel(Parallel_program program) noexcept {
-    parallel_program_ = program;
+    Group group;
+    group.num_pending = num_threads_;
 
-    range_program_ = nullptr;
+    for (uint32_t i = 0; i < num_threads_; ++i) {
+        push_pinned(i, Task{nullptr, &program, &group, 0, 0, 0});
+    }
 
     wake_all();
 
-    wait_all();
+    wait(group);
 }
 
 void Pool::run_range(Range_program program, int32_t begin, int32_t end) noexcept {
-    range_program_ = program;
+    if (end <= begin) {
+        return;
+    }
+
+    int32_t const range = end - begin;
+
+    int32_t const max_tasks = static_cast<int32_t>(num_threads_) * Num_range_splits;
+
+    int32_t const grain = std::max((range + max_tasks - 1) / max_tasks, 1);
+
+    Group group;
+
+    if (is_own_thread()) {
+        // The calling thread works on the whole range, and leaves pieces to steal for the others
+        group.num_pending = 1;
+
+        execute(current_id, Task{&program, nullptr, &group, begin, end, grain});
+    } else {
+        // Seed every thread with an initial chunk, they are split further on demand
+        int32_t const num_chunks = std::min(static_cast<int32_t>(num_threads_), range);
+
+        int32_t const step = range / num_chunks;
+        int32_t const rest = range % num_chunks;
+
+        group.num_pending = static_cast<uint32_t>(num_chunks);
+
+        for (int32_t i = 0, b = begin; i < num_chunks; ++i) {
+            int32_t const e = b + step + (i < rest ? 1 : 0);
+
+            push(static_cast<uint32_t>(i), Task{&program, nullptr, &group, b, e, grain});
+
+            b = e;
+        }
+
+        wake_all();
+    }
+
+    wait(group);
+}
+
+void Pool::fork_join(Task_program const& a, Task_program const& b) noexcept {
+    Group group;
+
+    if (is_own_thread()) {
+        uint32_t const id = current_id;
+
+        group.num_pending = 2;
+
+        push(id, Task{nullptr, &b, &group, 0, 0, 0});
+
+        wake_one();
+
+        execute(id, Task{nullptr, &a, &group, 0, 0, 0});
+    } else {
+        group.num_pending = 2;
+
+        uint32_t const id = next_.fetch_add(2, std::memory_order_relaxed);
+
+        push(id % num_threads_, Task{nullptr, &a, &group, 0, 0, 0});
+        push((id + 1) % num_threads_, Task{nullptr, &b, &group, 0, 0, 0});
+
+        wake_all();
+    }
 
-    parallel_program_ = nullptr;
+    wait(group);
+}
 
-    wake_all(begin, end);
+bool Pool::help() noexcept {
+    if (!is_own_thread()) {
+        return false;
+    }
 
-    wait_all();
+    uint32_t const id = current_id;
+
+    if (Task task; pop_unpinned(id, task) || steal(id, task)) {
+        execute(id, task);
+        return true;
+    }
+
+    return false;
 }
 
 void Pool::run_async(Async_program program) noexcept {
@@ -78,49 +156,202 @@ void Pool::wait_async() noexcept {
     async_.done_signal.wait(lock, [this]() noexcept { return !async_.wake; });
 }
 
-void Pool::wake_all() noexcept {
-    for (auto& u : uniques_) {
+bool Pool::is_own_thread() const noexcept {
+    return this == current_pool;
+}
+
+void Pool::push(uint32_t id, Task const& task) noexcept {
+    Unique& u = uniques_[id];
+
+    {
         std::unique_lock<std::mutex> lock(u.mutex);
-        u.wake = true;
-        lock.unlock();
-        u.wake_signal.notify_one();
+        u.tasks.push_back(task);
     }
+
+    u.num_tasks.fetch_add(1, std::memory_order_seq_cst);
 }
 
-void Pool::wake_all(int32_t begin, int32_t end) noexcept {
-#ifdef GRANULAR_TASKS
-    float const   range     = static_cast<float>(end - begin);
-    float const   num_tasks = static_cast<float>(tasks_.size());
-    int32_t const step      = static_cast<int32_t>(std::ceil(range / num_tasks));
+void Pool::push_pinned(uint32_t id, Task const& task) noexcept {
+    Unique& u = uniques_[id];
+
+    {
+        std::unique_lock<std::mutex> lock(u.mutex);
+        u.pinned.push_back(task);
+    }
+
+    u.num_pinned.fetch_add(1, std::memory_order_seq_cst);
+}
 
-    tasks_.clear();
+bool Pool::pop(uint32_t id, Task& task) noexcept {
+    Unique& u = uniques_[id];
 
-    for (int32_t i = begin; i < end; i += step) {
-        tasks_.push({i, std::min(i + step, end)});
+    if (0 == u.num_pinned.load(std::memory_order_relaxed) &&
+        0 == u.num_tasks.load(std::memory_order_relaxed)) {
+        return false;
     }
 
-    wake_all();
-#else
-    float const range       = static_cast<float>(end - begin);
-    float const num_threads = static_cast<float>(threads_.size());
+    std::unique_lock<std::mutex> lock(u.mutex);
+
+    if (!u.pinned.empty()) {
+        task = u.pinned.front();
+        u.pinned.pop_front();
+        u.num_pinned.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (!u.tasks.empty()) {
+        task = u.tasks.back();
+        u.tasks.pop_back();
+        u.num_tasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+bool Pool::pop_unpinned(uint32_t id, Task& task) noexcept {
+    Unique& u = uniques_[id];
 
-    int32_t const step = static_cast<int32_t>(std::ceil(range / num_threads));
+    if (0 == u.num_tasks.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(u.mutex);
+
+    if (!u.tasks.empty()) {
+        task = u.tasks.back();
+        u.tasks.pop_back();
+        u.num_tasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
 
-    int32_t b = 0;
-    int32_t e = begin;
+    return false;
+}
+
+bool Pool::steal(uint32_t id, Task& task) noexcept {
+    for (uint32_t i = 1; i < num_threads_; ++i) {
+        Unique& u = uniques_[(id + i) % num_threads_];
 
-    for (auto& u : uniques_) {
-        b = e;
-        e += step;
+        if (0 == u.num_tasks.load(std::memory_order_relaxed)) {
+            continue;
+        }
 
         std::unique_lock<std::mutex> lock(u.mutex);
-        u.begin = b;
-        u.end   = std::min(e, end);
-        u.wake  = true;
-        lock.unlock();
-        u.wake_signal.notify_one();
+
+        if (!u.tasks.empty()) {
+            task = u.tasks.front();
+            u.tasks.pop_front();
+            u.num_tasks.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
     }
-#endif
+
+    return false;
+}
+
+bool Pool::has_tasks(uint32_t id) const noexcept {
+    if (uniques_[id].num_pinned.load(std::memory_order_seq_cst) > 0) {
+        return true;
+    }
+
+    for (auto const& u : uniques_) {
+        if (u.num_tasks.load(std::memory_order_seq_cst) > 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Pool::execute(uint32_t id, Task const& task) noexcept {
+    if (task.range_program) {
+        execute_range(id, task);
+    } else {
+        (*task.program)(id);
+    }
+
+    complete(*task.group);
+}
+
+void Pool::execute_range(uint32_t id, Task const& task) noexcept {
+    Unique& u = uniques_[id];
+
+    int32_t const grain = task.grain;
+
+    int32_t b = task.begin;
+    int32_t e = task.end;
+
+    while (b < e) {
+        // Lazy splitting: Only offer the upper half of the remaining range,
+        // if the last offer was stolen in the meantime
+        if (e - b > grain && 0 == u.num_tasks.load(std::memory_order_relaxed)) {
+            int32_t const middle = b + (e - b) / 2;
+
+            task.group->num_pending.fetch_add(1, std::memory_order_relaxed);
+
+            push(id, Task{task.range_program, nullptr, task.group, middle, e, grain});
+
+            wake_one();
+
+            e = middle;
+        }
+
+        int32_t const chunk_end = std::min(b + grain, e);
+
+        (*task.range_program)(id, b, chunk_end);
+
+        b = chunk_end;
+    }
+}
+
+void Pool::complete(Group& group) noexcept {
+    if (1 == group.num_pending.fetch_sub(1, std::memory_order_acq_rel)) {
+        // group must not be touched anymore, the waiting thread might have returned already
+        { std::unique_lock<std::mutex> lock(done_mutex_); }
+
+        done_signal_.notify_all();
+    }
+}
+
+void Pool::wait(Group& group) noexcept {
+    if (is_own_thread()) {
+        uint32_t const id = current_id;
+
+        while (group.num_pending.load(std::memory_order_acquire) > 0) {
+            if (Task task; pop(id, task) || steal(id, task)) {
+                execute(id, task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    } else {
+        std::unique_lock<std::mutex> lock(done_mutex_);
+        done_signal_.wait(lock, [&group]() noexcept {
+            return 0 == group.num_pending.load(std::memory_order_acquire);
+        });
+    }
+}
+
+void Pool::wake_all() noexcept {
+    {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        ++wake_epoch_;
+    }
+
+    wake_signal_.notify_all();
+}
+
+void Pool::wake_one() noexcept {
+    if (0 == num_sleeping_.load(std::memory_order_seq_cst)) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        ++wake_epoch_;
+    }
+
+    wake_signal_.notify_one();
 }
 
 void Pool::wake_async() noexcept {
@@ -130,39 +361,46 @@ void Pool::wake_async() noexcept {
     async_.wake_signal.notify_one();
 }
 
-void Pool::wait_all() noexcept {
-    for (auto& u : uniques_) {
-        std::unique_lock<std::mutex> lock(u.mutex);
-        u.done_signal.wait(lock, [&u]() noexcept { return !u.wake; });
-    }
-}
-
 void Pool::loop(uint32_t id) noexcept {
-    Unique& unique = uniques_[id];
+    current_pool = this;
+    current_id   = id;
+
+    for (uint32_t spins = 0;;) {
+        if (Task task; pop(id, task) || steal(id, task)) {
+            execute(id, task);
+            spins = 0;
+            continue;
+        }
 
-    for (;;) {
-        std::unique_lock<std::mutex> lock(unique.mutex);
-        unique.wake_signal.wait(lock, [&unique]() noexcept { return unique.wake; });
+        if (++spins < Num_idle_spins) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        spins = 0;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
 
         if (quit_) {
             break;
         }
 
-        if (range_program_) {
-#ifdef GRANULAR_TASKS
-            for (Task task; tasks_.pop(task);) {
-                range_program_(id, task.begin, task.end);
-            }
-#else
-            range_program_(id, unique.begin, unique.end);
-#endif
-        } else if (parallel_program_) {
-            parallel_program_(id);
+        // Announce the intention to sleep before the final check,
+        // so that a concurrent push either is seen here or sees the sleeper
+        num_sleeping_.fetch_add(1, std::memory_order_seq_cst);
+
+        if (!has_tasks(id)) {
+            uint64_t const epoch = wake_epoch_;
+            wake_signal_.wait(lock, [this, epoch]() noexcept {
+                return quit_ || epoch != wake_epoch_;
+            });
         }
 
-        unique.wake = false;
-        lock.unlock();
-        unique.done_signal.notify_one();
+        num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+
+        if (quit_) {
+            break;
+        }
     }
 }
 
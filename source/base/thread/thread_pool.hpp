@@ -1,23 +1,26 @@
 #ifndef SU_BASE_THREAD_POOL_HPP
 #define SU_BASE_THREAD_POOL_HPP
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
-// #define GRANULAR_TASKS
-
-#ifdef GRANULAR_TASKS
-#include "task_queue.hpp"
-#endif
-
 namespace thread {
 
+// Work-stealing scheduler:
+// Every thread owns a deque of tasks. It pushes and pops at the back,
+// while idle threads steal from the front of the other deques.
+// All run_* functions can be called from any thread, including from inside of running programs.
+// Threads of the pool that wait for nested work keep on executing tasks instead of blocking.
 class Pool {
   public:
     using Parallel_program = std::function<void(uint32_t)>;
     using Range_program    = std::function<void(uint32_t, int32_t, int32_t)>;
+    using Task_program     = std::function<void(uint32_t)>;
     using Async_program    = std::function<void()>;
 
     Pool(uint32_t num_threads) noexcept;
@@ -26,29 +29,47 @@ class Pool {
 
     uint32_t num_threads() const noexcept;
 
+    // Calls program exactly once on every thread of the pool.
     void run_parallel(Parallel_program program) noexcept;
 
+    // Splits [begin, end) adaptively into consecutive sub-ranges.
+    // The same thread can receive more than one sub-range.
     void run_range(Range_program program, int32_t begin, int32_t end) noexcept;
 
+    // Runs a and b potentially in parallel and returns after both have completed.
+    void fork_join(Task_program const& a, Task_program const& b) noexcept;
+
+    // Executes one of the tasks that wait in the deques, if called from a thread of the pool.
+    // Programs of run_parallel() that loop over their own work call this between work items,
+    // because otherwise the tasks of concurrent run_range() calls wait until they are done.
+    // Returns whether a task was executed.
+    bool help() noexcept;
+
     void run_async(Async_program program) noexcept;
 
     void wait_async() noexcept;
 
   private:
-    void wake_all() noexcept;
-    void wake_all(int32_t begin, int32_t end) noexcept;
+    struct Group {
+        std::atomic<uint32_t> num_pending;
+    };
 
-    void wake_async() noexcept;
+    struct Task {
+        Range_program const* range_program;
+        Task_program const*  program;
+        Group*               group;
+        int32_t              begin;
+        int32_t              end;
+        int32_t              grain;
+    };
 
-    void wait_all() noexcept;
+    struct alignas(64) Unique {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+        std::deque<Task> pinned;
 
-    struct Unique {
-        int32_t                 begin;
-        int32_t                 end;
-        std::condition_variable wake_signal;
-        std::condition_variable done_signal;
-        std::mutex              mutex;
-        bool                    wake = false;
+        std::atomic<uint32_t> num_tasks{0};
+        std::atomic<uint32_t> num_pinned{0};
     };
 
     struct Async {
@@ -60,26 +81,54 @@ class Pool {
         bool                    quit = false;
     };
 
-    uint32_t num_threads_;
+    bool is_own_thread() const noexcept;
 
-    bool quit_ = false;
+    void push(uint32_t id, Task const& task) noexcept;
+
+    void push_pinned(uint32_t id, Task const& task) noexcept;
+
+    bool pop(uint32_t id, Task& task) noexcept;
+
+    // Same as above, but ignores the pinned tasks
+    bool pop_unpinned(uint32_t id, Task& task) noexcept;
 
-    Parallel_program parallel_program_;
+    bool steal(uint32_t id, Task& task) noexcept;
 
-    Range_program range_program_;
+    bool has_tasks(uint32_t id) const noexcept;
+
+    void execute(uint32_t id, Task const& task) noexcept;
+
+    void execute_range(uint32_t id, Task const& task) noexcept;
+
+    void complete(Group& group) noexcept;
+
+    void wait(Group& group) noexcept;
+
+    void wake_all() noexcept;
+
+    void wake_one() noexcept;
+
+    void wake_async() noexcept;
+
+    uint32_t num_threads_;
+
+    bool quit_ = false;
 
     std::vector<Unique> uniques_;
 
     std::vector<std::thread> threads_;
 
-    struct Task {
-        int32_t begin;
-        int32_t end;
-    };
+    std::atomic<uint32_t> next_{0};
 
-#ifdef GRANULAR_TASKS
-    Task_queue<Task> tasks_;
-#endif
+    std::atomic<uint32_t> num_sleeping_{0};
+
+    uint64_t wake_epoch_ = 0;
+
+    std::mutex              sleep_mutex_;
+    std::condition_variable wake_signal_;
+
+    std::mutex              done_mutex_;
+    std::condition_variable done_signal_;
 
     Async async_;
 
@@ -16,5 +16,6 @@ if (WIN32)
 endif()
 
 include("${CMAKE_CURRENT_LIST_DIR}/controller/controller.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/converter/converter.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/options/options.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/server/server.cmake")
@@ -0,0 +1,5 @@
+target_sources(cli
+  PRIVATE
+  "${CMAKE_CURRENT_LIST_DIR}/converter.cpp"
+  "${CMAKE_CURRENT_LIST_DIR}/converter.hpp"
+)
@@ -0,0 +1,83 @@
+#include "converter.hpp"
+#include <fstream>
+#include "base/memory/variant_map.inl"
+#include "core/file/file_system.hpp"
+#include "core/image/encoding/sui/sui_writer.hpp"
+#include "core/image/texture/texture.hpp"
+#include "core/image/texture/texture_provider.hpp"
+#include "core/logging/logging.hpp"
+#include "core/resource/resource_manager.inl"
+
+namespace converter {
+
+using Usage = image::texture::Provider::Usage;
+
+static Usage read_usage(std::string const& usage) {
+    if ("Normal" == usage) {
+        return Usage::Normal;
+    } else if ("Anisotropy" == usage) {
+        return Usage::Anisotropy;
+    } else if ("Roughness" == usage) {
+        return Usage::Roughness;
+    } else if ("Surface" == usage) {
+        return Usage::Surface;
+    } else if ("Specularity" == usage) {
+        return Usage::Specularity;
+    } else if ("Mask" == usage) {
+        return Usage::Mask;
+    }
+
+    return Usage::Color;
+}
+
+static std::string container_name(std::string const& filename) {
+    size_t const slash = filename.find_last_of("/\\");
+    size_t const dot   = filename.find_last_of('.');
+
+    if (std::string::npos == dot || (std::string::npos != slash && dot < slash)) {
+        return filename + ".sui";
+    }
+
+    return filename.substr(0, dot) + ".sui";
+}
+
+bool convert(std::vector<std::string> const& filenames, std::string const& usage,
+             resource::Manager& manager) {
+    Usage const texture_usage = read_usage(usage);
+
+    image::Channels const channels = image::texture::Provider::channels(texture_usage);
+
+    memory::Variant_map options;
+    options.set("usage", texture_usage);
+    options.set("mip_maps", true);
+
+    bool success = true;
+
+    for (auto const& f : filenames) {
+        auto const texture = manager.load<image::texture::Texture>(f, options);
+        if (!texture) {
+            success = false;
+            continue;
+        }
+
+        std::string resolved_name;
+        manager.filesystem().read_stream(f, resolved_name);
+
+        std::string const name = container_name(resolved_name);
+
+        std::ofstream stream(name, std::ios::binary);
+
+        if (!stream || !image::encoding::sui::Writer::write(
+                           stream, *texture, static_cast<uint32_t>(texture_usage), channels)) {
+            logging::error("Could not write \"" + name + "\".");
+            success = false;
+            continue;
+        }
+
+        logging::info("Converted \"" + f + "\" to \"" + name + "\".");
+    }
+
+    return success;
+}
+
+}  // namespace converter
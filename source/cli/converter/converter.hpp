@@ -0,0 +1,20 @@
+#ifndef SU_CLI_CONVERTER_CONVERTER_HPP
+#define SU_CLI_CONVERTER_CONVERTER_HPP
+
+#include <string>
+#include <vector>
+
+namespace resource {
+class Manager;
+}
+
+namespace converter {
+
+// Writes every image as a SUI container next to the original, with the mip levels and averages
+// of the texture it becomes for the given usage. Materials have to use the container the same way.
+bool convert(std::vector<std::string> const& filenames, std::string const& usage,
+             resource::Manager& manager);
+
+}  // namespace converter
+
+#endif
@@ -5,6 +5,7 @@
 #include "base/string/string.hpp"
 #include "base/thread/thread_pool.hpp"
 #include "controller/controller_progressive.hpp"
+#include "converter/converter.hpp"
 #include "core/baking/baking_driver.hpp"
 #include "core/file/file_system.hpp"
 #include "core/image/image_provider.hpp"
@@ -31,7 +32,9 @@
 //#include "extension/procedural/starburst/starburst.hpp"
 //#include "core/scene/material/substitute/substitute_test.hpp"
 //#include "core/scene/material/glass/glass_test.hpp"
+//#include "core/scene/prop/prop_test.hpp"
 //#include "core/testing/testing_cdf.hpp"
+//#include "core/testing/testing_fft.hpp"
 //#include "core/testing/testing_simd.hpp"
 //#include "core/testing/testing_size.hpp"
 //#include "core/testing/testing_spectrum.hpp"
@@ -49,6 +52,7 @@ int main(int argc, char const* argv[]) {
     //	scene::material::substitute::testing::test();
     //	scene::material::glass::testing::test();
     //  scene::material::glass::testing::rough_refraction();
+    //	scene::prop::testing::differentials();
     //	testing::size();
     //	testing::simd::rsqrt();
     //	testing::simd::rcp();
@@ -60,6 +64,7 @@ int main(int argc, char const* argv[]) {
     //	testing::simd::basis();
     //	testing::spectrum();
     //	testing::cdf::test_1D();
+    //	testing::fft::transforms();
 
     //    return 1;
 
@@ -70,7 +75,7 @@ int main(int argc, char const* argv[]) {
     logging::set_verbose(args.verbose);
     logging::info("Welcome to sprout (" + platform::build() + ")!");
 
-    if (args.take.empty()) {
+    if (args.take.empty() && args.convert.empty()) {
         return 1;
     }
 
@@ -118,11 +123,21 @@ int main(int argc, char const* argv[]) {
     image::Provider image_provider;
     resource_manager.register_provider(image_provider);
 
-    image::texture::Provider texture_provider;
-    if (!args.no_textures) {
+    // Converted textures are written from memory, so they must be kept as they are
+    size_t const texture_cache = args.convert.empty() ? size_t(args.texture_cache) * 1024 * 1024
+                                                      : 0;
+
+    image::texture::Provider texture_provider(texture_cache,
+                                              args.convert.empty() && args.compress_textures,
+                                              args.convert.empty() && args.tiled_textures);
+    if (!args.no_textures || !args.convert.empty()) {
         resource_manager.register_provider(texture_provider);
     }
 
+    if (!args.convert.empty()) {
+        return converter::convert(args.convert, args.convert_usage, resource_manager) ? 0 : 1;
+    }
+
     std::string take_name;
 
     std::unique_ptr<take::Take> take;
@@ -141,6 +156,7 @@ int main(int argc, char const* argv[]) {
     resource_manager.register_provider(material_provider);
 
     scene::shape::triangle::Provider mesh_provider;
+    mesh_provider.set_bvh_cache_folder(args.bvh_cache);
     resource_manager.register_provider(mesh_provider);
 
     // The scene loader must be alive during rendering,
@@ -177,6 +193,13 @@ int main(int argc, char const* argv[]) {
         if (take->view.camera) {
             rendering::Driver_finalframe driver(*take, scene, thread_pool, max_sample_size);
 
+            if (!args.checkpoint.empty()) {
+                driver.set_checkpoint(args.checkpoint, args.checkpoint_interval);
+            }
+
+            driver.set_resume(args.resume);
+            driver.set_time_budget(args.time_budget);
+
             rendering_num_bytes += driver.num_bytes();
 
             driver.render(take->exporters, progressor);
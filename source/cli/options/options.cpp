@@ -1,4 +1,5 @@
 #include "options.hpp"
+#include <limits>
 #include <sstream>
 #include "core/logging/logging.hpp"
 #include "cxxopts/cxxopts.hpp"
@@ -28,14 +29,83 @@ Options parse(int argc, char const* argv[]) {
                      "The default value is 0.",
                      cxxopts::value<int>(result.threads), "integer")
 
-                        ("p, progressive", "Starts sprout in progressive mode.",
-                         cxxopts::value<bool>(result.progressive))
+                        ("bvh-cache",
+                         "Specifies a directory for caching the BVHs of triangle meshes. "
+                         "Caching is disabled by default.",
+                         cxxopts::value<std::string>(result.bvh_cache), "directory path")
 
-                            ("no-textures", "Disables loading of all textures.",
-                             cxxopts::value<bool>(result.no_textures))
+                            ("checkpoint",
+                             "Specifies a file that the state of the render is written to "
+                             "periodically, so that it can be resumed later.",
+                             cxxopts::value<std::string>(result.checkpoint), "file path")
 
-                                ("v, verbose", "Enables verbose logging.",
-                                 cxxopts::value<bool>(result.verbose));
+                                ("checkpoint-interval",
+                                 "Specifies the minimum number of seconds between checkpoints. "
+                                 "The default value is 600.",
+                                 cxxopts::value<float>(result.checkpoint_interval), "seconds")
+
+                                    ("resume", "Resumes the render from a checkpoint file.",
+                                     cxxopts::value<std::string>(result.resume), "file path")
+
+                                        ("time-budget",
+                                         "Stops the render after the last pass that is expected "
+                                         "to finish within the given number of seconds. "
+                                         "Disabled by default.",
+                                         cxxopts::value<float>(result.time_budget), "seconds")
+
+                                            ("texture-cache",
+                                             "Pages textures out to disk and keeps at most "
+                                             "the given number of megabytes of their texels "
+                                             "in memory. Disabled by default.",
+                                             cxxopts::value<uint32_t>(result.texture_cache),
+                                             "megabytes")
+
+                                                ("compress-textures",
+                                                 "Keeps textures block compressed in memory, "
+                                                 "depending on their usage.",
+                                                 cxxopts::value<bool>(result.compress_textures))
+
+                                                    ("tiled-textures",
+                                                     "Stores texels in small bricks instead of "
+                                                     "rows, which speeds up filtering of large "
+                                                     "textures and volumes.",
+                                                     cxxopts::value<bool>(result.tiled_textures))
+
+                                                        ("convert",
+                                                         "Converts the given images to SUI "
+                                                         "containers, which are loaded without "
+                                                         "decoding, and exits. The containers are "
+                                                         "written next to the images.",
+                                                         cxxopts::value<std::vector<std::string>>(
+                                                             result.convert),
+                                                         "file paths")
+
+                                                            ("convert-usage",
+                                                             "Specifies how materials use the "
+                                                             "converted images: Color, Normal, "
+                                                             "Anisotropy, Roughness, Surface, "
+                                                             "Specularity or Mask. "
+                                                             "The default value is Color.",
+                                                             cxxopts::value<std::string>(
+                                                                 result.convert_usage),
+                                                             "usage")
+
+                                                                ("p, progressive",
+                                                                 "Starts sprout in progressive "
+                                                                 "mode.",
+                                                                 cxxopts::value<bool>(
+                                                                     result.progressive))
+
+                                                                    ("no-textures",
+                                                                     "Disables loading of all "
+                                                                     "textures.",
+                                                                     cxxopts::value<bool>(
+                                                                         result.no_textures))
+
+                                                                        ("v, verbose",
+                                                                         "Enables verbose logging.",
+                                                                         cxxopts::value<bool>(
+                                                                             result.verbose));
 
         const int initial_argc = argc;
 
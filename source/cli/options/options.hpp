@@ -1,6 +1,7 @@
 #ifndef SU_CLI_OPTIONS_OPTIONS_HPP
 #define SU_CLI_OPTIONS_OPTIONS_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -9,10 +10,20 @@ namespace options {
 struct Options {
     std::string              take;
     std::vector<std::string> mounts;
-    int                      threads     = 0;
-    bool                     progressive = false;
-    bool                     no_textures = false;
-    bool                     verbose     = false;
+    std::string              bvh_cache;
+    std::string              checkpoint;
+    float                    checkpoint_interval = 600.f;
+    std::string              resume;
+    float                    time_budget       = 0.f;
+    uint32_t                 texture_cache     = 0;
+    bool                     compress_textures = false;
+    bool                     tiled_textures    = false;
+    std::vector<std::string> convert;
+    std::string              convert_usage = "Color";
+    int                      threads       = 0;
+    bool                     progressive   = false;
+    bool                     no_textures   = false;
+    bool                     verbose       = false;
 };
 
 Options parse(int argc, char const* argv[]);
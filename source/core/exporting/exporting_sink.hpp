@@ -13,6 +13,11 @@ class Sink {
   public:
     virtual ~Sink() {}
 
+    // Called for blocks of the final image while they are still in cache,
+    // sinks that quantize the image do so here instead of in write()
+    virtual void encode(const image::Float4& /*image*/, int32_t /*begin*/, int32_t /*end*/) {}
+
+    // Expects encode() to have been called for all pixels of the image
     virtual void write(const image::Float4& image, uint32_t frame, thread::Pool& pool) = 0;
 };
 
@@ -2,7 +2,6 @@
 #include <sstream>
 #include "base/math/vector4.inl"
 #include "base/spectrum/rgb.hpp"
-#include "base/thread/thread_pool.hpp"
 #include "image/typed_image.hpp"
 
 // http://blog.mmacklin.com/2013/06/11/real-time-video-capture-with-ffmpeg/
@@ -38,15 +37,16 @@ Ffmpeg::~Ffmpeg() {
     }
 }
 
-void Ffmpeg::write(const image::Float4& image, uint32_t /*frame*/, thread::Pool& pool) {
+void Ffmpeg::encode(const image::Float4& image, int32_t begin, int32_t end) {
+    to_sRGB(image, begin, end);
+}
+
+void Ffmpeg::write(const image::Float4& image, uint32_t /*frame*/, thread::Pool& /*pool*/) {
     if (!stream_) {
         return;
     }
 
     auto const d = image.description().dimensions;
-    pool.run_range(
-        [this, &image](uint32_t /*id*/, int32_t begin, int32_t end) { to_sRGB(image, begin, end); },
-        0, d[0] * d[1]);
 
     fwrite(rgb_, sizeof(byte3) * static_cast<size_t>(d[0] * d[1]), 1, stream_);
 }
@@ -12,6 +12,8 @@ class Ffmpeg : public Sink, image::encoding::Srgb {
     Ffmpeg(std::string const& filename, int2 dimensions, uint32_t framerate);
     ~Ffmpeg();
 
+    virtual void encode(const image::Float4& image, int32_t begin, int32_t end) override final;
+
     virtual void write(const image::Float4& image, uint32_t frame,
                        thread::Pool& pool) override final;
 
@@ -9,6 +9,10 @@ namespace exporting {
 Image_sequence::Image_sequence(std::string const& filename, std::unique_ptr<image::Writer> writer)
     : filename_(filename), writer_(std::move(writer)) {}
 
+void Image_sequence::encode(const image::Float4& image, int32_t begin, int32_t end) {
+    writer_->encode(image, begin, end);
+}
+
 void Image_sequence::write(const image::Float4& image, uint32_t frame, thread::Pool& pool) {
     std::ofstream stream(filename_ + string::to_string(frame, 6) + "." + writer_->file_extension(),
                          std::ios::binary);
@@ -15,6 +15,8 @@ class Image_sequence : public Sink {
   public:
     Image_sequence(std::string const& filename, std::unique_ptr<image::Writer> writer);
 
+    virtual void encode(const image::Float4& image, int32_t begin, int32_t end) override final;
+
     virtual void write(const image::Float4& image, uint32_t frame,
                        thread::Pool& pool) override final;
 
@@ -1,5 +1,7 @@
 target_sources(core
   PRIVATE
+  "${CMAKE_CURRENT_LIST_DIR}/file_mapping.cpp"
+  "${CMAKE_CURRENT_LIST_DIR}/file_mapping.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/file_system.cpp"
   "${CMAKE_CURRENT_LIST_DIR}/file_system.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/file.cpp"
@@ -16,6 +16,8 @@ Type query_type(std::istream& stream) {
         type = Type::PNG;
     } else if (!strncmp("#?", header, 2)) {
         type = Type::RGBE;
+    } else if (!strncmp("SUI", header, 3)) {
+        type = Type::SUI;
     } else if (!strncmp("SUM\005", header, 4)) {
         type = Type::SUM;
     }
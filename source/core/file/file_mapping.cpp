@@ -0,0 +1,98 @@
+#include "file_mapping.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace file {
+
+#ifdef _WIN32
+
+Mapping::Mapping(std::string const& name) noexcept {
+    file_ = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file_) {
+        file_ = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size) || 0 == size.QuadPart) {
+        return;
+    }
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mapping_) {
+        return;
+    }
+
+    data_ = static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0));
+    if (data_) {
+        size_ = static_cast<size_t>(size.QuadPart);
+    }
+}
+
+Mapping::~Mapping() noexcept {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+
+    if (file_) {
+        CloseHandle(file_);
+    }
+}
+
+#else
+
+Mapping::Mapping(std::string const& name) noexcept {
+    int const file = open(name.c_str(), O_RDONLY);
+    if (-1 == file) {
+        return;
+    }
+
+    struct stat status;
+    if (0 == fstat(file, &status) && status.st_size > 0) {
+        size_t const size = static_cast<size_t>(status.st_size);
+
+        // The mapping stays valid after the file is closed
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        if (MAP_FAILED != data) {
+            data_ = static_cast<uint8_t*>(data);
+            size_ = size;
+        }
+    }
+
+    close(file);
+}
+
+Mapping::~Mapping() noexcept {
+    if (data_) {
+        munmap(data_, size_);
+    }
+}
+
+#endif
+
+bool Mapping::is_valid() const noexcept {
+    return nullptr != data_;
+}
+
+uint8_t* Mapping::data() const noexcept {
+    return data_;
+}
+
+size_t Mapping::size() const noexcept {
+    return size_;
+}
+
+}  // namespace file
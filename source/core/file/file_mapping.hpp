@@ -0,0 +1,38 @@
+#ifndef SU_CORE_FILE_MAPPING_HPP
+#define SU_CORE_FILE_MAPPING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace file {
+
+// Maps a whole file into memory. Pages are only read from disk when they are first touched.
+// Writes go to private copies of the touched pages and never reach the file.
+class Mapping {
+  public:
+    Mapping(std::string const& name) noexcept;
+
+    ~Mapping() noexcept;
+
+    bool is_valid() const noexcept;
+
+    uint8_t* data() const noexcept;
+
+    size_t size() const noexcept;
+
+  private:
+    uint8_t* data_ = nullptr;
+
+    size_t size_ = 0;
+
+#ifdef _WIN32
+    void* file_ = nullptr;
+
+    void* mapping_ = nullptr;
+#endif
+};
+
+}  // namespace file
+
+#endif
@@ -0,0 +1,290 @@
+#include "block_compression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "block_compression.inl"
+
+namespace image::bc {
+
+// Direction of the largest variance of the points around their mean, by power iteration
+static float3 principal_axis(float3 const points[16], float3 const& mean) noexcept {
+    float xx = 0.f;
+    float xy = 0.f;
+    float xz = 0.f;
+    float yy = 0.f;
+    float yz = 0.f;
+    float zz = 0.f;
+
+    float3 min(points[0]);
+    float3 max(points[0]);
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        float3 const d = points[i] - mean;
+
+        xx += d[0] * d[0];
+        xy += d[0] * d[1];
+        xz += d[0] * d[2];
+        yy += d[1] * d[1];
+        yz += d[1] * d[2];
+        zz += d[2] * d[2];
+
+        min = math::min(min, points[i]);
+        max = math::max(max, points[i]);
+    }
+
+    float3 axis = max - min;
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        float3 const next(xx * axis[0] + xy * axis[1] + xz * axis[2],
+                          xy * axis[0] + yy * axis[1] + yz * axis[2],
+                          xz * axis[0] + yz * axis[1] + zz * axis[2]);
+
+        float const length = math::length(next);
+        if (0.f == length) {
+            return float3(0.f);
+        }
+
+        axis = next / length;
+    }
+
+    return axis;
+}
+
+// Endpoints of the segment along the principal axis that covers all points
+static void fit_line(float3 const points[16], float3& a, float3& b) noexcept {
+    float3 mean(0.f);
+    for (uint32_t i = 0; i < 16; ++i) {
+        mean += points[i];
+    }
+
+    mean /= 16.f;
+
+    float3 const axis = principal_axis(points, mean);
+
+    float min_t = 0.f;
+    float max_t = 0.f;
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        float const t = math::dot(points[i] - mean, axis);
+
+        min_t = std::min(min_t, t);
+        max_t = std::max(max_t, t);
+    }
+
+    a = mean + min_t * axis;
+    b = mean + max_t * axis;
+}
+
+static uint16_t float3_to_rgb565(float3 const& c) noexcept {
+    float3 const s = math::clamp(c, 0.f, 255.f) * float3(31.f / 255.f, 63.f / 255.f, 31.f / 255.f);
+
+    uint32_t const r = static_cast<uint32_t>(s[0] + 0.5f);
+    uint32_t const g = static_cast<uint32_t>(s[1] + 0.5f);
+    uint32_t const b = static_cast<uint32_t>(s[2] + 0.5f);
+
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static uint32_t float3_to_rgb9e5(float3 const& c) noexcept {
+    // (511 / 512) * 2^16
+    float constexpr Max = 65408.f;
+
+    // Also maps NaN to 0
+    float const r = c[0] > 0.f ? std::min(c[0], Max) : 0.f;
+    float const g = c[1] > 0.f ? std::min(c[1], Max) : 0.f;
+    float const b = c[2] > 0.f ? std::min(c[2], Max) : 0.f;
+
+    float const m = std::max(std::max(r, g), b);
+
+    int32_t exponent;
+    std::frexp(m, &exponent);
+
+    int32_t shared = std::max(exponent - 1, -16) + 16;
+
+    float denominator = std::ldexp(1.f, shared - 24);
+
+    if (512 == static_cast<int32_t>(m / denominator + 0.5f)) {
+        ++shared;
+        denominator *= 2.f;
+    }
+
+    uint32_t const rm = static_cast<uint32_t>(r / denominator + 0.5f);
+    uint32_t const gm = static_cast<uint32_t>(g / denominator + 0.5f);
+    uint32_t const bm = static_cast<uint32_t>(b / denominator + 0.5f);
+
+    return rm | (gm << 9) | (bm << 18) | (static_cast<uint32_t>(shared) << 27);
+}
+
+static int32_t difference(uint8_t a, uint8_t b) noexcept {
+    return static_cast<int32_t>(a) - static_cast<int32_t>(b);
+}
+
+static int32_t squared_distance(byte3 a, byte3 b) noexcept {
+    int32_t const dr = difference(a[0], b[0]);
+    int32_t const dg = difference(a[1], b[1]);
+    int32_t const db = difference(a[2], b[2]);
+
+    return dr * dr + dg * dg + db * db;
+}
+
+BC1::Block BC1::encode(Texel const texels[16]) noexcept {
+    float3 points[16];
+    for (uint32_t i = 0; i < 16; ++i) {
+        points[i] = float3(texels[i]);
+    }
+
+    float3 a;
+    float3 b;
+    fit_line(points, a, b);
+
+    Block block{{float3_to_rgb565(b), float3_to_rgb565(a)}, 0};
+
+    // The four color mode requires the first endpoint to be the larger one
+    if (block.endpoints[0] < block.endpoints[1]) {
+        std::swap(block.endpoints[0], block.endpoints[1]);
+    } else if (block.endpoints[0] == block.endpoints[1]) {
+        return block;
+    }
+
+    // Let the first texels of a scratch block point at every palette entry in turn
+    Block const scratch{{block.endpoints[0], block.endpoints[1]}, 0xE4};
+
+    byte3 palette[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        palette[i] = decode(scratch, i);
+    }
+
+    for (uint32_t t = 0; t < 16; ++t) {
+        uint32_t best          = 0;
+        int32_t  best_distance = squared_distance(texels[t], palette[0]);
+
+        for (uint32_t i = 1; i < 4; ++i) {
+            int32_t const distance = squared_distance(texels[t], palette[i]);
+            if (distance < best_distance) {
+                best          = i;
+                best_distance = distance;
+            }
+        }
+
+        block.indices |= best << (2 * t);
+    }
+
+    return block;
+}
+
+BC4::Block BC4::encode(Texel const texels[16]) noexcept {
+    uint8_t min = texels[0];
+    uint8_t max = texels[0];
+
+    for (uint32_t i = 1; i < 16; ++i) {
+        min = std::min(min, texels[i]);
+        max = std::max(max, texels[i]);
+    }
+
+    Block block{{max, min}, {}};
+
+    if (min == max) {
+        return block;
+    }
+
+    // Let the first texels of a scratch block point at every palette entry in turn
+    uint64_t constexpr Sequence = 0xFAC688;
+
+    Block scratch{{max, min}, {}};
+    std::memcpy(scratch.indices, &Sequence, sizeof(scratch.indices));
+
+    uint8_t palette[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        palette[i] = decode(scratch, i);
+    }
+
+    uint64_t indices = 0;
+
+    for (uint32_t t = 0; t < 16; ++t) {
+        uint64_t best          = 0;
+        int32_t  best_distance = std::abs(difference(texels[t], palette[0]));
+
+        for (uint32_t i = 1; i < 8; ++i) {
+            int32_t const distance = std::abs(difference(texels[t], palette[i]));
+            if (distance < best_distance) {
+                best          = i;
+                best_distance = distance;
+            }
+        }
+
+        indices |= best << (3 * t);
+    }
+
+    std::memcpy(block.indices, &indices, sizeof(block.indices));
+
+    return block;
+}
+
+BC5::Block BC5::encode(Texel const texels[16]) noexcept {
+    uint8_t x[16];
+    uint8_t y[16];
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        x[i] = texels[i][0];
+        y[i] = texels[i][1];
+    }
+
+    return Block{{BC4::encode(x), BC4::encode(y)}};
+}
+
+BC5_normal::Block BC5_normal::encode(Texel const texels[16]) noexcept {
+    byte2 xy[16];
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        xy[i] = texels[i].xy();
+    }
+
+    return BC5::encode(xy);
+}
+
+HDR::Block HDR::encode(Texel const texels[16]) noexcept {
+    float3 points[16];
+    for (uint32_t i = 0; i < 16; ++i) {
+        float3 const c(texels[i]);
+
+        // Negative values and NaN are not representable
+        points[i] = float3(c[0] > 0.f ? c[0] : 0.f, c[1] > 0.f ? c[1] : 0.f,
+                           c[2] > 0.f ? c[2] : 0.f);
+    }
+
+    float3 a;
+    float3 b;
+    fit_line(points, a, b);
+
+    Block block{{float3_to_rgb9e5(a), float3_to_rgb9e5(b)}, {}};
+
+    // Let the texels of a scratch block point at every palette entry in turn
+    Block scratch{{block.endpoints[0], block.endpoints[1]}, {}};
+    for (uint32_t i = 0; i < 8; ++i) {
+        scratch.indices[i] = static_cast<uint8_t>((2 * i) | ((2 * i + 1) << 4));
+    }
+
+    float3 palette[16];
+    for (uint32_t i = 0; i < 16; ++i) {
+        palette[i] = float3(decode(scratch, i));
+    }
+
+    for (uint32_t t = 0; t < 16; ++t) {
+        uint32_t best          = 0;
+        float    best_distance = math::squared_distance(points[t], palette[0]);
+
+        for (uint32_t i = 1; i < 16; ++i) {
+            float const distance = math::squared_distance(points[t], palette[i]);
+            if (distance < best_distance) {
+                best          = i;
+                best_distance = distance;
+            }
+        }
+
+        block.indices[t >> 1] |= static_cast<uint8_t>(best << ((t & 1) << 2));
+    }
+
+    return block;
+}
+
+}  // namespace image::bc
@@ -0,0 +1,82 @@
+#ifndef SU_CORE_IMAGE_BLOCK_COMPRESSION_HPP
+#define SU_CORE_IMAGE_BLOCK_COMPRESSION_HPP
+
+#include <cstdint>
+#include "base/math/vector.hpp"
+
+// Codecs for blocks of 4x4 texels, similar to the BCn formats of GPUs.
+// Every codec encodes a whole block at once, but decodes single texels,
+// so that a lookup only touches the endpoints and the index it needs.
+// Texels of a block are numbered in row-major order.
+namespace image::bc {
+
+// 4 bits per texel: Two RGB565 endpoints with two interpolated colors in between
+struct BC1 {
+    using Texel = byte3;
+
+    struct Block {
+        uint16_t endpoints[2];
+        uint32_t indices;
+    };
+
+    static Block encode(Texel const texels[16]) noexcept;
+
+    static Texel decode(Block const& block, uint32_t index) noexcept;
+};
+
+// 4 bits per texel: Two 8 bit endpoints with six interpolated values in between
+struct BC4 {
+    using Texel = uint8_t;
+
+    struct Block {
+        uint8_t endpoints[2];
+        uint8_t indices[6];
+    };
+
+    static Block encode(Texel const texels[16]) noexcept;
+
+    static Texel decode(Block const& block, uint32_t index) noexcept;
+};
+
+// 8 bits per texel: Two independent BC4 channels
+struct BC5 {
+    using Texel = byte2;
+
+    struct Block {
+        BC4::Block channels[2];
+    };
+
+    static Block encode(Texel const texels[16]) noexcept;
+
+    static Texel decode(Block const& block, uint32_t index) noexcept;
+};
+
+// BC5 for unit length snorm vectors, which only stores x and y and reconstructs z
+struct BC5_normal {
+    using Texel = byte3;
+
+    using Block = BC5::Block;
+
+    static Block encode(Texel const texels[16]) noexcept;
+
+    static Texel decode(Block const& block, uint32_t index) noexcept;
+};
+
+// 8 bits per texel, for unsigned HDR colors in the spirit of BC6H:
+// Two endpoints with a shared exponent (RGB9E5) and 4 bit indices between them
+struct HDR {
+    using Texel = packed_float3;
+
+    struct Block {
+        uint32_t endpoints[2];
+        uint8_t  indices[8];
+    };
+
+    static Block encode(Texel const texels[16]) noexcept;
+
+    static Texel decode(Block const& block, uint32_t index) noexcept;
+};
+
+}  // namespace image::bc
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef SU_CORE_IMAGE_BLOCK_COMPRESSION_INL
+#define SU_CORE_IMAGE_BLOCK_COMPRESSION_INL
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "base/encoding/encoding.inl"
+#include "base/math/math.hpp"
+#include "base/math/vector3.inl"
+#include "block_compression.hpp"
+
+namespace image::bc {
+
+static inline byte3 rgb565_to_byte3(uint16_t c) noexcept {
+    uint32_t const r = (c >> 11) & 0x1F;
+    uint32_t const g = (c >> 5) & 0x3F;
+    uint32_t const b = c & 0x1F;
+
+    return byte3(static_cast<uint8_t>((r << 3) | (r >> 2)),
+                 static_cast<uint8_t>((g << 2) | (g >> 4)),
+                 static_cast<uint8_t>((b << 3) | (b >> 2)));
+}
+
+static inline float3 rgb9e5_to_float3(uint32_t c) noexcept {
+    // 2^(e - 15 - 9), 15 being the exponent bias and 9 the number of mantissa bits
+    uint32_t const bits = ((c >> 27) + 127 - 24) << 23;
+
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(float));
+
+    return scale * float3(static_cast<float>(c & 0x1FF), static_cast<float>((c >> 9) & 0x1FF),
+                          static_cast<float>((c >> 18) & 0x1FF));
+}
+
+inline BC1::Texel BC1::decode(Block const& block, uint32_t index) noexcept {
+    uint32_t const i = (block.indices >> (2 * index)) & 0x3;
+
+    byte3 const c0 = rgb565_to_byte3(block.endpoints[0]);
+    if (0 == i) {
+        return c0;
+    }
+
+    byte3 const c1 = rgb565_to_byte3(block.endpoints[1]);
+    if (1 == i) {
+        return c1;
+    }
+
+    // 2 and 3 are at 1/3 and 2/3 of the way from c0 to c1
+    uint32_t const w1 = i - 1;
+    uint32_t const w0 = 3 - w1;
+
+    return byte3(static_cast<uint8_t>((w0 * c0[0] + w1 * c1[0] + 1) / 3),
+                 static_cast<uint8_t>((w0 * c0[1] + w1 * c1[1] + 1) / 3),
+                 static_cast<uint8_t>((w0 * c0[2] + w1 * c1[2] + 1) / 3));
+}
+
+inline BC4::Texel BC4::decode(Block const& block, uint32_t index) noexcept {
+    uint64_t indices = 0;
+    std::memcpy(&indices, block.indices, sizeof(block.indices));
+
+    uint32_t const i = static_cast<uint32_t>(indices >> (3 * index)) & 0x7;
+
+    uint32_t const e0 = block.endpoints[0];
+    uint32_t const e1 = block.endpoints[1];
+
+    if (i < 2) {
+        return static_cast<uint8_t>(0 == i ? e0 : e1);
+    }
+
+    // 2 to 7 are at 1/7 to 6/7 of the way from e0 to e1
+    return static_cast<uint8_t>(((8 - i) * e0 + (i - 1) * e1 + 3) / 7);
+}
+
+inline BC5::Texel BC5::decode(Block const& block, uint32_t index) noexcept {
+    return byte2(BC4::decode(block.channels[0], index), BC4::decode(block.channels[1], index));
+}
+
+inline BC5_normal::Texel BC5_normal::decode(Block const& block, uint32_t index) noexcept {
+    uint8_t const x = BC4::decode(block.channels[0], index);
+    uint8_t const y = BC4::decode(block.channels[1], index);
+
+    float const fx = ::encoding::snorm_to_float(x);
+    float const fy = ::encoding::snorm_to_float(y);
+
+    float const z = std::sqrt(std::max(1.f - fx * fx - fy * fy, 0.f));
+
+    return byte3(x, y, ::encoding::float_to_snorm(z));
+}
+
+inline HDR::Texel HDR::decode(Block const& block, uint32_t index) noexcept {
+    uint32_t const i = (block.indices[index >> 1] >> ((index & 1) << 2)) & 0xF;
+
+    float3 const c0 = rgb9e5_to_float3(block.endpoints[0]);
+    float3 const c1 = rgb9e5_to_float3(block.endpoints[1]);
+
+    return packed_float3(math::lerp(c0, c1, static_cast<float>(i) * (1.f / 15.f)));
+}
+
+}  // namespace image::bc
+
+#endif
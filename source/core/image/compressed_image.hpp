@@ -0,0 +1,56 @@
+#ifndef SU_CORE_IMAGE_COMPRESSED_IMAGE_HPP
+#define SU_CORE_IMAGE_COMPRESSED_IMAGE_HPP
+
+#include "base/math/vector.hpp"
+#include "image.hpp"
+
+namespace thread {
+class Pool;
+}
+
+namespace image {
+
+template <typename T>
+class Typed_image;
+
+// Read-only counterpart of Typed_image, whose texels are stored in blocks of 4x4 by a bc codec
+// and decoded on every lookup.
+// Layers and elements are stacked vertically, the same way as in Typed_image.
+template <typename Codec>
+class Compressed_image final : public Image {
+  public:
+    using Texel = typename Codec::Texel;
+    using Block = typename Codec::Block;
+
+    Compressed_image(Typed_image<Texel> const& source, thread::Pool& pool) noexcept;
+
+    ~Compressed_image() noexcept override final;
+
+    Texel load(int32_t index) const noexcept;
+
+    Texel load(int32_t x, int32_t y) const noexcept;
+
+    Texel load_element(int32_t x, int32_t y, int32_t element) const noexcept;
+
+    Texel load(int32_t x, int32_t y, int32_t z) const noexcept;
+
+    void gather(int4 const& xy_xy1, Texel c[4]) const noexcept;
+
+    void gather(int3 const& xyz, int3 const& xyz1, Texel c[8]) const noexcept;
+
+    size_t num_bytes() const noexcept override final;
+
+  private:
+    Block const& block(int32_t x, int32_t y) const noexcept;
+
+    static uint32_t texel(int32_t x, int32_t y) noexcept;
+
+    int32_t num_blocks_x_;
+    int32_t num_blocks_y_;
+
+    Block* blocks_;
+};
+
+}  // namespace image
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SU_CORE_IMAGE_COMPRESSED_IMAGE_INL
+#define SU_CORE_IMAGE_COMPRESSED_IMAGE_INL
+
+#include <algorithm>
+#include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
+#include "base/thread/thread_pool.hpp"
+#include "block_compression.inl"
+#include "compressed_image.hpp"
+#include "typed_image.inl"
+
+namespace image {
+
+template <typename Codec>
+Compressed_image<Codec>::Compressed_image(Typed_image<Texel> const& source,
+                                          thread::Pool&             pool) noexcept
+    : Image(source.description()) {
+    int32_t const width  = description_.dimensions[0];
+    int32_t const height = description_.dimensions[1] * description_.dimensions[2] *
+                           description_.num_elements;
+
+    num_blocks_x_ = (width + 3) >> 2;
+    num_blocks_y_ = (height + 3) >> 2;
+
+    blocks_ = memory::allocate_aligned<Block>(static_cast<size_t>(num_blocks_x_) *
+                                              static_cast<size_t>(num_blocks_y_));
+
+    pool.run_range(
+        [this, &source, width, height](uint32_t /*id*/, int32_t begin, int32_t end) {
+            // Texels outside of the image are padded with the closest edge texel
+            Texel texels[16];
+
+            for (int32_t by = begin; by < end; ++by) {
+                for (int32_t bx = 0; bx < num_blocks_x_; ++bx) {
+                    for (int32_t y = 0; y < 4; ++y) {
+                        int32_t const sy = std::min((by << 2) + y, height - 1);
+
+                        for (int32_t x = 0; x < 4; ++x) {
+                            int32_t const sx = std::min((bx << 2) + x, width - 1);
+
+                            texels[texel(x, y)] = source.load(sy * width + sx);
+                        }
+                    }
+
+                    blocks_[by * num_blocks_x_ + bx] = Codec::encode(texels);
+                }
+            }
+        },
+        0, num_blocks_y_);
+}
+
+template <typename Codec>
+Compressed_image<Codec>::~Compressed_image() noexcept {
+    memory::free_aligned(blocks_);
+}
+
+template <typename Codec>
+typename Codec::Texel Compressed_image<Codec>::load(int32_t index) const noexcept {
+    int32_t const width = description_.dimensions[0];
+
+    int32_t const y = index / width;
+    int32_t const x = index - y * width;
+
+    return load(x, y);
+}
+
+template <typename Codec>
+typename Codec::Texel Compressed_image<Codec>::load(int32_t x, int32_t y) const noexcept {
+    return Codec::decode(block(x, y), texel(x, y));
+}
+
+template <typename Codec>
+typename Codec::Texel Compressed_image<Codec>::load_element(int32_t x, int32_t y,
+                                                             int32_t element) const noexcept {
+    return load(x, element * description_.dimensions[1] + y);
+}
+
+template <typename Codec>
+typename Codec::Texel Compressed_image<Codec>::load(int32_t x, int32_t y,
+                                                     int32_t z) const noexcept {
+    return load(x, z * description_.dimensions[1] + y);
+}
+
+template <typename Codec>
+void Compressed_image<Codec>::gather(int4 const& xy_xy1, Texel c[4]) const noexcept {
+    int32_t const x0 = xy_xy1[0];
+    int32_t const y0 = xy_xy1[1];
+    int32_t const x1 = xy_xy1[2];
+    int32_t const y1 = xy_xy1[3];
+
+    // Most footprints are inside of a single block
+    if (((x0 ^ x1) | (y0 ^ y1)) >> 2) {
+        c[0] = load(x0, y0);
+        c[1] = load(x1, y0);
+        c[2] = load(x0, y1);
+        c[3] = load(x1, y1);
+    } else {
+        Block const& b = block(x0, y0);
+
+        c[0] = Codec::decode(b, texel(x0, y0));
+        c[1] = Codec::decode(b, texel(x1, y0));
+        c[2] = Codec::decode(b, texel(x0, y1));
+        c[3] = Codec::decode(b, texel(x1, y1));
+    }
+}
+
+template <typename Codec>
+void Compressed_image<Codec>::gather(int3 const& xyz, int3 const& xyz1,
+                                     Texel c[8]) const noexcept {
+    c[0] = load(xyz[0], xyz[1], xyz[2]);
+    c[1] = load(xyz1[0], xyz[1], xyz[2]);
+    c[2] = load(xyz[0], xyz1[1], xyz[2]);
+    c[3] = load(xyz1[0], xyz1[1], xyz[2]);
+    c[4] = load(xyz[0], xyz[1], xyz1[2]);
+    c[5] = load(xyz1[0], xyz[1], xyz1[2]);
+    c[6] = load(xyz[0], xyz1[1], xyz1[2]);
+    c[7] = load(xyz1[0], xyz1[1], xyz1[2]);
+}
+
+template <typename Codec>
+size_t Compressed_image<Codec>::num_bytes() const noexcept {
+    return sizeof(*this) +
+           static_cast<size_t>(num_blocks_x_) * static_cast<size_t>(num_blocks_y_) * sizeof(Block);
+}
+
+template <typename Codec>
+typename Codec::Block const& Compressed_image<Codec>::block(int32_t x, int32_t y) const noexcept {
+    return blocks_[(y >> 2) * num_blocks_x_ + (x >> 2)];
+}
+
+template <typename Codec>
+uint32_t Compressed_image<Codec>::texel(int32_t x, int32_t y) noexcept {
+    return static_cast<uint32_t>(((y & 3) << 2) + (x & 3));
+}
+
+}  // namespace image
+
+#endif
@@ -2,6 +2,7 @@ include("${CMAKE_CURRENT_LIST_DIR}/json/json.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/png/png.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/raw/raw.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/rgbe/rgbe.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/sui/sui.cmake")
 
 target_sources(core
 	PRIVATE
@@ -4,7 +4,6 @@
 #include "base/math/vector4.inl"
 #include "base/spectrum/rgb.hpp"
 #include "base/string/string.hpp"
-#include "image/tiled_image.inl"
 #include "image/typed_image.inl"
 
 namespace image {
@@ -1,4 +1,6 @@
 #include "png_writer.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <vector>
 #include "base/math/vector4.inl"
@@ -8,30 +10,35 @@
 
 namespace image::encoding::png {
 
-Writer::Writer(int2 dimensions) : Srgb(dimensions) {}
+static bool write(std::ostream& stream, uint8_t const* image, int2 dimensions,
+                  uint32_t num_channels, uint32_t compression, Filter filter,
+                  thread::Pool& pool);
+
+Writer::Writer(int2 dimensions, uint32_t compression, Filter filter)
+    : Srgb(dimensions), compression_(compression), filter_(filter), encoded_(nullptr) {}
 
 std::string Writer::file_extension() const {
     return "png";
 }
 
-bool Writer::write(std::ostream& stream, Float4 const& image, thread::Pool& pool) {
-    auto const d = image.description().dimensions;
+void Writer::encode(Float4 const& image, int32_t begin, int32_t end) {
+    to_sRGB(image, begin, end);
 
-    pool.run_range(
-        [this, &image](uint32_t /*id*/, int32_t begin, int32_t end) { to_sRGB(image, begin, end); },
-        0, d[0] * d[1]);
+    encoded_.store(&image, std::memory_order_relaxed);
+}
 
-    size_t buffer_len = 0;
-    void*  png_buffer = tdefl_write_image_to_png_file_in_memory(rgb_, d[0], d[1], 3, &buffer_len);
-    if (!png_buffer) {
-        return false;
+bool Writer::write(std::ostream& stream, Float4 const& image, thread::Pool& pool) {
+    // For callers that did not encode() the image before
+    if (encoded_.exchange(nullptr, std::memory_order_relaxed) != &image) {
+        pool.run_range(
+            [this, &image](uint32_t /*id*/, int32_t begin, int32_t end) {
+                to_sRGB(image, begin, end);
+            },
+            0, image.area());
     }
 
-    stream.write(static_cast<char*>(png_buffer), buffer_len);
-
-    mz_free(png_buffer);
-
-    return true;
+    return png::write(stream, reinterpret_cast<uint8_t const*>(rgb_), image.dimensions2(), 3,
+                      compression_, filter_, pool);
 }
 
 bool Writer::write(std::string_view name, Byte3 const& image) {
@@ -167,29 +174,321 @@ bool Writer::write(std::string_view name, packed_float3 const* data, int2 dimens
     return true;
 }
 
-Writer_alpha::Writer_alpha(int2 dimensions) : Srgb_alpha(dimensions) {}
+Writer_alpha::Writer_alpha(int2 dimensions, uint32_t compression, Filter filter)
+    : Srgb_alpha(dimensions), compression_(compression), filter_(filter), encoded_(nullptr) {}
 
 std::string Writer_alpha::file_extension() const {
     return "png";
 }
 
+void Writer_alpha::encode(Float4 const& image, int32_t begin, int32_t end) {
+    to_sRGB(image, begin, end);
+
+    encoded_.store(&image, std::memory_order_relaxed);
+}
+
 bool Writer_alpha::write(std::ostream& stream, Float4 const& image, thread::Pool& pool) {
-    auto const d = image.description().dimensions;
+    // For callers that did not encode() the image before
+    if (encoded_.exchange(nullptr, std::memory_order_relaxed) != &image) {
+        pool.run_range(
+            [this, &image](uint32_t /*id*/, int32_t begin, int32_t end) {
+                to_sRGB(image, begin, end);
+            },
+            0, image.area());
+    }
+
+    return png::write(stream, reinterpret_cast<uint8_t const*>(rgba_), image.dimensions2(), 4,
+                      compression_, filter_, pool);
+}
+
+static uint32_t constexpr Adler_base = 65521;
+
+// Adler-32 of the concatenation of two buffers, the second one being len_b bytes long
+static uint32_t adler32_combine(uint32_t adler_a, uint32_t adler_b, size_t len_b) {
+    uint32_t const rem = static_cast<uint32_t>(len_b % Adler_base);
+
+    uint32_t sum_1 = adler_a & 0xFFFF;
+    uint32_t sum_2 = (rem * sum_1) % Adler_base;
+
+    sum_1 += (adler_b & 0xFFFF) + Adler_base - 1;
+    sum_2 += (adler_a >> 16) + (adler_b >> 16) + Adler_base - rem;
+
+    if (sum_1 >= Adler_base) {
+        sum_1 -= Adler_base;
+    }
+
+    if (sum_1 >= Adler_base) {
+        sum_1 -= Adler_base;
+    }
+
+    if (sum_2 >= Adler_base << 1) {
+        sum_2 -= Adler_base << 1;
+    }
+
+    if (sum_2 >= Adler_base) {
+        sum_2 -= Adler_base;
+    }
+
+    return sum_1 | (sum_2 << 16);
+}
+
+static void append_uint(std::vector<uint8_t>& buffer, uint32_t value) {
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+// Chunk data starts at offset 8 of the buffer, after the length and the type
+static void write_chunk(std::ostream& stream, std::vector<uint8_t>& chunk, char const* type) {
+    uint32_t const len = static_cast<uint32_t>(chunk.size() - 8);
+
+    uint8_t* header = chunk.data();
+
+    header[0] = static_cast<uint8_t>(len >> 24);
+    header[1] = static_cast<uint8_t>(len >> 16);
+    header[2] = static_cast<uint8_t>(len >> 8);
+    header[3] = static_cast<uint8_t>(len);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        header[4 + i] = static_cast<uint8_t>(type[i]);
+    }
+
+    uint32_t const crc = static_cast<uint32_t>(mz_crc32(MZ_CRC32_INIT, header + 4, len + 4));
+
+    append_uint(chunk, crc);
+
+    stream.write(reinterpret_cast<char const*>(chunk.data()), chunk.size());
+}
+
+static uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int32_t const p  = int32_t(a) + int32_t(b) - int32_t(c);
+    int32_t const pa = std::abs(p - int32_t(a));
+    int32_t const pb = std::abs(p - int32_t(b));
+    int32_t const pc = std::abs(p - int32_t(c));
+
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+
+    if (pb <= pc) {
+        return b;
+    }
+
+    return c;
+}
+
+// Writes the filter type followed by the filtered row to result.
+// Of the five PNG filters the one with the smallest sum of absolute differences is chosen,
+// the usual heuristic of libpng.
+static void filter_row(uint8_t* result, uint8_t* candidates, uint8_t const* row,
+                       uint8_t const* previous, uint32_t len, uint32_t bpp) {
+    uint32_t best     = 0;
+    uint32_t best_sum = 0xFFFFFFFF;
+
+    for (uint32_t f = 0; f < 5; ++f) {
+        uint8_t* out = candidates + f * len;
+
+        uint32_t sum = 0;
+
+        for (uint32_t i = 0; i < len; ++i) {
+            uint8_t const a = i >= bpp ? row[i - bpp] : 0;
+            uint8_t const b = previous ? previous[i] : 0;
+            uint8_t const c = i >= bpp && previous ? previous[i - bpp] : 0;
+
+            uint8_t predictor;
+            switch (f) {
+                default:
+                case 0:
+                    predictor = 0;
+                    break;
+                case 1:
+                    predictor = a;
+                    break;
+                case 2:
+                    predictor = b;
+                    break;
+                case 3:
+                    predictor = static_cast<uint8_t>((uint32_t(a) + uint32_t(b)) / 2);
+                    break;
+                case 4:
+                    predictor = paeth(a, b, c);
+                    break;
+            }
+
+            uint8_t const v = static_cast<uint8_t>(row[i] - predictor);
+
+            out[i] = v;
+
+            sum += static_cast<uint32_t>(std::abs(static_cast<int8_t>(v)));
+        }
+
+        if (sum < best_sum) {
+            best     = f;
+            best_sum = sum;
+        }
+    }
+
+    result[0] = static_cast<uint8_t>(best);
+    std::copy(candidates + best * len, candidates + (best + 1) * len, result + 1);
+}
+
+// Second byte of the zlib header, with the compression level and the check bits
+static uint8_t zlib_flags(int level) {
+    if (level <= 1) {
+        return 0x01;
+    }
+
+    if (level <= 5) {
+        return 0x5E;
+    }
+
+    if (6 == level) {
+        return 0x9C;
+    }
+
+    return 0xDA;
+}
+
+static mz_bool put_buffer(void const* buffer, int len, void* user) {
+    auto&          output = *static_cast<std::vector<uint8_t>*>(user);
+    uint8_t const* bytes  = static_cast<uint8_t const*>(buffer);
+
+    output.insert(output.end(), bytes, bytes + len);
+
+    return MZ_TRUE;
+}
+
+// Bands are sized so that compressing them independently costs little ratio
+static uint32_t constexpr Band_bytes = 1 << 18;
+
+static bool write(std::ostream& stream, uint8_t const* image, int2 dimensions,
+                  uint32_t num_channels, uint32_t compression, Filter filter,
+                  thread::Pool& pool) {
+    uint32_t const width  = static_cast<uint32_t>(dimensions[0]);
+    uint32_t const height = static_cast<uint32_t>(dimensions[1]);
+
+    uint32_t const row_len = width * num_channels;
+
+    uint32_t const rows_per_band = std::max(Band_bytes / (row_len + 1), 1u);
+    uint32_t const num_bands     = (height + rows_per_band - 1) / rows_per_band;
+
+    int const level = static_cast<int>(compression);
+
+    mz_uint const flags = tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS,
+                                                                  MZ_DEFAULT_STRATEGY);
+
+    bool const adaptive = Filter::Adaptive == filter;
+
+    // Each band becomes its own IDAT chunk, so that the CRCs can be computed in parallel as well
+    struct Band {
+        std::vector<uint8_t> chunk;
+
+        uint32_t adler;
+        size_t   len;
+
+        bool valid;
+    };
+
+    std::vector<Band> bands(num_bands);
 
     pool.run_range(
-        [this, &image](uint32_t /*id*/, int32_t begin, int32_t end) { to_sRGB(image, begin, end); },
-        0, d[0] * d[1]);
+        [image, height, row_len, rows_per_band, num_bands, num_channels, level, flags, adaptive,
+         &bands](uint32_t /*id*/, int32_t begin, int32_t end) {
+            tdefl_compressor* compressor = tdefl_compressor_alloc();
 
-    size_t buffer_len = 0;
-    void*  png_buffer = tdefl_write_image_to_png_file_in_memory(rgba_, d[0], d[1], 4, &buffer_len);
+            std::vector<uint8_t> filtered;
+            std::vector<uint8_t> candidates(adaptive ? 5 * row_len : 0);
 
-    if (!png_buffer) {
-        return false;
+            for (int32_t b = begin; b < end; ++b) {
+                uint32_t const row_begin = static_cast<uint32_t>(b) * rows_per_band;
+                uint32_t const row_end   = std::min(row_begin + rows_per_band, height);
+
+                filtered.resize((row_end - row_begin) * (row_len + 1));
+
+                for (uint32_t y = row_begin; y < row_end; ++y) {
+                    uint8_t const* row = image + y * row_len;
+                    uint8_t*       out = filtered.data() + (y - row_begin) * (row_len + 1);
+
+                    if (adaptive) {
+                        uint8_t const* previous = y > 0 ? row - row_len : nullptr;
+                        filter_row(out, candidates.data(), row, previous, row_len, num_channels);
+                    } else {
+                        out[0] = 0;
+                        std::copy(row, row + row_len, out + 1);
+                    }
+                }
+
+                Band& band = bands[b];
+
+                band.adler = static_cast<uint32_t>(
+                    mz_adler32(MZ_ADLER32_INIT, filtered.data(), filtered.size()));
+                band.len = filtered.size();
+
+                // Reserve room for the chunk header, and the zlib header in the first band
+                band.chunk.assign(0 == b ? 10 : 8, 0);
+
+                if (0 == b) {
+                    band.chunk[8] = 0x78;
+                    band.chunk[9] = zlib_flags(level);
+                }
+
+                // The last band finishes the deflate stream,
+                // the others are byte aligned by a sync flush so they can be concatenated
+                tdefl_flush const flush = static_cast<uint32_t>(b) + 1 == num_bands
+                                              ? TDEFL_FINISH
+                                              : TDEFL_SYNC_FLUSH;
+
+                tdefl_init(compressor, put_buffer, &band.chunk, static_cast<int>(flags));
+
+                tdefl_status const status = tdefl_compress_buffer(compressor, filtered.data(),
+                                                                  filtered.size(), flush);
+
+                band.valid = status >= TDEFL_STATUS_OKAY;
+            }
+
+            tdefl_compressor_free(compressor);
+        },
+        0, static_cast<int32_t>(num_bands));
+
+    for (auto const& band : bands) {
+        if (!band.valid) {
+            return false;
+        }
     }
 
-    stream.write(static_cast<char*>(png_buffer), buffer_len);
+    static uint8_t const Signature[] = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
 
-    mz_free(png_buffer);
+    stream.write(reinterpret_cast<char const*>(Signature), sizeof(Signature));
+
+    std::vector<uint8_t> header(8);
+    append_uint(header, width);
+    append_uint(header, height);
+
+    // 8 bit depth, RGB or RGBA, deflate, adaptive filtering, no interlace
+    header.push_back(8);
+    header.push_back(4 == num_channels ? 6 : 2);
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(0);
+
+    write_chunk(stream, header, "IHDR");
+
+    uint32_t adler = MZ_ADLER32_INIT;
+
+    for (auto& band : bands) {
+        write_chunk(stream, band.chunk, "IDAT");
+
+        adler = adler32_combine(adler, band.adler, band.len);
+    }
+
+    std::vector<uint8_t> trailer(8);
+    append_uint(trailer, adler);
+
+    write_chunk(stream, trailer, "IDAT");
+
+    std::vector<uint8_t> end(8);
+    write_chunk(stream, end, "IEND");
 
     return true;
 }
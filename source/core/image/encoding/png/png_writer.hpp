@@ -1,17 +1,27 @@
 #ifndef SU_CORE_IMAGE_ENCODING_PNG_WRITER_HPP
 #define SU_CORE_IMAGE_ENCODING_PNG_WRITER_HPP
 
+#include <atomic>
 #include "image/encoding/encoding_srgb.hpp"
 #include "image/image_writer.hpp"
 
 namespace image::encoding::png {
 
+// Fast stores the rows unfiltered. Adaptive chooses the filter that is expected to compress best
+// for each row, which helps with smooth images, but not with the noise of typical renders.
+enum class Filter { Fast, Adaptive };
+
+// The rows are split into bands that are filtered and deflated in parallel,
+// and then concatenated into a single zlib stream.
+// compression is the miniz level from 0 to 10.
 class Writer : public image::Writer, Srgb {
   public:
-    Writer(int2 dimensions);
+    Writer(int2 dimensions, uint32_t compression, Filter filter);
 
     virtual std::string file_extension() const override final;
 
+    virtual void encode(Float4 const& image, int32_t begin, int32_t end) override final;
+
     virtual bool write(std::ostream& stream, Float4 const& image,
                        thread::Pool& pool) override final;
 
@@ -25,16 +35,32 @@ class Writer : public image::Writer, Srgb {
 
     static bool write(std::string_view name, packed_float3 const* data, int2 dimensions,
                       float scale);
+
+  private:
+    uint32_t compression_;
+    Filter   filter_;
+
+    // The image that encode() was called for since the last write(), which converts it otherwise
+    std::atomic<Float4 const*> encoded_;
 };
 
 class Writer_alpha : public image::Writer, Srgb_alpha {
   public:
-    Writer_alpha(int2 dimensions);
+    Writer_alpha(int2 dimensions, uint32_t compression, Filter filter);
 
     virtual std::string file_extension() const override final;
 
+    virtual void encode(Float4 const& image, int32_t begin, int32_t end) override final;
+
     virtual bool write(std::ostream& stream, Float4 const& image,
                        thread::Pool& pool) override final;
+
+  private:
+    uint32_t compression_;
+    Filter   filter_;
+
+    // The image that encode() was called for since the last write(), which converts it otherwise
+    std::atomic<Float4 const*> encoded_;
 };
 
 }  // namespace image::encoding::png
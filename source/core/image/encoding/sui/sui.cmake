@@ -0,0 +1,8 @@
+target_sources(core
+  PRIVATE
+  "${CMAKE_CURRENT_LIST_DIR}/sui.hpp"
+  "${CMAKE_CURRENT_LIST_DIR}/sui_reader.cpp"
+  "${CMAKE_CURRENT_LIST_DIR}/sui_reader.hpp"
+  "${CMAKE_CURRENT_LIST_DIR}/sui_writer.cpp"
+  "${CMAKE_CURRENT_LIST_DIR}/sui_writer.hpp"
+)
@@ -0,0 +1,51 @@
+#ifndef SU_CORE_IMAGE_ENCODING_SUI_HPP
+#define SU_CORE_IMAGE_ENCODING_SUI_HPP
+
+#include <cstdint>
+
+// Container for textures in the same layout that they have in memory,
+// so that they can be memory mapped instead of decoded.
+// A container starts with a Header, followed by num_levels Level entries and num_averages
+// averages of three floats each. The texels of every level follow at offsets that are
+// multiples of Alignment. Every level halves the dimensions of the one before, down to 1.
+namespace image::encoding::sui {
+
+static char constexpr Signature[] = "SUI\002";
+
+static uint64_t constexpr Alignment = 64;
+
+enum class Layout : uint32_t { Linear };
+
+struct Header {
+    char signature[4];
+
+    // Image::Type
+    uint32_t type;
+
+    int32_t dimensions[3];
+    int32_t num_elements;
+
+    Layout layout;
+
+    uint32_t num_levels;
+    uint32_t num_averages;
+
+    // texture::Provider::Usage and Channels that the texture was converted for,
+    // because they determine the texel type and the sRGB handling of the mips
+    uint32_t usage;
+    uint32_t channels;
+
+    uint32_t padding;
+};
+
+struct Level {
+    int32_t  dimensions[3];
+    uint32_t padding;
+
+    uint64_t offset;
+    uint64_t num_bytes;
+};
+
+}  // namespace image::encoding::sui
+
+#endif
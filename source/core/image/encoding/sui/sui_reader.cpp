@@ -0,0 +1,135 @@
+#include "sui_reader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "base/math/vector4.inl"
+#include "file/file_mapping.hpp"
+#include "image/typed_image.inl"
+#include "sui.hpp"
+
+namespace image::encoding::sui {
+
+template <typename T>
+static std::shared_ptr<Image> wrap(Image::Description const&             description,
+                                   Level const&                          level,
+                                   std::shared_ptr<file::Mapping> const& mapping) {
+    if (level.num_bytes != description.num_pixels() * sizeof(T) ||
+        0 != level.offset % Alignment || level.offset + level.num_bytes > mapping->size()) {
+        throw std::runtime_error("Corrupt level");
+    }
+
+    T* data = reinterpret_cast<T*>(mapping->data() + level.offset);
+
+    return std::make_shared<Typed_image<T>>(description, data, mapping);
+}
+
+static std::shared_ptr<Image> wrap(Image::Description const&             description,
+                                   Level const&                          level,
+                                   std::shared_ptr<file::Mapping> const& mapping) {
+    switch (description.type) {
+        case Image::Type::Byte1:
+            return wrap<uint8_t>(description, level, mapping);
+        case Image::Type::Byte2:
+            return wrap<byte2>(description, level, mapping);
+        case Image::Type::Byte3:
+            return wrap<byte3>(description, level, mapping);
+        case Image::Type::Float1:
+            return wrap<float>(description, level, mapping);
+        case Image::Type::Float2:
+            return wrap<float2>(description, level, mapping);
+        case Image::Type::Float3:
+            return wrap<packed_float3>(description, level, mapping);
+        case Image::Type::Float4:
+            return wrap<float4>(description, level, mapping);
+        default:
+            throw std::runtime_error("Unsupported texel type");
+    }
+}
+
+std::shared_ptr<Image> Reader::read(std::string const& filename) {
+    auto mapping = std::make_shared<file::Mapping>(filename);
+    if (!mapping->is_valid()) {
+        throw std::runtime_error("Could not map file");
+    }
+
+    uint8_t const* data = mapping->data();
+
+    Header header;
+    if (mapping->size() < sizeof(Header)) {
+        throw std::runtime_error("Corrupt header");
+    }
+
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (std::memcmp(header.signature, Signature, sizeof(header.signature))) {
+        throw std::runtime_error("Unsupported SUI version, the image has to be converted again");
+    }
+
+    if (Layout::Linear != header.layout) {
+        throw std::runtime_error("Unsupported texel layout");
+    }
+
+    size_t const num_bytes = sizeof(Header) + header.num_levels * sizeof(Level) +
+                             header.num_averages * sizeof(packed_float3);
+
+    uint32_t const num_elements = static_cast<uint32_t>(header.num_elements);
+
+    if (0 == header.num_levels || num_bytes > mapping->size() ||
+        (0 != header.num_averages && num_elements != header.num_averages)) {
+        throw std::runtime_error("Corrupt header");
+    }
+
+    Level const* levels = reinterpret_cast<Level const*>(data + sizeof(Header));
+
+    auto const type = static_cast<Image::Type>(header.type);
+
+    int3 const dimensions(header.dimensions[0], header.dimensions[1], header.dimensions[2]);
+
+    // Only 2D textures have mip levels
+    if (header.num_levels > 1 && (1 != dimensions[2] || 1 != header.num_elements)) {
+        throw std::runtime_error("Corrupt header");
+    }
+
+    if (int3(levels[0].dimensions[0], levels[0].dimensions[1], levels[0].dimensions[2]) !=
+        dimensions) {
+        throw std::runtime_error("Corrupt level dimensions");
+    }
+
+    auto image = wrap(Image::Description(type, dimensions, header.num_elements), levels[0],
+                      mapping);
+
+    std::vector<std::shared_ptr<Image>> mip_levels;
+    mip_levels.reserve(header.num_levels - 1);
+
+    for (uint32_t l = 1; l < header.num_levels; ++l) {
+        Level const& level = levels[l];
+
+        int3 const level_dimensions(level.dimensions[0], level.dimensions[1], level.dimensions[2]);
+
+        // The sampling of the mip chain derives the dimensions of a level from the one before
+        int3 const expected(std::max(levels[l - 1].dimensions[0] / 2, 1),
+                            std::max(levels[l - 1].dimensions[1] / 2, 1), 1);
+
+        if (expected != level_dimensions) {
+            throw std::runtime_error("Corrupt level dimensions");
+        }
+
+        mip_levels.push_back(wrap(Image::Description(type, level_dimensions, header.num_elements),
+                                  level, mapping));
+    }
+
+    image->set_levels(std::move(mip_levels));
+
+    image->set_stored_usage(header.usage, static_cast<Channels>(header.channels));
+
+    std::vector<packed_float3> averages(header.num_averages);
+
+    std::memcpy(averages.data(), levels + header.num_levels,
+                header.num_averages * sizeof(packed_float3));
+
+    image->set_averages(std::move(averages));
+
+    return image;
+}
+
+}  // namespace image::encoding::sui
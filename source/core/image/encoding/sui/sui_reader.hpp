@@ -0,0 +1,22 @@
+#ifndef SU_CORE_IMAGE_ENCODING_SUI_READER_HPP
+#define SU_CORE_IMAGE_ENCODING_SUI_READER_HPP
+
+#include <memory>
+#include <string>
+
+namespace image {
+
+class Image;
+
+namespace encoding::sui {
+
+class Reader {
+  public:
+    // The texels are not copied, the returned image keeps the file mapped instead
+    static std::shared_ptr<Image> read(std::string const& filename);
+};
+
+}  // namespace encoding::sui
+}  // namespace image
+
+#endif
@@ -0,0 +1,127 @@
+#include "sui_writer.hpp"
+#include <cstring>
+#include <ostream>
+#include <vector>
+#include "base/math/vector4.inl"
+#include "image/texture/texture.hpp"
+#include "image/typed_image.inl"
+#include "sui.hpp"
+
+namespace image::encoding::sui {
+
+struct Texels {
+    char const* data;
+
+    uint64_t num_bytes;
+};
+
+template <typename T>
+static Texels typed_texels(Image const& image) {
+    return {reinterpret_cast<char const*>(static_cast<Typed_image<T> const&>(image).data()),
+            image.description().num_pixels() * sizeof(T)};
+}
+
+static Texels texels(Image const& image) {
+    switch (image.description().type) {
+        case Image::Type::Byte1:
+            return typed_texels<uint8_t>(image);
+        case Image::Type::Byte2:
+            return typed_texels<byte2>(image);
+        case Image::Type::Byte3:
+            return typed_texels<byte3>(image);
+        case Image::Type::Float1:
+            return typed_texels<float>(image);
+        case Image::Type::Float2:
+            return typed_texels<float2>(image);
+        case Image::Type::Float3:
+            return typed_texels<packed_float3>(image);
+        case Image::Type::Float4:
+            return typed_texels<float4>(image);
+        default:
+            return {nullptr, 0};
+    }
+}
+
+static uint64_t align(uint64_t offset) {
+    return (offset + Alignment - 1) & ~(Alignment - 1);
+}
+
+bool Writer::write(std::ostream& stream, texture::Texture const& texture, uint32_t usage,
+                   Channels channels) {
+    auto const& description = texture.image().description();
+
+    uint32_t const num_levels   = static_cast<uint32_t>(texture.num_levels());
+    uint32_t const num_elements = static_cast<uint32_t>(description.num_elements);
+
+    Header header;
+    std::memcpy(header.signature, Signature, sizeof(header.signature));
+    header.type          = static_cast<uint32_t>(description.type);
+    header.dimensions[0] = description.dimensions[0];
+    header.dimensions[1] = description.dimensions[1];
+    header.dimensions[2] = description.dimensions[2];
+    header.num_elements  = description.num_elements;
+    header.layout        = Layout::Linear;
+    header.num_levels    = num_levels;
+    header.num_averages  = num_elements;
+    header.usage         = usage;
+    header.channels      = static_cast<uint32_t>(channels);
+    header.padding       = 0;
+
+    std::vector<Level>  levels(num_levels);
+    std::vector<Texels> level_texels(num_levels);
+
+    uint64_t const header_bytes = sizeof(Header) + num_levels * sizeof(Level) +
+                                  num_elements * sizeof(packed_float3);
+
+    uint64_t offset = header_bytes;
+
+    for (uint32_t l = 0; l < num_levels; ++l) {
+        Image const& image = texture.level(static_cast<int32_t>(l)).image();
+
+        Texels const t = texels(image);
+        if (!t.data) {
+            return false;
+        }
+
+        level_texels[l] = t;
+
+        Level& level = levels[l];
+
+        level.dimensions[0] = image.description().dimensions[0];
+        level.dimensions[1] = image.description().dimensions[1];
+        level.dimensions[2] = image.description().dimensions[2];
+        level.padding       = 0;
+
+        offset = align(offset);
+
+        level.offset    = offset;
+        level.num_bytes = t.num_bytes;
+
+        offset += t.num_bytes;
+    }
+
+    std::vector<packed_float3> averages(num_elements);
+    for (uint32_t e = 0; e < num_elements; ++e) {
+        averages[e] = packed_float3(texture.average_3(static_cast<int32_t>(e)));
+    }
+
+    stream.write(reinterpret_cast<char const*>(&header), sizeof(Header));
+    stream.write(reinterpret_cast<char const*>(levels.data()), num_levels * sizeof(Level));
+    stream.write(reinterpret_cast<char const*>(averages.data()),
+                 num_elements * sizeof(packed_float3));
+
+    char const padding[Alignment] = {};
+
+    offset = header_bytes;
+
+    for (uint32_t l = 0; l < num_levels; ++l) {
+        stream.write(padding, static_cast<std::streamsize>(levels[l].offset - offset));
+        stream.write(level_texels[l].data, static_cast<std::streamsize>(level_texels[l].num_bytes));
+
+        offset = levels[l].offset + levels[l].num_bytes;
+    }
+
+    return static_cast<bool>(stream);
+}
+
+}  // namespace image::encoding::sui
@@ -0,0 +1,27 @@
+#ifndef SU_CORE_IMAGE_ENCODING_SUI_WRITER_HPP
+#define SU_CORE_IMAGE_ENCODING_SUI_WRITER_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include "image/channels.hpp"
+
+namespace image {
+
+namespace texture {
+class Texture;
+}
+
+namespace encoding::sui {
+
+class Writer {
+  public:
+    // Writes the texels of all levels of the texture, which must be kept in memory,
+    // together with the averages of its elements and the usage and channels it was loaded with
+    static bool write(std::ostream& stream, texture::Texture const& texture, uint32_t usage,
+                      Channels channels);
+};
+
+}  // namespace encoding::sui
+}  // namespace image
+
+#endif
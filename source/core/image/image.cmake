@@ -6,7 +6,12 @@ include("${CMAKE_CURRENT_LIST_DIR}/texture/texture.cmake")
 
 target_sources(core
 	PRIVATE
+	"${CMAKE_CURRENT_LIST_DIR}/block_compression.cpp"
+	"${CMAKE_CURRENT_LIST_DIR}/block_compression.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/block_compression.inl"
 	"${CMAKE_CURRENT_LIST_DIR}/channels.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/compressed_image.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/compressed_image.inl"
 	"${CMAKE_CURRENT_LIST_DIR}/image_helper.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/image_helper.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/image_provider.cpp"
@@ -15,6 +20,10 @@ target_sources(core
 	"${CMAKE_CURRENT_LIST_DIR}/image_writer.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/image.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/image.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/paged_image.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/paged_image.inl"
+	"${CMAKE_CURRENT_LIST_DIR}/tile_cache.cpp"
+	"${CMAKE_CURRENT_LIST_DIR}/tile_cache.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/tiled_image.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/tiled_image.inl"
 	"${CMAKE_CURRENT_LIST_DIR}/typed_image.hpp"
@@ -58,6 +58,35 @@ int2 Image::coordinates_2(int32_t index) const noexcept {
     return c;
 }
 
+std::vector<std::shared_ptr<Image>> const& Image::levels() const noexcept {
+    return levels_;
+}
+
+void Image::set_levels(std::vector<std::shared_ptr<Image>>&& levels) noexcept {
+    levels_ = std::move(levels);
+}
+
+std::vector<packed_float3> const& Image::averages() const noexcept {
+    return averages_;
+}
+
+void Image::set_averages(std::vector<packed_float3>&& averages) noexcept {
+    averages_ = std::move(averages);
+}
+
+uint32_t Image::stored_usage() const noexcept {
+    return stored_usage_;
+}
+
+Channels Image::stored_channels() const noexcept {
+    return stored_channels_;
+}
+
+void Image::set_stored_usage(uint32_t usage, Channels channels) noexcept {
+    stored_usage_    = usage;
+    stored_channels_ = channels;
+}
+
 void Image::resize(Description const& description) noexcept {
     description_ = description;
 }
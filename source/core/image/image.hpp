@@ -2,7 +2,10 @@
 #define SU_CORE_IMAGE_IMAGE_HPP
 
 #include <cstddef>
+#include <memory>
+#include <vector>
 #include "base/math/vector3.hpp"
+#include "channels.hpp"
 
 namespace image {
 
@@ -42,10 +45,36 @@ class Image {
 
     virtual size_t num_bytes() const noexcept = 0;
 
+    // Levels 1 and up of the mip chain, if they were stored together with the image
+    std::vector<std::shared_ptr<Image>> const& levels() const noexcept;
+
+    void set_levels(std::vector<std::shared_ptr<Image>>&& levels) noexcept;
+
+    // Average of every element as the texture sees it, if it was stored together with the image
+    std::vector<packed_float3> const& averages() const noexcept;
+
+    void set_averages(std::vector<packed_float3>&& averages) noexcept;
+
+    // Usage, as texture::Provider::Usage, and channels of the texture the image was stored for.
+    // Undefined and None for images that were not.
+    uint32_t stored_usage() const noexcept;
+
+    Channels stored_channels() const noexcept;
+
+    void set_stored_usage(uint32_t usage, Channels channels) noexcept;
+
   protected:
     void resize(Description const& description) noexcept;
 
     Description description_;
+
+    std::vector<std::shared_ptr<Image>> levels_;
+
+    std::vector<packed_float3> averages_;
+
+    uint32_t stored_usage_ = 0;
+
+    Channels stored_channels_ = Channels::None;
 };
 
 }  // namespace image
@@ -5,6 +5,7 @@
 #include "encoding/json/json_reader.hpp"
 #include "encoding/raw/raw_reader.hpp"
 #include "encoding/rgbe/rgbe_reader.hpp"
+#include "encoding/sui/sui_reader.hpp"
 #include "file/file.hpp"
 #include "file/file_system.hpp"
 #include "resource/resource_manager.hpp"
@@ -26,7 +27,8 @@ std::shared_ptr<Image> Provider::load(std::string const&         filename,
         return flakes_provider_.create_mask(options);
     }
 
-    auto stream_pointer = manager.filesystem().read_stream(filename);
+    std::string resolved_name;
+    auto stream_pointer = manager.filesystem().read_stream(filename, resolved_name);
 
     auto& stream = *stream_pointer;
 
@@ -50,6 +52,8 @@ std::shared_ptr<Image> Provider::load(std::string const&         filename,
     } else if (file::Type::RGBE == type) {
         encoding::rgbe::Reader reader;
         return reader.read(stream);
+    } else if (file::Type::SUI == type) {
+        return encoding::sui::Reader::read(resolved_name);
     } else if (file::Type::Undefined == type) {
         if ("raw" == string::suffix(filename) || "raw" == string::presuffix(filename)) {
             encoding::raw::Reader reader;
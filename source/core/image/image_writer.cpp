@@ -5,4 +5,6 @@ namespace image {
 
 Writer::~Writer() {}
 
+void Writer::encode(Float4 const& /*image*/, int32_t /*begin*/, int32_t /*end*/) {}
+
 }  // namespace image
@@ -16,6 +16,10 @@ class Writer {
 
     virtual std::string file_extension() const = 0;
 
+    // Converts the pixels [begin, end) into the format of the file, see exporting::Sink::encode()
+    virtual void encode(Float4 const& image, int32_t begin, int32_t end);
+
+    // Expects encode() to have been called for all pixels of the image
     virtual bool write(std::ostream& stream, Float4 const& image, thread::Pool& pool) = 0;
 };
 
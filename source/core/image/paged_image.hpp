@@ -0,0 +1,59 @@
+#ifndef SU_CORE_IMAGE_PAGED_IMAGE_HPP
+#define SU_CORE_IMAGE_PAGED_IMAGE_HPP
+
+#include <memory>
+#include "base/math/vector.hpp"
+#include "image.hpp"
+#include "tile_cache.hpp"
+
+namespace image {
+
+template <typename T>
+class Typed_image;
+
+// Read-only counterpart of Typed_image, whose texels live in a Tile_cache.
+// Layers and elements are stacked vertically, the same way as in Typed_image.
+template <typename T>
+class Paged_image final : public Image {
+  public:
+    static int32_t constexpr Log_tile_size = 6;
+    static int32_t constexpr Tile_size     = 1 << Log_tile_size;
+
+    Paged_image(Typed_image<T> const& source, std::shared_ptr<Tile_cache> const& cache) noexcept;
+
+    ~Paged_image() noexcept override final;
+
+    // False if the tiles could not be stored
+    bool is_valid() const noexcept;
+
+    T load(int32_t index) const noexcept;
+
+    T load(int32_t x, int32_t y) const noexcept;
+
+    T load_element(int32_t x, int32_t y, int32_t element) const noexcept;
+
+    T load(int32_t x, int32_t y, int32_t z) const noexcept;
+
+    void gather(int4 const& xy_xy1, T c[4]) const noexcept;
+
+    void gather(int3 const& xyz, int3 const& xyz1, T c[8]) const noexcept;
+
+    size_t num_bytes() const noexcept override final;
+
+  private:
+    T const* tile(int32_t x, int32_t y) const noexcept;
+
+    static int32_t texel(int32_t x, int32_t y) noexcept;
+
+    static uint32_t num_tiles(Description const& description) noexcept;
+
+    std::shared_ptr<Tile_cache> cache_;
+
+    Tile_cache::Source source_;
+
+    int32_t num_tiles_x_;
+};
+
+}  // namespace image
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef SU_CORE_IMAGE_PAGED_IMAGE_INL
+#define SU_CORE_IMAGE_PAGED_IMAGE_INL
+
+#include <algorithm>
+#include <vector>
+#include "base/math/vector4.inl"
+#include "paged_image.hpp"
+#include "typed_image.inl"
+
+namespace image {
+
+template <typename T>
+Paged_image<T>::Paged_image(Typed_image<T> const&              source,
+                            std::shared_ptr<Tile_cache> const& cache) noexcept
+    : Image(source.description()),
+      cache_(cache),
+      source_(*cache, num_tiles(source.description()),
+              static_cast<uint32_t>(Tile_size * Tile_size * sizeof(T))),
+      num_tiles_x_((description_.dimensions[0] + Tile_size - 1) >> Log_tile_size) {
+    int3 const d = description_.dimensions;
+
+    int32_t const width  = d[0];
+    int32_t const height = d[1] * d[2] * description_.num_elements;
+
+    int32_t const num_tiles_y = (height + Tile_size - 1) >> Log_tile_size;
+
+    // Texels outside of the image are padded with the closest edge texel
+    std::vector<T> buffer(Tile_size * Tile_size);
+
+    for (int32_t ty = 0; ty < num_tiles_y && source_.is_valid(); ++ty) {
+        for (int32_t tx = 0; tx < num_tiles_x_; ++tx) {
+            for (int32_t y = 0; y < Tile_size; ++y) {
+                int32_t const sy = std::min((ty << Log_tile_size) + y, height - 1);
+
+                for (int32_t x = 0; x < Tile_size; ++x) {
+                    int32_t const sx = std::min((tx << Log_tile_size) + x, width - 1);
+
+                    buffer[texel(x, y)] = source.load(sy * width + sx);
+                }
+            }
+
+            source_.write(static_cast<uint32_t>(ty * num_tiles_x_ + tx), buffer.data());
+        }
+    }
+}
+
+template <typename T>
+Paged_image<T>::~Paged_image() noexcept {}
+
+template <typename T>
+bool Paged_image<T>::is_valid() const noexcept {
+    return source_.is_valid();
+}
+
+template <typename T>
+T Paged_image<T>::load(int32_t index) const noexcept {
+    int32_t const width = description_.dimensions[0];
+
+    int32_t const y = index / width;
+    int32_t const x = index - y * width;
+
+    return load(x, y);
+}
+
+template <typename T>
+T Paged_image<T>::load(int32_t x, int32_t y) const noexcept {
+    return tile(x, y)[texel(x, y)];
+}
+
+template <typename T>
+T Paged_image<T>::load_element(int32_t x, int32_t y, int32_t element) const noexcept {
+    return load(x, element * description_.dimensions[1] + y);
+}
+
+template <typename T>
+T Paged_image<T>::load(int32_t x, int32_t y, int32_t z) const noexcept {
+    return load(x, z * description_.dimensions[1] + y);
+}
+
+template <typename T>
+void Paged_image<T>::gather(int4 const& xy_xy1, T c[4]) const noexcept {
+    int32_t const x0 = xy_xy1[0];
+    int32_t const y0 = xy_xy1[1];
+    int32_t const x1 = xy_xy1[2];
+    int32_t const y1 = xy_xy1[3];
+
+    // Most footprints are inside of a single tile
+    if (((x0 ^ x1) | (y0 ^ y1)) >> Log_tile_size) {
+        c[0] = load(x0, y0);
+        c[1] = load(x1, y0);
+        c[2] = load(x0, y1);
+        c[3] = load(x1, y1);
+    } else {
+        T const* data = tile(x0, y0);
+
+        c[0] = data[texel(x0, y0)];
+        c[1] = data[texel(x1, y0)];
+        c[2] = data[texel(x0, y1)];
+        c[3] = data[texel(x1, y1)];
+    }
+}
+
+template <typename T>
+void Paged_image<T>::gather(int3 const& xyz, int3 const& xyz1, T c[8]) const noexcept {
+    c[0] = load(xyz[0], xyz[1], xyz[2]);
+    c[1] = load(xyz1[0], xyz[1], xyz[2]);
+    c[2] = load(xyz[0], xyz1[1], xyz[2]);
+    c[3] = load(xyz1[0], xyz1[1], xyz[2]);
+    c[4] = load(xyz[0], xyz[1], xyz1[2]);
+    c[5] = load(xyz1[0], xyz[1], xyz1[2]);
+    c[6] = load(xyz[0], xyz1[1], xyz1[2]);
+    c[7] = load(xyz1[0], xyz1[1], xyz1[2]);
+}
+
+template <typename T>
+size_t Paged_image<T>::num_bytes() const noexcept {
+    return sizeof(*this);
+}
+
+template <typename T>
+T const* Paged_image<T>::tile(int32_t x, int32_t y) const noexcept {
+    int32_t const index = (y >> Log_tile_size) * num_tiles_x_ + (x >> Log_tile_size);
+
+    return static_cast<T const*>(cache_->tile(source_, static_cast<uint32_t>(index)));
+}
+
+template <typename T>
+int32_t Paged_image<T>::texel(int32_t x, int32_t y) noexcept {
+    int32_t constexpr Mask = Tile_size - 1;
+
+    return ((y & Mask) << Log_tile_size) + (x & Mask);
+}
+
+template <typename T>
+uint32_t Paged_image<T>::num_tiles(Description const& description) noexcept {
+    int3 const d = description.dimensions;
+
+    int32_t const num_tiles_x = (d[0] + Tile_size - 1) >> Log_tile_size;
+    int32_t const num_tiles_y = (d[1] * d[2] * description.num_elements + Tile_size - 1) >>
+                                Log_tile_size;
+
+    return static_cast<uint32_t>(num_tiles_x * num_tiles_y);
+}
+
+}  // namespace image
+
+#endif
@@ -8,6 +8,8 @@ target_sources(core
   "${CMAKE_CURRENT_LIST_DIR}/sampler_linear_2d.inl"
   "${CMAKE_CURRENT_LIST_DIR}/sampler_linear_3d.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/sampler_linear_3d.inl"
+  "${CMAKE_CURRENT_LIST_DIR}/sampler_mipmap_2d.hpp"
+  "${CMAKE_CURRENT_LIST_DIR}/sampler_mipmap_2d.inl"
   "${CMAKE_CURRENT_LIST_DIR}/sampler_nearest_2d.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/sampler_nearest_2d.inl"
   "${CMAKE_CURRENT_LIST_DIR}/sampler_nearest_3d.hpp"
@@ -21,6 +21,17 @@ class Sampler_2D {
     virtual float2 sample_2(Texture const& texture, float2 uv, int32_t element) const noexcept = 0;
     virtual float3 sample_3(Texture const& texture, float2 uv, int32_t element) const noexcept = 0;
 
+    // duv holds the derivatives of uv along the two axes of the footprint of the lookup,
+    // in the order du/dx, dv/dx, du/dy, dv/dy. Only mip mapping samplers make use of them.
+    virtual float sample_1(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept = 0;
+
+    virtual float2 sample_2(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept = 0;
+
+    virtual float3 sample_3(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept = 0;
+
     virtual float2 address(float2 uv) const noexcept = 0;
 };
 
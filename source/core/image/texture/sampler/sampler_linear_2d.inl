@@ -90,6 +90,24 @@ float3 Linear_2D<Address_U, Address_V>::sample_3(Texture const& texture, float2
     return bilinear(c00, c01, c10, c11, st[0], st[1]);
 }
 
+template <typename Address_U, typename Address_V>
+float Linear_2D<Address_U, Address_V>::sample_1(Texture const& texture, float2 uv,
+                                                float4 const& /*duv*/) const noexcept {
+    return sample_1(texture, uv);
+}
+
+template <typename Address_U, typename Address_V>
+float2 Linear_2D<Address_U, Address_V>::sample_2(Texture const& texture, float2 uv,
+                                                 float4 const& /*duv*/) const noexcept {
+    return sample_2(texture, uv);
+}
+
+template <typename Address_U, typename Address_V>
+float3 Linear_2D<Address_U, Address_V>::sample_3(Texture const& texture, float2 uv,
+                                                 float4 const& /*duv*/) const noexcept {
+    return sample_3(texture, uv);
+}
+
 template <typename Address_U, typename Address_V>
 float2 Linear_2D<Address_U, Address_V>::address(float2 uv) const noexcept {
     return float2(Address_U::f(uv[0]), Address_V::f(uv[1]));
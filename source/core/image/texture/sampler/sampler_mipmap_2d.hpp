@@ -0,0 +1,52 @@
+#ifndef SU_CORE_IMAGE_TEXTURE_SAMPLER_MIPMAP_2D_HPP
+#define SU_CORE_IMAGE_TEXTURE_SAMPLER_MIPMAP_2D_HPP
+
+#include "sampler_linear_2d.hpp"
+
+namespace image::texture::sampler {
+
+// Filters the two mip levels around the width of the footprint trilinearly.
+// Anisotropic footprints are covered by up to max_anisotropy lookups along their major axis,
+// so that the width is given by the minor axis. A max_anisotropy of 1 is plain trilinear.
+// Lookups without footprint fall back to bilinear filtering of the texture itself.
+template <typename Address_U, typename Address_V>
+class Mipmap_2D final : public Sampler_2D {
+  public:
+    Mipmap_2D(uint32_t max_anisotropy) noexcept;
+
+    float  sample_1(Texture const& texture, float2 uv) const noexcept override final;
+    float2 sample_2(Texture const& texture, float2 uv) const noexcept override final;
+    float3 sample_3(Texture const& texture, float2 uv) const noexcept override final;
+
+    float sample_1(Texture const& texture, float2 uv, int32_t element) const
+        noexcept override final;
+
+    float2 sample_2(Texture const& texture, float2 uv, int32_t element) const
+        noexcept override final;
+
+    float3 sample_3(Texture const& texture, float2 uv, int32_t element) const
+        noexcept override final;
+
+    float sample_1(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept override final;
+
+    float2 sample_2(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept override final;
+
+    float3 sample_3(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept override final;
+
+    float2 address(float2 uv) const noexcept override final;
+
+  private:
+    template <typename T, typename Lookup>
+    T filter(Texture const& texture, float2 uv, float4 const& duv, Lookup lookup) const noexcept;
+
+    Linear_2D<Address_U, Address_V> linear_;
+
+    float max_anisotropy_;
+};
+
+}  // namespace image::texture::sampler
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef SU_CORE_IMAGE_TEXTURE_SAMPLER_MIPMAP_2D_INL
+#define SU_CORE_IMAGE_TEXTURE_SAMPLER_MIPMAP_2D_INL
+
+#include <algorithm>
+#include <cmath>
+#include "base/math/vector4.inl"
+#include "image/texture/texture.hpp"
+#include "sampler_linear_2d.inl"
+#include "sampler_mipmap_2d.hpp"
+
+namespace image::texture::sampler {
+
+template <typename Address_U, typename Address_V>
+Mipmap_2D<Address_U, Address_V>::Mipmap_2D(uint32_t max_anisotropy) noexcept
+    : max_anisotropy_(static_cast<float>(max_anisotropy)) {}
+
+template <typename Address_U, typename Address_V>
+float Mipmap_2D<Address_U, Address_V>::sample_1(Texture const& texture, float2 uv) const noexcept {
+    return linear_.sample_1(texture, uv);
+}
+
+template <typename Address_U, typename Address_V>
+float2 Mipmap_2D<Address_U, Address_V>::sample_2(Texture const& texture, float2 uv) const noexcept {
+    return linear_.sample_2(texture, uv);
+}
+
+template <typename Address_U, typename Address_V>
+float3 Mipmap_2D<Address_U, Address_V>::sample_3(Texture const& texture, float2 uv) const noexcept {
+    return linear_.sample_3(texture, uv);
+}
+
+template <typename Address_U, typename Address_V>
+float Mipmap_2D<Address_U, Address_V>::sample_1(Texture const& texture, float2 uv,
+                                                int32_t element) const noexcept {
+    return linear_.sample_1(texture, uv, element);
+}
+
+template <typename Address_U, typename Address_V>
+float2 Mipmap_2D<Address_U, Address_V>::sample_2(Texture const& texture, float2 uv,
+                                                 int32_t element) const noexcept {
+    return linear_.sample_2(texture, uv, element);
+}
+
+template <typename Address_U, typename Address_V>
+float3 Mipmap_2D<Address_U, Address_V>::sample_3(Texture const& texture, float2 uv,
+                                                 int32_t element) const noexcept {
+    return linear_.sample_3(texture, uv, element);
+}
+
+template <typename Address_U, typename Address_V>
+float Mipmap_2D<Address_U, Address_V>::sample_1(Texture const& texture, float2 uv,
+                                                float4 const& duv) const noexcept {
+    return filter<float>(texture, uv, duv, [this](Texture const& level, float2 p) noexcept {
+        return linear_.sample_1(level, p);
+    });
+}
+
+template <typename Address_U, typename Address_V>
+float2 Mipmap_2D<Address_U, Address_V>::sample_2(Texture const& texture, float2 uv,
+                                                 float4 const& duv) const noexcept {
+    return filter<float2>(texture, uv, duv, [this](Texture const& level, float2 p) noexcept {
+        return linear_.sample_2(level, p);
+    });
+}
+
+template <typename Address_U, typename Address_V>
+float3 Mipmap_2D<Address_U, Address_V>::sample_3(Texture const& texture, float2 uv,
+                                                 float4 const& duv) const noexcept {
+    return filter<float3>(texture, uv, duv, [this](Texture const& level, float2 p) noexcept {
+        return linear_.sample_3(level, p);
+    });
+}
+
+template <typename Address_U, typename Address_V>
+float2 Mipmap_2D<Address_U, Address_V>::address(float2 uv) const noexcept {
+    return linear_.address(uv);
+}
+
+template <typename Address_U, typename Address_V>
+template <typename T, typename Lookup>
+T Mipmap_2D<Address_U, Address_V>::filter(Texture const& texture, float2 uv, float4 const& duv,
+                                           Lookup lookup) const noexcept {
+    int32_t const num_levels = texture.num_levels();
+
+    float2 const d = texture.dimensions_float2();
+
+    float2 const dx(duv[0], duv[1]);
+    float2 const dy(duv[2], duv[3]);
+
+    // Lengths of the axes in texels
+    float const lx = math::length(dx * d);
+    float const ly = math::length(dy * d);
+
+    float const major = std::max(lx, ly);
+    float const minor = std::max(std::min(lx, ly), major / max_anisotropy_);
+
+    if (1 == num_levels || minor <= 0.f) {
+        return lookup(texture, uv);
+    }
+
+    float const lod = std::min(std::max(std::log2(minor), 0.f),
+                               static_cast<float>(num_levels - 1));
+
+    int32_t const l = static_cast<int32_t>(lod);
+    float const   t = lod - static_cast<float>(l);
+
+    Texture const& a = texture.level(l);
+    Texture const& b = texture.level(std::min(l + 1, num_levels - 1));
+
+    float2 const major_axis = lx > ly ? dx : dy;
+
+    int32_t const num_probes = std::min(static_cast<int32_t>(std::ceil(major / minor)),
+                                        static_cast<int32_t>(max_anisotropy_));
+
+    float const step = 1.f / static_cast<float>(num_probes);
+
+    T result(0.f);
+
+    for (int32_t i = 0; i < num_probes; ++i) {
+        float2 const p = uv + (step * (static_cast<float>(i) + 0.5f) - 0.5f) * major_axis;
+
+        T const va = lookup(a, p);
+
+        result += t > 0.f ? (1.f - t) * va + t * lookup(b, p) : va;
+    }
+
+    return step * result;
+}
+
+}  // namespace image::texture::sampler
+
+#endif
@@ -21,6 +21,15 @@ class Nearest_2D final : public Sampler_2D {
     float3 sample_3(Texture const& texture, float2 uv, int32_t element) const
         noexcept override final;
 
+    float sample_1(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept override final;
+
+    float2 sample_2(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept override final;
+
+    float3 sample_3(Texture const& texture, float2 uv, float4 const& duv) const
+        noexcept override final;
+
     float2 address(float2 uv) const noexcept override final;
 
   private:
@@ -63,6 +63,24 @@ float3 Nearest_2D<Address_mode_U, Address_mode_V>::sample_3(Texture const& textu
     return texture.at_element_3(xy[0], xy[1], min_element);
 }
 
+template <typename Address_mode_U, typename Address_mode_V>
+float Nearest_2D<Address_mode_U, Address_mode_V>::sample_1(Texture const& texture, float2 uv,
+                                                           float4 const& /*duv*/) const noexcept {
+    return sample_1(texture, uv);
+}
+
+template <typename Address_mode_U, typename Address_mode_V>
+float2 Nearest_2D<Address_mode_U, Address_mode_V>::sample_2(Texture const& texture, float2 uv,
+                                                            float4 const& /*duv*/) const noexcept {
+    return sample_2(texture, uv);
+}
+
+template <typename Address_mode_U, typename Address_mode_V>
+float3 Nearest_2D<Address_mode_U, Address_mode_V>::sample_3(Texture const& texture, float2 uv,
+                                                            float4 const& /*duv*/) const noexcept {
+    return sample_3(texture, uv);
+}
+
 template <typename Address_mode_U, typename Address_mode_V>
 float2 Nearest_2D<Address_mode_U, Address_mode_V>::address(float2 uv) const noexcept {
     return float2(Address_mode_U::f(uv[0]), Address_mode_V::f(uv[1]));
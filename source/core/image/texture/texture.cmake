@@ -24,6 +24,8 @@ target_sources(core
   "${CMAKE_CURRENT_LIST_DIR}/texture_float_2.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/texture_float_3.cpp"
   "${CMAKE_CURRENT_LIST_DIR}/texture_float_3.hpp"
+  "${CMAKE_CURRENT_LIST_DIR}/texture_mipmap.cpp"
+  "${CMAKE_CURRENT_LIST_DIR}/texture_mipmap.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/texture_provider.cpp"
   "${CMAKE_CURRENT_LIST_DIR}/texture_provider.hpp"
   "${CMAKE_CURRENT_LIST_DIR}/texture_test.cpp"
@@ -49,6 +49,10 @@ float3 const& Texture::dimensions_float3() const noexcept {
 }
 
 float3 Texture::average_3() const noexcept {
+    if (!averages_.empty()) {
+        return float3(averages_[0]);
+    }
+
     float3 average(0.f);
 
     auto const d = dimensions_2();
@@ -63,6 +67,10 @@ float3 Texture::average_3() const noexcept {
 }
 
 float3 Texture::average_3(int32_t element) const noexcept {
+    if (!averages_.empty()) {
+        return float3(averages_[element]);
+    }
+
     float3 average(0.f);
 
     auto const d = dimensions_2();
@@ -76,4 +84,20 @@ float3 Texture::average_3(int32_t element) const noexcept {
     return average / (df[0] * df[1]);
 }
 
+void Texture::set_averages(std::vector<packed_float3> const& averages) noexcept {
+    averages_ = averages;
+}
+
+int32_t Texture::num_levels() const noexcept {
+    return static_cast<int32_t>(levels_.size()) + 1;
+}
+
+Texture const& Texture::level(int32_t level) const noexcept {
+    return 0 == level ? *this : *levels_[level - 1];
+}
+
+void Texture::set_levels(std::vector<std::shared_ptr<Texture>>&& levels) noexcept {
+    levels_ = std::move(levels);
+}
+
 }  // namespace image::texture
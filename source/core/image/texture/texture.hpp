@@ -2,6 +2,7 @@
 #define SU_CORE_IMAGE_TEXTURE_TEXTURE_HPP
 
 #include <memory>
+#include <vector>
 #include "base/math/vector3.hpp"
 
 namespace image {
@@ -41,6 +42,9 @@ class Texture {
     virtual void gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept = 0;
     virtual void gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept = 0;
 
+    // The 8 corners of a trilinear footprint, in the order x, y, z
+    virtual void gather_1(int3 const& xyz, int3 const& xyz1, float c[8]) const noexcept = 0;
+
     virtual float  at_element_1(int32_t x, int32_t y, int32_t element) const noexcept = 0;
     virtual float2 at_element_2(int32_t x, int32_t y, int32_t element) const noexcept = 0;
     virtual float3 at_element_3(int32_t x, int32_t y, int32_t element) const noexcept = 0;
@@ -52,9 +56,25 @@ class Texture {
     float3 average_3() const noexcept;
     float3 average_3(int32_t element) const noexcept;
 
+    // Precomputed averages for every element, so that they don't have to be computed on demand
+    void set_averages(std::vector<packed_float3> const& averages) noexcept;
+
+    // Level 0 of the mip chain is the texture itself
+    int32_t num_levels() const noexcept;
+
+    Texture const& level(int32_t level) const noexcept;
+
+    // Every level is expected to have half the dimensions of the previous one, rounded down
+    void set_levels(std::vector<std::shared_ptr<Texture>>&& levels) noexcept;
+
   protected:
     std::shared_ptr<Image> untyped_image_;
 
+    // Levels 1 and up
+    std::vector<std::shared_ptr<Texture>> levels_;
+
+    std::vector<packed_float3> averages_;
+
     int3 back_;
 
     float3 dimensions_float_;
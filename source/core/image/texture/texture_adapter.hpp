@@ -3,6 +3,7 @@
 
 #include <memory>
 #include "base/math/vector2.hpp"
+#include "base/math/vector4.hpp"
 
 namespace image::texture {
 
@@ -37,6 +38,11 @@ class Adapter {
     float2 sample_2(Sampler_2D const& sampler, float2 uv, int32_t element) const noexcept;
     float3 sample_3(Sampler_2D const& sampler, float2 uv, int32_t element) const noexcept;
 
+    // duv is the footprint of the lookup, as expected by Sampler_2D
+    float  sample_1(Sampler_2D const& sampler, float2 uv, float4 const& duv) const noexcept;
+    float2 sample_2(Sampler_2D const& sampler, float2 uv, float4 const& duv) const noexcept;
+    float3 sample_3(Sampler_2D const& sampler, float2 uv, float4 const& duv) const noexcept;
+
     float2 address(Sampler_2D const& sampler, float2 uv) const noexcept;
 
     using Sampler_3D = sampler::Sampler_3D;
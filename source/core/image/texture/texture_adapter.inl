@@ -2,6 +2,7 @@
 #define SU_CORE_IMAGE_TEXTURE_ADAPTER_INL
 
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 #include "sampler/sampler_2d.hpp"
 #include "sampler/sampler_3d.hpp"
 #include "texture.hpp"
@@ -58,6 +59,24 @@ inline float3 Adapter::sample_3(Sampler_2D const& sampler, float2 uv, int32_t el
     return sampler.sample_3(*texture_, scale_ * uv, element);
 }
 
+inline float Adapter::sample_1(Sampler_2D const& sampler, float2 uv, float4 const& duv) const
+    noexcept {
+    float4 const scale(scale_[0], scale_[1], scale_[0], scale_[1]);
+    return sampler.sample_1(*texture_, scale_ * uv, scale * duv);
+}
+
+inline float2 Adapter::sample_2(Sampler_2D const& sampler, float2 uv, float4 const& duv) const
+    noexcept {
+    float4 const scale(scale_[0], scale_[1], scale_[0], scale_[1]);
+    return sampler.sample_2(*texture_, scale_ * uv, scale * duv);
+}
+
+inline float3 Adapter::sample_3(Sampler_2D const& sampler, float2 uv, float4 const& duv) const
+    noexcept {
+    float4 const scale(scale_[0], scale_[1], scale_[0], scale_[1]);
+    return sampler.sample_3(*texture_, scale_ * uv, scale * duv);
+}
+
 inline float2 Adapter::address(Sampler_2D const& sampler, float2 uv) const noexcept {
     return sampler.address(scale_ * uv);
 }
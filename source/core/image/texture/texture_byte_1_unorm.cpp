@@ -1,39 +1,49 @@
 #include "texture_byte_1_unorm.hpp"
 #include "base/math/vector4.inl"
+#include "image/compressed_image.inl"
+#include "image/paged_image.inl"
+#include "image/tiled_image.inl"
 #include "image/typed_image.inl"
 #include "texture_encoding.hpp"
 
 namespace image::texture {
 
-Byte1_unorm::Byte1_unorm(std::shared_ptr<Image> const& image) noexcept
-    : Texture(image), image_(*static_cast<const Byte1*>(image.get())) {}
+template <typename Storage>
+Byte1_unorm<Storage>::Byte1_unorm(std::shared_ptr<Image> const& image) noexcept
+    : Texture(image), image_(*static_cast<Storage const*>(image.get())) {}
 
-float Byte1_unorm::at_1(int32_t i) const noexcept {
+template <typename Storage>
+float Byte1_unorm<Storage>::at_1(int32_t i) const noexcept {
     uint8_t value = image_.load(i);
     return encoding::cached_unorm_to_float(value);
 }
 
-float3 Byte1_unorm::at_3(int32_t i) const noexcept {
+template <typename Storage>
+float3 Byte1_unorm<Storage>::at_3(int32_t i) const noexcept {
     uint8_t value = image_.load(i);
     return float3(encoding::cached_unorm_to_float(value), 0.f, 0.f);
 }
 
-float Byte1_unorm::at_1(int32_t x, int32_t y) const noexcept {
+template <typename Storage>
+float Byte1_unorm<Storage>::at_1(int32_t x, int32_t y) const noexcept {
     uint8_t value = image_.load(x, y);
     return encoding::cached_unorm_to_float(value);
 }
 
-float2 Byte1_unorm::at_2(int32_t x, int32_t y) const noexcept {
+template <typename Storage>
+float2 Byte1_unorm<Storage>::at_2(int32_t x, int32_t y) const noexcept {
     uint8_t value = image_.load(x, y);
     return float2(encoding::cached_unorm_to_float(value), 0.f);
 }
 
-float3 Byte1_unorm::at_3(int32_t x, int32_t y) const noexcept {
+template <typename Storage>
+float3 Byte1_unorm<Storage>::at_3(int32_t x, int32_t y) const noexcept {
     uint8_t value = image_.load(x, y);
     return float3(encoding::cached_unorm_to_float(value), 0.f, 0.f);
 }
 
-void Byte1_unorm::gather_1(int4 const& xy_xy1, float c[4]) const noexcept {
+template <typename Storage>
+void Byte1_unorm<Storage>::gather_1(int4 const& xy_xy1, float c[4]) const noexcept {
     uint8_t v[4];
     image_.gather(xy_xy1, v);
 
@@ -43,7 +53,23 @@ void Byte1_unorm::gather_1(int4 const& xy_xy1, float c[4]) const noexcept {
     c[3] = encoding::cached_unorm_to_float(v[3]);
 }
 
-void Byte1_unorm::gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept {
+template <typename Storage>
+void Byte1_unorm<Storage>::gather_1(int3 const& xyz, int3 const& xyz1, float c[8]) const noexcept {
+    uint8_t v[8];
+    image_.gather(xyz, xyz1, v);
+
+    c[0] = encoding::cached_unorm_to_float(v[0]);
+    c[1] = encoding::cached_unorm_to_float(v[1]);
+    c[2] = encoding::cached_unorm_to_float(v[2]);
+    c[3] = encoding::cached_unorm_to_float(v[3]);
+    c[4] = encoding::cached_unorm_to_float(v[4]);
+    c[5] = encoding::cached_unorm_to_float(v[5]);
+    c[6] = encoding::cached_unorm_to_float(v[6]);
+    c[7] = encoding::cached_unorm_to_float(v[7]);
+}
+
+template <typename Storage>
+void Byte1_unorm<Storage>::gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept {
     uint8_t v[4];
     image_.gather(xy_xy1, v);
 
@@ -53,7 +79,8 @@ void Byte1_unorm::gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept {
     c[3] = float2(encoding::cached_unorm_to_float(v[3]), 0.f);
 }
 
-void Byte1_unorm::gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept {
+template <typename Storage>
+void Byte1_unorm<Storage>::gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept {
     uint8_t v[4];
     image_.gather(xy_xy1, v);
 
@@ -63,34 +90,45 @@ void Byte1_unorm::gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept {
     c[3] = float3(encoding::cached_unorm_to_float(v[3]), 0.f, 0.f);
 }
 
-float Byte1_unorm::at_element_1(int32_t x, int32_t y, int32_t element) const noexcept {
+template <typename Storage>
+float Byte1_unorm<Storage>::at_element_1(int32_t x, int32_t y, int32_t element) const noexcept {
     uint8_t value = image_.load_element(x, y, element);
     return encoding::cached_unorm_to_float(value);
 }
 
-float2 Byte1_unorm::at_element_2(int32_t x, int32_t y, int32_t element) const noexcept {
+template <typename Storage>
+float2 Byte1_unorm<Storage>::at_element_2(int32_t x, int32_t y, int32_t element) const noexcept {
     uint8_t value = image_.load_element(x, y, element);
     return float2(encoding::cached_unorm_to_float(value), 0.f);
 }
 
-float3 Byte1_unorm::at_element_3(int32_t x, int32_t y, int32_t element) const noexcept {
+template <typename Storage>
+float3 Byte1_unorm<Storage>::at_element_3(int32_t x, int32_t y, int32_t element) const noexcept {
     uint8_t value = image_.load_element(x, y, element);
     return float3(encoding::cached_unorm_to_float(value), 0.f, 0.f);
 }
 
-float Byte1_unorm::at_1(int32_t x, int32_t y, int32_t z) const noexcept {
+template <typename Storage>
+float Byte1_unorm<Storage>::at_1(int32_t x, int32_t y, int32_t z) const noexcept {
     uint8_t value = image_.load(x, y, z);
     return encoding::cached_unorm_to_float(value);
 }
 
-float2 Byte1_unorm::at_2(int32_t x, int32_t y, int32_t z) const noexcept {
+template <typename Storage>
+float2 Byte1_unorm<Storage>::at_2(int32_t x, int32_t y, int32_t z) const noexcept {
     uint8_t value = image_.load(x, y, z);
     return float2(encoding::cached_unorm_to_float(value), 0.f);
 }
 
-float3 Byte1_unorm::at_3(int32_t x, int32_t y, int32_t z) const noexcept {
+template <typename Storage>
+float3 Byte1_unorm<Storage>::at_3(int32_t x, int32_t y, int32_t z) const noexcept {
     uint8_t value = image_.load(x, y, z);
     return float3(encoding::cached_unorm_to_float(value), 0.f, 0.f);
 }
 
+template class Byte1_unorm<Byte1>;
+template class Byte1_unorm<Paged_image<uint8_t>>;
+template class Byte1_unorm<Tiled_image<uint8_t>>;
+template class Byte1_unorm<Compressed_image<bc::BC4>>;
+
 }  // namespace image::texture
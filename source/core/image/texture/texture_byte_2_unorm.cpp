@@ -1,42 +1,52 @@
 #include "texture_byte_2_unorm.hpp"
 #include "base/math/vector4.inl"
+#include "image/compressed_image.inl"
+#include "image/paged_image.inl"
+#include "image/tiled_image.inl"
 #include "image/typed_image.inl"
 #include "texture_encoding.hpp"
 
 namespace image::texture {
 
-Byte2_unorm::Byte2_unorm(std::shared_ptr<Image> image) noexcept
-    : Texture(image), image_(*static_cast<const Byte2*>(image.get())) {}
+template <typename Storage>
+Byte2_unorm<Storage>::Byte2_unorm(std::shared_ptr<Image> image) noexcept
+    : Texture(image), image_(*static_cast<Storage const*>(image.get())) {}
 
-float Byte2_unorm::at_1(int32_t i) const noexcept {
+template <typename Storage>
+float Byte2_unorm<Storage>::at_1(int32_t i) const noexcept {
     auto value = image_.load(i);
     return encoding::cached_unorm_to_float(value[0]);
 }
 
-float3 Byte2_unorm::at_3(int32_t i) const noexcept {
+template <typename Storage>
+float3 Byte2_unorm<Storage>::at_3(int32_t i) const noexcept {
     auto value = image_.load(i);
     return float3(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]), 0.f);
 }
 
-float Byte2_unorm::at_1(int32_t x, int32_t y) const noexcept {
+template <typename Storage>
+float Byte2_unorm<Storage>::at_1(int32_t x, int32_t y) const noexcept {
     auto value = image_.load(x, y);
     return encoding::cached_unorm_to_float(value[0]);
 }
 
-float2 Byte2_unorm::at_2(int32_t x, int32_t y) const noexcept {
+template <typename Storage>
+float2 Byte2_unorm<Storage>::at_2(int32_t x, int32_t y) const noexcept {
     auto value = image_.load(x, y);
     return float2(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]));
 }
 
-float3 Byte2_unorm::at_3(int32_t x, int32_t y) const noexcept {
+template <typename Storage>
+float3 Byte2_unorm<Storage>::at_3(int32_t x, int32_t y) const noexcept {
     auto value = image_.load(x, y);
     return float3(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]), 0.f);
 }
 
-void Byte2_unorm::gather_1(int4 const& xy_xy1, float c[4]) const noexcept {
+template <typename Storage>
+void Byte2_unorm<Storage>::gather_1(int4 const& xy_xy1, float c[4]) const noexcept {
     byte2 v[4];
     image_.gather(xy_xy1, v);
 
@@ -46,14 +56,31 @@ void Byte2_unorm::gather_1(int4 const& xy_xy1, float c[4]) const noexcept {
     c[3] = encoding::cached_unorm_to_float(v[3][0]);
 }
 
-void Byte2_unorm::gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept {
+template <typename Storage>
+void Byte2_unorm<Storage>::gather_1(int3 const& xyz, int3 const& xyz1, float c[8]) const noexcept {
+    byte2 v[8];
+    image_.gather(xyz, xyz1, v);
+
+    c[0] = encoding::cached_unorm_to_float(v[0][0]);
+    c[1] = encoding::cached_unorm_to_float(v[1][0]);
+    c[2] = encoding::cached_unorm_to_float(v[2][0]);
+    c[3] = encoding::cached_unorm_to_float(v[3][0]);
+    c[4] = encoding::cached_unorm_to_float(v[4][0]);
+    c[5] = encoding::cached_unorm_to_float(v[5][0]);
+    c[6] = encoding::cached_unorm_to_float(v[6][0]);
+    c[7] = encoding::cached_unorm_to_float(v[7][0]);
+}
+
+template <typename Storage>
+void Byte2_unorm<Storage>::gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept {
     byte2 v[4];
     image_.gather(xy_xy1, v);
 
     encoding::cached_unorm_to_float(v, c);
 }
 
-void Byte2_unorm::gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept {
+template <typename Storage>
+void Byte2_unorm<Storage>::gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept {
     byte2 v[4];
     image_.gather(xy_xy1, v);
 
@@ -70,38 +97,49 @@ void Byte2_unorm::gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept {
                   encoding::cached_unorm_to_float(v[3][1]), 0.f);
 }
 
-float Byte2_unorm::at_element_1(int32_t x, int32_t y, int32_t element) const noexcept {
+template <typename Storage>
+float Byte2_unorm<Storage>::at_element_1(int32_t x, int32_t y, int32_t element) const noexcept {
     auto value = image_.load_element(x, y, element);
     return encoding::cached_unorm_to_float(value[0]);
 }
 
-float2 Byte2_unorm::at_element_2(int32_t x, int32_t y, int32_t element) const noexcept {
+template <typename Storage>
+float2 Byte2_unorm<Storage>::at_element_2(int32_t x, int32_t y, int32_t element) const noexcept {
     auto value = image_.load_element(x, y, element);
     return float2(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]));
 }
 
-float3 Byte2_unorm::at_element_3(int32_t x, int32_t y, int32_t element) const noexcept {
+template <typename Storage>
+float3 Byte2_unorm<Storage>::at_element_3(int32_t x, int32_t y, int32_t element) const noexcept {
     auto value = image_.load_element(x, y, element);
     return float3(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]), 0.f);
 }
 
-float Byte2_unorm::at_1(int32_t x, int32_t y, int32_t z) const noexcept {
+template <typename Storage>
+float Byte2_unorm<Storage>::at_1(int32_t x, int32_t y, int32_t z) const noexcept {
     auto value = image_.load(x, y, z);
     return encoding::cached_unorm_to_float(value[0]);
 }
 
-float2 Byte2_unorm::at_2(int32_t x, int32_t y, int32_t z) const noexcept {
+template <typename Storage>
+float2 Byte2_unorm<Storage>::at_2(int32_t x, int32_t y, int32_t z) const noexcept {
     auto value = image_.load(x, y, z);
     return float2(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]));
 }
 
-float3 Byte2_unorm::at_3(int32_t x, int32_t y, int32_t z) const noexcept {
+template <typename Storage>
+float3 Byte2_unorm<Storage>::at_3(int32_t x, int32_t y, int32_t z) const noexcept {
     auto value = image_.load(x, y, z);
     return float3(encoding::cached_unorm_to_float(value[0]),
                   encoding::cached_unorm_to_float(value[1]), 0.f);
 }
 
+template class Byte2_unorm<Byte2>;
+template class Byte2_unorm<Paged_image<byte2>>;
+template class Byte2_unorm<Tiled_image<byte2>>;
+template class Byte2_unorm<Compressed_image<bc::BC5>>;
+
 }  // namespace image::texture
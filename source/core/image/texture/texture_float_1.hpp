@@ -1,11 +1,11 @@
 #ifndef SU_CORE_IMAGE_TEXTURE_FLOAT1_HPP
 #define SU_CORE_IMAGE_TEXTURE_FLOAT1_HPP
 
-#include "image/typed_image_fwd.hpp"
 #include "texture.hpp"
 
 namespace image::texture {
 
+template <typename Storage>
 class Float1 final : public Texture {
   public:
     Float1(std::shared_ptr<Image> const& image) noexcept;
@@ -21,6 +21,8 @@ class Float1 final : public Texture {
     void gather_2(int4 const& xy_xy1, float2 c[4]) const noexcept override final;
     void gather_3(int4 const& xy_xy1, float3 c[4]) const noexcept override final;
 
+    void gather_1(int3 const& xyz, int3 const& xyz1, float c[8]) const noexcept override final;
+
     float  at_element_1(int32_t x, int32_t y, int32_t element) const noexcept override final;
     float2 at_element_2(int32_t x, int32_t y, int32_t element) const noexcept override final;
     float3 at_element_3(int32_t x, int32_t y, int32_t element) const noexcept override final;
@@ -30,7 +32,7 @@ class Float1 final : public Texture {
     float3 at_3(int32_t x, int32_t y, int32_t z) const noexcept override final;
 
   private:
-    image::Float1 const& image_;
+    Storage const& image_;
 };
 
 }  // namespace image::texture
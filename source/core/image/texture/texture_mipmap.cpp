@@ -0,0 +1,90 @@
+#include "texture_mipmap.hpp"
+#include <algorithm>
+#include "base/encoding/encoding.inl"
+#include "base/math/vector4.inl"
+#include "base/spectrum/rgb.hpp"
+#include "image/typed_image.inl"
+#include "texture_encoding.hpp"
+
+namespace image::texture {
+
+static inline float decode(uint8_t c, bool sRGB) noexcept {
+    return sRGB ? encoding::cached_srgb_to_float(c) : static_cast<float>(c);
+}
+
+static inline float decode(float c, bool /*sRGB*/) noexcept {
+    return c;
+}
+
+static inline void encode(float v, bool sRGB, uint8_t& c) noexcept {
+    c = sRGB ? ::encoding::float_to_unorm(spectrum::linear_to_sRGB(v))
+             : static_cast<uint8_t>(v + 0.5f);
+}
+
+static inline void encode(float v, bool /*sRGB*/, float& c) noexcept {
+    c = v;
+}
+
+// T consists of N components of type C
+template <typename T, typename C, int32_t N>
+static std::shared_ptr<Image> create_mip_level(Image const& image, bool sRGB) noexcept {
+    static_assert(sizeof(T) == N * sizeof(C));
+
+    auto const& source = static_cast<Typed_image<T> const&>(image);
+
+    int2 const sd = source.dimensions2();
+    int2 const td = math::max(sd / 2, int2(1));
+
+    auto target = std::make_shared<Typed_image<T>>(
+        Image::Description(source.description().type, td));
+
+    C const* s = reinterpret_cast<C const*>(source.data());
+    C*       t = reinterpret_cast<C*>(target->data());
+
+    for (int32_t y = 0; y < td[1]; ++y) {
+        int32_t const y0 = std::min(2 * y, sd[1] - 1);
+        int32_t const y1 = std::min(2 * y + 1, sd[1] - 1);
+
+        for (int32_t x = 0; x < td[0]; ++x) {
+            int32_t const x0 = std::min(2 * x, sd[0] - 1);
+            int32_t const x1 = std::min(2 * x + 1, sd[0] - 1);
+
+            int32_t const i00 = (y0 * sd[0] + x0) * N;
+            int32_t const i01 = (y0 * sd[0] + x1) * N;
+            int32_t const i10 = (y1 * sd[0] + x0) * N;
+            int32_t const i11 = (y1 * sd[0] + x1) * N;
+
+            int32_t const o = (y * td[0] + x) * N;
+
+            for (int32_t c = 0; c < N; ++c) {
+                float const v = 0.25f * (decode(s[i00 + c], sRGB) + decode(s[i01 + c], sRGB) +
+                                         decode(s[i10 + c], sRGB) + decode(s[i11 + c], sRGB));
+
+                encode(v, sRGB, t[o + c]);
+            }
+        }
+    }
+
+    return target;
+}
+
+std::shared_ptr<Image> create_mip_level(Image const& image, bool sRGB) noexcept {
+    switch (image.description().type) {
+        case Image::Type::Byte1:
+            return create_mip_level<uint8_t, uint8_t, 1>(image, false);
+        case Image::Type::Byte2:
+            return create_mip_level<byte2, uint8_t, 2>(image, false);
+        case Image::Type::Byte3:
+            return create_mip_level<byte3, uint8_t, 3>(image, sRGB);
+        case Image::Type::Float1:
+            return create_mip_level<float, float, 1>(image, false);
+        case Image::Type::Float2:
+            return create_mip_level<float2, float, 2>(image, false);
+        case Image::Type::Float3:
+            return create_mip_level<packed_float3, float, 3>(image, false);
+        default:
+            return nullptr;
+    }
+}
+
+}  // namespace image::texture
@@ -0,0 +1,19 @@
+#ifndef SU_CORE_IMAGE_TEXTURE_MIPMAP_HPP
+#define SU_CORE_IMAGE_TEXTURE_MIPMAP_HPP
+
+#include <memory>
+
+namespace image {
+
+class Image;
+
+namespace texture {
+
+// Returns the next level of the mip chain of a 2D image, with half the dimensions rounded down.
+// The texels are averaged with a box filter, in linear space for sRGB images.
+std::shared_ptr<Image> create_mip_level(Image const& image, bool sRGB) noexcept;
+
+}  // namespace texture
+}  // namespace image
+
+#endif
@@ -1,8 +1,15 @@
 #include "texture_provider.hpp"
+#include <stdexcept>
 #include "base/math/vector4.inl"
 #include "base/memory/variant_map.inl"
+#include "base/thread/thread_pool.hpp"
+#include "image/compressed_image.inl"
 #include "image/image.hpp"
 #include "image/image_provider.hpp"
+#include "image/paged_image.inl"
+#include "image/tiled_image.inl"
+#include "image/tile_cache.hpp"
+#include "image/typed_image.inl"
 #include "logging/logging.hpp"
 #include "resource/resource_manager.inl"
 #include "resource/resource_provider.inl"
@@ -15,42 +22,163 @@
 #include "texture_encoding.hpp"
 #include "texture_float_1.hpp"
 #include "texture_float_3.hpp"
+#include "texture_mipmap.hpp"
 
 #include "base/debug/assert.hpp"
 #include "texture_test.hpp"
 
+#include <type_traits>
+
 namespace image::texture {
 
-Provider::Provider() noexcept : resource::Provider<Texture>("Texture") {
+Provider::Provider(size_t tile_cache_budget, bool compress, bool tiled) noexcept
+    : resource::Provider<Texture>("Texture"), compress_(compress), tiled_(tiled) {
     encoding::init();
+
+    if (tile_cache_budget > 0) {
+        tile_cache_ = std::make_shared<Tile_cache>(tile_cache_budget);
+    }
+}
+
+Provider::~Provider() noexcept {}
+
+// The block compression codec of every texture type that supports one
+template <template <typename> class T>
+struct Codec {
+    using type = void;
+};
+
+template <>
+struct Codec<Byte1_unorm> {
+    using type = bc::BC4;
+};
+
+template <>
+struct Codec<Byte2_snorm> {
+    using type = bc::BC5;
+};
+
+template <>
+struct Codec<Byte2_unorm> {
+    using type = bc::BC5;
+};
+
+template <>
+struct Codec<Byte3_snorm> {
+    using type = bc::BC5_normal;
+};
+
+template <>
+struct Codec<Byte3_sRGB> {
+    using type = bc::BC1;
+};
+
+template <>
+struct Codec<Float3> {
+    using type = bc::HDR;
+};
+
+template <template <typename> class T, typename Texel>
+static std::shared_ptr<Texture> create_level(std::shared_ptr<Image> const&      image,
+                                             std::shared_ptr<Tile_cache> const& cache,
+                                             bool compress, bool tiled,
+                                             thread::Pool& pool) noexcept {
+    auto const& typed = static_cast<Typed_image<Texel> const&>(*image);
+
+    if constexpr (!std::is_void_v<typename Codec<T>::type>) {
+        if (compress) {
+            using Compressed = Compressed_image<typename Codec<T>::type>;
+
+            return std::make_shared<T<Compressed>>(std::make_shared<Compressed>(typed, pool));
+        }
+    }
+
+    // Memory mapped images are already paged in by the operating system
+    if (cache && typed.owns_data()) {
+        auto paged = std::make_shared<Paged_image<Texel>>(typed, cache);
+
+        if (paged->is_valid()) {
+            return std::make_shared<T<Paged_image<Texel>>>(paged);
+        }
+
+        logging::warning("Could not page out texture: Keeping it in memory.");
+    }
+
+    if (tiled) {
+        return std::make_shared<T<Tiled_image<Texel>>>(std::make_shared<Tiled_image<Texel>>(typed));
+    }
+
+    return std::make_shared<T<Typed_image<Texel>>>(image);
+}
+
+// Every level of the mip chain is a texture of the same type as the original
+template <template <typename> class T, typename Texel>
+static std::shared_ptr<Texture> create(std::shared_ptr<Image>             image,
+                                       std::shared_ptr<Tile_cache> const& cache, bool compress,
+                                       bool tiled, bool mip_maps, thread::Pool& pool,
+                                       bool sRGB = false) noexcept {
+    auto texture = create_level<T, Texel>(image, cache, compress, tiled, pool);
+
+    Image::Description const description = image->description();
+
+    if (!image->averages().empty()) {
+        texture->set_averages(image->averages());
+    }
+
+    // Levels that were stored together with the image are used as they are,
+    // otherwise they are only created for samplers that use them.
+    // Texture arrays and volumes are not mip mapped.
+    if (!image->levels().empty()) {
+        std::vector<std::shared_ptr<Texture>> levels;
+        levels.reserve(image->levels().size());
+
+        for (auto const& level : image->levels()) {
+            levels.push_back(create_level<T, Texel>(level, cache, compress, tiled, pool));
+        }
+
+        texture->set_levels(std::move(levels));
+    } else if (mip_maps && 1 == description.num_elements && 1 == description.dimensions[2]) {
+        std::vector<std::shared_ptr<Texture>> levels;
+
+        // Paged levels release their texels as soon as the next level is derived from them,
+        // so that at most two levels are in memory at once
+        for (auto level = std::move(image);;) {
+            int2 const d = level->dimensions2();
+            if (1 == d[0] && 1 == d[1]) {
+                break;
+            }
+
+            level = create_mip_level(*level, sRGB);
+            if (!level) {
+                break;
+            }
+
+            levels.push_back(create_level<T, Texel>(level, cache, compress, tiled, pool));
+        }
+
+        texture->set_levels(std::move(levels));
+    }
+
+    return texture;
 }
 
 std::shared_ptr<Texture> Provider::load(std::string const&         filename,
                                         memory::Variant_map const& options,
                                         resource::Manager&         manager) {
-    Channels channels = Channels::XYZ;
-
     Usage usage = Usage::Undefined;
     options.query("usage", usage);
 
-    bool invert = false;
-
-    if (Usage::Mask == usage) {
-        channels = Channels::W;
-    } else if (Usage::Anisotropy == usage) {
-        channels = Channels::XY;
-    } else if (Usage::Surface == usage) {
-        channels = Channels::XY;
-    } else if (Usage::Roughness == usage) {
-        channels = Channels::X;
-    } else if (Usage::Specularity == usage) {
-        channels = Channels::X;
-        invert   = true;
-    }
+    Channels const channels = Provider::channels(usage);
+
+    bool const invert = Usage::Specularity == usage;
+
+    bool mip_maps = false;
+    options.query("mip_maps", mip_maps);
 
     memory::Variant_map image_options;
     image_options.set("channels", channels);
     image_options.inherit_except(options, "usage");
+    image_options.erase("mip_maps");
 
     if (invert) {
         image_options.set("invert", invert);
@@ -63,28 +191,54 @@ std::shared_ptr<Texture> Provider::load(std::string const&         filename,
             return nullptr;
         }
 
+        // The usage of a container determined its texel type, channels and sRGB handling of mips.
+        // Textures without a usage are loaded as colors.
+        if (Usage const stored = static_cast<Usage>(image->stored_usage());
+            Usage::Undefined != stored) {
+            Usage const expected = Usage::Undefined == usage ? Usage::Color : usage;
+
+            if (expected != stored || channels != image->stored_channels()) {
+                throw std::runtime_error("Container was converted for a different usage");
+            }
+        }
+
+        if (tile_cache_ || compress_ || tiled_) {
+            // Only the paged, compressed or tiled copy of the texels is kept around
+            manager.erase<Image>(filename, image_options);
+        }
+
+        thread::Pool& pool = manager.thread_pool();
+
         if (Image::Type::Byte1 == image->description().type) {
-            return std::make_shared<Byte1_unorm>(image);
+            return create<Byte1_unorm, uint8_t>(std::move(image), tile_cache_, compress_, tiled_,
+                                                mip_maps, pool);
         } else if (Image::Type::Byte2 == image->description().type) {
             if (Usage::Anisotropy == usage) {
-                return std::make_shared<Byte2_snorm>(image);
+                return create<Byte2_snorm, byte2>(std::move(image), tile_cache_, compress_, tiled_,
+                                                  mip_maps, pool);
             } else {
-                return std::make_shared<Byte2_unorm>(image);
+                return create<Byte2_unorm, byte2>(std::move(image), tile_cache_, compress_, tiled_,
+                                                  mip_maps, pool);
             }
         } else if (Image::Type::Byte3 == image->description().type) {
             if (Usage::Normal == usage) {
                 SOFT_ASSERT(testing::is_valid_normal_map(*image.get(), filename));
 
-                return std::make_shared<Byte3_snorm>(image);
+                return create<Byte3_snorm, byte3>(std::move(image), tile_cache_, compress_, tiled_,
+                                                  mip_maps, pool);
             } else if (Usage::Surface == usage) {
-                return std::make_shared<Byte3_unorm>(image);
+                return create<Byte3_unorm, byte3>(std::move(image), tile_cache_, compress_, tiled_,
+                                                  mip_maps, pool);
             } else {
-                return std::make_shared<Byte3_sRGB>(image);
+                return create<Byte3_sRGB, byte3>(std::move(image), tile_cache_, compress_, tiled_,
+                                                 mip_maps, pool, true);
             }
         } else if (Image::Type::Float1 == image->description().type) {
-            return std::make_shared<Float1>(image);
+            return create<Float1, float>(std::move(image), tile_cache_, compress_, tiled_,
+                                         mip_maps, pool);
         } else if (Image::Type::Float3 == image->description().type) {
-            return std::make_shared<Float3>(image);
+            return create<Float3, packed_float3>(std::move(image), tile_cache_, compress_, tiled_,
+                                                 mip_maps, pool);
         }
     } catch (const std::exception& e) {
         logging::error("Loading texture \"" + filename + "\": " + e.what() + ".");
@@ -100,7 +254,22 @@ std::shared_ptr<Texture> Provider::load(void const* /*data*/, std::string_view /
 }
 
 size_t Provider::num_bytes() const noexcept {
-    return sizeof(*this);
+    return sizeof(*this) + (tile_cache_ ? tile_cache_->num_bytes() : 0);
+}
+
+Channels Provider::channels(Usage usage) noexcept {
+    switch (usage) {
+        case Usage::Mask:
+            return Channels::W;
+        case Usage::Anisotropy:
+        case Usage::Surface:
+            return Channels::XY;
+        case Usage::Roughness:
+        case Usage::Specularity:
+            return Channels::X;
+        default:
+            return Channels::XYZ;
+    }
 }
 
 }  // namespace image::texture
@@ -1,11 +1,13 @@
 #ifndef SU_CORE_IMAGE_TEXTURE_PROVIDER_HPP
 #define SU_CORE_IMAGE_TEXTURE_PROVIDER_HPP
 
+#include "image/channels.hpp"
 #include "resource/resource_provider.hpp"
 
 namespace image {
 
 class Image;
+class Tile_cache;
 
 namespace texture {
 
@@ -13,7 +15,14 @@ class Texture;
 
 class Provider final : public resource::Provider<Texture> {
   public:
-    Provider() noexcept;
+    // With a budget of 0 all textures are kept in memory,
+    // otherwise their texels are paged in from disk as needed.
+    // Compressed textures are always kept in memory, but take 4 to 8 times less space.
+    // Tiled textures store their texels in small bricks,
+    // so that filtering touches fewer cache lines.
+    Provider(size_t tile_cache_budget, bool compress, bool tiled) noexcept;
+
+    ~Provider() noexcept override final;
 
     enum class Usage {
         Undefined,
@@ -26,6 +35,10 @@ class Provider final : public resource::Provider<Texture> {
         Mask
     };
 
+    // Channels of the image that a texture of the usage is made of
+    static Channels channels(Usage usage) noexcept;
+
+    // The option "mip_maps" creates the mip chain of 2D textures that were stored without one
     std::shared_ptr<Texture> load(std::string const& filename, memory::Variant_map const& options,
                                   resource::Manager& manager) override final;
 
@@ -34,6 +47,12 @@ class Provider final : public resource::Provider<Texture> {
                                   resource::Manager&         manager) override final;
 
     size_t num_bytes() const noexcept override final;
+
+  private:
+    std::shared_ptr<Tile_cache> tile_cache_;
+
+    bool compress_;
+    bool tiled_;
 };
 
 }  // namespace texture
@@ -0,0 +1,151 @@
+#include "tile_cache.hpp"
+#include <cstring>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace image {
+
+static std::atomic<uint32_t> Next_source_id = 1;
+
+static uint32_t constexpr Num_lookaside = 64;
+
+struct Lookaside {
+    uint64_t key = 0;
+
+    std::shared_ptr<uint8_t[]> tile;
+};
+
+static thread_local Lookaside lookaside[Num_lookaside];
+
+static inline uint32_t lookaside_slot(uint64_t key) noexcept {
+    return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 58);
+}
+
+Tile_cache::Source::Source(Tile_cache& cache, uint32_t num_tiles, uint32_t tile_bytes) noexcept
+    : cache_(cache),
+      id_(Next_source_id++),
+      tile_bytes_(tile_bytes),
+      offset_(cache.file_size_.fetch_add(static_cast<uint64_t>(num_tiles) * tile_bytes)),
+      valid_(nullptr != cache.file_) {}
+
+bool Tile_cache::Source::is_valid() const noexcept {
+    return valid_;
+}
+
+void Tile_cache::Source::write(uint32_t tile, void const* data) noexcept {
+    if (valid_ && !cache_.write(offset(tile), tile_bytes_, data)) {
+        valid_ = false;
+    }
+}
+
+uint64_t Tile_cache::Source::offset(uint32_t tile) const noexcept {
+    return offset_ + static_cast<uint64_t>(tile) * static_cast<uint64_t>(tile_bytes_);
+}
+
+Tile_cache::Tile_cache(size_t max_bytes) noexcept
+    : max_bytes_(max_bytes),
+      file_(std::tmpfile()),
+      file_size_(0),
+      num_bytes_(std::make_shared<std::atomic<size_t>>(0)) {}
+
+Tile_cache::~Tile_cache() noexcept {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+void const* Tile_cache::tile(Source const& source, uint32_t index) noexcept {
+    uint64_t const key = (static_cast<uint64_t>(source.id_) << 32) | index;
+
+    Lookaside& slot = lookaside[lookaside_slot(key)];
+
+    if (key == slot.key) {
+        return slot.tile.get();
+    }
+
+    Tile tile;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (auto const entry = tiles_.find(key); tiles_.end() != entry) {
+            lru_.splice(lru_.begin(), lru_, entry->second.lru);
+            tile = entry->second.tile;
+        }
+    }
+
+    if (!tile) {
+        // The tile is read without holding the lock, so that other threads can continue
+        uint32_t const num_bytes = source.tile_bytes_;
+
+        *num_bytes_ += num_bytes;
+
+        tile = Tile(new uint8_t[num_bytes],
+                    [num_bytes, counter = num_bytes_](uint8_t* data) noexcept {
+                        delete[] data;
+                        *counter -= num_bytes;
+                    });
+
+        if (!read(source.offset(index), num_bytes, tile.get())) {
+            std::memset(tile.get(), 0, num_bytes);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (auto [entry, inserted] = tiles_.try_emplace(key); inserted) {
+            lru_.push_front(key);
+            entry->second = Entry{tile, lru_.begin()};
+
+            // The tile that was just loaded is never evicted.
+            // Evicting a tile that a lookaside table still holds frees nothing yet,
+            // so more tiles are evicted in that case.
+            while (*num_bytes_ > max_bytes_ && lru_.size() > 1) {
+                tiles_.erase(lru_.back());
+                lru_.pop_back();
+            }
+        } else {
+            // Another thread loaded the same tile in the meantime
+            lru_.splice(lru_.begin(), lru_, entry->second.lru);
+            tile = entry->second.tile;
+        }
+    }
+
+    slot.key  = key;
+    slot.tile = std::move(tile);
+
+    return slot.tile.get();
+}
+
+size_t Tile_cache::num_bytes() const noexcept {
+    return *num_bytes_;
+}
+
+// Positional I/O, which needs no lock, and 64 bit offsets,
+// because the tiles of large images easily exceed the 2 GB of a long on Windows
+bool Tile_cache::read(uint64_t offset, uint32_t num_bytes, void* data) const noexcept {
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(file_mutex_);
+
+    return 0 == _fseeki64(file_, static_cast<__int64>(offset), SEEK_SET) &&
+           num_bytes == std::fread(data, 1, num_bytes, file_);
+#else
+    return static_cast<ssize_t>(num_bytes) ==
+           pread(fileno(file_), data, num_bytes, static_cast<off_t>(offset));
+#endif
+}
+
+bool Tile_cache::write(uint64_t offset, uint32_t num_bytes, void const* data) noexcept {
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(file_mutex_);
+
+    return 0 == _fseeki64(file_, static_cast<__int64>(offset), SEEK_SET) &&
+           num_bytes == std::fwrite(data, 1, num_bytes, file_);
+#else
+    return static_cast<ssize_t>(num_bytes) ==
+           pwrite(fileno(file_), data, num_bytes, static_cast<off_t>(offset));
+#endif
+}
+
+}  // namespace image
@@ -0,0 +1,100 @@
+#ifndef SU_CORE_IMAGE_TILE_CACHE_HPP
+#define SU_CORE_IMAGE_TILE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace image {
+
+// Tiles of images that are kept on disk and only loaded on first access.
+// All images share one temporary file, in which every image has its own range.
+// The resident tiles are shared by all images and evicted in LRU order,
+// once their memory exceeds the budget.
+// Every thread additionally holds on to the last few tiles it used in a small lookaside table,
+// so that most lookups neither take the lock nor touch the shared reference counts.
+// Evicted tiles that are still held by these tables count toward the budget until released.
+// They cannot be released by the cache, so the budget can still be exceeded by at most
+// the size of the lookaside tables, if it is smaller than that.
+class Tile_cache {
+  public:
+    // The tiles of one image. Their range of the file is not reused after the image is gone.
+    class Source {
+      public:
+        Source(Tile_cache& cache, uint32_t num_tiles, uint32_t tile_bytes) noexcept;
+
+        bool is_valid() const noexcept;
+
+        void write(uint32_t tile, void const* data) noexcept;
+
+      private:
+        uint64_t offset(uint32_t tile) const noexcept;
+
+        Tile_cache& cache_;
+
+        // Never reused, so that the lookaside tables cannot confuse tiles of different images
+        uint32_t const id_;
+
+        uint32_t const tile_bytes_;
+
+        uint64_t const offset_;
+
+        bool valid_;
+
+        friend Tile_cache;
+    };
+
+    Tile_cache(size_t max_bytes) noexcept;
+
+    ~Tile_cache() noexcept;
+
+    // The returned data stays valid until the calling thread requests the next tile
+    void const* tile(Source const& source, uint32_t index) noexcept;
+
+    size_t num_bytes() const noexcept;
+
+  private:
+    using Tile = std::shared_ptr<uint8_t[]>;
+
+    bool read(uint64_t offset, uint32_t num_bytes, void* data) const noexcept;
+
+    bool write(uint64_t offset, uint32_t num_bytes, void const* data) noexcept;
+
+    struct Entry {
+        Tile tile;
+
+        std::list<uint64_t>::iterator lru;
+    };
+
+    size_t const max_bytes_;
+
+    std::FILE* file_;
+
+    // The ranges of the file that were handed out to sources
+    std::atomic<uint64_t> file_size_;
+
+#ifdef _WIN32
+    // There is no positional I/O for std::FILE, so seeking and reading must not be interleaved
+    mutable std::mutex file_mutex_;
+#endif
+
+    // Bytes of all tiles that are alive, shared with their deleters,
+    // because the lookaside tables can release tiles after the cache is gone
+    std::shared_ptr<std::atomic<size_t>> num_bytes_;
+
+    std::unordered_map<uint64_t, Entry> tiles_;
+
+    // Most recently used in front
+    std::list<uint64_t> lru_;
+
+    mutable std::mutex mutex_;
+};
+
+}  // namespace image
+
+#endif
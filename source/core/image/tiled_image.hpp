@@ -1,24 +1,60 @@
-#pragma once
+#ifndef SU_CORE_IMAGE_TILED_IMAGE_HPP
+#define SU_CORE_IMAGE_TILED_IMAGE_HPP
 
-#include "base/memory/tiled_array.hpp"
-#include "base/spectrum/rgb.hpp"
+#include "base/math/vector.hpp"
 #include "image.hpp"
 
 namespace image {
 
-template <typename T, uint32_t Log_tile_size>
-class Tiled_image : public Image {
+template <typename T>
+class Typed_image;
+
+// Read-only counterpart of Typed_image, whose texels are stored in bricks of 8x8,
+// or 8x8x8 for volumes, and in Z-order inside of every brick.
+// Most bilinear and trilinear footprints are thereby inside of one brick,
+// and often inside of one cache line.
+// Layers and elements are stacked vertically, the same way as in Typed_image.
+template <typename T>
+class Tiled_image final : public Image {
   public:
-    Tiled_image(const Image::Description& description);
-    ~Tiled_image();
+    static int32_t constexpr Log_brick_size = 3;
+    static int32_t constexpr Brick_size     = 1 << Log_brick_size;
+
+    Tiled_image(Typed_image<T> const& source) noexcept;
+
+    ~Tiled_image() noexcept override final;
+
+    T load(int32_t index) const noexcept;
+
+    T load(int32_t x, int32_t y) const noexcept;
+
+    T load_element(int32_t x, int32_t y, int32_t element) const noexcept;
+
+    T load(int32_t x, int32_t y, int32_t z) const noexcept;
+
+    void gather(int4 const& xy_xy1, T c[4]) const noexcept;
+
+    void gather(int3 const& xyz, int3 const& xyz1, T c[8]) const noexcept;
 
-    T const& at(uint32_t x, uint32_t y) const;
-    T&       at(uint32_t x, uint32_t y);
+    size_t num_bytes() const noexcept override final;
 
   private:
-    memory::Tiled_array<T, Log_tile_size> data_;
-};
+    int32_t index(int32_t x, int32_t y, int32_t z) const noexcept;
+
+    int32_t brick(int32_t x, int32_t y, int32_t z) const noexcept;
+
+    int32_t texel(int32_t x, int32_t y, int32_t z) const noexcept;
+
+    int3 num_bricks_;
 
-// using Byte3 = Tiled_image<spectrum::Color3c, 1> Byte3;
+    // Volumes are split into bricks along z as well, layers and elements are not
+    bool volume_;
+
+    int32_t log_brick_volume_;
+
+    T* data_;
+};
 
 }  // namespace image
+
+#endif
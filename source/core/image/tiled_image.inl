@@ -1,25 +1,185 @@
-#pragma once
+#ifndef SU_CORE_IMAGE_TILED_IMAGE_INL
+#define SU_CORE_IMAGE_TILED_IMAGE_INL
 
-#include "base/memory/tiled_array.inl"
+#include <algorithm>
+#include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
 #include "tiled_image.hpp"
+#include "typed_image.inl"
 
 namespace image {
 
-template <typename T, uint32_t Log_tile_size>
-Tiled_image<T, Log_tile_size>::Tiled_image(const Image::Description& description)
-    : Image(description), data_(description.dimensions[0], description.dimensions[1]) {}
+// The bits of a coordinate inside of a brick, spread out for interleaving
+static int32_t constexpr Morton_2[8] = {0, 1, 4, 5, 16, 17, 20, 21};
+static int32_t constexpr Morton_3[8] = {0, 1, 8, 9, 64, 65, 72, 73};
 
-template <typename T, uint32_t Log_tile_size>
-Tiled_image<T, Log_tile_size>::~Tiled_image() {}
+template <typename T>
+Tiled_image<T>::Tiled_image(Typed_image<T> const& source) noexcept
+    : Image(source.description()), volume_(description_.dimensions[2] > 1) {
+    int3 const d = description_.dimensions;
 
-template <typename T, uint32_t Log_tile_size>
-T const& Tiled_image<T, Log_tile_size>::at(uint32_t x, uint32_t y) const {
-    return data_.at(x, y);
+    int32_t const width  = d[0];
+    int32_t const height = volume_ ? d[1] : d[1] * d[2] * description_.num_elements;
+    int32_t const depth  = volume_ ? d[2] : 1;
+
+    num_bricks_ = int3((width + Brick_size - 1) >> Log_brick_size,
+                       (height + Brick_size - 1) >> Log_brick_size,
+                       (depth + Brick_size - 1) >> Log_brick_size);
+
+    log_brick_volume_ = (volume_ ? 3 : 2) * Log_brick_size;
+
+    data_ = memory::allocate_aligned<T>(static_cast<size_t>(num_bricks_[0] * num_bricks_[1] *
+                                                            num_bricks_[2])
+                                        << log_brick_volume_);
+
+    int32_t const end_z = volume_ ? num_bricks_[2] << Log_brick_size : 1;
+    int32_t const end_y = num_bricks_[1] << Log_brick_size;
+    int32_t const end_x = num_bricks_[0] << Log_brick_size;
+
+    // Texels outside of the image are padded with the closest edge texel
+    for (int32_t z = 0; z < end_z; ++z) {
+        int32_t const sz = std::min(z, depth - 1);
+
+        for (int32_t y = 0; y < end_y; ++y) {
+            int32_t const sy = std::min(y, height - 1);
+
+            for (int32_t x = 0; x < end_x; ++x) {
+                int32_t const sx = std::min(x, width - 1);
+
+                data_[index(x, y, z)] = source.load((sz * height + sy) * width + sx);
+            }
+        }
+    }
 }
 
-template <typename T, uint32_t Log_tile_size>
-T& Tiled_image<T, Log_tile_size>::at(uint32_t x, uint32_t y) {
-    return data_.at(x, y);
+template <typename T>
+Tiled_image<T>::~Tiled_image() noexcept {
+    memory::free_aligned(data_);
+}
+
+template <typename T>
+T Tiled_image<T>::load(int32_t index) const noexcept {
+    int32_t const width = description_.dimensions[0];
+
+    int32_t const y = index / width;
+    int32_t const x = index - y * width;
+
+    return load(x, y);
+}
+
+template <typename T>
+T Tiled_image<T>::load(int32_t x, int32_t y) const noexcept {
+    if (volume_) {
+        int32_t const height = description_.dimensions[1];
+
+        int32_t const z = y / height;
+
+        return data_[index(x, y - z * height, z)];
+    }
+
+    return data_[index(x, y, 0)];
+}
+
+template <typename T>
+T Tiled_image<T>::load_element(int32_t x, int32_t y, int32_t element) const noexcept {
+    return load(x, element * description_.dimensions[1] + y);
+}
+
+template <typename T>
+T Tiled_image<T>::load(int32_t x, int32_t y, int32_t z) const noexcept {
+    if (volume_) {
+        return data_[index(x, y, z)];
+    }
+
+    return data_[index(x, z * description_.dimensions[1] + y, 0)];
+}
+
+template <typename T>
+void Tiled_image<T>::gather(int4 const& xy_xy1, T c[4]) const noexcept {
+    int32_t const x0 = xy_xy1[0];
+    int32_t const y0 = xy_xy1[1];
+    int32_t const x1 = xy_xy1[2];
+    int32_t const y1 = xy_xy1[3];
+
+    // Most footprints are inside of a single brick
+    if (volume_ || ((x0 ^ x1) | (y0 ^ y1)) >> Log_brick_size) {
+        c[0] = load(x0, y0);
+        c[1] = load(x1, y0);
+        c[2] = load(x0, y1);
+        c[3] = load(x1, y1);
+    } else {
+        T const* data = data_ + (brick(x0, y0, 0) << log_brick_volume_);
+
+        c[0] = data[texel(x0, y0, 0)];
+        c[1] = data[texel(x1, y0, 0)];
+        c[2] = data[texel(x0, y1, 0)];
+        c[3] = data[texel(x1, y1, 0)];
+    }
+}
+
+template <typename T>
+void Tiled_image<T>::gather(int3 const& xyz, int3 const& xyz1, T c[8]) const noexcept {
+    int32_t const x0 = xyz[0];
+    int32_t const y0 = xyz[1];
+    int32_t const z0 = xyz[2];
+    int32_t const x1 = xyz1[0];
+    int32_t const y1 = xyz1[1];
+    int32_t const z1 = xyz1[2];
+
+    if (!volume_ || ((x0 ^ x1) | (y0 ^ y1) | (z0 ^ z1)) >> Log_brick_size) {
+        c[0] = load(x0, y0, z0);
+        c[1] = load(x1, y0, z0);
+        c[2] = load(x0, y1, z0);
+        c[3] = load(x1, y1, z0);
+        c[4] = load(x0, y0, z1);
+        c[5] = load(x1, y0, z1);
+        c[6] = load(x0, y1, z1);
+        c[7] = load(x1, y1, z1);
+    } else {
+        T const* data = data_ + (brick(x0, y0, z0) << log_brick_volume_);
+
+        c[0] = data[texel(x0, y0, z0)];
+        c[1] = data[texel(x1, y0, z0)];
+        c[2] = data[texel(x0, y1, z0)];
+        c[3] = data[texel(x1, y1, z0)];
+        c[4] = data[texel(x0, y0, z1)];
+        c[5] = data[texel(x1, y0, z1)];
+        c[6] = data[texel(x0, y1, z1)];
+        c[7] = data[texel(x1, y1, z1)];
+    }
+}
+
+template <typename T>
+size_t Tiled_image<T>::num_bytes() const noexcept {
+    return sizeof(*this) +
+           (static_cast<size_t>(num_bricks_[0] * num_bricks_[1] * num_bricks_[2])
+            << log_brick_volume_) *
+               sizeof(T);
+}
+
+template <typename T>
+int32_t Tiled_image<T>::index(int32_t x, int32_t y, int32_t z) const noexcept {
+    return (brick(x, y, z) << log_brick_volume_) + texel(x, y, z);
+}
+
+template <typename T>
+int32_t Tiled_image<T>::brick(int32_t x, int32_t y, int32_t z) const noexcept {
+    return ((z >> Log_brick_size) * num_bricks_[1] + (y >> Log_brick_size)) * num_bricks_[0] +
+           (x >> Log_brick_size);
+}
+
+template <typename T>
+int32_t Tiled_image<T>::texel(int32_t x, int32_t y, int32_t z) const noexcept {
+    int32_t constexpr Mask = Brick_size - 1;
+
+    if (volume_) {
+        return Morton_3[x & Mask] | (Morton_3[y & Mask] << 1) | (Morton_3[z & Mask] << 2);
+    }
+
+    return Morton_2[x & Mask] | (Morton_2[y & Mask] << 1);
 }
 
 }  // namespace image
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef SU_CORE_IMAGE_TYPED_IMAGE_HPP
 #define SU_CORE_IMAGE_TYPED_IMAGE_HPP
 
+#include <memory>
 #include "base/math/vector.hpp"
 #include "image.hpp"
 
@@ -12,6 +13,10 @@ class Typed_image final : public Image {
     Typed_image() noexcept = default;
     Typed_image(const Image::Description& description) noexcept;
 
+    // Uses texels that are kept alive by owner, e.g. a memory mapped file, instead of copying them
+    Typed_image(const Image::Description& description, T* data,
+                std::shared_ptr<void> const& owner) noexcept;
+
     ~Typed_image() noexcept;
 
     Typed_image<T> clone() const noexcept;
@@ -46,14 +51,20 @@ class Typed_image final : public Image {
 
     void gather(int4 const& xy_xy1, T c[4]) const noexcept;
 
+    void gather(int3 const& xyz, int3 const& xyz1, T c[8]) const noexcept;
+
     void square_transpose() noexcept;
 
     T* data() const noexcept;
 
+    bool owns_data() const noexcept;
+
     size_t num_bytes() const noexcept override final;
 
   private:
     T* data_ = nullptr;
+
+    std::shared_ptr<void> owner_;
 };
 
 }  // namespace image
@@ -12,9 +12,16 @@ template <typename T>
 Typed_image<T>::Typed_image(const Image::Description& description) noexcept
     : Image(description), data_(memory::allocate_aligned<T>(description.num_pixels())) {}
 
+template <typename T>
+Typed_image<T>::Typed_image(const Image::Description& description, T* data,
+                            std::shared_ptr<void> const& owner) noexcept
+    : Image(description), data_(data), owner_(owner) {}
+
 template <typename T>
 Typed_image<T>::~Typed_image() noexcept {
-    memory::free_aligned(data_);
+    if (!owner_) {
+        memory::free_aligned(data_);
+    }
 }
 
 template <typename T>
@@ -24,7 +31,11 @@ Typed_image<T> Typed_image<T>::clone() const noexcept {
 
 template <typename T>
 void Typed_image<T>::resize(const Image::Description& description) noexcept {
-    memory::free_aligned(data_);
+    if (owner_) {
+        owner_.reset();
+    } else {
+        memory::free_aligned(data_);
+    }
 
     Image::resize(description);
 
@@ -123,6 +134,29 @@ void Typed_image<T>::gather(int4 const& xy_xy1, T c[4]) const noexcept {
     c[3] = data_[y1 + xy_xy1[2]];
 }
 
+template <typename T>
+void Typed_image<T>::gather(int3 const& xyz, int3 const& xyz1, T c[8]) const noexcept {
+    int32_t const width = description_.dimensions[0];
+    int32_t const area  = width * description_.dimensions[1];
+
+    int32_t const y0 = width * xyz[1];
+    int32_t const y1 = width * xyz1[1];
+
+    T const* const z0 = data_ + area * xyz[2];
+
+    c[0] = z0[y0 + xyz[0]];
+    c[1] = z0[y0 + xyz1[0]];
+    c[2] = z0[y1 + xyz[0]];
+    c[3] = z0[y1 + xyz1[0]];
+
+    T const* const z1 = data_ + area * xyz1[2];
+
+    c[4] = z1[y0 + xyz[0]];
+    c[5] = z1[y0 + xyz1[0]];
+    c[6] = z1[y1 + xyz[0]];
+    c[7] = z1[y1 + xyz1[0]];
+}
+
 template <typename T>
 void Typed_image<T>::square_transpose() noexcept {
     int32_t const n = description_.dimensions[0];
@@ -140,6 +174,11 @@ T* Typed_image<T>::data() const noexcept {
     return data_;
 }
 
+template <typename T>
+bool Typed_image<T>::owns_data() const noexcept {
+    return !owner_;
+}
+
 template <typename T>
 size_t Typed_image<T>::num_bytes() const noexcept {
     return sizeof(*this) + description_.dimensions[0] * description_.dimensions[1] *
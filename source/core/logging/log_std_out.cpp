@@ -1,10 +1,16 @@
 #include "log_std_out.hpp"
 #include <iostream>
+#include <mutex>
 #include <string_view>
 
 namespace logging {
 
+// Exports post from a background thread while the next frame renders
+static std::mutex mutex;
+
 void Std_out::post(Type type, std::string_view text) {
+    std::lock_guard<std::mutex> lock(mutex);
+
     switch (type) {
         case Type::Info:
         default:
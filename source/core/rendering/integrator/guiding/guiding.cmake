@@ -0,0 +1,5 @@
+target_sources(core
+    PRIVATE
+    "${CMAKE_CURRENT_LIST_DIR}/guiding_tree.cpp"
+    "${CMAKE_CURRENT_LIST_DIR}/guiding_tree.hpp"
+    ) 
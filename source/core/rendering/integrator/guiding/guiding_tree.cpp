@@ -0,0 +1,434 @@
+#include "guiding_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include "base/math/aabb.inl"
+#include "base/math/math.hpp"
+#include "base/math/vector2.inl"
+#include "base/math/vector3.inl"
+#include "base/thread/thread_pool.hpp"
+#include "take/take_settings.hpp"
+
+namespace rendering::integrator::guiding {
+
+static uint32_t constexpr Max_depth = 20;
+
+// Quadrants with more than this share of the energy of a quadtree are subdivided
+static float constexpr Directional_threshold = 0.01f;
+
+// Leaves with more samples than this, scaled by sqrt(2^iteration), are split
+static float constexpr Spatial_threshold = 12000.f;
+
+static uint32_t constexpr No_source = 0xFFFFFFFF;
+
+static float constexpr One_minus_epsilon = 0.99999994f;
+
+// The cylindrical mapping preserves area, so the pdf over the unit square only differs from the
+// pdf over the sphere by a constant
+static float2 cylindrical(float3 const& wi) noexcept {
+    float const phi = std::atan2(wi[1], wi[0]);
+
+    float const u = 0.5f * (std::min(std::max(wi[2], -1.f), 1.f) + 1.f);
+    float const v = (phi < 0.f ? phi + 2.f * math::Pi : phi) / (2.f * math::Pi);
+
+    return float2(std::min(u, One_minus_epsilon), std::min(v, One_minus_epsilon));
+}
+
+static float3 direction(float2 uv) noexcept {
+    float const cos_theta = 2.f * uv[0] - 1.f;
+    float const sin_theta = std::sqrt(std::max(1.f - cos_theta * cos_theta, 0.f));
+
+    float const phi = 2.f * math::Pi * uv[1];
+
+    return float3(sin_theta * std::cos(phi), sin_theta * std::sin(phi), cos_theta);
+}
+
+static uint32_t quadrant(float2& uv) noexcept {
+    uint32_t const x = uv[0] < 0.5f ? 0 : 1;
+    uint32_t const y = uv[1] < 0.5f ? 0 : 1;
+
+    uv = 2.f * uv - float2(static_cast<float>(x), static_cast<float>(y));
+
+    return x + 2 * y;
+}
+
+static void atomic_add(std::atomic<float>& a, float value) noexcept {
+    float expected = a.load(std::memory_order_relaxed);
+
+    while (!a.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed)) {
+    }
+}
+
+Quadtree::Quadtree() noexcept : nodes_(1, Node{{0.f, 0.f, 0.f, 0.f}, {0, 0, 0, 0}}) {
+    restart_records();
+}
+
+Quadtree::Quadtree(Quadtree const& other) noexcept
+    : nodes_(other.nodes_), records_(new std::atomic<float>[4 * other.nodes_.size()]) {
+    for (size_t i = 0, len = 4 * nodes_.size(); i < len; ++i) {
+        records_[i].store(other.records_[i].load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+    }
+}
+
+bool Quadtree::is_valid() const noexcept {
+    float const* sums = nodes_[0].sums;
+
+    return sums[0] + sums[1] + sums[2] + sums[3] > 0.f;
+}
+
+float3 Quadtree::sample(float2 r2, float& pdf) const noexcept {
+    float2 origin(0.f);
+    float  size = 1.f;
+
+    float pdf_square = 1.f;
+
+    for (uint32_t n = 0;;) {
+        Node const& node = nodes_[n];
+
+        float const* sums  = node.sums;
+        float const  total = sums[0] + sums[1] + sums[2] + sums[3];
+
+        // First the column, then the quadrant inside of the column.
+        // The random numbers are rescaled, so that they can be reused on the next level.
+        float const left = (sums[0] + sums[2]) / total;
+
+        uint32_t x;
+        if (r2[0] < left) {
+            x = 0;
+            r2[0] /= left;
+        } else {
+            x = 1;
+            r2[0] = (r2[0] - left) / (1.f - left);
+        }
+
+        float const bottom = sums[x] / (sums[x] + sums[x + 2]);
+
+        uint32_t y;
+        if (r2[1] < bottom) {
+            y = 0;
+            r2[1] /= bottom;
+        } else {
+            y = 1;
+            r2[1] = (r2[1] - bottom) / (1.f - bottom);
+        }
+
+        uint32_t const q = x + 2 * y;
+
+        pdf_square *= 4.f * sums[q] / total;
+
+        size *= 0.5f;
+        origin += size * float2(static_cast<float>(x), static_cast<float>(y));
+
+        n = node.children[q];
+
+        if (!n) {
+            break;
+        }
+    }
+
+    pdf = pdf_square / (4.f * math::Pi);
+
+    r2 = float2(std::min(r2[0], One_minus_epsilon), std::min(r2[1], One_minus_epsilon));
+
+    return direction(origin + size * r2);
+}
+
+float Quadtree::pdf(float3 const& wi) const noexcept {
+    float2 uv = cylindrical(wi);
+
+    float pdf_square = 1.f;
+
+    for (uint32_t n = 0;;) {
+        Node const& node = nodes_[n];
+
+        float const* sums  = node.sums;
+        float const  total = sums[0] + sums[1] + sums[2] + sums[3];
+
+        if (0.f == total) {
+            return 0.f;
+        }
+
+        uint32_t const q = quadrant(uv);
+
+        pdf_square *= 4.f * sums[q] / total;
+
+        n = node.children[q];
+
+        if (!n) {
+            break;
+        }
+    }
+
+    return pdf_square / (4.f * math::Pi);
+}
+
+void Quadtree::record(float3 const& wi, float value) noexcept {
+    float2 uv = cylindrical(wi);
+
+    // Every level receives the value, so that each node knows the energy of its quadrants
+    for (uint32_t n = 0;;) {
+        uint32_t const q = quadrant(uv);
+
+        atomic_add(records_[4 * n + q], value);
+
+        n = nodes_[n].children[q];
+
+        if (!n) {
+            break;
+        }
+    }
+}
+
+void Quadtree::rebuild(float threshold, uint32_t max_nodes) noexcept {
+    float sums[4];
+    for (uint32_t q = 0; q < 4; ++q) {
+        sums[q] = records_[q].load(std::memory_order_relaxed);
+    }
+
+    float const total = sums[0] + sums[1] + sums[2] + sums[3];
+
+    // Otherwise the last distribution is kept
+    if (total > 0.f && std::isfinite(total)) {
+        std::vector<Node> nodes(1, Node{{0.f, 0.f, 0.f, 0.f}, {0, 0, 0, 0}});
+        nodes.reserve(nodes_.size());
+
+        build(0, 0, sums, threshold * total, std::max(max_nodes, 1u), 1, nodes);
+
+        nodes_ = std::move(nodes);
+    }
+
+    restart_records();
+}
+
+uint32_t Quadtree::num_nodes() const noexcept {
+    return static_cast<uint32_t>(nodes_.size());
+}
+
+size_t Quadtree::num_bytes() const noexcept {
+    return sizeof(*this) + nodes_.size() * Node_bytes;
+}
+
+void Quadtree::build(uint32_t node, uint32_t source, float const sums[4], float threshold,
+                     uint32_t max_nodes, uint32_t depth, std::vector<Node>& nodes) const
+    noexcept {
+    for (uint32_t q = 0; q < 4; ++q) {
+        nodes[node].sums[q] = sums[q];
+    }
+
+    if (depth >= Max_depth) {
+        return;
+    }
+
+    for (uint32_t q = 0; q < 4; ++q) {
+        if (sums[q] <= threshold || nodes.size() >= max_nodes) {
+            continue;
+        }
+
+        uint32_t const child_source = No_source != source && nodes_[source].children[q]
+                                          ? nodes_[source].children[q]
+                                          : No_source;
+
+        // Quadrants that were not subdivided before share their energy evenly
+        float child_sums[4];
+        for (uint32_t c = 0; c < 4; ++c) {
+            child_sums[c] = No_source != child_source
+                                ? records_[4 * child_source + c].load(std::memory_order_relaxed)
+                                : 0.25f * sums[q];
+        }
+
+        uint32_t const child = static_cast<uint32_t>(nodes.size());
+
+        nodes.push_back(Node{{0.f, 0.f, 0.f, 0.f}, {0, 0, 0, 0}});
+
+        nodes[node].children[q] = child;
+
+        build(child, child_source, child_sums, threshold, max_nodes, depth + 1, nodes);
+    }
+}
+
+void Quadtree::restart_records() noexcept {
+    size_t const num_records = 4 * nodes_.size();
+
+    records_.reset(new std::atomic<float>[num_records]);
+
+    for (size_t i = 0; i < num_records; ++i) {
+        records_[i].store(0.f, std::memory_order_relaxed);
+    }
+}
+
+Tree::Tree(take::Guiding_settings const& settings) noexcept
+    : iteration_(0),
+      training_(false),
+      bsdf_probability_(settings.bsdf_probability),
+      num_training_samples_(settings.num_training_samples),
+      max_bytes_(static_cast<size_t>(settings.max_megabytes) * 1024 * 1024) {}
+
+Tree::~Tree() noexcept {}
+
+void Tree::start(math::AABB const& aabb, bool training) noexcept {
+    // The spatial subdivision works on a cube around the scene
+    float3 const position = aabb.position();
+
+    float halfsize = 1.01f * math::max_component(aabb.halfsize());
+
+    if (!(halfsize > 0.f) || !std::isfinite(halfsize)) {
+        halfsize = 1.f;
+    }
+
+    aabb_ = math::AABB(position - float3(halfsize), position + float3(halfsize));
+
+    inv_extent_ = float3(1.f / (2.f * halfsize));
+
+    nodes_.assign(1, Node{0, 0, 0});
+
+    leaves_.clear();
+    leaves_.emplace_back();
+
+    num_samples_.reset(new std::atomic<uint32_t>[1]);
+    num_samples_[0].store(0, std::memory_order_relaxed);
+
+    iteration_ = 0;
+
+    training_ = training;
+}
+
+bool Tree::is_training() const noexcept {
+    return training_;
+}
+
+float Tree::bsdf_probability() const noexcept {
+    return bsdf_probability_;
+}
+
+uint32_t Tree::num_training_samples() const noexcept {
+    return num_training_samples_;
+}
+
+uint32_t Tree::leaf(float3 const& p) const noexcept {
+    float3 const o = (p - aabb_.min()) * inv_extent_;
+
+    float3 u(std::min(std::max(o[0], 0.f), One_minus_epsilon),
+             std::min(std::max(o[1], 0.f), One_minus_epsilon),
+             std::min(std::max(o[2], 0.f), One_minus_epsilon));
+
+    for (uint32_t n = 0;;) {
+        Node const& node = nodes_[n];
+
+        if (!node.children) {
+            return node.leaf;
+        }
+
+        uint32_t const axis = node.axis;
+
+        if (u[axis] < 0.5f) {
+            u[axis] *= 2.f;
+            n = node.children;
+        } else {
+            u[axis] = 2.f * u[axis] - 1.f;
+            n = node.children + 1;
+        }
+    }
+}
+
+Quadtree const& Tree::directions(uint32_t leaf) const noexcept {
+    return leaves_[leaf];
+}
+
+void Tree::record(uint32_t leaf, float3 const& wi, float value) noexcept {
+    num_samples_[leaf].fetch_add(1, std::memory_order_relaxed);
+
+    if (value > 0.f && std::isfinite(value)) {
+        leaves_[leaf].record(wi, value);
+    }
+}
+
+void Tree::update(bool last, thread::Pool& pool) noexcept {
+    float const threshold = Spatial_threshold *
+                            std::sqrt(static_cast<float>(1u << std::min(iteration_, 31u)));
+
+    size_t num_bytes = Tree::num_bytes();
+
+    for (uint32_t i = 0, len = static_cast<uint32_t>(nodes_.size()); i < len; ++i) {
+        if (!nodes_[i].children) {
+            split(i, num_samples_[nodes_[i].leaf].load(std::memory_order_relaxed),
+                  static_cast<uint32_t>(threshold), num_bytes);
+        }
+    }
+
+    uint32_t const num_leaves = static_cast<uint32_t>(leaves_.size());
+
+    // The remaining budget is shared evenly by the directional distributions
+    size_t const spatial_bytes = nodes_.size() * sizeof(Node) +
+                                 num_leaves * (sizeof(Quadtree) + sizeof(std::atomic<uint32_t>));
+
+    size_t const leaf_bytes = max_bytes_ > spatial_bytes ? (max_bytes_ - spatial_bytes) / num_leaves
+                                                         : 0;
+
+    uint32_t const max_nodes = static_cast<uint32_t>(
+        std::min(leaf_bytes / Quadtree::Node_bytes, size_t(0xFFFFFFFF)));
+
+    pool.run_range(
+        [this, max_nodes](uint32_t /*id*/, int32_t begin, int32_t end) noexcept {
+            for (int32_t i = begin; i < end; ++i) {
+                leaves_[i].rebuild(Directional_threshold, max_nodes);
+            }
+        },
+        0, static_cast<int32_t>(num_leaves));
+
+    num_samples_.reset(new std::atomic<uint32_t>[num_leaves]);
+
+    for (uint32_t i = 0; i < num_leaves; ++i) {
+        num_samples_[i].store(0, std::memory_order_relaxed);
+    }
+
+    ++iteration_;
+
+    if (last) {
+        training_ = false;
+    }
+}
+
+size_t Tree::num_bytes() const noexcept {
+    size_t num_bytes = 0;
+    for (auto const& l : leaves_) {
+        num_bytes += l.num_bytes() + sizeof(std::atomic<uint32_t>);
+    }
+
+    return sizeof(*this) + nodes_.size() * sizeof(Node) + num_bytes;
+}
+
+void Tree::split(uint32_t node, uint32_t num_samples, uint32_t threshold,
+                 size_t& num_bytes) noexcept {
+    if (num_samples <= threshold) {
+        return;
+    }
+
+    uint32_t const leaf = nodes_[node].leaf;
+
+    size_t const split_bytes = 2 * sizeof(Node) + leaves_[leaf].num_bytes() +
+                               sizeof(std::atomic<uint32_t>);
+
+    if (num_bytes + split_bytes > max_bytes_) {
+        return;
+    }
+
+    num_bytes += split_bytes;
+
+    uint32_t const children = static_cast<uint32_t>(nodes_.size());
+    uint32_t const axis     = (nodes_[node].axis + 1) % 3;
+
+    // Both halves start out with everything that was recorded for the whole
+    Quadtree copy(leaves_[leaf]);
+    leaves_.push_back(std::move(copy));
+
+    nodes_.push_back(Node{0, leaf, axis});
+    nodes_.push_back(Node{0, static_cast<uint32_t>(leaves_.size() - 1), axis});
+
+    nodes_[node].children = children;
+
+    // Assuming that the samples are distributed evenly
+    split(children, num_samples / 2, threshold, num_bytes);
+    split(children + 1, num_samples / 2, threshold, num_bytes);
+}
+
+}  // namespace rendering::integrator::guiding
@@ -0,0 +1,137 @@
+#ifndef SU_RENDERING_INTEGRATOR_GUIDING_TREE_HPP
+#define SU_RENDERING_INTEGRATOR_GUIDING_TREE_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "base/math/aabb.hpp"
+#include "base/math/vector2.hpp"
+#include "base/math/vector3.hpp"
+
+namespace thread {
+class Pool;
+}
+
+namespace take {
+struct Guiding_settings;
+}
+
+// Spatial-directional radiance cache after
+// Müller et al., "Practical Path Guiding for Efficient Light-Transport Simulation"
+
+namespace rendering::integrator::guiding {
+
+// Distribution of incident radiance over the sphere of directions, as a quadtree over the
+// cylindrical mapping. Next to the distribution that is sampled during a pass,
+// it accumulates the radiance that is recorded with the same subdivision for the next one.
+class Quadtree {
+  public:
+    Quadtree() noexcept;
+
+    Quadtree(Quadtree const& other) noexcept;
+
+    Quadtree(Quadtree&& other) noexcept = default;
+
+    // False if nothing has been learned yet
+    bool is_valid() const noexcept;
+
+    float3 sample(float2 r2, float& pdf) const noexcept;
+
+    float pdf(float3 const& wi) const noexcept;
+
+    void record(float3 const& wi, float value) noexcept;
+
+    // Replaces the sampled distribution with the recorded one and restarts the recording.
+    // Quadrants that hold more than the threshold of the recorded energy are subdivided.
+    void rebuild(float threshold, uint32_t max_nodes) noexcept;
+
+    uint32_t num_nodes() const noexcept;
+
+    size_t num_bytes() const noexcept;
+
+    static size_t constexpr Node_bytes = 4 * (2 * sizeof(float) + sizeof(uint32_t));
+
+  private:
+    struct Node {
+        float sums[4];
+
+        // Quadrants without children are 0, because the root is never a child
+        uint32_t children[4];
+    };
+
+    void build(uint32_t node, uint32_t source, float const sums[4], float threshold,
+               uint32_t max_nodes, uint32_t depth, std::vector<Node>& nodes) const noexcept;
+
+    void restart_records() noexcept;
+
+    std::vector<Node> nodes_;
+
+    // Four per node, in the same order as the quadrants
+    std::unique_ptr<std::atomic<float>[]> records_;
+};
+
+class Tree {
+  public:
+    Tree(take::Guiding_settings const& settings) noexcept;
+
+    ~Tree() noexcept;
+
+    // Forgets everything that was learned, for a new scene inside of the bounds
+    void start(math::AABB const& aabb, bool training) noexcept;
+
+    bool is_training() const noexcept;
+
+    float bsdf_probability() const noexcept;
+
+    uint32_t num_training_samples() const noexcept;
+
+    uint32_t leaf(float3 const& p) const noexcept;
+
+    Quadtree const& directions(uint32_t leaf) const noexcept;
+
+    // Safe to call concurrently during a pass
+    void record(uint32_t leaf, float3 const& wi, float value) noexcept;
+
+    // Learns from the radiance recorded in the last pass.
+    // The last pass of the training has to call this with last set.
+    void update(bool last, thread::Pool& pool) noexcept;
+
+    size_t num_bytes() const noexcept;
+
+  private:
+    struct Node {
+        // Both children are consecutive and the node is a leaf if this is 0
+        uint32_t children;
+
+        uint32_t leaf;
+
+        uint32_t axis;
+    };
+
+    void split(uint32_t node, uint32_t num_samples, uint32_t threshold, size_t& num_bytes) noexcept;
+
+    math::AABB aabb_;
+
+    float3 inv_extent_;
+
+    std::vector<Node> nodes_;
+
+    std::vector<Quadtree> leaves_;
+
+    // Recorded samples per leaf in the current pass
+    std::unique_ptr<std::atomic<uint32_t>[]> num_samples_;
+
+    uint32_t iteration_;
+
+    bool training_;
+
+    float bsdf_probability_;
+
+    uint32_t num_training_samples_;
+
+    size_t max_bytes_;
+};
+
+}  // namespace rendering::integrator::guiding
+
+#endif
@@ -1,3 +1,4 @@
+include("${CMAKE_CURRENT_LIST_DIR}/guiding/guiding.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/photon/photon.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/surface/surface.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/volume/volume.cmake")
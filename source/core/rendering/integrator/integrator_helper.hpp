@@ -1,8 +1,10 @@
 #ifndef SU_CORE_RENDERING_INTEGRATOR_HELPER_HPP
 #define SU_CORE_RENDERING_INTEGRATOR_HELPER_HPP
 
+#include <algorithm>
 #include <cmath>
 #include "base/math/vector3.inl"
+#include "scene/scene_ray.hpp"
 
 namespace rendering {
 
@@ -38,6 +40,17 @@ static inline bool russian_roulette(float3& throughput, float continuation_proba
     return false;
 }
 
+// Moves the ray cone to the hit point, before the ray continues from there.
+// Caustic bounces keep the spread, other bounces widen the cone according to the pdf,
+// so that the texture lookups of diffuse paths use coarse mip levels.
+static inline void propagate_cone(scene::Ray& ray, float pdf, bool caustic) noexcept {
+    ray.cone_width += ray.cone_spread * ray.max_t;
+
+    if (!caustic) {
+        ray.cone_spread = std::max(ray.cone_spread, 0.125f / std::sqrt(pdf));
+    }
+}
+
 }  // namespace rendering
 
 #endif
@@ -199,7 +199,25 @@ void Grid::resize(math::AABB const& aabb) noexcept {
     }
 }
 
-void Grid::update(uint32_t num_photons, Photon* photons) noexcept {
+// Counting and scattering have to visit the photons with the same partition
+static inline int2 partition(uint32_t id, uint32_t num_parts, int32_t size) noexcept {
+    int32_t const i = static_cast<int32_t>(id);
+    int32_t const n = static_cast<int32_t>(num_parts);
+
+    int32_t const step = size / n;
+    int32_t const rest = size % n;
+
+    int32_t const begin = i * step + std::min(i, rest);
+
+    return int2(begin, begin + step + (i < rest ? 1 : 0));
+}
+
+// The cells are sorted by digits of this many bits,
+// so that the per thread counts do not depend on the size of the grid
+static uint32_t constexpr Radix_bits  = 11;
+static uint32_t constexpr Num_buckets = 1u << Radix_bits;
+
+void Grid::update(uint32_t num_photons, Photon* photons, thread::Pool& pool) noexcept {
     num_photons_ = num_photons;
     photons_     = photons;
 
@@ -207,36 +225,125 @@ void Grid::update(uint32_t num_photons, Photon* photons) noexcept {
         return;
     }
 
-    std::sort(photons,
-              photons + num_photons, [this](Photon const& a, Photon const& b) noexcept->bool {
-                  int32_t const ida = map1(a.p);
-                  int32_t const idb = map1(b.p);
-
-                  return ida < idb;
-              });
+    uint32_t const num_threads = pool.num_threads();
 
     int32_t const num_cells = dimensions_[0] * dimensions_[1] * dimensions_[2];
 
     int32_t const len = static_cast<int32_t>(num_photons);
 
-    int32_t current = 0;
-    for (int32_t c = 0; c < num_cells; ++c) {
-        int32_t const begin = current;
-        for (; current < len; ++current) {
-            if (map1(photons[current].p) != c) {
-                break;
-            }
+    uint32_t num_bits = 0;
+    for (uint32_t c = static_cast<uint32_t>(num_cells - 1); c > 0; c >>= 1) {
+        ++num_bits;
+    }
+
+    // LSD radix sort by cell, which keeps the photons of a cell in their original order
+    Photon* sorted = memory::allocate_aligned<Photon>(num_photons);
+
+    // Indexed by thread * Num_buckets + bucket
+    uint32_t* counts = memory::allocate_aligned<uint32_t>(num_threads * Num_buckets);
+
+    Photon* source = photons;
+    Photon* target = sorted;
+
+    for (uint32_t shift = 0; shift < num_bits; shift += Radix_bits) {
+        radix_pass(shift, num_threads, len, source, target, counts, pool);
+
+        std::swap(source, target);
+    }
+
+    if (source != photons) {
+        pool.run_range(
+            [photons, sorted](uint32_t /*id*/, int32_t begin, int32_t end) noexcept {
+                std::copy(sorted + begin, sorted + end, photons + begin);
+            },
+            0, len);
+    }
+
+    memory::free_aligned(counts);
+    memory::free_aligned(sorted);
+
+    set_cell_ranges(num_cells, len, pool);
+}
+
+void Grid::radix_pass(uint32_t shift, uint32_t num_threads, int32_t len, Photon const* photons,
+                      Photon* sorted, uint32_t* counts, thread::Pool& pool) const noexcept {
+    pool.run_parallel([this, shift, photons, counts, num_threads, len](uint32_t id) noexcept {
+        uint32_t* thread_counts = counts + id * Num_buckets;
+
+        std::fill(thread_counts, thread_counts + Num_buckets, 0u);
+
+        int2 const part = partition(id, num_threads, len);
+
+        for (int32_t i = part[0]; i < part[1]; ++i) {
+            ++thread_counts[digit(photons[i].p, shift)];
+        }
+    });
+
+    // The threads scatter the photons of a bucket in their order, so that the pass is stable
+    for (uint32_t b = 0, offset = 0; b < Num_buckets; ++b) {
+        for (uint32_t t = 0; t < num_threads; ++t) {
+            uint32_t& count = counts[t * Num_buckets + b];
+
+            uint32_t const num = count;
+
+            count = offset;
+
+            offset += num;
         }
+    }
+
+    pool.run_parallel(
+        [this, shift, photons, sorted, counts, num_threads, len](uint32_t id) noexcept {
+            uint32_t* offsets = counts + id * Num_buckets;
+
+            int2 const part = partition(id, num_threads, len);
+
+            for (int32_t i = part[0]; i < part[1]; ++i) {
+                sorted[offsets[digit(photons[i].p, shift)]++] = photons[i];
+            }
+        });
+}
+
+// Empty cells begin and end where the next photon begins,
+// because a lookup covers consecutive cells with a single range
+void Grid::set_cell_ranges(int32_t num_cells, int32_t len, thread::Pool& pool) noexcept {
+    pool.run_range(
+        [this](uint32_t /*id*/, int32_t begin, int32_t end) noexcept {
+            int32_t previous = begin > 0 ? map1(photons_[begin - 1].p) : -1;
+
+            for (int32_t i = begin; i < end; ++i) {
+                int32_t const cell = map1(photons_[i].p);
+
+                for (int32_t c = previous; c < cell; ++c) {
+                    if (c >= 0) {
+                        grid_[c][1] = i;
+                    }
+
+                    grid_[c + 1][0] = i;
+                }
 
-        grid_[c][0] = begin;
-        grid_[c][1] = current;
+                previous = cell;
+            }
+        },
+        0, len);
+
+    for (int32_t c = map1(photons_[len - 1].p); c < num_cells; ++c) {
+        grid_[c][1] = len;
+
+        if (c + 1 < num_cells) {
+            grid_[c + 1][0] = len;
+        }
     }
 }
 
 uint32_t Grid::reduce_and_move(Photon* photons, uint32_t* num_reduced,
                                thread::Pool& pool) noexcept {
+    for (uint32_t i = 0, len = pool.num_threads(); i < len; ++i) {
+        num_reduced[i] = 0;
+    }
+
     pool.run_range([this, num_reduced](uint32_t id, int32_t begin,
-                                       int32_t end) { num_reduced[id] = reduce(begin, end); },
+                                       int32_t end) { num_reduced[id] += reduce(begin, end); },
                    0, static_cast<int32_t>(num_photons_));
 
     uint32_t comp_num_photons = num_photons_;
@@ -257,7 +364,7 @@ uint32_t Grid::reduce_and_move(Photon* photons, uint32_t* num_reduced,
         }
     }
 
-    update(comp_num_photons, photons_);
+    update(comp_num_photons, photons_, pool);
 
     return comp_num_photons;
 }
@@ -268,7 +375,10 @@ static inline float kernel(float squared_distance, float inv_squared_radius) {
 }
 
 float3 Grid::li(Intersection const& intersection, Material_sample const& sample, uint32_t num_paths,
-                scene::Worker const& worker) const noexcept {
+                float radius_factor, scene::Worker const& worker, uint32_t& num_gathered) const
+    noexcept {
+    num_gathered = 0;
+
     if (0 == num_photons_) {
         return float3::identity();
     }
@@ -284,9 +394,11 @@ float3 Grid::li(Intersection const& intersection, Material_sample const& sample,
     Adjacency adjacency;
     adjacent_cells(position, adjacency);
 
+    float const radius = radius_factor * photon_radius_;
+
     if (intersection.subsurface) {
-        float const radius_2 = photon_radius_ * photon_radius_;
-        float const radius_3 = photon_radius_ * radius_2;
+        float const radius_2 = radius * radius;
+        float const radius_3 = radius * radius_2;
 
         for (uint32_t c = 0; c < adjacency.num_cells; ++c) {
             int2 const cell = adjacency.cells[c];
@@ -299,6 +411,8 @@ float3 Grid::li(Intersection const& intersection, Material_sample const& sample,
                 }
 
                 if (math::squared_distance(photon.p, position) <= radius_2) {
+                    ++num_gathered;
+
                     auto const bxdf = sample.evaluate(photon.wi, true);
 
                     result += float3(photon.alpha) * bxdf.reflection;
@@ -310,7 +424,7 @@ float3 Grid::li(Intersection const& intersection, Material_sample const& sample,
 
         result /= (((4.f / 3.f) * math::Pi) * (radius_3 * static_cast<float>(num_paths))) * mu_s;
     } else {
-        float const radius_2     = photon_radius_ * photon_radius_;
+        float const radius_2     = radius * radius;
         float const inv_radius_2 = 1.f / radius_2;
 
         for (uint32_t c = 0; c < adjacency.num_cells; ++c) {
@@ -327,6 +441,8 @@ float3 Grid::li(Intersection const& intersection, Material_sample const& sample,
                     distance_2 <= radius_2) {
                     if (float const n_dot_wi = sample.base_layer().abs_n_dot(photon.wi);
                         n_dot_wi > 0.f) {
+                        ++num_gathered;
+
                         float const clamped_n_dot_wi = scene::material::clamp(n_dot_wi);
 
                         float const k = kernel(distance_2, inv_radius_2);
@@ -433,6 +549,10 @@ int32_t Grid::map1(float3 const& v) const noexcept {
     return (c[2] * dimensions_[1] + c[1]) * dimensions_[0] + c[0];
 }
 
+uint32_t Grid::digit(float3 const& v, uint32_t shift) const noexcept {
+    return (static_cast<uint32_t>(map1(v)) >> shift) & (Num_buckets - 1);
+}
+
 int3 Grid::map3(float3 const& v) const noexcept {
     return static_cast<int3>(inverse_cell_size_ * (v - aabb_.min()));
 }
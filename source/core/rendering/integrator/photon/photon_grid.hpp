@@ -47,22 +47,33 @@ class Grid {
 
     void resize(math::AABB const& aabb) noexcept;
 
-    void update(uint32_t num_photons, Photon* photons) noexcept;
+    void update(uint32_t num_photons, Photon* photons, thread::Pool& pool) noexcept;
 
     uint32_t reduce_and_move(Photon* photons, uint32_t* num_reduced, thread::Pool& pool) noexcept;
 
+    // The radius of the lookup is scaled by radius_factor, which must not be greater than 1
     float3 li(Intersection const& intersection, const Material_sample& sample, uint32_t num_paths,
-              scene::Worker const& worker) const noexcept;
+              float radius_factor, scene::Worker const& worker, uint32_t& num_gathered) const
+        noexcept;
 
+    // Without the copy of the photons that update() sorts into, which it frees before returning
     size_t num_bytes() const noexcept;
 
   private:
+    // One stable pass of the radix sort, by the digit of the cell that starts at shift
+    void radix_pass(uint32_t shift, uint32_t num_threads, int32_t len, Photon const* photons,
+                    Photon* sorted, uint32_t* counts, thread::Pool& pool) const noexcept;
+
+    void set_cell_ranges(int32_t num_cells, int32_t len, thread::Pool& pool) noexcept;
+
     uint32_t reduce(int32_t begin, int32_t end) noexcept;
 
     static uint8_t adjacent(float s) noexcept;
 
     int32_t map1(float3 const& v) const noexcept;
 
+    uint32_t digit(float3 const& v, uint32_t shift) const noexcept;
+
     int3 map3(float3 const& v) const noexcept;
     int3 map3(float3 const& v, uint8_t& adjacent) const noexcept;
 
@@ -11,27 +11,44 @@ namespace rendering::integrator::photon {
 
 static float constexpr Merge_threshold = 0.15f;
 
-Map::Map(uint32_t num_photons, float radius, float indirect_radius_factor,
-         bool separate_caustics) noexcept
+Map::Map(uint32_t num_photons, float radius, float indirect_radius_factor, bool separate_caustics,
+         float alpha) noexcept
     : num_photons_(num_photons),
       photons_(nullptr),
       radius_(radius),
       indirect_radius_factor_(indirect_radius_factor),
       separate_caustics_(separate_caustics),
+      alpha_(alpha),
       num_reduced_(nullptr),
+      num_pixels_(0),
+      pixels_(nullptr),
       caustic_grid_(radius, Merge_threshold),
       indirect_grid_(indirect_radius_factor_ * radius_,
                      Merge_threshold / (math::lerp(std::sqrt(indirect_radius_factor),
                                                    indirect_radius_factor, 0.25f))) {}
 
 Map::~Map() noexcept {
+    memory::free_aligned(pixels_);
     memory::free_aligned(num_reduced_);
     memory::free_aligned(photons_);
 }
 
-void Map::init(uint32_t num_workers) noexcept {
+void Map::init(uint32_t num_workers, uint32_t num_pixels) noexcept {
     photons_     = memory::allocate_aligned<Photon>(num_photons_);
     num_reduced_ = memory::allocate_aligned<uint32_t>(num_workers);
+
+    if (alpha_ > 0.f) {
+        num_pixels_ = num_pixels;
+        pixels_     = memory::allocate_aligned<Pixel>(num_pixels);
+
+        restart();
+    }
+}
+
+void Map::restart() noexcept {
+    for (uint32_t i = 0, len = num_pixels_; i < len; ++i) {
+        pixels_[i] = Pixel{1.f, 0.f};
+    }
 }
 
 void Map::insert(Photon const& photon, uint32_t index) noexcept {
@@ -56,8 +73,13 @@ uint32_t Map::compile(uint32_t num_paths, thread::Pool& pool) noexcept {
             std::distance(photons_, indirect_photons));
         uint32_t const num_indirect = num_photons_ - num_caustics;
 
-        caustic_grid_.update(num_caustics, photons_);
-        indirect_grid_.update(num_indirect, photons_ + num_caustics);
+        caustic_grid_.update(num_caustics, photons_, pool);
+        indirect_grid_.update(num_indirect, photons_ + num_caustics, pool);
+
+        // The radius of the pixels shrinks below the distance at which photons would be merged
+        if (pixels_) {
+            return num_photons_;
+        }
 
         uint32_t const red_num_caustics = caustic_grid_.reduce_and_move(photons_, num_reduced_,
                                                                         pool);
@@ -78,7 +100,11 @@ uint32_t Map::compile(uint32_t num_paths, thread::Pool& pool) noexcept {
 
         return red_num_caustics + red_num_indirect;
     } else {
-        caustic_grid_.update(num_photons_, photons_);
+        caustic_grid_.update(num_photons_, photons_, pool);
+
+        if (pixels_) {
+            return num_photons_;
+        }
 
         uint32_t const red_num_caustics = caustic_grid_.reduce_and_move(photons_, num_reduced_,
                                                                         pool);
@@ -93,14 +119,38 @@ uint32_t Map::compile(uint32_t num_paths, thread::Pool& pool) noexcept {
     }
 }
 
-float3 Map::li(Intersection const& intersection, Material_sample const& sample,
-               scene::Worker const& worker) const noexcept {
-    return caustic_grid_.li(intersection, sample, num_paths_, worker) +
-           indirect_grid_.li(intersection, sample, num_paths_, worker);
+float3 Map::li(Intersection const& intersection, Material_sample const& sample, int32_t pixel,
+               scene::Worker const& worker) noexcept {
+    uint32_t num_caustics;
+    uint32_t num_indirect;
+
+    if (!pixels_ || pixel < 0) {
+        return caustic_grid_.li(intersection, sample, num_paths_, 1.f, worker, num_caustics) +
+               indirect_grid_.li(intersection, sample, num_paths_, 1.f, worker, num_indirect);
+    }
+
+    // Pixels are only ever rendered by one thread at a time
+    Pixel& p = pixels_[pixel];
+
+    float3 const result = caustic_grid_.li(intersection, sample, num_paths_, p.radius_factor,
+                                           worker, num_caustics) +
+                          indirect_grid_.li(intersection, sample, num_paths_, p.radius_factor,
+                                            worker, num_indirect);
+
+    if (uint32_t const num_gathered = num_caustics + num_indirect; num_gathered > 0) {
+        float const m = static_cast<float>(num_gathered);
+        float const n = p.num_photons + alpha_ * m;
+
+        p.radius_factor *= std::sqrt(n / (p.num_photons + m));
+
+        p.num_photons = n;
+    }
+
+    return result;
 }
 
 size_t Map::num_bytes() const noexcept {
-    size_t num_bytes = num_photons_ * sizeof(Photon);
+    size_t num_bytes = num_photons_ * sizeof(Photon) + num_pixels_ * sizeof(Pixel);
 
     num_bytes += caustic_grid_.num_bytes() + indirect_grid_.num_bytes();
 
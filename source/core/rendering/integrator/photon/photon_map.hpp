@@ -12,19 +12,27 @@ class Map {
     using Intersection    = scene::prop::Intersection;
     using Material_sample = scene::material::Sample;
 
-    Map(uint32_t num_photons, float radius, float indirect_radius_factor,
-        bool separate_caustics) noexcept;
+    // With alpha greater than zero, every pixel keeps its own radius, which shrinks with the
+    // photons that it gathers (Hachisuka and Jensen, "Stochastic Progressive Photon Mapping").
+    // Alpha is the fraction of the gathered photons that is kept when the radius shrinks.
+    Map(uint32_t num_photons, float radius, float indirect_radius_factor, bool separate_caustics,
+        float alpha) noexcept;
 
     ~Map() noexcept;
 
-    void init(uint32_t num_workers) noexcept;
+    // The statistics of num_pixels are only allocated for progressive photon mapping
+    void init(uint32_t num_workers, uint32_t num_pixels) noexcept;
+
+    // Returns all pixels to the initial radius
+    void restart() noexcept;
 
     void insert(Photon const& photon, uint32_t index) noexcept;
 
     uint32_t compile(uint32_t num_paths, thread::Pool& pool) noexcept;
 
-    float3 li(Intersection const& intersection, Material_sample const& sample,
-              scene::Worker const& worker) const noexcept;
+    // Pixel is the sensor pixel of the camera sample, or negative for the fixed radius
+    float3 li(Intersection const& intersection, Material_sample const& sample, int32_t pixel,
+              scene::Worker const& worker) noexcept;
 
     size_t num_bytes() const noexcept;
 
@@ -41,8 +49,20 @@ class Map {
 
     bool separate_caustics_;
 
+    float alpha_;
+
     uint32_t* num_reduced_;
 
+    struct Pixel {
+        // Relative to the radius of the grids
+        float radius_factor;
+
+        float num_photons;
+    };
+
+    uint32_t num_pixels_;
+    Pixel*   pixels_;
+
     Grid caustic_grid_;
     Grid indirect_grid_;
 };
@@ -31,7 +31,7 @@ void Mapper::prepare(Scene const& /*scene*/, uint32_t /*num_photons*/) noexcept
     sampler_.resize(1, 1, 1, 1);
 }
 
-void Mapper::start_pixel() noexcept {}
+void Mapper::start_pixel(uint32_t /*sample_begin*/) noexcept {}
 
 uint32_t Mapper::bake(Map& map, int32_t begin, int32_t end, uint32_t frame,
                       Worker& worker) noexcept {
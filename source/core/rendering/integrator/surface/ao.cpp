@@ -18,8 +18,8 @@ void AO::prepare(Scene const& /*scene*/, uint32_t num_samples_per_pixel) noexcep
     sampler_.resize(num_samples_per_pixel, settings_.num_samples, 1, 1);
 }
 
-void AO::start_pixel() noexcept {
-    sampler_.start_pixel();
+void AO::start_pixel(uint32_t sample_begin) noexcept {
+    sampler_.start_pixel(sample_begin);
 }
 
 float3 AO::li(Ray& ray, Intersection& intersection, Worker& worker,
@@ -35,11 +35,11 @@ void Lighttracer::prepare(Scene const& /*scene*/, uint32_t num_samples_per_pixel
     }
 }
 
-void Lighttracer::start_pixel() noexcept {
-    sampler_.start_pixel();
+void Lighttracer::start_pixel(uint32_t sample_begin) noexcept {
+    sampler_.start_pixel(sample_begin);
 
     for (auto& s : material_samplers_) {
-        s.start_pixel();
+        s.start_pixel(sample_begin);
     }
 }
 
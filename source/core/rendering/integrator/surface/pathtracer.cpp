@@ -35,11 +35,11 @@ void Pathtracer::prepare(Scene const& /*scene*/, uint32_t num_samples_per_pixel)
     }
 }
 
-void Pathtracer::start_pixel() noexcept {
-    sampler_.start_pixel();
+void Pathtracer::start_pixel(uint32_t sample_begin) noexcept {
+    sampler_.start_pixel(sample_begin);
 
     for (auto& s : material_samplers_) {
-        s.start_pixel();
+        s.start_pixel(sample_begin);
     }
 }
 
@@ -123,6 +123,8 @@ float3 Pathtracer::integrate(Ray& ray, Intersection& intersection, Worker& worke
         if (material_sample.ior_greater_one()) {
             throughput *= sample_result.reflection / sample_result.pdf;
 
+            propagate_cone(ray, sample_result.pdf, sample_result.type.test(Bxdf_type::Caustic));
+
             ray.origin = intersection.geo.p;
             ray.set_direction(sample_result.wi);
             ray.min_t = ray_offset;
@@ -3,6 +3,7 @@
 #include "base/memory/align.hpp"
 #include "base/random/generator.inl"
 #include "base/spectrum/rgb.hpp"
+#include "rendering/integrator/guiding/guiding_tree.hpp"
 #include "rendering/integrator/integrator_helper.hpp"
 #include "rendering/rendering_worker.hpp"
 #include "scene/light/light.hpp"
@@ -22,6 +23,32 @@ namespace rendering::integrator::surface {
 
 using namespace scene;
 
+// Only this many vertices of a path contribute to the training of the path guiding
+static uint32_t constexpr Max_guide_vertices = 16;
+
+struct Guide_vertex {
+    float3 wi;
+
+    // Throughput after the vertex and the radiance of the path before it
+    float3 throughput;
+    float3 li;
+
+    float pdf;
+
+    uint32_t leaf;
+};
+
+static float incident_luminance(float3 const& radiance, float3 const& throughput) noexcept {
+    float3 li(0.f);
+    for (uint32_t i = 0; i < 3; ++i) {
+        if (throughput[i] > 0.f) {
+            li[i] = radiance[i] / throughput[i];
+        }
+    }
+
+    return spectrum::luminance(li);
+}
+
 Pathtracer_MIS::Pathtracer_MIS(rnd::Generator& rng, take::Settings const& take_settings,
                                Settings const& settings) noexcept
     : Integrator(rng, take_settings),
@@ -54,15 +81,15 @@ void Pathtracer_MIS::prepare(Scene const& scene, uint32_t num_samples_per_pixel)
     }
 }
 
-void Pathtracer_MIS::start_pixel() noexcept {
-    sampler_.start_pixel();
+void Pathtracer_MIS::start_pixel(uint32_t sample_begin) noexcept {
+    sampler_.start_pixel(sample_begin);
 
     for (auto& s : material_samplers_) {
-        s.start_pixel();
+        s.start_pixel(sample_begin);
     }
 
     for (auto& s : light_samplers_) {
-        s.start_pixel();
+        s.start_pixel(sample_begin);
     }
 }
 
@@ -127,10 +154,21 @@ Pathtracer_MIS::Result Pathtracer_MIS::integrate(Ray& ray, Intersection& interse
     bool is_translucent    = false;
     bool evaluate_back     = true;
 
+    // The vertex that lights were sampled from, for the light tree pdf of emitters hit later
+    float3 vertex_p(0.f);
+    float3 vertex_n(0.f);
+
     float3 throughput(1.f);
 
     Result result{float3(0.f), float3(0.f), false};
 
+    auto* const guide_tree = worker.guide_tree();
+
+    bool const training = guide_tree && guide_tree->is_training();
+
+    Guide_vertex guide_vertices[Max_guide_vertices];
+    uint32_t     num_guide_vertices = 0;
+
     for (uint32_t i = ray.depth;; ++i) {
         float3 const wo = -ray.direction;
 
@@ -149,22 +187,38 @@ Pathtracer_MIS::Result Pathtracer_MIS::integrate(Ray& ray, Intersection& interse
         }
 
         if (material_sample.is_pure_emissive()) {
-            return result;
+            break;
         }
 
         evaluate_back = material_sample.do_evaluate_back(evaluate_back, same_side);
 
         float const ray_offset = take_settings_.ray_offset_factor * intersection.geo.epsilon;
 
+        bool const guided = guide_tree && material_sample.ior_greater_one() &&
+                            !material_sample.is_specular();
+
+        uint32_t const guide_leaf = guided ? guide_tree->leaf(intersection.geo.p) : 0;
+
+        Guide guide{nullptr, 1.f};
+
+        if (guided && guide_tree->directions(guide_leaf).is_valid()) {
+            guide = Guide{&guide_tree->directions(guide_leaf), guide_tree->bsdf_probability()};
+        }
+
         result.li += throughput * sample_lights(ray, ray_offset, intersection, material_sample,
-                                                evaluate_back, filter, worker);
+                                                guide, evaluate_back, filter, worker);
 
         SOFT_ASSERT(math::all_finite(result.li));
 
         float const previous_bxdf_pdf = sample_result.pdf;
 
-        // Material BSDF importance sample
-        material_sample.sample(material_sampler(ray.depth), sample_result);
+        // Material BSDF importance sample, possibly mixed with the learned incident radiance
+        if (guide.directions) {
+            sample_guided(guide, material_sample, ray.depth, sample_result);
+        } else {
+            material_sample.sample(material_sampler(ray.depth), sample_result);
+        }
+
         if (0.f == sample_result.pdf) {
             break;
         }
@@ -198,6 +252,17 @@ Pathtracer_MIS::Result Pathtracer_MIS::integrate(Ray& ray, Intersection& interse
         if (material_sample.ior_greater_one()) {
             throughput *= sample_result.reflection / sample_result.pdf;
 
+            if (training && guided && !sample_result.type.test(Bxdf_type::Specular) &&
+                num_guide_vertices < Max_guide_vertices) {
+                guide_vertices[num_guide_vertices++] = Guide_vertex{
+                    sample_result.wi, throughput, result.li, sample_result.pdf, guide_leaf};
+            }
+
+            propagate_cone(ray, sample_result.pdf, sample_result.type.test(Bxdf_type::Caustic));
+
+            vertex_p = intersection.geo.p;
+            vertex_n = material_sample.geometric_normal();
+
             ray.origin = intersection.geo.p;
             ray.set_direction(sample_result.wi);
             ray.min_t = ray_offset;
@@ -236,9 +301,9 @@ Pathtracer_MIS::Result Pathtracer_MIS::integrate(Ray& ray, Intersection& interse
 
         if (evaluate_back || treat_as_singular) {
             bool         pure_emissive;
-            float3 const radiance = evaluate_light(ray, intersection, sample_result,
-                                                   treat_as_singular, is_translucent, filter,
-                                                   worker, pure_emissive);
+            float3 const radiance = evaluate_light(ray, intersection, sample_result, vertex_p,
+                                                   vertex_n, treat_as_singular, is_translucent,
+                                                   filter, worker, pure_emissive);
 
             result.li += throughput * radiance;
 
@@ -259,12 +324,21 @@ Pathtracer_MIS::Result Pathtracer_MIS::integrate(Ray& ray, Intersection& interse
         }
     }
 
+    // Everything that the path gathered after a vertex arrived there from the sampled direction
+    for (uint32_t i = 0; i < num_guide_vertices; ++i) {
+        Guide_vertex const& v = guide_vertices[i];
+
+        float const li = incident_luminance(result.li - v.li, v.throughput);
+
+        guide_tree->record(v.leaf, v.wi, li / v.pdf);
+    }
+
     return result;
 }
 
 float3 Pathtracer_MIS::sample_lights(Ray const& ray, float ray_offset, Intersection& intersection,
-                                     const Material_sample& material_sample, bool evaluate_back,
-                                     Filter filter, Worker& worker) noexcept {
+                                     const Material_sample& material_sample, Guide const& guide,
+                                     bool evaluate_back, Filter filter, Worker& worker) noexcept {
     float3 result(0.f);
 
     if (!material_sample.ior_greater_one()) {
@@ -279,11 +353,17 @@ float3 Pathtracer_MIS::sample_lights(Ray const& ray, float ray_offset, Intersect
         for (uint32_t i = num_samples; i > 0; --i) {
             float const select = light_sampler(ray.depth).generate_sample_1D(1);
 
-            auto const light = worker.scene().random_light(select);
+            auto const light = worker.scene().random_light(
+                intersection.geo.p, material_sample.geometric_normal(),
+                material_sample.is_translucent(), select);
+
+            if (0.f == light.pdf) {
+                continue;
+            }
 
             float3 const el = evaluate_light(light.ref, light.pdf, ray, ray_offset, 0,
-                                             evaluate_back, intersection, material_sample, filter,
-                                             worker);
+                                             evaluate_back, intersection, material_sample, guide,
+                                             filter, worker);
 
             result += num_light_samples_reciprocal * el;
         }
@@ -293,7 +373,8 @@ float3 Pathtracer_MIS::sample_lights(Ray const& ray, float ray_offset, Intersect
             auto const& light = *lights[l];
             for (uint32_t i = num_samples; i > 0; --i) {
                 float3 const el = evaluate_light(light, 1.f, ray, ray_offset, l, evaluate_back,
-                                                 intersection, material_sample, filter, worker);
+                                                 intersection, material_sample, guide, filter,
+                                                 worker);
 
                 result += num_light_samples_reciprocal * el;
             }
@@ -306,8 +387,8 @@ float3 Pathtracer_MIS::sample_lights(Ray const& ray, float ray_offset, Intersect
 float3 Pathtracer_MIS::evaluate_light(const Light& light, float light_weight, Ray const& history,
                                       float ray_offset, uint32_t sampler_dimension,
                                       bool evaluate_back, Intersection const& intersection,
-                                      const Material_sample& material_sample, Filter filter,
-                                      Worker& worker) noexcept {
+                                      const Material_sample& material_sample, Guide const& guide,
+                                      Filter filter, Worker& worker) noexcept {
     // Light source importance sample
     shape::Sample_to light_sample;
     if (!light.sample(intersection.geo.p, material_sample.geometric_normal(), history.time,
@@ -333,15 +414,16 @@ float3 Pathtracer_MIS::evaluate_light(const Light& light, float light_weight, Ra
     float3 const radiance = light.evaluate(light_sample, Filter::Nearest, worker);
 
     float const light_pdf = light_sample.pdf * light_weight;
-    float const weight    = evaluate_back ? power_heuristic(light_pdf, bxdf.pdf) : 1.f;
+    float const bxdf_pdf  = guide.pdf(bxdf.pdf, light_sample.wi);
+    float const weight    = evaluate_back ? power_heuristic(light_pdf, bxdf_pdf) : 1.f;
 
     return (weight / light_pdf) * (tv * radiance * bxdf.reflection);
 }
 
 float3 Pathtracer_MIS::evaluate_light(Ray const& ray, Intersection const& intersection,
-                                      Bxdf_sample sample_result, bool treat_as_singular,
-                                      bool is_translucent, Filter filter, Worker& worker,
-                                      bool& pure_emissive) noexcept {
+                                      Bxdf_sample sample_result, float3 const& p, float3 const& n,
+                                      bool treat_as_singular, bool is_translucent, Filter filter,
+                                      Worker& worker, bool& pure_emissive) noexcept {
     uint32_t const light_id = intersection.light_id();
     if (!Light::is_light(light_id)) {
         pure_emissive = false;
@@ -354,7 +436,9 @@ float3 Pathtracer_MIS::evaluate_light(Ray const& ray, Intersection const& inters
         bool const calculate_pdf = Light_sampling::Strategy::Single ==
                                    settings_.light_sampling.strategy;
 
-        auto const light = worker.scene().light(light_id, calculate_pdf);
+        auto const light = calculate_pdf
+                               ? worker.scene().light(light_id, p, n, is_translucent)
+                               : worker.scene().light(light_id, false);
 
         float const ls_pdf = light.ref.pdf(ray, intersection.geo, is_translucent, Filter::Nearest,
                                            worker);
@@ -390,6 +474,49 @@ float3 Pathtracer_MIS::evaluate_light(Ray const& ray, Intersection const& inters
     return radiance;
 }
 
+void Pathtracer_MIS::sample_guided(Guide const& guide, const Material_sample& material_sample,
+                                   uint32_t bounce, Bxdf_sample& result) noexcept {
+    // One sample MIS: the pdf of either choice is the pdf of the mix of both
+    float const bsdf_probability = guide.bsdf_probability;
+
+    if (sampler_.generate_sample_1D() < bsdf_probability) {
+        material_sample.sample(material_sampler(bounce), result);
+
+        if (0.f == result.pdf) {
+            return;
+        }
+
+        // Singular lobes are only ever reached by the BSDF
+        if (result.type.test(Bxdf_type::Specular)) {
+            result.pdf *= bsdf_probability;
+        } else {
+            result.pdf = guide.pdf(result.pdf, result.wi);
+        }
+
+        return;
+    }
+
+    float        guide_pdf;
+    float3 const wi = guide.directions->sample(sampler_.generate_sample_2D(), guide_pdf);
+
+    auto const bxdf = material_sample.evaluate(wi, true);
+
+    if (0.f == guide_pdf || !math::any_greater_zero(bxdf.reflection)) {
+        result.pdf = 0.f;
+        return;
+    }
+
+    bool const same_side = material_sample.same_hemisphere(material_sample.wo());
+
+    result.reflection = bxdf.reflection;
+    result.wi         = wi;
+    result.pdf        = bsdf_probability * bxdf.pdf + (1.f - bsdf_probability) * guide_pdf;
+    result.wavelength = 0.f;
+    result.type.clear(material_sample.same_hemisphere(wi) == same_side
+                          ? Bxdf_type::Glossy_reflection
+                          : Bxdf_type::Glossy_transmission);
+}
+
 sampler::Sampler& Pathtracer_MIS::material_sampler(uint32_t bounce) noexcept {
     if (Num_material_samplers > bounce) {
         return material_samplers_[bounce];
@@ -406,6 +533,14 @@ sampler::Sampler& Pathtracer_MIS::light_sampler(uint32_t bounce) noexcept {
     return sampler_;
 }
 
+float Pathtracer_MIS::Guide::pdf(float bsdf_pdf, float3 const& wi) const noexcept {
+    if (!directions) {
+        return bsdf_pdf;
+    }
+
+    return bsdf_probability * bsdf_pdf + (1.f - bsdf_probability) * directions->pdf(wi);
+}
+
 Pathtracer_MIS_factory::Pathtracer_MIS_factory(take::Settings const& take_settings,
                                                uint32_t num_integrators, uint32_t num_samples,
                                                uint32_t min_bounces, uint32_t max_bounces,
@@ -6,6 +6,10 @@
 #include "sampler/sampler_random.hpp"
 #include "surface_integrator.hpp"
 
+namespace rendering::integrator::guiding {
+class Quadtree;
+}
+
 namespace rendering::integrator::surface {
 
 class alignas(64) Pathtracer_MIS final : public Integrator {
@@ -29,7 +33,7 @@ class alignas(64) Pathtracer_MIS final : public Integrator {
 
     void prepare(Scene const& scene, uint32_t num_samples_per_pixel) noexcept override final;
 
-    void start_pixel() noexcept override final;
+    void start_pixel(uint32_t sample_begin) noexcept override final;
 
     float3 li(Ray& ray, Intersection& intersection, Worker& worker,
               Interface_stack const& initial_stack) noexcept override final;
@@ -43,21 +47,34 @@ class alignas(64) Pathtracer_MIS final : public Integrator {
         bool   split_photon;
     };
 
+    // The learned incident radiance at a vertex, which is sampled in a mix with the BSDF
+    struct Guide {
+        guiding::Quadtree const* directions;
+
+        float bsdf_probability;
+
+        float pdf(float bsdf_pdf, float3 const& wi) const noexcept;
+    };
+
     Result integrate(Ray& ray, Intersection& intersection, Worker& worker,
                      bool integrate_photons) noexcept;
 
     float3 sample_lights(Ray const& ray, float ray_offset, Intersection& intersection,
-                         const Material_sample& material_sample, bool evaluate_back, Filter filter,
-                         Worker& worker) noexcept;
+                         const Material_sample& material_sample, Guide const& guide,
+                         bool evaluate_back, Filter filter, Worker& worker) noexcept;
 
     float3 evaluate_light(const Light& light, float light_weight, Ray const& history,
                           float ray_offset, uint32_t sampler_dimension, bool evaluate_back,
                           Intersection const& intersection, const Material_sample& material_sample,
-                          Filter filter, Worker& worker) noexcept;
+                          Guide const& guide, Filter filter, Worker& worker) noexcept;
 
     float3 evaluate_light(Ray const& ray, Intersection const& intersection,
-                          Bxdf_sample sample_result, bool treat_as_singular, bool is_translucent,
-                          Filter filter, Worker& worker, bool& pure_emissive) noexcept;
+                          Bxdf_sample sample_result, float3 const& p, float3 const& n,
+                          bool treat_as_singular, bool is_translucent, Filter filter,
+                          Worker& worker, bool& pure_emissive) noexcept;
+
+    void sample_guided(Guide const& guide, const Material_sample& material_sample,
+                       uint32_t bounce, Bxdf_sample& result) noexcept;
 
     sampler::Sampler& material_sampler(uint32_t bounce) noexcept;
     sampler::Sampler& light_sampler(uint32_t bounce) noexcept;
@@ -0,0 +1,466 @@
+#include "pathtracer_wf.hpp"
+#include <algorithm>
+#include "base/math/ray_packet.hpp"
+#include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
+#include "base/random/generator.inl"
+#include "base/spectrum/rgb.hpp"
+#include "rendering/integrator/integrator_helper.hpp"
+#include "rendering/rendering_worker.hpp"
+#include "scene/light/light.hpp"
+#include "scene/material/bxdf.hpp"
+#include "scene/material/material.hpp"
+#include "scene/material/material_sample.inl"
+#include "scene/prop/interface_stack.inl"
+#include "scene/prop/prop_intersection.inl"
+#include "scene/scene.hpp"
+#include "scene/scene_constants.hpp"
+#include "scene/scene_ray.inl"
+#include "scene/shape/shape_sample.hpp"
+
+namespace rendering::integrator::surface {
+
+Pathtracer_WF::Pathtracer_WF(rnd::Generator& rng, take::Settings const& take_settings,
+                             Settings const& settings) noexcept
+    : Integrator(rng, take_settings),
+      settings_(settings),
+      sampler_(rng),
+      rays_(memory::allocate_aligned<Ray>(Max_batch_size)),
+      intersections_(memory::allocate_aligned<Intersection>(Max_batch_size)),
+      throughputs_(memory::allocate_aligned<float3>(Max_batch_size)),
+      results_(memory::allocate_aligned<float3>(Max_batch_size)),
+      flags_(memory::allocate_aligned<uint32_t>(Max_batch_size)),
+      num_paths_(0),
+      queue_(memory::allocate_aligned<uint32_t>(Max_batch_size)),
+      keys_(memory::allocate_aligned<uint64_t>(Max_batch_size)),
+      num_shadow_rays_(0) {
+    // One more path worth of light samples for the paths that are finished depth-first
+    uint32_t const num_shadow_rays = (Max_batch_size + 1) * settings.num_light_samples;
+
+    shadow_rays_          = memory::allocate_aligned<Ray>(num_shadow_rays);
+    shadow_radiances_     = memory::allocate_aligned<float3>(num_shadow_rays);
+    shadow_intersections_ = memory::allocate_aligned<Intersection const*>(num_shadow_rays);
+    shadow_results_       = memory::allocate_aligned<float3*>(num_shadow_rays);
+    shadow_filters_       = memory::allocate_aligned<Filter>(num_shadow_rays);
+}
+
+Pathtracer_WF::~Pathtracer_WF() noexcept {
+    memory::free_aligned(shadow_filters_);
+    memory::free_aligned(shadow_results_);
+    memory::free_aligned(shadow_intersections_);
+    memory::free_aligned(shadow_radiances_);
+    memory::free_aligned(shadow_rays_);
+    memory::free_aligned(keys_);
+    memory::free_aligned(queue_);
+    memory::free_aligned(flags_);
+    memory::free_aligned(results_);
+    memory::free_aligned(throughputs_);
+    memory::free_aligned(intersections_);
+    memory::free_aligned(rays_);
+}
+
+void Pathtracer_WF::prepare(Scene const& /*scene*/, uint32_t num_samples_per_pixel) noexcept {
+    sampler_.resize(num_samples_per_pixel, 1, 1, 1);
+}
+
+void Pathtracer_WF::start_pixel(uint32_t sample_begin) noexcept {
+    sampler_.start_pixel(sample_begin);
+}
+
+float3 Pathtracer_WF::li(Ray& ray, Intersection& intersection, Worker& worker,
+                         Interface_stack const& initial_stack) noexcept {
+    worker.reset_interface_stack(initial_stack);
+
+    float3 throughput(1.f);
+    float3 result(0.f);
+
+    uint32_t flags = Primary_ray | Treat_as_singular | Evaluate_back;
+
+    trace(ray, intersection, Path{throughput, result, flags}, worker);
+
+    return result;
+}
+
+Pathtracer_WF* Pathtracer_WF::wavefront() noexcept {
+    return this;
+}
+
+void Pathtracer_WF::integrate(Ray const* rays, uint32_t num_rays, Worker& worker,
+                              float4* results) noexcept {
+    for (uint32_t i = 0; i < num_rays; ++i) {
+        rays_[i]        = rays[i];
+        throughputs_[i] = float3(1.f);
+        results_[i]     = float3(0.f);
+        flags_[i]       = Primary_ray | Treat_as_singular | Evaluate_back;
+        queue_[i]       = i;
+    }
+
+    num_paths_ = num_rays;
+
+    for (bool primary = true; num_paths_ > 0; primary = false) {
+        extend(worker);
+
+        if (primary) {
+            for (uint32_t i = 0; i < num_paths_; ++i) {
+                flags_[queue_[i]] |= Hit;
+            }
+        }
+
+        sort_by_material();
+
+        shade(worker);
+
+        worker.interface_stack().clear();
+
+        shadow(0, worker);
+
+        sort_by_direction();
+    }
+
+    for (uint32_t i = 0; i < num_rays; ++i) {
+        results[i] = (flags_[i] & Hit) ? float4(results_[i], 1.f) : float4(0.f);
+    }
+}
+
+size_t Pathtracer_WF::num_bytes() const noexcept {
+    uint32_t const num_shadow_rays = (Max_batch_size + 1) * settings_.num_light_samples;
+
+    size_t const path_bytes = sizeof(Ray) + sizeof(Intersection) + 2 * sizeof(float3) +
+                              2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+    size_t const shadow_bytes = sizeof(Ray) + sizeof(float3) + sizeof(Intersection const*) +
+                                sizeof(float3*) + sizeof(Filter);
+
+    return sizeof(*this) + sampler_.num_bytes() + Max_batch_size * path_bytes +
+           num_shadow_rays * shadow_bytes;
+}
+
+void Pathtracer_WF::extend(Worker& worker) noexcept {
+    uint32_t num_hits = 0;
+
+    for (uint32_t i = 0; i < num_paths_; i += math::Ray_packet::Size) {
+        uint32_t const num_rays = std::min(num_paths_ - i, math::Ray_packet::Size);
+
+        uint32_t     paths[math::Ray_packet::Size];
+        Ray          rays[math::Ray_packet::Size];
+        Intersection intersections[math::Ray_packet::Size];
+
+        uint32_t mask = 0;
+
+        for (uint32_t r = 0; r < num_rays; ++r) {
+            paths[r] = queue_[i + r];
+            rays[r]  = rays_[paths[r]];
+
+            mask |= 1u << r;
+        }
+
+        uint32_t const hits = worker.intersect(rays, mask, intersections);
+
+        for (uint32_t r = 0; r < num_rays; ++r) {
+            uint32_t const p = paths[r];
+
+            rays_[p]          = rays[r];
+            intersections_[p] = intersections[r];
+
+            if ((hits & (1u << r)) &&
+                worker.resolve_mask(rays_[p], intersections_[p], filter(flags_[p]))) {
+                queue_[num_hits++] = p;
+            }
+        }
+    }
+
+    num_paths_ = num_hits;
+}
+
+static inline void sort_queue(uint64_t* keys, uint32_t* queue, uint32_t num_paths) noexcept {
+    std::sort(keys, keys + num_paths);
+
+    for (uint32_t i = 0; i < num_paths; ++i) {
+        queue[i] = static_cast<uint32_t>(keys[i]);
+    }
+}
+
+void Pathtracer_WF::sort_by_material() noexcept {
+    for (uint32_t i = 0; i < num_paths_; ++i) {
+        uint32_t const p = queue_[i];
+
+        uint64_t const material = reinterpret_cast<uintptr_t>(intersections_[p].material());
+
+        keys_[i] = ((material >> 4) << 32) | p;
+    }
+
+    sort_queue(keys_, queue_, num_paths_);
+}
+
+void Pathtracer_WF::shade(Worker& worker) noexcept {
+    uint32_t num_continued = 0;
+
+    for (uint32_t i = 0; i < num_paths_; ++i) {
+        uint32_t const p = queue_[i];
+
+        Path const path{throughputs_[p], results_[p], flags_[p]};
+
+        Ray&                ray          = rays_[p];
+        Intersection const& intersection = intersections_[p];
+
+        worker.interface_stack().clear();
+
+        Bxdf_sample sample_result;
+        if (!bounce(ray, intersection, path, worker, sample_result)) {
+            continue;
+        }
+
+        if (sample_result.type.test(Bxdf_type::Transmission)) {
+            worker.interface_change(sample_result.wi, intersection);
+
+            if (!worker.interface_stack().empty()) {
+                // Paths inside of media are finished depth-first,
+                // on a copy because the queued light samples still refer to the intersection
+                Intersection temp = intersection;
+
+                if (advance(ray, temp, path, worker)) {
+                    trace(ray, temp, path, worker);
+                }
+
+                continue;
+            }
+        }
+
+        queue_[num_continued++] = p;
+    }
+
+    num_paths_ = num_continued;
+}
+
+void Pathtracer_WF::sort_by_direction() noexcept {
+    for (uint32_t i = 0; i < num_paths_; ++i) {
+        uint32_t const p = queue_[i];
+
+        float3 const& d = rays_[p].direction;
+
+        uint64_t const octant = (d[0] < 0.f ? 1 : 0) | (d[1] < 0.f ? 2 : 0) | (d[2] < 0.f ? 4 : 0);
+
+        keys_[i] = (octant << 32) | p;
+    }
+
+    sort_queue(keys_, queue_, num_paths_);
+}
+
+void Pathtracer_WF::shadow(uint32_t begin, Worker& worker) noexcept {
+    for (uint32_t i = begin, len = num_shadow_rays_; i < len; ++i) {
+        if (float3 tv; worker.transmitted_visibility(shadow_rays_[i], *shadow_intersections_[i],
+                                                     shadow_filters_[i], tv)) {
+            *shadow_results_[i] += tv * shadow_radiances_[i];
+        }
+    }
+
+    num_shadow_rays_ = begin;
+}
+
+void Pathtracer_WF::trace(Ray& ray, Intersection& intersection, Path path,
+                          Worker& worker) noexcept {
+    for (;;) {
+        uint32_t const shadow_begin = num_shadow_rays_;
+
+        Bxdf_sample sample_result;
+        bool const  next = bounce(ray, intersection, path, worker, sample_result);
+
+        shadow(shadow_begin, worker);
+
+        if (!next) {
+            break;
+        }
+
+        if (sample_result.type.test(Bxdf_type::Transmission)) {
+            worker.interface_change(sample_result.wi, intersection);
+        }
+
+        if (!advance(ray, intersection, path, worker)) {
+            break;
+        }
+    }
+}
+
+bool Pathtracer_WF::advance(Ray& ray, Intersection& intersection, Path path,
+                            Worker& worker) noexcept {
+    Filter const filter = Pathtracer_WF::filter(path.flags);
+
+    if (!worker.interface_stack().empty()) {
+        float3     vli, vtr;
+        bool const hit = worker.volume(ray, intersection, filter, vli, vtr);
+
+        path.result += path.throughput * vli;
+        path.throughput *= vtr;
+
+        return hit;
+    }
+
+    return worker.intersect_and_resolve_mask(ray, intersection, filter);
+}
+
+bool Pathtracer_WF::bounce(Ray& ray, Intersection const& intersection, Path path, Worker& worker,
+                           Bxdf_sample& sample_result) noexcept {
+    float3 const wo = -ray.direction;
+
+    Filter const filter = Pathtracer_WF::filter(path.flags);
+
+    bool const avoid_caustics = settings_.avoid_caustics && !(path.flags & Primary_ray) &&
+                                worker.interface_stack().top_is_vacuum_or_not_scattering();
+
+    auto& material_sample = intersection.sample(wo, ray, filter, avoid_caustics, sampler_, worker);
+
+    bool const same_side = material_sample.same_hemisphere(wo);
+
+    if ((path.flags & Treat_as_singular) && same_side) {
+        path.result += path.throughput * material_sample.radiance();
+    }
+
+    if (material_sample.is_pure_emissive()) {
+        return false;
+    }
+
+    if (material_sample.do_evaluate_back(path.flags & Evaluate_back, same_side)) {
+        path.flags |= Evaluate_back;
+    } else {
+        path.flags &= ~Evaluate_back;
+    }
+
+    direct_light(ray, intersection, material_sample, path, worker);
+
+    if (ray.depth >= settings_.max_bounces - 1) {
+        return false;
+    }
+
+    if (ray.depth > settings_.min_bounces) {
+        float const q = settings_.path_continuation_probability;
+        if (rendering::russian_roulette(path.throughput, q, sampler_.generate_sample_1D())) {
+            return false;
+        }
+    }
+
+    material_sample.sample(sampler_, sample_result);
+    if (0.f == sample_result.pdf) {
+        return false;
+    }
+
+    if (sample_result.type.test(Bxdf_type::Caustic)) {
+        if (material_sample.ior_greater_one()) {
+            if (avoid_caustics) {
+                return false;
+            }
+
+            if (sample_result.type.test(Bxdf_type::Specular)) {
+                path.flags |= Treat_as_singular;
+            } else {
+                path.flags &= ~Treat_as_singular;
+            }
+        }
+    } else {
+        path.flags &= ~(Primary_ray | Treat_as_singular);
+        path.flags |= Nearest_filter;
+    }
+
+    if (0.f == ray.wavelength) {
+        ray.wavelength = sample_result.wavelength;
+    }
+
+    float const ray_offset = take_settings_.ray_offset_factor * intersection.geo.epsilon;
+
+    if (material_sample.ior_greater_one()) {
+        path.throughput *= sample_result.reflection / sample_result.pdf;
+
+        propagate_cone(ray, sample_result.pdf, sample_result.type.test(Bxdf_type::Caustic));
+
+        ray.origin = intersection.geo.p;
+        ray.set_direction(sample_result.wi);
+        ray.min_t = ray_offset;
+        ++ray.depth;
+    } else {
+        ray.min_t = ray.max_t + ray_offset;
+    }
+
+    ray.max_t = scene::Ray_max_t;
+
+    return true;
+}
+
+void Pathtracer_WF::direct_light(Ray const& ray, Intersection const& intersection,
+                                 Material_sample const& material_sample, Path path,
+                                 Worker& worker) noexcept {
+    if (!material_sample.ior_greater_one()) {
+        return;
+    }
+
+    bool const evaluate_back = path.flags & Evaluate_back;
+
+    float const num_samples_reciprocal = 1.f / static_cast<float>(settings_.num_light_samples);
+
+    for (uint32_t i = settings_.num_light_samples; i > 0; --i) {
+        float const select = sampler_.generate_sample_1D(1);
+
+        auto const light = worker.scene().random_light(select);
+
+        scene::shape::Sample_to light_sample;
+        if (!light.ref.sample(intersection.geo.p, material_sample.geometric_normal(), ray.time,
+                              material_sample.is_translucent(), sampler_, 0, worker,
+                              light_sample)) {
+            continue;
+        }
+
+        // The contribution is evaluated now, and only added if the shadow test passes later
+        auto const bxdf = material_sample.evaluate(light_sample.wi, evaluate_back);
+
+        float3 const radiance = light.ref.evaluate(light_sample, Filter::Nearest, worker);
+
+        float const weight = num_samples_reciprocal / (light.pdf * light_sample.pdf);
+
+        uint32_t const s = num_shadow_rays_++;
+
+        Ray& shadow_ray = shadow_rays_[s];
+
+        float const offset = take_settings_.ray_offset_factor * light_sample.epsilon;
+
+        shadow_ray.origin = intersection.geo.p;
+        shadow_ray.set_direction(light_sample.wi);
+        shadow_ray.min_t      = take_settings_.ray_offset_factor * intersection.geo.epsilon;
+        shadow_ray.max_t      = light_sample.t - offset;
+        shadow_ray.depth      = ray.depth;
+        shadow_ray.time       = ray.time;
+        shadow_ray.wavelength = ray.wavelength;
+
+        shadow_radiances_[s]     = weight * (path.throughput * radiance * bxdf.reflection);
+        shadow_intersections_[s] = &intersection;
+        shadow_results_[s]       = &path.result;
+        shadow_filters_[s]       = filter(path.flags);
+    }
+}
+
+Pathtracer_WF::Filter Pathtracer_WF::filter(uint32_t flags) noexcept {
+    return (flags & Nearest_filter) ? Filter::Nearest : Filter::Undefined;
+}
+
+Pathtracer_WF_factory::Pathtracer_WF_factory(take::Settings const& take_settings,
+                                             uint32_t num_integrators, uint32_t min_bounces,
+                                             uint32_t max_bounces,
+                                             float    path_termination_probability,
+                                             uint32_t num_light_samples,
+                                             bool     enable_caustics) noexcept
+    : Factory(take_settings),
+      integrators_(memory::allocate_aligned<Pathtracer_WF>(num_integrators)) {
+    settings_.min_bounces                   = min_bounces;
+    settings_.max_bounces                   = max_bounces;
+    settings_.path_continuation_probability = 1.f - path_termination_probability;
+    settings_.num_light_samples             = num_light_samples;
+    settings_.avoid_caustics                = !enable_caustics;
+}
+
+Pathtracer_WF_factory::~Pathtracer_WF_factory() noexcept {
+    memory::free_aligned(integrators_);
+}
+
+Integrator* Pathtracer_WF_factory::create(uint32_t id, rnd::Generator& rng) const noexcept {
+    return new (&integrators_[id]) Pathtracer_WF(rng, take_settings_, settings_);
+}
+
+}  // namespace rendering::integrator::surface
@@ -0,0 +1,130 @@
+#ifndef SU_CORE_RENDERING_INTEGRATOR_SURFACE_PATHTRACER_WF_HPP
+#define SU_CORE_RENDERING_INTEGRATOR_SURFACE_PATHTRACER_WF_HPP
+
+#include "base/math/vector4.hpp"
+#include "sampler/sampler_random.hpp"
+#include "scene/material/sampler_settings.hpp"
+#include "surface_integrator.hpp"
+
+namespace rendering::integrator::surface {
+
+// Wavefront version of Pathtracer_DL:
+// All paths of a batch are advanced together, one bounce per pass, which is split into
+// extend, shade and shadow stages that each work on queues of path states.
+class alignas(64) Pathtracer_WF final : public Integrator {
+  public:
+    struct Settings {
+        uint32_t min_bounces;
+        uint32_t max_bounces;
+        float    path_continuation_probability;
+
+        uint32_t num_light_samples;
+
+        bool avoid_caustics;
+    };
+
+    static uint32_t constexpr Max_batch_size = 4096;
+
+    Pathtracer_WF(rnd::Generator& rng, take::Settings const& take_settings,
+                  Settings const& settings) noexcept;
+
+    ~Pathtracer_WF() noexcept override final;
+
+    void prepare(Scene const& scene, uint32_t num_samples_per_pixel) noexcept override final;
+
+    void start_pixel(uint32_t sample_begin) noexcept override final;
+
+    // Traces the path depth-first, e.g. for cameras that are inside a medium
+    float3 li(Ray& ray, Intersection& intersection, Worker& worker,
+              Interface_stack const& initial_stack) noexcept override final;
+
+    Pathtracer_WF* wavefront() noexcept override final;
+
+    // Traces the camera rays breadth-first, writing one result per ray.
+    // num_rays must not be larger than Max_batch_size.
+    void integrate(Ray const* rays, uint32_t num_rays, Worker& worker, float4* results) noexcept;
+
+    size_t num_bytes() const noexcept override final;
+
+  private:
+    enum Flag : uint32_t {
+        Primary_ray       = 1u << 0,
+        Treat_as_singular = 1u << 1,
+        Evaluate_back     = 1u << 2,
+        Nearest_filter    = 1u << 3,
+        Hit               = 1u << 4
+    };
+
+    struct Path {
+        float3& throughput;
+        float3& result;
+
+        uint32_t& flags;
+    };
+
+    void extend(Worker& worker) noexcept;
+
+    void sort_by_material() noexcept;
+
+    void shade(Worker& worker) noexcept;
+
+    void sort_by_direction() noexcept;
+
+    void shadow(uint32_t begin, Worker& worker) noexcept;
+
+    void trace(Ray& ray, Intersection& intersection, Path path, Worker& worker) noexcept;
+
+    bool advance(Ray& ray, Intersection& intersection, Path path, Worker& worker) noexcept;
+
+    bool bounce(Ray& ray, Intersection const& intersection, Path path, Worker& worker,
+                Bxdf_sample& sample_result) noexcept;
+
+    void direct_light(Ray const& ray, Intersection const& intersection,
+                      Material_sample const& material_sample, Path path, Worker& worker) noexcept;
+
+    static Filter filter(uint32_t flags) noexcept;
+
+    const Settings settings_;
+
+    sampler::Random sampler_;
+
+    // Path states, the queue refers to them by index
+    Ray*          rays_;
+    Intersection* intersections_;
+    float3*       throughputs_;
+    float3*       results_;
+    uint32_t*     flags_;
+
+    uint32_t  num_paths_;
+    uint32_t* queue_;
+    uint64_t* keys_;
+
+    // Light samples waiting for their shadow test
+    uint32_t             num_shadow_rays_;
+    Ray*                 shadow_rays_;
+    float3*              shadow_radiances_;
+    Intersection const** shadow_intersections_;
+    float3**             shadow_results_;
+    Filter*              shadow_filters_;
+};
+
+class Pathtracer_WF_factory final : public Factory {
+  public:
+    Pathtracer_WF_factory(take::Settings const& take_settings, uint32_t num_integrators,
+                          uint32_t min_bounces, uint32_t max_bounces,
+                          float path_termination_probability, uint32_t num_light_samples,
+                          bool enable_caustics) noexcept;
+
+    ~Pathtracer_WF_factory() noexcept override final;
+
+    Integrator* create(uint32_t id, rnd::Generator& rng) const noexcept override final;
+
+  private:
+    Pathtracer_WF* integrators_;
+
+    Pathtracer_WF::Settings settings_;
+};
+
+}  // namespace rendering::integrator::surface
+
+#endif
@@ -7,6 +7,10 @@ Integrator::Integrator(rnd::Generator& rng, take::Settings const& settings) noex
 
 Integrator::~Integrator() noexcept {}
 
+Pathtracer_WF* Integrator::wavefront() noexcept {
+    return nullptr;
+}
+
 Factory::Factory(take::Settings const& settings) noexcept : take_settings_(settings) {}
 
 Factory::~Factory() noexcept {}
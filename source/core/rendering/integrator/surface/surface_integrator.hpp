@@ -14,6 +14,8 @@ class Worker;
 
 namespace integrator::surface {
 
+class Pathtracer_WF;
+
 class Integrator : public integrator::Integrator {
   public:
     using Interface_stack = scene::prop::Interface_stack;
@@ -24,6 +26,9 @@ class Integrator : public integrator::Integrator {
 
     virtual float3 li(Ray& ray, Intersection& intersection, Worker& worker,
                       Interface_stack const& initial_stack) noexcept = 0;
+
+    // Integrators that can trace whole batches of camera rays breadth-first return themselves
+    virtual Pathtracer_WF* wavefront() noexcept;
 };
 
 class Factory {
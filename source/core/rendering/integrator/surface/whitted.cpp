@@ -25,8 +25,8 @@ void Whitted::prepare(Scene const& scene, uint32_t num_samples_per_pixel) noexce
     sampler_.resize(num_samples_per_pixel, settings_.num_light_samples, num_lights, num_lights);
 }
 
-void Whitted::start_pixel() noexcept {
-    sampler_.start_pixel();
+void Whitted::start_pixel(uint32_t sample_begin) noexcept {
+    sampler_.start_pixel(sample_begin);
 }
 
 float3 Whitted::li(Ray& ray, Intersection& intersection, Worker& worker,
@@ -24,7 +24,7 @@ Tracking_multi::Tracking_multi(rnd::Generator& rng, take::Settings const& take_s
 
 void Tracking_multi::prepare(Scene const& /*scene*/, uint32_t /*num_samples_per_pixel*/) noexcept {}
 
-void Tracking_multi::start_pixel() noexcept {}
+void Tracking_multi::start_pixel(uint32_t /*sample_begin*/) noexcept {}
 
 bool Tracking_multi::transmittance(Ray const& ray, Worker& worker, float3& transmittance) noexcept {
     return Tracking::transmittance(ray, rng_, worker, transmittance);
@@ -12,7 +12,7 @@ class alignas(64) Tracking_single final : public Integrator {
 
     void prepare(Scene const& scene, uint32_t num_samples_per_pixel) noexcept override final;
 
-    void start_pixel() noexcept override final;
+    void start_pixel(uint32_t sample_begin) noexcept override final;
 
     bool transmittance(Ray const& ray, Worker& worker,
                        float3& transmittance) noexcept override final;
@@ -13,6 +13,10 @@ bool Postprocessor::alpha_out(bool alpha_in) const {
     return alpha_in;
 }
 
+bool Postprocessor::per_pixel() const {
+    return false;
+}
+
 void Postprocessor::apply(const image::Float4& source, image::Float4& destination,
                           thread::Pool& pool) {
     pre_apply(source, destination, pool);
@@ -26,6 +30,11 @@ void Postprocessor::apply(const image::Float4& source, image::Float4& destinatio
     }
 }
 
+void Postprocessor::apply_block(uint32_t id, int32_t begin, int32_t end,
+                                image::Float4& target) {
+    apply(id, 0, begin, end, target, target);
+}
+
 void Postprocessor::pre_apply(const image::Float4& /*source*/, image::Float4& /*destination*/,
                               thread::Pool& /*pool*/) {}
 
@@ -21,8 +21,15 @@ class Postprocessor {
 
     virtual bool alpha_out(bool alpha_in) const;
 
+    // Postprocessors that only read the pixel they write,
+    // which allows the pipeline to fuse them with their neighbors into a single pass
+    virtual bool per_pixel() const;
+
     void apply(const image::Float4& source, image::Float4& destination, thread::Pool& pool);
 
+    // In place on the pixels [begin, end), only valid for per_pixel() postprocessors
+    void apply_block(uint32_t id, int32_t begin, int32_t end, image::Float4& target);
+
   private:
     virtual void pre_apply(const image::Float4& source, image::Float4& destination,
                            thread::Pool& pool);
@@ -13,6 +13,10 @@ bool Backplate::alpha_out(bool /*alpha_in*/) const {
     return false;
 }
 
+bool Backplate::per_pixel() const {
+    return true;
+}
+
 size_t Backplate::num_bytes() const {
     return sizeof(*this);
 }
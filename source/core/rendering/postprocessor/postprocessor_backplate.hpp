@@ -14,6 +14,8 @@ class Backplate : public Postprocessor {
 
     virtual bool alpha_out(bool alpha_in) const override final;
 
+    virtual bool per_pixel() const override final;
+
     virtual size_t num_bytes() const override final;
 
   private:
@@ -2,7 +2,7 @@
 #include <vector>
 #include "base/math/exp.hpp"
 #include "base/math/filter/gaussian.hpp"
-#include "base/math/fourier/dft.hpp"
+#include "base/math/fourier/fft.hpp"
 #include "base/math/simd_vector.inl"
 #include "base/math/vector4.inl"
 #include "base/memory/align.hpp"
@@ -29,11 +29,9 @@ Glare2::Glare2(Adaption adaption, float threshold, float intensity)
       high_pass_b_(nullptr),
       high_pass_dft_r_(nullptr),
       high_pass_dft_g_(nullptr),
-      high_pass_dft_b_(nullptr),
-      temp_(nullptr) {}
+      high_pass_dft_b_(nullptr) {}
 
 Glare2::~Glare2() {
-    memory::free_aligned(temp_);
     memory::free_aligned(high_pass_dft_b_);
     memory::free_aligned(high_pass_dft_g_);
     memory::free_aligned(high_pass_dft_r_);
@@ -211,22 +209,21 @@ void Glare2::init(scene::camera::Camera const& camera, thread::Pool& pool) {
         }
     }
 
-    int32_t const kernel_dft_size = math::dft_size(kernel_dimensions_[0]) * kernel_dimensions_[1];
+    int32_t const kernel_dft_size = math::fft::real_size(kernel_dimensions_[0]) *
+                                    kernel_dimensions_[1];
 
     kernel_dft_r_ = memory::allocate_aligned<float2>(kernel_dft_size);
     kernel_dft_g_ = memory::allocate_aligned<float2>(kernel_dft_size);
     kernel_dft_b_ = memory::allocate_aligned<float2>(kernel_dft_size);
 
-    temp_ = memory::allocate_aligned<float2>(kernel_dft_size);
+    math::fft::forward_real_2d(kernel_dft_r_, kernel_r, kernel_dimensions_[0],
+                               kernel_dimensions_[1], pool);
 
-    math::dft_2d(kernel_dft_r_, kernel_r, temp_, kernel_dimensions_[0], kernel_dimensions_[1],
-                 pool);
+    math::fft::forward_real_2d(kernel_dft_g_, kernel_g, kernel_dimensions_[0],
+                               kernel_dimensions_[1], pool);
 
-    math::dft_2d(kernel_dft_g_, kernel_g, temp_, kernel_dimensions_[0], kernel_dimensions_[1],
-                 pool);
-
-    math::dft_2d(kernel_dft_b_, kernel_b, temp_, kernel_dimensions_[0], kernel_dimensions_[1],
-                 pool);
+    math::fft::forward_real_2d(kernel_dft_b_, kernel_b, kernel_dimensions_[0],
+                               kernel_dimensions_[1], pool);
 
     memory::free_aligned(kernel_b);
     memory::free_aligned(kernel_g);
@@ -244,10 +241,10 @@ void Glare2::init(scene::camera::Camera const& camera, thread::Pool& pool) {
 size_t Glare2::num_bytes() const {
     size_t const kernel_size = static_cast<size_t>(kernel_dimensions_[0] * kernel_dimensions_[1]);
 
-    size_t const kernel_dft_size = static_cast<size_t>(math::dft_size(kernel_dimensions_[0]) *
+    size_t const kernel_dft_size = static_cast<size_t>(math::fft::real_size(kernel_dimensions_[0]) *
                                                        kernel_dimensions_[1]);
 
-    return sizeof(*this) + kernel_size * sizeof(float) * 3 + kernel_dft_size * sizeof(float2) * 7;
+    return sizeof(*this) + kernel_size * sizeof(float) * 3 + kernel_dft_size * sizeof(float2) * 6;
 }
 
 static inline float2 mul_complex(float2 a, float2 b, float scale) {
@@ -293,11 +290,12 @@ void Glare2::pre_apply(const image::Float4& source, image::Float4& destination,
     //	image::encoding::png::Writer::write("high_pass_g.png", high_pass_g_, dim, 16.f);
     //	image::encoding::png::Writer::write("high_pass_b.png", high_pass_b_, dim, 16.f);
 
-    int32_t const kernel_dft_size = math::dft_size(kernel_dimensions_[0]) * kernel_dimensions_[1];
+    int32_t const kernel_dft_size = math::fft::real_size(kernel_dimensions_[0]) *
+                                    kernel_dimensions_[1];
 
-    math::dft_2d(high_pass_dft_r_, high_pass_r_, temp_, dim[0], dim[1], pool);
-    math::dft_2d(high_pass_dft_g_, high_pass_g_, temp_, dim[0], dim[1], pool);
-    math::dft_2d(high_pass_dft_b_, high_pass_b_, temp_, dim[0], dim[1], pool);
+    math::fft::forward_real_2d(high_pass_dft_r_, high_pass_r_, dim[0], dim[1], pool);
+    math::fft::forward_real_2d(high_pass_dft_g_, high_pass_g_, dim[0], dim[1], pool);
+    math::fft::forward_real_2d(high_pass_dft_b_, high_pass_b_, dim[0], dim[1], pool);
 
     pool.run_range(
         [this, dim](uint32_t /*id*/, int32_t begin, int32_t end) {
@@ -314,13 +312,14 @@ void Glare2::pre_apply(const image::Float4& source, image::Float4& destination,
         },
         0, kernel_dft_size);
 
-    //	int2 kernel_dft_dimensions(math::dft_size(kernel_dimensions_[0]), kernel_dimensions_[1]);
+    //	int2 kernel_dft_dimensions(math::fft::real_size(kernel_dimensions_[0]),
+    //	                           kernel_dimensions_[1]);
     //	image::encoding::png::Writer::write("high_pass_dft_r.png", high_pass_dft_r_,
     //										kernel_dft_dimensions, 16.f);
 
-    math::idft_2d(high_pass_r_, high_pass_dft_r_, temp_, dim[0], dim[1], pool);
-    math::idft_2d(high_pass_g_, high_pass_dft_g_, temp_, dim[0], dim[1], pool);
-    math::idft_2d(high_pass_b_, high_pass_dft_b_, temp_, dim[0], dim[1], pool);
+    math::fft::inverse_real_2d(high_pass_r_, high_pass_dft_r_, dim[0], dim[1], pool);
+    math::fft::inverse_real_2d(high_pass_g_, high_pass_dft_g_, dim[0], dim[1], pool);
+    math::fft::inverse_real_2d(high_pass_b_, high_pass_dft_b_, dim[0], dim[1], pool);
 
     int2 const offset = dim / 4;
 
@@ -39,8 +39,6 @@ class Glare2 : public Postprocessor {
     float2* high_pass_dft_r_;
     float2* high_pass_dft_g_;
     float2* high_pass_dft_b_;
-
-    float2* temp_;
 };
 
 }  // namespace rendering::postprocessor
@@ -1,35 +1,41 @@
 #include "postprocessor_glare3.hpp"
 #include <vector>
 #include "base/math/exp.hpp"
-#include "base/math/filter/gaussian.hpp"
-#include "base/math/sample_distribution.inl"
-#include "base/math/simd_vector.inl"
+#include "base/math/fourier/fft.hpp"
 #include "base/math/vector4.inl"
 #include "base/memory/align.hpp"
-#include "base/random/generator.inl"
 #include "base/spectrum/interpolated.hpp"
 #include "base/spectrum/rgb.hpp"
 #include "base/spectrum/xyz.hpp"
 #include "base/thread/thread_pool.hpp"
 #include "image/typed_image.inl"
 
-#include "base/math/print.hpp"
-
 namespace rendering::postprocessor {
 
 Glare3::Glare3(Adaption adaption, float threshold, float intensity)
-    : Postprocessor(4),
-      adaption_(adaption),
+    : adaption_(adaption),
       threshold_(threshold),
       intensity_(intensity),
-      high_pass_(nullptr),
-      kernel_(nullptr),
-      gauss_kernel_(nullptr) {}
+      kernel_dft_r_(nullptr),
+      kernel_dft_g_(nullptr),
+      kernel_dft_b_(nullptr),
+      high_pass_r_(nullptr),
+      high_pass_g_(nullptr),
+      high_pass_b_(nullptr),
+      high_pass_dft_r_(nullptr),
+      high_pass_dft_g_(nullptr),
+      high_pass_dft_b_(nullptr) {}
 
 Glare3::~Glare3() {
-    memory::free_aligned(gauss_kernel_);
-    memory::free_aligned(kernel_);
-    memory::free_aligned(high_pass_);
+    memory::free_aligned(high_pass_dft_b_);
+    memory::free_aligned(high_pass_dft_g_);
+    memory::free_aligned(high_pass_dft_r_);
+    memory::free_aligned(high_pass_b_);
+    memory::free_aligned(high_pass_g_);
+    memory::free_aligned(high_pass_r_);
+    memory::free_aligned(kernel_dft_b_);
+    memory::free_aligned(kernel_dft_g_);
+    memory::free_aligned(kernel_dft_r_);
 }
 
 static inline float f0(float theta) {
@@ -54,15 +60,13 @@ static inline float f3(float theta, float lambda) {
 
 void Glare3::init(scene::camera::Camera const& camera, thread::Pool& pool) {
     auto const dim = camera.sensor_dimensions();
-    dimensions_    = dim;
-    high_pass_     = memory::allocate_aligned<float3>(dim[0] * dim[1]);
 
     // This seems a bit arbitrary
     float const solid_angle = 0.5f * math::radians_to_degrees(camera.pixel_solid_angle());
 
-    kernel_dimensions_  = 2 * dim;
+    // Padded to sizes that the FFT can split into small radices
+    kernel_dimensions_  = int2(math::fft::fast_size(2 * dim[0]), math::fft::fast_size(2 * dim[1]));
     int32_t kernel_size = kernel_dimensions_[0] * kernel_dimensions_[1];
-    kernel_             = memory::allocate_aligned<float3>(kernel_size);
 
     spectrum::Interpolated const CIE_X(spectrum::CIE_Wavelengths_360_830_1nm,
                                        spectrum::CIE_X_360_830_1nm, spectrum::CIE_XYZ_Num);
@@ -102,7 +106,17 @@ void Glare3::init(scene::camera::Camera const& camera, thread::Pool& pool) {
 
             for (int32_t y = begin; y < end; ++y) {
                 for (int32_t x = 0; x < kernel_dimensions_[0]; ++x) {
-                    int2 p(-dim[0] + x, -dim[1] + y);
+                    // The kernel is stored wrapped around, with the center at the origin
+                    int2 p(x < dim[0] ? x : x - kernel_dimensions_[0],
+                           y < dim[1] ? y : y - kernel_dimensions_[1]);
+
+                    int32_t i = y * kernel_dimensions_[0] + x;
+
+                    // The padding is beyond any offset between two pixels of the image
+                    if (p[0] < -dim[0] || p[1] < -dim[1]) {
+                        f[i] = F{0.f, 0.f, 0.f, float3(0.f)};
+                        continue;
+                    }
 
                     float theta = math::length(float2(p)) * solid_angle;
 
@@ -131,8 +145,7 @@ void Glare3::init(scene::camera::Camera const& camera, thread::Pool& pool) {
                         init.d_sum += d;
                     }
 
-                    int32_t i = y * kernel_dimensions_[0] + x;
-                    f[i]      = F{a, b, c, d};
+                    f[i] = F{a, b, c, d};
                 }
             }
         },
@@ -178,189 +191,140 @@ void Glare3::init(scene::camera::Camera const& camera, thread::Pool& pool) {
     float const b_n = scale[1] / b_sum;
     float const c_n = scale[2] / c_sum;
 
+    float* kernel_r = memory::allocate_aligned<float>(kernel_size);
+    float* kernel_g = memory::allocate_aligned<float>(kernel_size);
+    float* kernel_b = memory::allocate_aligned<float>(kernel_size);
+
     if (Adaption::Photopic == adaption_) {
-        for (int32_t i = 0, len = kernel_size; i < len; ++i) {
-            kernel_[i] = float3(a_n * f[i].a + b_n * f[i].b + c_n * f[i].c);
+        for (int32_t i = 0; i < kernel_size; ++i) {
+            float const k = a_n * f[i].a + b_n * f[i].b + c_n * f[i].c;
+
+            kernel_r[i] = k;
+            kernel_g[i] = k;
+            kernel_b[i] = k;
         }
     } else {
         float3 const d_n = float3(scale[3]) / d_sum;
 
-        for (int32_t i = 0, len = kernel_size; i < len; ++i) {
-            kernel_[i] = float3(a_n * f[i].a + b_n * f[i].b + c_n * f[i].c) + d_n * f[i].d;
+        for (int32_t i = 0; i < kernel_size; ++i) {
+            float3 const k = float3(a_n * f[i].a + b_n * f[i].b + c_n * f[i].c) + d_n * f[i].d;
+
+            kernel_r[i] = k[0];
+            kernel_g[i] = k[1];
+            kernel_b[i] = k[2];
         }
     }
 
-    // Gaussian blur
-    float const radius = 16.f;  // static_cast<float>(std::max(dim[0], dim[1])) * 0.00125f;
-    gauss_width_       = 2 * std::max(static_cast<int32_t>(radius + 0.5f), 1) + 1;
+    int32_t const kernel_dft_size = math::fft::real_size(kernel_dimensions_[0]) *
+                                    kernel_dimensions_[1];
 
-    gauss_kernel_ = memory::allocate_aligned<K>(gauss_width_);
+    kernel_dft_r_ = memory::allocate_aligned<float2>(kernel_dft_size);
+    kernel_dft_g_ = memory::allocate_aligned<float2>(kernel_dft_size);
+    kernel_dft_b_ = memory::allocate_aligned<float2>(kernel_dft_size);
 
-    float const                          fr = radius + 0.5f;
-    const math::filter::Gaussian_functor gauss(static_cast<float>(fr * fr),
-                                               /*radius * 0.5f*/ 0.15f);
+    math::fft::forward_real_2d(kernel_dft_r_, kernel_r, kernel_dimensions_[0],
+                               kernel_dimensions_[1], pool);
 
-    int32_t const ir = static_cast<int32_t>(radius);
+    math::fft::forward_real_2d(kernel_dft_g_, kernel_g, kernel_dimensions_[0],
+                               kernel_dimensions_[1], pool);
 
-    for (int32_t x = 0, len = gauss_width_; x < len; ++x) {
-        int32_t const o = -ir + x;
+    math::fft::forward_real_2d(kernel_dft_b_, kernel_b, kernel_dimensions_[0],
+                               kernel_dimensions_[1], pool);
 
-        float const fo = static_cast<float>(o);
-        float const w  = gauss(fo * fo);
+    memory::free_aligned(kernel_b);
+    memory::free_aligned(kernel_g);
+    memory::free_aligned(kernel_r);
 
-        gauss_kernel_[x] = K{o, w};
-    }
-}
+    high_pass_r_ = memory::allocate_aligned<float>(kernel_size);
+    high_pass_g_ = memory::allocate_aligned<float>(kernel_size);
+    high_pass_b_ = memory::allocate_aligned<float>(kernel_size);
 
-size_t Glare3::num_bytes() const {
-    return sizeof(*this) + (dimensions_[0] * dimensions_[1]) * sizeof(float3) +
-           (kernel_dimensions_[0] * kernel_dimensions_[1]) * sizeof(float3);
+    high_pass_dft_r_ = memory::allocate_aligned<float2>(kernel_dft_size);
+    high_pass_dft_g_ = memory::allocate_aligned<float2>(kernel_dft_size);
+    high_pass_dft_b_ = memory::allocate_aligned<float2>(kernel_dft_size);
 }
 
-void Glare3::apply(uint32_t id, uint32_t pass, int32_t begin, int32_t end,
-                   const image::Float4& source, image::Float4& destination) {
-    if (0 == pass) {
-        float const threshold = threshold_;
-
-        for (int32_t i = begin; i < end; ++i) {
-            float3 const color = source.at(i).xyz();
-            float const  l     = spectrum::luminance(color);
-
-            if (l > threshold) {
-                high_pass_[i] = color;
-            } else {
-                high_pass_[i] = float3(0.f);
-            }
-        }
-    } else if (1 == pass) {
-        auto const d = destination.description().dimensions.xy();
-
-        float const fdm0 = static_cast<float>(d[0] - 1);
-        float const fdm1 = static_cast<float>(d[1] - 1);
-
-        int32_t const num_samples = 4096;  // std::max(d[0], d[1]) * 2;
-
-        float const weight = static_cast<float>(d[0] * d[1]) / static_cast<float>(num_samples);
-
-        float const intensity = weight * intensity_;
-        // Vector const intensity = simd::set_float4(intensity_);
-
-        int32_t const kd0 = kernel_dimensions_[0];
-
-        rnd::Generator rng(0, id);
-
-        for (int32_t i = begin; i < end; ++i) {
-            int2 const c  = destination.coordinates_2(i);
-            int2 const kb = d - c;
+size_t Glare3::num_bytes() const {
+    size_t const kernel_size = static_cast<size_t>(kernel_dimensions_[0] * kernel_dimensions_[1]);
 
-            //			float2 const center = (float2(c) + float2(0.5f)) / float2(d);
+    size_t const kernel_dft_size = static_cast<size_t>(math::fft::real_size(kernel_dimensions_[0]) *
+                                                       kernel_dimensions_[1]);
 
-            uint32_t const r = rng.random_uint();
+    return sizeof(*this) + kernel_size * sizeof(float) * 3 + kernel_dft_size * sizeof(float2) * 6;
+}
 
-            float3 glare(0.f);
-            for (int32_t j = 0; j < num_samples; ++j) {
-                //				float const r0 = rng.random_float();
-                //				float const r1 = rng.random_float();
+static inline float2 mul_complex(float2 a, float2 b, float scale) {
+    return scale * float2(a[0] * b[0] - a[1] * b[1], a[0] * b[1] + a[1] * b[0]);
+}
 
-                //				int32_t const sx = static_cast<int32_t>(r0 * fdm0);
-                //				int32_t const sy = static_cast<int32_t>(r1 * fdm1);
+void Glare3::pre_apply(const image::Float4& source, image::Float4& /*destination*/,
+                       thread::Pool& pool) {
+    auto const dim = kernel_dimensions_;
 
-                float2 uv = math::hammersley(j, num_samples, r);
+    pool.run_range(
+        [this, dim, &source](uint32_t /*id*/, int32_t begin, int32_t end) {
+            float const threshold = threshold_;
 
-                //				float2 const d = uv - center;
-                //				float const scale = 2.f * std::max(std::abs(d[0]),
-                // std::abs(d[1]));
+            int2 const source_dim = source.dimensions2();
 
-                //				uv = scale * d + center;
+            for (int32_t y = begin, i = begin * dim[0]; y < end; ++y) {
+                for (int32_t x = 0; x < dim[0]; ++x, ++i) {
+                    float3 out(0.f);
 
-                int32_t const sx = static_cast<int32_t>(uv[0] * fdm0);
-                int32_t const sy = static_cast<int32_t>(uv[1] * fdm1);
+                    if (x < source_dim[0] && y < source_dim[1]) {
+                        float3 const color = source.at(x, y).xyz();
 
-                int32_t const si = sy * d[0] + sx;
+                        if (spectrum::luminance(color) > threshold) {
+                            out = color;
+                        }
+                    }
 
-                int2 const kc = kb + int2(sx, sy);
+                    high_pass_r_[i] = out[0];
+                    high_pass_g_[i] = out[1];
+                    high_pass_b_[i] = out[2];
+                }
+            }
+        },
+        0, dim[1]);
 
-                int32_t const ki = kc[1] * kd0 + kc[0];
+    math::fft::forward_real_2d(high_pass_dft_r_, high_pass_r_, dim[0], dim[1], pool);
+    math::fft::forward_real_2d(high_pass_dft_g_, high_pass_g_, dim[0], dim[1], pool);
+    math::fft::forward_real_2d(high_pass_dft_b_, high_pass_b_, dim[0], dim[1], pool);
 
-                float3 const k = kernel_[ki];
+    pool.run_range(
+        [this, dim](uint32_t /*id*/, int32_t begin, int32_t end) {
+            float const scale = 1.f / static_cast<float>(dim[0] * dim[1]);
 
-                glare += k * high_pass_[si];
+            for (int32_t i = begin; i < end; ++i) {
+                high_pass_dft_r_[i] = mul_complex(high_pass_dft_r_[i], kernel_dft_r_[i], scale);
+                high_pass_dft_g_[i] = mul_complex(high_pass_dft_g_[i], kernel_dft_g_[i], scale);
+                high_pass_dft_b_[i] = mul_complex(high_pass_dft_b_[i], kernel_dft_b_[i], scale);
             }
+        },
+        0, math::fft::real_size(dim[0]) * dim[1]);
 
-            destination.store(i, float4(intensity * glare));
-
-            //	float4 s = source.load(i);
+    math::fft::inverse_real_2d(high_pass_r_, high_pass_dft_r_, dim[0], dim[1], pool);
+    math::fft::inverse_real_2d(high_pass_g_, high_pass_dft_g_, dim[0], dim[1], pool);
+    math::fft::inverse_real_2d(high_pass_b_, high_pass_dft_b_, dim[0], dim[1], pool);
+}
 
-            //	destination.at(i) = float4(s.xyz() + intensity * glare, s[3]);
+void Glare3::apply(uint32_t /*id*/, uint32_t /*pass*/, int32_t begin, int32_t end,
+                   const image::Float4& source, image::Float4& destination) {
+    int32_t const kd0 = kernel_dimensions_[0];
 
-            /*
-                                    Vector glare = simd::Zero;
-                                    for (int32_t ky = kb[1], krow = kb[1] * kd0; ky < ke[1]; ++ky,
-               krow += kd0) { int32_t si = (cd1 + ky) * d[0]; for (int32_t ki = kb[0] + krow, kl =
-               ke[0] + krow; ki < kl; ++ki, ++si) { Vector const k =
-               simd::load_float4(kernel_[ki].v); Vector const h =
-               simd::load_float4(high_pass_[si].v);
+    float const intensity = intensity_;
 
-                                                    glare = math::add(glare, math::mul(k, h));
-                                            }
-                                    }
+    for (int32_t i = begin; i < end; ++i) {
+        int2 const c = source.coordinates_2(i);
 
-                                    glare = math::mul(glare, intensity);
+        int32_t const ki = c[1] * kd0 + c[0];
 
-                                    Vector s =
-               simd::load_float4(reinterpret_cast<float*>(source.address(i))); s = math::add(s,
-               glare); simd::store_float4(reinterpret_cast<float*>(destination.address(i)), s);
-            */
-        }
-    } else if (2 == pass) {
-        // vertical
-
-        auto const d = destination.description().dimensions.xy();
-
-        for (int32_t i = begin; i < end; ++i) {
-            int2 const c = destination.coordinates_2(i);
-            float3     accum(0.f);
-            float      weight_sum = 0.f;
-            for (int32_t j = 0, len = gauss_width_; j < len; ++j) {
-                auto const k  = gauss_kernel_[j];
-                int32_t    kx = c[0] + k.o;
-
-                if (kx >= 0 && kx < d[0]) {
-                    int32_t const si = c[1] * d[0] + kx;
-                    float3 const  v  = destination.at(si).xyz();
-                    accum += k.w * v;
-                    weight_sum += k.w;
-                }
-            }
+        float3 glare(high_pass_r_[ki], high_pass_g_[ki], high_pass_b_[ki]);
+        glare = math::max(glare, float3(0.f));
 
-            int32_t const di = c[1] * d[0] + c[0];
-            high_pass_[di]   = accum / weight_sum;
-        }
-    } else if (3 == pass) {
-        // horizontal
-
-        auto const d = destination.description().dimensions.xy();
-
-        for (int32_t i = begin; i < end; ++i) {
-            int2 const c = destination.coordinates_2(i);
-            float3     accum(0.f);
-            float      weight_sum = 0.f;
-            for (int32_t j = 0, len = gauss_width_; j < len; ++j) {
-                auto const k  = gauss_kernel_[j];
-                int32_t    ky = c[1] + k.o;
-
-                if (ky >= 0 && ky < d[1]) {
-                    int32_t const si = ky * d[0] + c[0];
-                    float3 const  v  = high_pass_[si];
-                    accum += k.w * v;
-                    weight_sum += k.w;
-                }
-            }
+        float4 const s = source.load(i);
 
-            float4 s = source.load(i);
-
-            destination.store(i, float4(s.xyz() + accum / weight_sum, s[3]));
-        }
+        destination.store(i, float4(s.xyz() + intensity * glare, s[3]));
     }
 }
 
@@ -16,6 +16,9 @@ class Glare3 : public Postprocessor {
     virtual size_t num_bytes() const override final;
 
   private:
+    virtual void pre_apply(const image::Float4& source, image::Float4& destination,
+                           thread::Pool& pool) override final;
+
     virtual void apply(uint32_t id, uint32_t pass, int32_t begin, int32_t end,
                        const image::Float4& source, image::Float4& destination) override final;
 
@@ -23,20 +26,21 @@ class Glare3 : public Postprocessor {
     float    threshold_;
     float    intensity_;
 
-    //	image::Float3 high_pass_;
-    int2    dimensions_;
-    float3* high_pass_;
+    // The glare is the convolution of the high pass with the kernel,
+    // done with FFTs that are twice the size of the image to avoid wrap around
+    int2 kernel_dimensions_;
 
-    int2    kernel_dimensions_;
-    float3* kernel_;
+    float2* kernel_dft_r_;
+    float2* kernel_dft_g_;
+    float2* kernel_dft_b_;
 
-    struct K {
-        int32_t o;
-        float   w;
-    };
+    float* high_pass_r_;
+    float* high_pass_g_;
+    float* high_pass_b_;
 
-    int32_t gauss_width_;
-    K*      gauss_kernel_;
+    float2* high_pass_dft_r_;
+    float2* high_pass_dft_g_;
+    float2* high_pass_dft_b_;
 };
 
 }  // namespace rendering::postprocessor
@@ -1,5 +1,8 @@
 #include "postprocessor_pipeline.hpp"
+#include <algorithm>
 #include "base/math/vector4.inl"
+#include "base/thread/thread_pool.hpp"
+#include "exporting/exporting_sink.hpp"
 #include "image/typed_image.inl"
 #include "postprocessor.hpp"
 #include "rendering/sensor/sensor.hpp"
@@ -41,26 +44,17 @@ bool Pipeline::has_alpha_transparency(bool alpha_in) const {
 }
 
 void Pipeline::apply(sensor::Sensor const& sensor, image::Float4& target, thread::Pool& pool) {
-    if (postprocessors_.empty()) {
-        sensor.resolve(pool, target);
-    } else {
-        image::Float4* targets[2];
-
-        if (0 == postprocessors_.size() % 2) {
-            targets[0] = &target;
-            targets[1] = &scratch_;
-        } else {
-            targets[0] = &scratch_;
-            targets[1] = &target;
-        }
+    apply(sensor, target, nullptr, 0, pool);
+}
 
-        sensor.resolve(pool, *targets[0]);
+void Pipeline::apply(sensor::Sensor const& sensor, image::Float4& target,
+                     exporting::Sink* const* sinks, uint32_t num_sinks, thread::Pool& pool) {
+    apply(&sensor, nullptr, target, sinks, num_sinks, pool);
+}
 
-        for (auto& pp : postprocessors_) {
-            pp->apply(*targets[0], *targets[1], pool);
-            std::swap(targets[0], targets[1]);
-        }
-    }
+void Pipeline::apply(image::Float4 const& resolved, image::Float4& target,
+                     exporting::Sink* const* sinks, uint32_t num_sinks, thread::Pool& pool) {
+    apply(nullptr, &resolved, target, sinks, num_sinks, pool);
 }
 
 size_t Pipeline::num_bytes() const {
@@ -72,4 +66,81 @@ size_t Pipeline::num_bytes() const {
     return num_bytes;
 }
 
+void Pipeline::apply(sensor::Sensor const* sensor, image::Float4 const* resolved,
+                     image::Float4& target, exporting::Sink* const* sinks, uint32_t num_sinks,
+                     thread::Pool& pool) {
+    uint32_t num_neighbor_passes = 0;
+    for (auto const& pp : postprocessors_) {
+        if (!pp->per_pixel()) {
+            ++num_neighbor_passes;
+        }
+    }
+
+    // Only passes that read neighboring pixels need a separate destination
+    image::Float4* targets[2];
+
+    if (0 == num_neighbor_passes % 2) {
+        targets[0] = &target;
+        targets[1] = &scratch_;
+    } else {
+        targets[0] = &scratch_;
+        targets[1] = &target;
+    }
+
+    uint32_t const num_pps = static_cast<uint32_t>(postprocessors_.size());
+
+    for (uint32_t begin = 0;;) {
+        uint32_t end = begin;
+        while (end < num_pps && postprocessors_[end]->per_pixel()) {
+            ++end;
+        }
+
+        bool const last = num_pps == end;
+
+        if (sensor || resolved || begin < end || (last && num_sinks > 0)) {
+            apply_fused(sensor, resolved, begin, end, *targets[0], sinks, last ? num_sinks : 0,
+                        pool);
+        }
+
+        if (last) {
+            break;
+        }
+
+        postprocessors_[end]->apply(*targets[0], *targets[1], pool);
+        std::swap(targets[0], targets[1]);
+
+        sensor   = nullptr;
+        resolved = nullptr;
+        begin    = end + 1;
+    }
+}
+
+void Pipeline::apply_fused(sensor::Sensor const* sensor, image::Float4 const* resolved,
+                           uint32_t begin, uint32_t end, image::Float4& target,
+                           exporting::Sink* const* sinks, uint32_t num_sinks,
+                           thread::Pool& pool) {
+    pool.run_range(
+        [this, sensor, resolved, begin, end, &target, sinks, num_sinks](
+            uint32_t id, int32_t range_begin, int32_t range_end) {
+            for (int32_t b = range_begin; b < range_end; b += Block_size) {
+                int32_t const e = std::min(b + Block_size, range_end);
+
+                if (sensor) {
+                    sensor->resolve(b, e, target);
+                } else if (resolved) {
+                    std::copy(resolved->data() + b, resolved->data() + e, target.data() + b);
+                }
+
+                for (uint32_t i = begin; i < end; ++i) {
+                    postprocessors_[i]->apply_block(id, b, e, target);
+                }
+
+                for (uint32_t i = 0; i < num_sinks; ++i) {
+                    sinks[i]->encode(target, b, e);
+                }
+            }
+        },
+        0, target.area());
+}
+
 }  // namespace rendering::postprocessor
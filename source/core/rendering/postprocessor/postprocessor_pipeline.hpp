@@ -7,6 +7,10 @@
 #include "image/typed_image_fwd.hpp"
 #include "scene/camera/camera.hpp"
 
+namespace exporting {
+class Sink;
+}
+
 namespace thread {
 class Pool;
 }
@@ -36,9 +40,33 @@ class Pipeline {
 
     void apply(sensor::Sensor const& sensor, image::Float4& target, thread::Pool& pool);
 
+    // Resolving the sensor and consecutive per-pixel postprocessors are fused into single passes
+    // over cache sized blocks of the image. Only postprocessors that read neighboring pixels get
+    // passes of their own. The last pass also lets the sinks encode the final image.
+    void apply(sensor::Sensor const& sensor, image::Float4& target, exporting::Sink* const* sinks,
+               uint32_t num_sinks, thread::Pool& pool);
+
+    // Same as above, but starts from an image that was already resolved from the sensor,
+    // so that the sensor is free for the next frame while this runs
+    void apply(image::Float4 const& resolved, image::Float4& target,
+               exporting::Sink* const* sinks, uint32_t num_sinks, thread::Pool& pool);
+
     size_t num_bytes() const;
 
   private:
+    // Expects exactly one of sensor and resolved to not be null
+    void apply(sensor::Sensor const* sensor, image::Float4 const* resolved, image::Float4& target,
+               exporting::Sink* const* sinks, uint32_t num_sinks, thread::Pool& pool);
+
+    // Resolves the sensor or copies the resolved image, if either is not null,
+    // then applies the postprocessors [begin, end)
+    void apply_fused(sensor::Sensor const* sensor, image::Float4 const* resolved, uint32_t begin,
+                     uint32_t end, image::Float4& target, exporting::Sink* const* sinks,
+                     uint32_t num_sinks, thread::Pool& pool);
+
+    // Number of pixels in a block of a fused pass
+    static int32_t constexpr Block_size = 4096;
+
     image::Float4 scratch_;
 
     std::vector<std::unique_ptr<Postprocessor>> postprocessors_;
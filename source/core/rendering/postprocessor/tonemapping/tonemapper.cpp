@@ -12,6 +12,10 @@ size_t Tonemapper::num_bytes() const {
     return 0;
 }
 
+bool Tonemapper::per_pixel() const {
+    return true;
+}
+
 float Tonemapper::normalization_factor(float linear_max, float tonemapped_max) {
     return linear_max > 0.f ? 1.f / tonemapped_max : 1.f;
 }
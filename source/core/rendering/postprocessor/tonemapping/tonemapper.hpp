@@ -14,6 +14,8 @@ class Tonemapper : public Postprocessor {
 
     virtual size_t num_bytes() const override final;
 
+    virtual bool per_pixel() const override final;
+
   protected:
     static float normalization_factor(float hdr_max, float tonemapped_max);
 };
@@ -1,6 +1,10 @@
 #include "rendering_camera_worker.hpp"
+#include <algorithm>
+#include "base/math/ray_packet.hpp"
 #include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
 #include "base/random/generator.inl"
+#include "rendering/integrator/surface/pathtracer_wf.hpp"
 #include "rendering/integrator/surface/surface_integrator.hpp"
 #include "rendering/integrator/volume/volume_integrator.hpp"
 #include "rendering/sensor/sensor.hpp"
@@ -8,50 +12,172 @@
 #include "sampler/camera_sample.hpp"
 #include "sampler/sampler.hpp"
 #include "scene/camera/camera.hpp"
+#include "scene/prop/interface_stack.inl"
 #include "scene/scene_ray.inl"
 
 namespace rendering {
 
 Camera_worker::Camera_worker(Tile_queue const& tiles) : tiles_(tiles) {}
 
+Camera_worker::~Camera_worker() noexcept {
+    memory::free_aligned(batch_results_);
+    memory::free_aligned(batch_rays_);
+    memory::free_aligned(batch_samples_);
+}
+
 void Camera_worker::render(uint32_t frame, uint32_t view, int4 const& tile,
-                           uint32_t num_samples) noexcept {
+                           uint32_t sample_begin, uint32_t sample_end) noexcept {
     scene::camera::Camera const& camera = *camera_;
 
     auto& sensor = camera.sensor();
 
-    int4 bounds = camera.view_bounds(view);
+    int4 const view_bounds = camera.view_bounds(view);
+
+    int4 bounds = view_bounds;
     bounds[2] -= bounds[0];
     bounds[3] -= bounds[1];
 
-    int4 isolated_bounds = sensor.isolated_tile(
-        int4(bounds.xy() + tile.xy(), bounds.xy() + tile.zw()));
-    isolated_bounds[2] -= isolated_bounds[0];
-    isolated_bounds[3] -= isolated_bounds[1];
+    // Pixels outside of the view never receive samples
+    int4 const footprint = sensor.footprint(
+        int4(view_bounds.xy() + tile.xy(), view_bounds.xy() + tile.zw()));
+
+    tile_buffer_.start(int4(math::max(footprint.xy(), view_bounds.xy()),
+                            math::min(footprint.zw(), view_bounds.zw())));
 
     uint32_t const tile_index = tiles_.index(tile);
 
-    rng_.start(0, tile_index);
+    if (surface_integrator_->wavefront() && camera.interface_stack().empty()) {
+        render_wavefront(frame, view, tile, tile_index, sample_begin, sample_end, bounds);
+        sensor.merge(tile_buffer_);
+        return;
+    }
 
     for (int32_t y = tile[1], y_len = tile[3] + 1; y < y_len; ++y) {
         for (int32_t x = tile[0], x_len = tile[2] + 1; x < x_len; ++x) {
-            sampler_->start_pixel();
-            surface_integrator_->start_pixel();
+            int2 const pixel(x, y);
+
+            // Pixels of the filter border follow the closest pixel of the view
+            int2 const view_pixel = math::min(math::max(pixel, int2(0)), bounds.zw());
+
+            if (sensor.converged(bounds.xy() + view_pixel)) {
+                continue;
+            }
+
+            // The samples of the filter border must not shrink the radius of the edge pixels,
+            // because they gather photons of a different area
+            if (pixel == view_pixel) {
+                pixel_ = (bounds[1] + pixel[1]) * sensor.dimensions()[0] + bounds[0] + pixel[0];
+            } else {
+                pixel_ = -1;
+            }
+
+            start_pixel(tile, tile_index, pixel, sample_begin);
+
+            // The samples of a pixel are traced as packets, because their rays are coherent
+            for (uint32_t i = sample_begin; i < sample_end; i += math::Ray_packet::Size) {
+                uint32_t const num_rays = std::min(sample_end - i, math::Ray_packet::Size);
+
+                sampler::Camera_sample samples[math::Ray_packet::Size];
+                Ray                    rays[math::Ray_packet::Size];
+
+                uint32_t mask = 0;
+
+                for (uint32_t r = 0; r < num_rays; ++r) {
+                    samples[r] = sampler_->generate_camera_sample(pixel, i + r);
+
+                    if (camera.generate_ray(samples[r], frame, view, rays[r])) {
+                        mask |= 1u << r;
+                    }
+                }
+
+                float4 colors[math::Ray_packet::Size];
+                li(rays, mask, camera.interface_stack(), colors);
+
+                for (uint32_t r = 0; r < num_rays; ++r) {
+                    sensor.add_sample(samples[r], colors[r], tile_buffer_, bounds);
+                }
+            }
+        }
+    }
+
+    sensor.merge(tile_buffer_);
+}
+
+void Camera_worker::render_wavefront(uint32_t frame, uint32_t view, int4 const& tile,
+                                     uint32_t tile_index, uint32_t sample_begin,
+                                     uint32_t sample_end, int4 const& bounds) noexcept {
+    using Wavefront = integrator::surface::Pathtracer_WF;
 
+    scene::camera::Camera const& camera = *camera_;
+
+    if (!batch_samples_) {
+        uint32_t const size = Wavefront::Max_batch_size;
+
+        batch_samples_ = memory::allocate_aligned<sampler::Camera_sample>(size);
+        batch_rays_    = memory::allocate_aligned<Ray>(size);
+        batch_results_ = memory::allocate_aligned<float4>(size);
+    }
+
+    uint32_t num_rays = 0;
+
+    for (int32_t y = tile[1], y_len = tile[3] + 1; y < y_len; ++y) {
+        for (int32_t x = tile[0], x_len = tile[2] + 1; x < x_len; ++x) {
             int2 const pixel(x, y);
 
-            for (uint32_t i = 0; i < num_samples; ++i) {
-                sampler::Camera_sample sample = sampler_->generate_camera_sample(pixel, i);
+            int2 const view_pixel = math::min(math::max(pixel, int2(0)), bounds.zw());
+
+            if (camera.sensor().converged(bounds.xy() + view_pixel)) {
+                continue;
+            }
+
+            start_pixel(tile, tile_index, pixel, sample_begin);
+
+            for (uint32_t i = sample_begin; i < sample_end; ++i) {
+                sampler::Camera_sample const sample = sampler_->generate_camera_sample(pixel, i);
+
+                if (camera.generate_ray(sample, frame, view, batch_rays_[num_rays])) {
+                    batch_samples_[num_rays] = sample;
 
-                if (Ray ray; camera.generate_ray(sample, frame, view, ray)) {
-                    float4 const color = li(ray, camera.interface_stack());
-                    sensor.add_sample(sample, color, isolated_bounds, bounds);
+                    if (Wavefront::Max_batch_size == ++num_rays) {
+                        render_batch(num_rays, bounds);
+                        num_rays = 0;
+                    }
                 } else {
-                    sensor.add_sample(sample, float4(0.f), isolated_bounds, bounds);
+                    camera.sensor().add_sample(sample, float4(0.f), tile_buffer_, bounds);
                 }
             }
         }
     }
+
+    if (num_rays) {
+        render_batch(num_rays, bounds);
+    }
+}
+
+void Camera_worker::start_pixel(int4 const& tile, uint32_t tile_index, int2 pixel,
+                                uint32_t sample_begin) noexcept {
+    uint32_t const tile_width = static_cast<uint32_t>(tile[2] - tile[0] + 1);
+
+    uint64_t const sequence = (static_cast<uint64_t>(tile_index) << 32) |
+                              ((pixel[1] - tile[1]) * tile_width + (pixel[0] - tile[0]));
+
+    rng_.start(0, sequence);
+
+    sampler_->start_pixel(sample_begin);
+    surface_integrator_->start_pixel(sample_begin);
+
+    // Later passes must not repeat the random numbers of earlier ones
+    rng_.start(sample_begin + 1, sequence);
+}
+
+void Camera_worker::render_batch(uint32_t num_rays, int4 const& bounds) noexcept {
+    surface_integrator_->wavefront()->integrate(batch_rays_, num_rays, *this, batch_results_);
+
+    auto& sensor = camera_->sensor();
+
+    for (uint32_t i = 0; i < num_rays; ++i) {
+        sensor.add_sample(batch_samples_[i], batch_results_[i], tile_buffer_, bounds);
+    }
 }
 
 }  // namespace rendering
@@ -2,6 +2,11 @@
 #define SU_CORE_RENDERING_CAMERA_WORKER_HPP
 
 #include "rendering_worker.hpp"
+#include "sensor/tile_buffer.hpp"
+
+namespace sampler {
+struct Camera_sample;
+}
 
 namespace scene::camera {
 class Camera;
@@ -15,10 +20,33 @@ class alignas(64) Camera_worker : public Worker {
   public:
     Camera_worker(Tile_queue const& tiles);
 
-    void render(uint32_t frame, uint32_t view, int4 const& tile, uint32_t num_samples) noexcept;
+    ~Camera_worker() noexcept;
+
+    // Renders the samples [sample_begin, sample_end) of the pixels of the tile,
+    // skipping the pixels that the sensor considers converged
+    void render(uint32_t frame, uint32_t view, int4 const& tile, uint32_t sample_begin,
+                uint32_t sample_end) noexcept;
 
   private:
+    void render_wavefront(uint32_t frame, uint32_t view, int4 const& tile, uint32_t tile_index,
+                          uint32_t sample_begin, uint32_t sample_end, int4 const& bounds) noexcept;
+
+    // Positions the samplers of the pixel at sample_begin. Their randomization only depends on
+    // the pixel, so that rendering it in several passes yields the same sequences as one pass.
+    void start_pixel(int4 const& tile, uint32_t tile_index, int2 pixel,
+                     uint32_t sample_begin) noexcept;
+
+    void render_batch(uint32_t num_rays, int4 const& bounds) noexcept;
+
     Tile_queue const& tiles_;
+
+    // The samples of a tile are accumulated here, before they are merged into the sensor
+    sensor::Tile_buffer tile_buffer_;
+
+    // Camera rays that are traced together by a wavefront integrator
+    sampler::Camera_sample* batch_samples_ = nullptr;
+    Ray*                    batch_rays_    = nullptr;
+    float4*                 batch_results_ = nullptr;
 };
 
 }  // namespace rendering
@@ -28,14 +28,18 @@ Driver::Driver(take::Take& take, Scene& scene, thread::Pool& thread_pool,
       target_(Image::Description(Image::Type::Float4, take.view.camera->sensor_dimensions())),
       photon_map_(take.photon_settings.num_photons, take.photon_settings.radius,
                   take.photon_settings.indirect_radius_factor,
-                  take.photon_settings.separate_caustics && take.photon_settings.indirect_caustics),
+                  take.photon_settings.separate_caustics && take.photon_settings.indirect_caustics,
+                  take.photon_settings.progressive ? take.photon_settings.alpha : 0.f),
       photon_settings_(take.photon_settings),
-      photon_infos_(nullptr) {
+      photon_infos_(nullptr),
+      guide_tree_(take.guiding_settings) {
     uint32_t const num_photons = take.photon_settings.num_photons;
     if (num_photons) {
         uint32_t const num_workers = thread_pool.num_threads();
 
-        photon_map_.init(num_workers);
+        int2 const d = take.view.camera->sensor_dimensions();
+
+        photon_map_.init(num_workers, static_cast<uint32_t>(d[0] * d[1]));
 
         uint32_t range = num_photons / num_workers;
         if (num_photons % num_workers) {
@@ -47,11 +51,15 @@ Driver::Driver(take::Take& take, Scene& scene, thread::Pool& thread_pool,
 
     integrator::photon::Map* photon_map = num_photons ? &photon_map_ : nullptr;
 
+    integrator::guiding::Tree* guide_tree = take.guiding_settings.num_training_samples
+                                                ? &guide_tree_
+                                                : nullptr;
+
     for (uint32_t i = 0, len = thread_pool.num_threads(); i < len; ++i) {
         workers_[i].init(i, take.settings, scene, *take.view.camera, max_material_sample_size,
                          take.view.num_samples_per_pixel, *take.surface_integrator_factory,
                          *take.volume_integrator_factory, *take.sampler_factory, photon_map,
-                         take.photon_settings);
+                         take.photon_settings, guide_tree);
     }
 }
 
@@ -72,7 +80,8 @@ size_t Driver::num_bytes() const noexcept {
     // Every worker must have exactly the same size, so we only need to query a single one
     size_t const worker_num_bytes = thread_pool_.num_threads() * workers_[0].num_bytes();
 
-    return sizeof(*this) + worker_num_bytes + target_.num_bytes() + photon_map_.num_bytes();
+    return sizeof(*this) + worker_num_bytes + target_.num_bytes() + photon_map_.num_bytes() +
+           guide_tree_.num_bytes();
 }
 
 }  // namespace rendering
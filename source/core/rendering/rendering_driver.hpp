@@ -5,6 +5,7 @@
 #include "base/math/vector2.hpp"
 #include "image/typed_image.hpp"
 #include "image/typed_image_fwd.hpp"
+#include "integrator/guiding/guiding_tree.hpp"
 #include "integrator/photon/photon_map.hpp"
 #include "take/take_settings.hpp"
 #include "tile_queue.hpp"
@@ -84,6 +85,8 @@ class Driver {
     };
 
     Photon_info* photon_infos_;
+
+    integrator::guiding::Tree guide_tree_;
 };
 
 }  // namespace rendering
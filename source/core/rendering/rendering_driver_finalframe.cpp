@@ -1,10 +1,16 @@
 #include "rendering_driver_finalframe.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include "base/chrono/chrono.hpp"
 #include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
 #include "base/string/string.hpp"
 #include "base/thread/thread_pool.hpp"
 #include "exporting/exporting_sink.hpp"
 #include "image/texture/texture_adapter.hpp"
+#include "image/typed_image.inl"
 #include "logging/logging.hpp"
 #include "progress/progress_sink.hpp"
 #include "rendering/rendering_camera_worker.hpp"
@@ -12,83 +18,435 @@
 #include "sampler/sampler.hpp"
 #include "scene/camera/camera.hpp"
 #include "scene/scene.hpp"
+#include "take/take.hpp"
 #include "take/take_view.hpp"
 
 namespace rendering {
 
+static char const Checkpoint_header[] = "SUCP";
+
+static uint32_t constexpr Checkpoint_version = 3;
+
+// Path guiding is trained in passes that double the number of samples
+static uint32_t training_pass_end(uint32_t begin, uint32_t num_training_samples) noexcept {
+    return std::min(2 * begin + 1, num_training_samples);
+}
+
+static uint32_t num_training_passes(uint32_t num_training_samples) noexcept {
+    uint32_t num_passes = 0;
+
+    for (uint32_t begin = 0; begin < num_training_samples; ++num_passes) {
+        begin = training_pass_end(begin, num_training_samples);
+    }
+
+    return num_passes;
+}
+
 Driver_finalframe::Driver_finalframe(take::Take& take, Scene& scene, thread::Pool& thread_pool,
                                      uint32_t max_sample_size) noexcept
-    : Driver(take, scene, thread_pool, max_sample_size) {}
+    : Driver(take, scene, thread_pool, max_sample_size),
+      resolved_(image::Image::Description(image::Image::Type::Float4,
+                                          take.view.camera->sensor_dimensions())),
+      active_tiles_(memory::allocate_aligned<bool>(tiles_.size())),
+      checkpoint_interval_(0.f),
+      time_budget_(0.f) {
+    view_.camera->sensor().set_noise_threshold(view_.noise_threshold);
+}
+
+Driver_finalframe::~Driver_finalframe() noexcept {
+    memory::free_aligned(active_tiles_);
+}
 
 void Driver_finalframe::render(Exporters& exporters, progress::Sink& progressor) noexcept {
     photons_baked_ = false;
 
+    render_start_     = std::chrono::high_resolution_clock::now();
+    checkpoint_start_ = render_start_;
+
     auto& camera = *view_.camera;
     auto& sensor = camera.sensor();
 
-    uint32_t const progress_range = tiles_.size() * camera.num_views();
+    // Adaptive sampling only reports the progress of its first pass
+    uint32_t const num_samples  = view_.num_samples_per_pixel;
+    uint32_t const num_training = std::min(guide_tree_.num_training_samples(), num_samples);
+    uint32_t const num_per_pass = num_samples_per_pass();
+    uint32_t const num_passes   = num_training_passes(num_training) +
+                                (view_.noise_threshold > 0.f && !progressive_photons()
+                                     ? 1
+                                     : (num_samples - num_training + num_per_pass - 1) /
+                                           num_per_pass);
+
+    uint32_t const progress_range = tiles_.size() * camera.num_views() * num_passes;
+
+    std::vector<exporting::Sink*> sinks;
+    sinks.reserve(exporters.size());
+
+    for (auto& e : exporters) {
+        sinks.push_back(e.get());
+    }
 
-    for (uint32_t f = 0; f < view_.num_frames; ++f) {
-        uint32_t const current_frame = view_.start_frame + f;
+    Checkpoint resume{view_.start_frame, 0, 0};
+
+    if (!resume_name_.empty() && read_checkpoint(resume)) {
+        logging::info("Resuming frame " + string::to_string(resume.frame) + " at sample " +
+                      string::to_string(resume.sample_begin));
+    }
+
+    uint32_t const end_frame = view_.start_frame + view_.num_frames;
+
+    for (uint32_t current_frame = resume.frame; current_frame < end_frame; ++current_frame) {
         logging::info("Frame " + string::to_string(current_frame));
 
         auto const render_start = std::chrono::high_resolution_clock::now();
 
-        sensor.clear();
+        Checkpoint const start = current_frame == resume.frame ? resume
+                                                               : Checkpoint{current_frame, 0, 0};
+
+        // Otherwise the sensor already contains the samples of the checkpoint
+        if (0 == start.view && 0 == start.sample_begin) {
+            sensor.clear();
+            sensor.clear_statistics();
+        }
 
         progressor.start(progress_range);
 
-        uint64_t const start = current_frame * camera.frame_step();
-        scene_.simulate(start, start + camera.frame_duration(), thread_pool_);
+        uint64_t const start_time = current_frame * camera.frame_step();
+        scene_.simulate(start_time, start_time + camera.frame_duration(), thread_pool_);
 
-        camera.update(scene_, start, workers_[0]);
+        camera.update(scene_, start_time, workers_[0]);
 
-        render_frame(current_frame, progressor);
+        bool const complete = render_frame(start, progressor);
 
         progressor.end();
 
         auto const render_duration = chrono::seconds_since(render_start);
         logging::info("Render time " + string::to_string(render_duration) + " s");
 
-        auto const export_start = std::chrono::high_resolution_clock::now();
+        // The export of the previous frame might still read the resolved image
+        thread_pool_.wait_async();
+
+        sensor.resolve(thread_pool_, resolved_);
+
+        thread_pool_.run_async([this, &exporters, &sinks, current_frame, complete]() noexcept {
+            auto const export_start = std::chrono::high_resolution_clock::now();
 
-        view_.pipeline.apply(sensor, target_, thread_pool_);
+            view_.pipeline.apply(resolved_, target_, sinks.data(),
+                                 static_cast<uint32_t>(sinks.size()), thread_pool_);
 
-        for (auto& e : exporters) {
-            e->write(target_, current_frame, thread_pool_);
+            for (auto& e : exporters) {
+                e->write(target_, current_frame, thread_pool_);
+            }
+
+            auto const export_duration = chrono::seconds_since(export_start);
+            logging::info("Export time " + string::to_string(export_duration) + " s");
+
+            // Only after the export, so that resuming never skips a frame that was not written
+            if (complete && !checkpoint_name_.empty()) {
+                write_checkpoint(Checkpoint{current_frame + 1, 0, 0});
+            }
+        });
+
+        if (!complete) {
+            logging::info("Time budget exhausted");
+            break;
         }
+    }
 
-        auto const export_duration = chrono::seconds_since(export_start);
-        logging::info("Export time " + string::to_string(export_duration) + " s");
+    thread_pool_.wait_async();
+}
+
+void Driver_finalframe::set_checkpoint(std::string_view filename, float interval) noexcept {
+    checkpoint_name_     = filename;
+    checkpoint_interval_ = interval;
+}
+
+void Driver_finalframe::set_resume(std::string_view filename) noexcept {
+    resume_name_ = filename;
+}
+
+void Driver_finalframe::set_time_budget(float budget) noexcept {
+    time_budget_ = budget;
+}
+
+bool Driver_finalframe::render_frame(Checkpoint const& start, progress::Sink& progressor) noexcept {
+    uint32_t const frame = start.frame;
+
+    bool const progressive = progressive_photons();
+
+    if (progressive) {
+        photon_map_.restart();
+    } else {
+        bake_photons(frame, 0);
     }
+
+    uint32_t const num_samples  = view_.num_samples_per_pixel;
+    uint32_t const num_training = std::min(guide_tree_.num_training_samples(), num_samples);
+    uint32_t const num_per_pass = num_samples_per_pass();
+
+    // The samples of the training are noisy, because the guide is still learning.
+    // Like Müller et al. they are discarded, unless there are no other samples.
+    bool const discard_training = num_training < num_samples;
+
+    bool const adaptive = view_.noise_threshold > 0.f && !progressive;
+
+    for (uint32_t v = start.view, len = view_.camera->num_views(); v < len; ++v) {
+        std::fill(active_tiles_, active_tiles_ + tiles_.size(), true);
+
+        uint32_t begin = v == start.view ? start.sample_begin : 0;
+
+        // What was learned is not part of checkpoints. A view that is resumed during the
+        // training trains again from the start, because its samples are discarded anyway.
+        // After the training the rest of the view is rendered without guiding.
+        if (num_training) {
+            if (discard_training && begin < num_training) {
+                begin = 0;
+            } else if (begin >= num_training) {
+                logging::warning("Resuming view " + string::to_string(v) +
+                                 " after the training of path guiding: Guiding is disabled.");
+            }
+
+            guide_tree_.start(scene_.aabb(), begin < num_training);
+        }
+
+        while (begin < num_samples) {
+            uint32_t end;
+
+            bool const training = begin < num_training;
+
+            if (training) {
+                end = training_pass_end(begin, num_training);
+            } else if (!adaptive) {
+                end = std::min(begin + num_per_pass, num_samples);
+            } else if (num_training == begin) {
+                // Adaptive sampling renders the minimum number of samples for all pixels first
+                end = std::min(begin + view_.min_samples_per_pixel, num_samples);
+            } else {
+                // and then continues with the pixels that are not converged, in passes that
+                // double the number of samples
+                if (!retire_converged(v)) {
+                    break;
+                }
+
+                end = std::min(begin + std::max(begin, view_.min_samples_per_pixel), num_samples);
+            }
+
+            auto const pass_start = std::chrono::high_resolution_clock::now();
+
+            if (progressive) {
+                bake_photons(frame, begin);
+            }
+
+            render_tiles(frame, v, begin, end,
+                         adaptive && begin > num_training ? nullptr : &progressor);
+
+            if (training) {
+                guide_tree_.update(num_training == end, thread_pool_);
+
+                if (discard_training && num_training == end) {
+                    view_.camera->sensor().clear_area(view_.camera->view_bounds(v));
+                }
+            }
+
+            begin = end;
+
+            if (!end_pass(Checkpoint{frame, v, begin}, chrono::seconds_since(pass_start))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void Driver_finalframe::render_tiles(uint32_t frame, uint32_t view, uint32_t sample_begin,
+                                     uint32_t sample_end, progress::Sink* progressor) noexcept {
+    for (uint32_t phase = 0; phase < Tile_queue::Num_phases; ++phase) {
+        tiles_.restart(active_tiles_, phase);
+
+        thread_pool_.run_parallel(
+            [this, frame, view, sample_begin, sample_end, progressor](uint32_t index) noexcept {
+                auto& worker = workers_[index];
+
+                for (int4 tile; tiles_.pop(tile);) {
+                    worker.render(frame, view, tile, sample_begin, sample_end);
+
+                    if (progressor) {
+                        progressor->tick();
+                    }
+
+                    // The export of the previous frame gets its share of the threads this way
+                    thread_pool_.help();
+                }
+            });
+    }
+}
+
+bool Driver_finalframe::retire_converged(uint32_t view) noexcept {
+    auto& sensor = view_.camera->sensor();
+
+    int4 const bounds = view_.camera->view_bounds(view);
+
+    // Visits the tiles of the last round again
+    tiles_.restart(active_tiles_);
+
+    thread_pool_.run_parallel([this, &sensor, bounds](uint32_t /*index*/) noexcept {
+        for (int4 tile; tiles_.pop(tile);) {
+            int4 const offset_tile = tile + int4(bounds.xy(), bounds.xy());
+
+            int4 const sensor_tile(math::max(offset_tile.xy(), bounds.xy()),
+                                   math::min(offset_tile.zw(), bounds.zw()));
+
+            active_tiles_[tiles_.index(tile)] = sensor.retire_converged(sensor_tile);
+        }
+    });
+
+    return std::any_of(active_tiles_, active_tiles_ + tiles_.size(),
+                       [](bool active) { return active; });
+}
+
+uint32_t Driver_finalframe::num_samples_per_pass() const noexcept {
+    if (progressive_photons()) {
+        return 1;
+    }
+
+    // Splitting the samples into passes is only necessary if the render can be interrupted.
+    // The passes continue the sample sequences of the pixels, so this costs no quality.
+    if (checkpoint_name_.empty() && time_budget_ <= 0.f) {
+        return view_.num_samples_per_pixel;
+    }
+
+    return std::max(view_.min_samples_per_pixel, 1u);
+}
+
+bool Driver_finalframe::progressive_photons() const noexcept {
+    return photon_infos_ && photon_settings_.progressive;
+}
+
+bool Driver_finalframe::end_pass(Checkpoint const& next, float pass_duration) noexcept {
+    // The next pass is expected to take about as long as the last one
+    bool const out_of_time = time_budget_ > 0.f &&
+                             chrono::seconds_since(render_start_) + pass_duration > time_budget_;
+
+    if (!checkpoint_name_.empty() &&
+        (out_of_time || chrono::seconds_since(checkpoint_start_) >= checkpoint_interval_)) {
+        // The checkpoint must not claim a frame before the export of the previous one is done
+        thread_pool_.wait_async();
+
+        write_checkpoint(next);
+
+        checkpoint_start_ = std::chrono::high_resolution_clock::now();
+    }
+
+    return !out_of_time;
 }
 
-void Driver_finalframe::render_frame(uint32_t frame, progress::Sink& progressor) noexcept {
-    bake_photons(frame);
+void Driver_finalframe::write_checkpoint(Checkpoint const& next) noexcept {
+    // The sensor is cleared at the start of a frame anyway,
+    // which also allows writing this while the next frame is rendered
+    bool const mid_frame = 0 != next.view || 0 != next.sample_begin;
+
+    // Written under a temporary name first, so that an interrupted write keeps the last checkpoint
+    std::string const temp_name = checkpoint_name_ + ".tmp";
 
-    for (uint32_t v = 0, len = view_.camera->num_views(); v < len; ++v) {
-        tiles_.restart();
+    {
+        std::ofstream stream(temp_name, std::ios::binary);
 
-        thread_pool_.run_parallel([ this, frame, v, &progressor ](uint32_t index) noexcept {
-            auto& worker = workers_[index];
+        if (stream) {
+            stream.write(Checkpoint_header, 4);
+            stream.write(reinterpret_cast<char const*>(&Checkpoint_version), sizeof(uint32_t));
 
-            uint32_t const num_samples = view_.num_samples_per_pixel;
+            Checkpoint_take const take = checkpoint_take();
+            stream.write(reinterpret_cast<char const*>(&take), sizeof(Checkpoint_take));
 
-            for (int4 tile; tiles_.pop(tile);) {
-                worker.render(frame, v, tile, num_samples);
+            stream.write(reinterpret_cast<char const*>(&next), sizeof(Checkpoint));
 
-                progressor.tick();
+            if (mid_frame) {
+                view_.camera->sensor().write(stream);
             }
-        });
+        }
+
+        if (!stream) {
+            logging::warning("Could not write checkpoint \"" + checkpoint_name_ + "\".");
+            std::remove(temp_name.c_str());
+            return;
+        }
+    }
+
+    // std::rename() does not replace existing files on every platform
+    std::remove(checkpoint_name_.c_str());
+
+    if (0 != std::rename(temp_name.c_str(), checkpoint_name_.c_str())) {
+        logging::warning("Could not write checkpoint \"" + checkpoint_name_ + "\".");
+        std::remove(temp_name.c_str());
+        return;
+    }
+
+    logging::verbose("Wrote checkpoint \"" + checkpoint_name_ + "\".");
+}
+
+bool Driver_finalframe::read_checkpoint(Checkpoint& next) noexcept {
+    std::ifstream stream(resume_name_, std::ios::binary);
+
+    if (!stream) {
+        logging::warning("Could not open checkpoint \"" + resume_name_ + "\".");
+        return false;
+    }
+
+    char     header[4];
+    uint32_t version = 0;
+
+    stream.read(header, sizeof(header));
+    stream.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+
+    Checkpoint_take take;
+    stream.read(reinterpret_cast<char*>(&take), sizeof(Checkpoint_take));
+
+    Checkpoint_take const expected_take = checkpoint_take();
+
+    Checkpoint checkpoint;
+    stream.read(reinterpret_cast<char*>(&checkpoint), sizeof(Checkpoint));
+
+    if (!stream || 0 != std::memcmp(header, Checkpoint_header, sizeof(header)) ||
+        Checkpoint_version != version ||
+        0 != std::memcmp(&take, &expected_take, sizeof(Checkpoint_take)) ||
+        checkpoint.frame < view_.start_frame ||
+        ((0 != checkpoint.view || 0 != checkpoint.sample_begin) &&
+         !view_.camera->sensor().read(stream))) {
+        logging::warning("Checkpoint \"" + resume_name_ + "\" does not fit the take.");
+        return false;
     }
+
+    next = checkpoint;
+
+    return true;
 }
 
-void Driver_finalframe::bake_photons(uint32_t frame) noexcept {
+Driver_finalframe::Checkpoint_take Driver_finalframe::checkpoint_take() const noexcept {
+    auto const& camera = *view_.camera;
+
+    return Checkpoint_take{camera.sensor_dimensions(),
+                           camera.num_views(),
+                           view_.start_frame,
+                           view_.num_frames,
+                           view_.num_samples_per_pixel,
+                           view_.min_samples_per_pixel,
+                           view_.noise_threshold,
+                           guide_tree_.num_training_samples(),
+                           photon_settings_.num_photons,
+                           static_cast<uint32_t>(scene_.lights().size())};
+}
+
+void Driver_finalframe::bake_photons(uint32_t frame, uint32_t iteration) noexcept {
     if (/*photons_baked_ || */ !photon_infos_) {
         return;
     }
 
-    logging::info("Baking photons...");
+    // Progressive photon mapping bakes for every pass and would flood the log
+    bool const verbose = 0 == iteration;
+
+    if (verbose) {
+        logging::info("Baking photons...");
+    }
 
     auto const start = std::chrono::high_resolution_clock::now();
 
@@ -96,10 +454,15 @@ void Driver_finalframe::bake_photons(uint32_t frame) noexcept {
     uint32_t begin     = 0;
 
     for (;;) {
-        thread_pool_.run_range([ this, frame ](uint32_t id, int32_t begin, int32_t end) noexcept {
+        for (uint32_t i = 0, len = thread_pool_.num_threads(); i < len; ++i) {
+            photon_infos_[i].num_paths = 0;
+        }
+
+        thread_pool_.run_range([ this, frame, iteration ](uint32_t id, int32_t begin,
+                                                          int32_t end) noexcept {
             auto& worker = workers_[id];
 
-            photon_infos_[id].num_paths = worker.bake_photons(begin, end, frame);
+            photon_infos_[id].num_paths += worker.bake_photons(begin, end, frame, iteration);
         },
                                static_cast<int32_t>(begin),
                                static_cast<int32_t>(photon_settings_.num_photons));
@@ -127,8 +490,10 @@ void Driver_finalframe::bake_photons(uint32_t frame) noexcept {
         }
     }
 
-    auto const duration = chrono::seconds_since(start);
-    logging::info("Photon time " + string::to_string(duration) + " s");
+    if (verbose) {
+        auto const duration = chrono::seconds_since(start);
+        logging::info("Photon time " + string::to_string(duration) + " s");
+    }
 
     photons_baked_ = true;
 }
@@ -1,7 +1,10 @@
 #ifndef SU_CORE_RENDERING_DRIVER_FINALFRAME_HPP
 #define SU_CORE_RENDERING_DRIVER_FINALFRAME_HPP
 
+#include <chrono>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 #include "rendering_driver.hpp"
 
@@ -24,16 +27,90 @@ class Driver_finalframe : public Driver {
     Driver_finalframe(take::Take& take, Scene& scene, thread::Pool& thread_pool,
                       uint32_t max_sample_size) noexcept;
 
+    ~Driver_finalframe() noexcept;
+
     using Exporters = std::vector<std::unique_ptr<exporting::Sink>>;
 
+    // Every frame is resolved into a second image and then postprocessed and exported in the
+    // background, while the next frame is rendered. At most one export is in flight,
+    // so the frames are written in order.
     void render(Exporters& exporters, progress::Sink& progressor) noexcept;
 
+    // Writes the state of the render to the file after passes, at most once per interval,
+    // and always when the time budget runs out
+    void set_checkpoint(std::string_view filename, float interval) noexcept;
+
+    // Continues the render from the checkpoint in the file
+    void set_resume(std::string_view filename) noexcept;
+
+    // Stops the render after the last pass that is expected to end within the budget.
+    // The budget is in seconds and 0 disables it.
+    void set_time_budget(float budget) noexcept;
+
   private:
-    void render_frame(uint32_t frame, progress::Sink& progressor) noexcept;
+    // Position of the next pass of the render
+    struct Checkpoint {
+        uint32_t frame;
+        uint32_t view;
+        uint32_t sample_begin;
+    };
+
+    // What a checkpoint has to agree on with the take, to be resumed by it
+    struct Checkpoint_take {
+        int2     dimensions;
+        uint32_t num_views;
+        uint32_t start_frame;
+        uint32_t num_frames;
+        uint32_t num_samples_per_pixel;
+        uint32_t min_samples_per_pixel;
+        float    noise_threshold;
+        uint32_t num_training_samples;
+        uint32_t num_photons;
+        uint32_t num_lights;
+    };
+
+    Checkpoint_take checkpoint_take() const noexcept;
+
+    // Returns false if the render stopped because of the time budget
+    bool render_frame(Checkpoint const& start, progress::Sink& progressor) noexcept;
+
+    void render_tiles(uint32_t frame, uint32_t view, uint32_t sample_begin, uint32_t sample_end,
+                      progress::Sink* progressor) noexcept;
+
+    // Returns whether there are tiles left that need more samples
+    bool retire_converged(uint32_t view) noexcept;
+
+    uint32_t num_samples_per_pass() const noexcept;
 
-    void bake_photons(uint32_t frame) noexcept;
+    // Stochastic progressive photon mapping traces new photons for every sample per pixel
+    bool progressive_photons() const noexcept;
+
+    // Returns false if the time budget does not allow another pass
+    bool end_pass(Checkpoint const& next, float pass_duration) noexcept;
+
+    void write_checkpoint(Checkpoint const& next) noexcept;
+
+    bool read_checkpoint(Checkpoint& next) noexcept;
+
+    void bake_photons(uint32_t frame, uint32_t iteration) noexcept;
 
     bool photons_baked_;
+
+    // The sensor resolved for the export that runs in the background
+    image::Float4 resolved_;
+
+    // Tiles that still have pixels that are not converged, indexed by Tile_queue::index()
+    bool* active_tiles_;
+
+    std::string checkpoint_name_;
+    float       checkpoint_interval_;
+
+    std::string resume_name_;
+
+    float time_budget_;
+
+    std::chrono::high_resolution_clock::time_point render_start_;
+    std::chrono::high_resolution_clock::time_point checkpoint_start_;
 };
 
 }  // namespace rendering
@@ -66,23 +66,27 @@ uint32_t Driver_progressive::iteration() const {
 
 bool Driver_progressive::render_loop(exporting::Sink& exporter) {
     for (uint32_t v = 0, len = view_.camera->num_views(); v < len; ++v) {
-        tiles_.restart();
+        for (uint32_t phase = 0; phase < Tile_queue::Num_phases; ++phase) {
+            tiles_.restart(nullptr, phase);
 
-        thread_pool_.run_parallel([this, v](uint32_t index) {
-            auto& worker = workers_[index];
+            thread_pool_.run_parallel([this, v](uint32_t index) {
+                auto& worker = workers_[index];
 
-            for (;;) {
-                int4 tile;
-                if (!tiles_.pop(tile)) {
-                    break;
-                }
+                for (;;) {
+                    int4 tile;
+                    if (!tiles_.pop(tile)) {
+                        break;
+                    }
 
-                worker.render(0, v, tile, samples_per_iteration_);
-            }
-        });
+                    worker.render(0, v, tile, 0, samples_per_iteration_);
+                }
+            });
+        }
     }
 
-    view_.pipeline.apply(view_.camera->sensor(), target_, thread_pool_);
+    exporting::Sink* sinks[] = {&exporter};
+
+    view_.pipeline.apply(view_.camera->sensor(), target_, sinks, 1, thread_pool_);
     exporter.write(target_, iteration_, thread_pool_);
 
     if (schedule_.statistics || force_statistics_) {
@@ -1,7 +1,9 @@
 #include "rendering_worker.hpp"
+#include "base/math/ray_packet.hpp"
 #include "base/math/sample_distribution.inl"
 #include "base/math/vector4.inl"
 #include "base/memory/align.hpp"
+#include "base/random/generator.inl"
 #include "base/spectrum/rgb.hpp"
 #include "rendering/integrator/photon/photon_map.hpp"
 #include "rendering/integrator/photon/photon_mapper.hpp"
@@ -20,6 +22,8 @@
 
 namespace rendering {
 
+static uint64_t constexpr Photon_sequence = 1ull << 32;
+
 Worker::~Worker() noexcept {
     delete photon_mapper_;
     memory::destroy(sampler_);
@@ -33,7 +37,8 @@ void Worker::init(uint32_t id, take::Settings const& settings, scene::Scene cons
                   integrator::surface::Factory& surface_integrator_factory,
                   integrator::volume::Factory&  volume_integrator_factory,
                   sampler::Factory& sampler_factory, integrator::photon::Map* photon_map,
-                  take::Photon_settings const& photon_settings) noexcept {
+                  take::Photon_settings const& photon_settings,
+                  integrator::guiding::Tree*   guide_tree) noexcept {
     scene::Worker::init(id, settings, scene, camera, max_material_sample_size,
                         surface_integrator_factory.max_sample_depth());
 
@@ -43,6 +48,8 @@ void Worker::init(uint32_t id, take::Settings const& settings, scene::Scene cons
     volume_integrator_ = volume_integrator_factory.create(id, rng_);
     volume_integrator_->prepare(scene, num_samples_per_pixel);
 
+    // The passes over a pixel continue the sequences of each other,
+    // so the samplers hold the samples of all of them
     sampler_ = sampler_factory.create(id, rng_);
     sampler_->resize(num_samples_per_pixel, 1, 2, 1);
 
@@ -56,6 +63,8 @@ void Worker::init(uint32_t id, take::Settings const& settings, scene::Scene cons
 
         photon_map_ = photon_map;
     }
+
+    guide_tree_ = guide_tree;
 }
 
 float4 Worker::li(Ray& ray, scene::prop::Interface_stack const& interface_stack) noexcept {
@@ -87,6 +96,35 @@ float4 Worker::li(Ray& ray, scene::prop::Interface_stack const& interface_stack)
     }
 }
 
+void Worker::li(Ray* rays, uint32_t mask, scene::prop::Interface_stack const& interface_stack,
+                float4* results) noexcept {
+    if (!interface_stack.empty()) {
+        // The volume integrator needs to intersect the rays by itself
+        for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+            results[i] = (mask & (1u << i)) ? li(rays[i], interface_stack) : float4(0.f);
+        }
+
+        return;
+    }
+
+    Intersection intersections[math::Ray_packet::Size];
+
+    uint32_t const hits = intersect(rays, mask, intersections);
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if ((hits & (1u << i)) && resolve_mask(rays[i], intersections[i], Filter::Undefined)) {
+            float3 const li = surface_integrator_->li(rays[i], intersections[i], *this,
+                                                      interface_stack);
+
+            SOFT_ASSERT(math::all_finite_and_positive(li));
+
+            results[i] = float4(li, 1.f);
+        } else {
+            results[i] = float4(0.f);
+        }
+    }
+}
+
 bool Worker::volume(Ray& ray, Intersection& intersection, Filter filter, float3& li,
                     float3& transmittance) noexcept {
     return volume_integrator_->integrate(ray, intersection, filter, *this, li, transmittance);
@@ -104,8 +142,15 @@ bool Worker::transmitted_visibility(Ray& ray, Intersection const& intersection,
     return false;
 }
 
-uint32_t Worker::bake_photons(int32_t begin, int32_t end, uint32_t frame) noexcept {
+uint32_t Worker::bake_photons(int32_t begin, int32_t end, uint32_t frame,
+                              uint32_t iteration) noexcept {
     if (photon_mapper_) {
+        // Every pass of progressive photon mapping needs new photons. The sequences of the
+        // camera passes are the tile indices, which never reach this offset.
+        if (iteration > 0) {
+            rng_.start(iteration, Photon_sequence + static_cast<uint64_t>(begin));
+        }
+
         return photon_mapper_->bake(*photon_map_, begin, end, frame, *this);
     }
 
@@ -115,12 +160,16 @@ uint32_t Worker::bake_photons(int32_t begin, int32_t end, uint32_t frame) noexce
 float3 Worker::photon_li(Intersection const& intersection, Material_sample const& sample) const
     noexcept {
     if (photon_map_) {
-        return photon_map_->li(intersection, sample, *this);
+        return photon_map_->li(intersection, sample, pixel_, *this);
     }
 
     return float3::identity();
 }
 
+integrator::guiding::Tree* Worker::guide_tree() const noexcept {
+    return guide_tree_;
+}
+
 size_t Worker::num_bytes() const noexcept {
     size_t num_bytes = sizeof(*this);
 
@@ -18,6 +18,10 @@ namespace rendering {
 
 namespace integrator {
 
+namespace guiding {
+class Tree;
+}
+
 namespace photon {
 
 class Map;
@@ -53,21 +57,30 @@ class Worker : public scene::Worker {
               integrator::surface::Factory& surface_integrator_factory,
               integrator::volume::Factory&  volume_integrator_factory,
               sampler::Factory& sampler_factory, integrator::photon::Map* photon_map,
-              take::Photon_settings const& photon_settings_) noexcept;
+              take::Photon_settings const& photon_settings_,
+              integrator::guiding::Tree*   guide_tree) noexcept;
 
     float4 li(Ray& ray, scene::prop::Interface_stack const& interface_stack) noexcept;
 
+    // Same as above for the rays selected by mask, which are intersected as one packet
+    void li(Ray* rays, uint32_t mask, scene::prop::Interface_stack const& interface_stack,
+            float4* results) noexcept;
+
     bool volume(Ray& ray, Intersection& intersection, Filter filter, float3& li,
                 float3& transmittance) noexcept;
 
     bool transmitted_visibility(Ray& ray, Intersection const& intersection, Filter filter,
                                 float3& tv) noexcept;
 
-    uint32_t bake_photons(int32_t begin, int32_t end, uint32_t frame) noexcept;
+    // Iteration counts the photon passes of progressive photon mapping
+    uint32_t bake_photons(int32_t begin, int32_t end, uint32_t frame, uint32_t iteration) noexcept;
 
     float3 photon_li(Intersection const& intersection, Material_sample const& sample) const
         noexcept;
 
+    // Null if path guiding is disabled
+    integrator::guiding::Tree* guide_tree() const noexcept;
+
     size_t num_bytes() const noexcept;
 
   protected:
@@ -83,6 +96,11 @@ class Worker : public scene::Worker {
 
     integrator::photon::Mapper* photon_mapper_ = nullptr;
     integrator::photon::Map*    photon_map_    = nullptr;
+
+    integrator::guiding::Tree* guide_tree_ = nullptr;
+
+    // Sensor pixel of the current camera sample, for the statistics of progressive photon mapping
+    int32_t pixel_ = -1;
 };
 
 }  // namespace rendering
@@ -20,6 +20,8 @@ namespace filter {
 class Filter;
 }
 
+class Tile_buffer;
+
 template <class Base, class Clamp>
 class Filtered : public Base {
   public:
@@ -33,17 +35,17 @@ class Filtered : public Base {
 
     int32_t filter_radius_int() const noexcept override final;
 
-    int4 isolated_tile(int4 const& tile) const noexcept override final;
+    int4 footprint(int4 const& tile) const noexcept override final;
 
-    void add_sample(sampler::Camera_sample const& sample, float4 const&,
-                    int4 const& isolated_bounds, int4 const& bounds) noexcept override final;
+    void add_sample(sampler::Camera_sample const& sample, float4 const&, Tile_buffer& buffer,
+                    int4 const& bounds) noexcept override final;
 
   private:
-    void add_weighted_pixel(int2 pixel, float weight, float4 const& color,
-                            int4 const& isolated_bounds, int4 const& bounds) noexcept;
+    void add_weighted_pixel(int2 pixel, float weight, float4 const& color, Tile_buffer& buffer,
+                            int4 const& bounds) noexcept;
 
     void weight_and_add_pixel(int2 pixel, float2 relative_offset, float4 const& color,
-                              int4 const& isolated_bounds, int4 const& bounds) noexcept;
+                              Tile_buffer& buffer, int4 const& bounds) noexcept;
 
     Clamp clamp_;
 
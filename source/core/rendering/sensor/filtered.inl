@@ -5,6 +5,7 @@
 #include "filter/sensor_filter.hpp"
 #include "filtered.hpp"
 #include "sampler/camera_sample.hpp"
+#include "tile_buffer.hpp"
 
 namespace rendering::sensor {
 
@@ -29,19 +30,24 @@ int32_t Filtered<Base, Clamp>::filter_radius_int() const noexcept {
 }
 
 template <class Base, class Clamp>
-int4 Filtered<Base, Clamp>::isolated_tile(int4 const& tile) const noexcept {
-    int32_t const r = filter_radius_int();
-    return tile + int4(r, r, -r, -r);
+int4 Filtered<Base, Clamp>::footprint(int4 const& tile) const noexcept {
+    // add_sample() splats into the 3x3 neighborhood of the pixel of the sample
+    return tile + int4(-1, -1, 1, 1);
 }
 
 template <class Base, class Clamp>
 void Filtered<Base, Clamp>::add_sample(sampler::Camera_sample const& sample, float4 const& color,
-                                       int4 const& isolated_bounds, int4 const& bounds) noexcept {
+                                       Tile_buffer& buffer, int4 const& bounds) noexcept {
     float4 const clamped_color = clamp_.clamp(color);
 
     int32_t const x = bounds[0] + sample.pixel[0];
     int32_t const y = bounds[1] + sample.pixel[1];
 
+    if (static_cast<uint32_t>(sample.pixel[0]) <= static_cast<uint32_t>(bounds[2]) &&
+        static_cast<uint32_t>(sample.pixel[1]) <= static_cast<uint32_t>(bounds[3])) {
+        Base::add_statistics(int2(x, y), clamped_color);
+    }
+
     float const ox = sample.pixel_uv[0] - 0.5f;
     float const oy = sample.pixel_uv[1] - 0.5f;
 
@@ -54,56 +60,46 @@ void Filtered<Base, Clamp>::add_sample(sampler::Camera_sample const& sample, flo
     float const wy2 = filter_->evaluate(oy - 1.f);
 
     // 1. row
-    add_weighted_pixel(int2(x - 1, y - 1), wx0 * wy0, clamped_color, isolated_bounds, bounds);
-    add_weighted_pixel(int2(x, y - 1), wx1 * wy0, clamped_color, isolated_bounds, bounds);
-    add_weighted_pixel(int2(x + 1, y - 1), wx2 * wy0, clamped_color, isolated_bounds, bounds);
+    add_weighted_pixel(int2(x - 1, y - 1), wx0 * wy0, clamped_color, buffer, bounds);
+    add_weighted_pixel(int2(x, y - 1), wx1 * wy0, clamped_color, buffer, bounds);
+    add_weighted_pixel(int2(x + 1, y - 1), wx2 * wy0, clamped_color, buffer, bounds);
 
     // 2. row
-    add_weighted_pixel(int2(x - 1, y), wx0 * wy1, clamped_color, isolated_bounds, bounds);
-    add_weighted_pixel(int2(x, y), wx1 * wy1, clamped_color, isolated_bounds, bounds);
-    add_weighted_pixel(int2(x + 1, y), wx2 * wy1, clamped_color, isolated_bounds, bounds);
+    add_weighted_pixel(int2(x - 1, y), wx0 * wy1, clamped_color, buffer, bounds);
+    add_weighted_pixel(int2(x, y), wx1 * wy1, clamped_color, buffer, bounds);
+    add_weighted_pixel(int2(x + 1, y), wx2 * wy1, clamped_color, buffer, bounds);
 
     // 3. row
-    add_weighted_pixel(int2(x - 1, y + 1), wx0 * wy2, clamped_color, isolated_bounds, bounds);
-    add_weighted_pixel(int2(x, y + 1), wx1 * wy2, clamped_color, isolated_bounds, bounds);
-    add_weighted_pixel(int2(x + 1, y + 1), wx2 * wy2, clamped_color, isolated_bounds, bounds);
+    add_weighted_pixel(int2(x - 1, y + 1), wx0 * wy2, clamped_color, buffer, bounds);
+    add_weighted_pixel(int2(x, y + 1), wx1 * wy2, clamped_color, buffer, bounds);
+    add_weighted_pixel(int2(x + 1, y + 1), wx2 * wy2, clamped_color, buffer, bounds);
 }
 
 template <class Base, class Clamp>
 void Filtered<Base, Clamp>::add_weighted_pixel(int2 pixel, float weight, float4 const& color,
-                                               int4 const& isolated_bounds,
-                                               int4 const& bounds) noexcept {
+                                               Tile_buffer& buffer, int4 const& bounds) noexcept {
     if (static_cast<uint32_t>(pixel[0] - bounds[0]) <= static_cast<uint32_t>(bounds[2]) &&
         static_cast<uint32_t>(pixel[1] - bounds[1]) <= static_cast<uint32_t>(bounds[3])) {
-        if (static_cast<uint32_t>(pixel[0] - isolated_bounds[0]) <=
-                static_cast<uint32_t>(isolated_bounds[2]) &&
-            static_cast<uint32_t>(pixel[1] - isolated_bounds[1]) <=
-                static_cast<uint32_t>(isolated_bounds[3])) {
-            Base::add_pixel(pixel, color, weight);
-        } else {
-            Base::add_pixel_atomic(pixel, color, weight);
+        // The samples of neighbors would change the weighting of retired pixels
+        if (Base::converged(pixel)) {
+            return;
         }
+
+        buffer.add(pixel, color, weight);
     }
 }
 
 template <class Base, class Clamp>
 void Filtered<Base, Clamp>::weight_and_add_pixel(int2 pixel, float2 relative_offset,
-                                                 float4 const& color, int4 const& isolated_bounds,
+                                                 float4 const& color, Tile_buffer& buffer,
                                                  int4 const& bounds) noexcept {
-    // This code assumes that (isolated_)bounds contains [x_lo, y_lo, x_hi - x_lo, y_hi - y_lo]
+    // This code assumes that bounds contains [x_lo, y_lo, x_hi - x_lo, y_hi - y_lo]
 
     if (static_cast<uint32_t>(pixel[0] - bounds[0]) <= static_cast<uint32_t>(bounds[2]) &&
         static_cast<uint32_t>(pixel[1] - bounds[1]) <= static_cast<uint32_t>(bounds[3])) {
         float const weight = filter_->evaluate(relative_offset);
 
-        if (static_cast<uint32_t>(pixel[0] - isolated_bounds[0]) <=
-                static_cast<uint32_t>(isolated_bounds[2]) &&
-            static_cast<uint32_t>(pixel[1] - isolated_bounds[1]) <=
-                static_cast<uint32_t>(isolated_bounds[3])) {
-            Base::add_pixel(pixel, color, weight);
-        } else {
-            Base::add_pixel_atomic(pixel, color, weight);
-        }
+        buffer.add(pixel, color, weight);
     }
 }
 
@@ -1,8 +1,10 @@
 #include "opaque.hpp"
-#include "base/atomic/atomic.hpp"
+#include <istream>
+#include <ostream>
 #include "base/math/vector4.inl"
 #include "base/memory/align.hpp"
 #include "image/typed_image.inl"
+#include "tile_buffer.hpp"
 
 namespace rendering::sensor {
 
@@ -30,21 +32,18 @@ size_t Opaque::num_bytes() const noexcept {
     return static_cast<size_t>(d[0] * d[1]) * sizeof(float4);
 }
 
-void Opaque::add_pixel(int2 pixel, float4 const& color, float weight) noexcept {
+void Opaque::merge(Tile_buffer const& buffer) noexcept {
     auto const d = dimensions();
 
-    auto& value = pixels_[d[0] * pixel[1] + pixel[0]];
-    value += float4(weight * color.xyz(), weight);
-}
+    int4 const& area = buffer.area();
 
-void Opaque::add_pixel_atomic(int2 pixel, float4 const& color, float weight) noexcept {
-    auto const d = dimensions();
+    for (int32_t y = area[1], y_len = area[3] + 1; y < y_len; ++y) {
+        Tile_buffer::Pixel const* row = buffer.row(y - area[1]);
 
-    auto& value = pixels_[d[0] * pixel[1] + pixel[0]];
-    atomic::add_assign(value[0], weight * color[0]);
-    atomic::add_assign(value[1], weight * color[1]);
-    atomic::add_assign(value[2], weight * color[2]);
-    atomic::add_assign(value[3], weight);
+        for (int32_t x = area[0], x_len = area[2] + 1; x < x_len; ++x, ++row) {
+            pixels_[d[0] * y + x] += float4(row->color.xyz(), row->weight_sum);
+        }
+    }
 }
 
 void Opaque::resolve(int32_t begin, int32_t end, image::Float4& target) const noexcept {
@@ -59,4 +58,24 @@ void Opaque::resolve(int32_t begin, int32_t end, image::Float4& target) const no
     }
 }
 
+void Opaque::write_pixels(std::ostream& stream) const noexcept {
+    auto const d = dimensions();
+    stream.write(reinterpret_cast<char const*>(pixels_), d[0] * d[1] * sizeof(float4));
+}
+
+void Opaque::read_pixels(std::istream& stream) noexcept {
+    auto const d = dimensions();
+    stream.read(reinterpret_cast<char*>(pixels_), d[0] * d[1] * sizeof(float4));
+}
+
+void Opaque::clear_pixels(int4 const& area) noexcept {
+    auto const d = dimensions();
+
+    for (int32_t y = area[1]; y <= area[3]; ++y) {
+        for (int32_t x = area[0]; x <= area[2]; ++x) {
+            pixels_[d[0] * y + x] = float4(0.f);
+        }
+    }
+}
+
 }  // namespace rendering::sensor
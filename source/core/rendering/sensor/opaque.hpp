@@ -17,12 +17,16 @@ class Opaque : public Sensor {
 
     size_t num_bytes() const noexcept override final;
 
+    void merge(Tile_buffer const& buffer) noexcept override final;
+
   protected:
-    void add_pixel(int2 pixel, float4 const& color, float weight) noexcept override final;
+    void resolve(int32_t begin, int32_t end, image::Float4& target) const noexcept override final;
 
-    void add_pixel_atomic(int2 pixel, float4 const& color, float weight) noexcept override final;
+    void write_pixels(std::ostream& stream) const noexcept override final;
 
-    void resolve(int32_t begin, int32_t end, image::Float4& target) const noexcept override final;
+    void read_pixels(std::istream& stream) noexcept override final;
+
+    void clear_pixels(int4 const& area) noexcept override final;
 
     // weight_sum is saved in pixel.w
     float4* pixels_;
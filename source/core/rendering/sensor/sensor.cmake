@@ -10,6 +10,8 @@ target_sources(core
 	"${CMAKE_CURRENT_LIST_DIR}/opaque.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/sensor.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/sensor.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/tile_buffer.cpp"
+	"${CMAKE_CURRENT_LIST_DIR}/tile_buffer.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/transparent.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/transparent.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/unfiltered.hpp"
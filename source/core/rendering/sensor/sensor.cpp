@@ -1,14 +1,24 @@
 #include "sensor.hpp"
+#include <istream>
+#include <limits>
+#include <ostream>
 #include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
+#include "base/spectrum/rgb.hpp"
 #include "base/thread/thread_pool.hpp"
 #include "image/typed_image.inl"
 
 namespace rendering::sensor {
 
 Sensor::Sensor(int2 dimensions, float exposure) noexcept
-    : dimensions_(dimensions), exposure_factor_(std::exp2(exposure)) {}
+    : dimensions_(dimensions),
+      exposure_factor_(std::exp2(exposure)),
+      noise_threshold_(0.f),
+      statistics_(nullptr) {}
 
-Sensor::~Sensor() noexcept {}
+Sensor::~Sensor() noexcept {
+    memory::free_aligned(statistics_);
+}
 
 int2 Sensor::dimensions() const noexcept {
     return dimensions_;
@@ -21,4 +31,159 @@ void Sensor::resolve(thread::Pool& pool, image::Float4& target) const noexcept {
                    0, target.area());
 }
 
+void Sensor::write(std::ostream& stream) const noexcept {
+    uint32_t const header[] = {static_cast<uint32_t>(dimensions_[0]),
+                               static_cast<uint32_t>(dimensions_[1]),
+                               has_alpha_transparency() ? 1u : 0u, statistics_ ? 1u : 0u};
+
+    stream.write(reinterpret_cast<char const*>(header), sizeof(header));
+
+    write_pixels(stream);
+
+    if (statistics_) {
+        stream.write(reinterpret_cast<char const*>(statistics_),
+                     dimensions_[0] * dimensions_[1] * sizeof(Statistics));
+    }
+}
+
+bool Sensor::read(std::istream& stream) noexcept {
+    uint32_t header[4];
+    stream.read(reinterpret_cast<char*>(header), sizeof(header));
+
+    if (!stream || header[0] != static_cast<uint32_t>(dimensions_[0]) ||
+        header[1] != static_cast<uint32_t>(dimensions_[1]) ||
+        (1u == header[2]) != has_alpha_transparency() || (1u == header[3]) != bool(statistics_)) {
+        return false;
+    }
+
+    read_pixels(stream);
+
+    if (statistics_) {
+        stream.read(reinterpret_cast<char*>(statistics_),
+                    dimensions_[0] * dimensions_[1] * sizeof(Statistics));
+    }
+
+    return bool(stream);
+}
+
+void Sensor::set_noise_threshold(float threshold) noexcept {
+    noise_threshold_ = threshold;
+
+    if (threshold > 0.f && !statistics_) {
+        statistics_ = memory::allocate_aligned<Statistics>(dimensions_[0] * dimensions_[1]);
+
+        clear_statistics();
+    }
+}
+
+void Sensor::clear_statistics() noexcept {
+    if (!statistics_) {
+        return;
+    }
+
+    for (int32_t i = 0, len = dimensions_[0] * dimensions_[1]; i < len; ++i) {
+        statistics_[i] = Statistics{0.f, 0.f, 0, false, false};
+    }
+}
+
+void Sensor::clear_area(int4 const& area) noexcept {
+    int4 const clamped(math::max(area.xy(), int2(0)), math::min(area.zw(), dimensions_ - int2(1)));
+
+    clear_pixels(clamped);
+
+    if (!statistics_) {
+        return;
+    }
+
+    for (int32_t y = clamped[1]; y <= clamped[3]; ++y) {
+        for (int32_t x = clamped[0]; x <= clamped[2]; ++x) {
+            statistics_[dimensions_[0] * y + x] = Statistics{0.f, 0.f, 0, false, false};
+        }
+    }
+}
+
+bool Sensor::converged(int2 pixel) const noexcept {
+    return statistics_ && statistics_[dimensions_[0] * pixel[1] + pixel[0]].converged;
+}
+
+bool Sensor::retire_converged(int4 const& tile) noexcept {
+    if (!statistics_) {
+        return true;
+    }
+
+    int2 const last = dimensions_ - int2(1);
+
+    int4 const clamped(math::max(tile.xy(), int2(0)), math::min(tile.zw(), last));
+
+    bool active = false;
+
+    for (int32_t y = clamped[1]; y <= clamped[3]; ++y) {
+        for (int32_t x = clamped[0]; x <= clamped[2]; ++x) {
+            auto& s = statistics_[dimensions_[0] * y + x];
+
+            if (s.converged) {
+                continue;
+            }
+
+            // The neighborhood must be converged as well,
+            // which makes it less likely to retire pixels that just missed rare bright paths
+            float max_error = 0.f;
+
+            for (int32_t ny = std::max(y - 1, 0), ny_len = std::min(y + 1, last[1]); ny <= ny_len;
+                 ++ny) {
+                for (int32_t nx = std::max(x - 1, 0), nx_len = std::min(x + 1, last[0]);
+                     nx <= nx_len; ++nx) {
+                    max_error = std::max(error(int2(nx, ny)), max_error);
+                }
+            }
+
+            s.converged = max_error <= noise_threshold_;
+
+            active |= !s.converged;
+        }
+    }
+
+    return active;
+}
+
+float Sensor::error(int2 pixel) const noexcept {
+    // Dark pixels would never converge on the relative error alone
+    static float constexpr Min_luminance = 0.01f;
+
+    auto const& s = statistics_[dimensions_[0] * pixel[1] + pixel[0]];
+
+    if (s.num_samples < 2) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // Black pixels that are not background might just not have found the light yet
+    if (0.f == s.mean && s.hit) {
+        return std::numeric_limits<float>::max();
+    }
+
+    float const n        = static_cast<float>(s.num_samples);
+    float const variance = s.m2 / (n - 1.f);
+
+    return std::sqrt(variance / n) / std::max(s.mean, Min_luminance);
+}
+
+void Sensor::add_statistics(int2 pixel, float4 const& color) noexcept {
+    if (!statistics_) {
+        return;
+    }
+
+    // Welford's online algorithm
+    auto& s = statistics_[dimensions_[0] * pixel[1] + pixel[0]];
+
+    float const value = spectrum::luminance(color.xyz());
+
+    ++s.num_samples;
+
+    s.hit |= color[3] > 0.f;
+
+    float const delta = value - s.mean;
+    s.mean += delta / static_cast<float>(s.num_samples);
+    s.m2 += delta * (value - s.mean);
+}
+
 }  // namespace rendering::sensor
@@ -2,6 +2,7 @@
 #define SU_CORE_RENDERING_SENSOR_SENSOR_HPP
 
 #include <cstddef>
+#include <iosfwd>
 #include "base/math/vector2.hpp"
 #include "image/typed_image_fwd.hpp"
 
@@ -15,6 +16,8 @@ struct Camera_sample;
 
 namespace rendering::sensor {
 
+class Tile_buffer;
+
 class Sensor {
   public:
     Sensor(int2 dimensions, float exposure) noexcept;
@@ -25,29 +28,77 @@ class Sensor {
 
     void resolve(thread::Pool& pool, image::Float4& target) const noexcept;
 
+    // Resolves only the pixels [begin, end) of the target
+    virtual void resolve(int32_t begin, int32_t end, image::Float4& target) const noexcept = 0;
+
+    // Adaptive sampling keeps luminance statistics of the samples of every pixel,
+    // so that pixels can be retired once their relative error is below the threshold
+    void set_noise_threshold(float threshold) noexcept;
+
+    void clear_statistics() noexcept;
+
+    bool converged(int2 pixel) const noexcept;
+
+    // Retires the converged pixels of the tile, which is given in sensor coordinates.
+    // Returns whether the tile still has pixels that need more samples.
+    bool retire_converged(int4 const& tile) noexcept;
+
+    // Serializes the accumulated samples together with the adaptive sampling statistics
+    void write(std::ostream& stream) const noexcept;
+
+    // Counterpart of write(), fails if the checkpoint was written by a different kind of sensor
+    bool read(std::istream& stream) noexcept;
+
     virtual int32_t filter_radius_int() const noexcept = 0;
 
-    virtual int4 isolated_tile(int4 const& tile) const noexcept = 0;
+    // Area that the samples of the tile can contribute to
+    virtual int4 footprint(int4 const& tile) const noexcept = 0;
 
     virtual void clear() = 0;
 
+    // Clears the samples and statistics of the pixels inside the area, which is inclusive
+    void clear_area(int4 const& area) noexcept;
+
+    // Adds the sample to the buffer of the worker, which must cover the footprint of the tile
     virtual void add_sample(sampler::Camera_sample const& sample, float4 const& color,
-                            int4 const& isolated_bounds, int4 const& bounds) noexcept = 0;
+                            Tile_buffer& buffer, int4 const& bounds) noexcept = 0;
+
+    // Adds the samples of the buffer to the sensor. Buffers that overlap must not be merged
+    // concurrently, see Tile_queue::Num_phases.
+    virtual void merge(Tile_buffer const& buffer) noexcept = 0;
 
     virtual bool has_alpha_transparency() const noexcept = 0;
 
     virtual size_t num_bytes() const noexcept = 0;
 
   protected:
-    virtual void add_pixel(int2 pixel, float4 const& color, float weight) noexcept = 0;
+    virtual void write_pixels(std::ostream& stream) const noexcept = 0;
 
-    virtual void add_pixel_atomic(int2 pixel, float4 const& color, float weight) noexcept = 0;
+    virtual void read_pixels(std::istream& stream) noexcept = 0;
 
-    virtual void resolve(int32_t begin, int32_t end, image::Float4& target) const noexcept = 0;
+    // The area lies inside of the sensor
+    virtual void clear_pixels(int4 const& area) noexcept = 0;
+
+    void add_statistics(int2 pixel, float4 const& color) noexcept;
+
+    // Relative standard error of the mean luminance of the pixel
+    float error(int2 pixel) const noexcept;
 
     int2 dimensions_;
 
     float exposure_factor_;
+
+    struct Statistics {
+        float    mean;
+        float    m2;
+        uint32_t num_samples;
+        bool     hit;
+        bool     converged;
+    };
+
+    float noise_threshold_;
+
+    Statistics* statistics_;
 };
 
 }  // namespace rendering::sensor
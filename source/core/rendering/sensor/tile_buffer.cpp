@@ -0,0 +1,47 @@
+#include "tile_buffer.hpp"
+#include "base/math/vector4.inl"
+#include "base/memory/align.hpp"
+
+namespace rendering::sensor {
+
+Tile_buffer::Tile_buffer() noexcept
+    : area_(0), width_(0), capacity_(0), pixels_(nullptr) {}
+
+Tile_buffer::~Tile_buffer() noexcept {
+    memory::free_aligned(pixels_);
+}
+
+void Tile_buffer::start(int4 const& area) noexcept {
+    area_  = area;
+    width_ = area[2] - area[0] + 1;
+
+    uint32_t const num_pixels = static_cast<uint32_t>(width_ * (area[3] - area[1] + 1));
+
+    if (num_pixels > capacity_) {
+        memory::free_aligned(pixels_);
+
+        pixels_   = memory::allocate_aligned<Pixel>(num_pixels);
+        capacity_ = num_pixels;
+    }
+
+    for (uint32_t i = 0; i < num_pixels; ++i) {
+        pixels_[i] = Pixel{float4(0.f), 0.f};
+    }
+}
+
+int4 const& Tile_buffer::area() const noexcept {
+    return area_;
+}
+
+void Tile_buffer::add(int2 pixel, float4 const& color, float weight) noexcept {
+    auto& value = pixels_[width_ * (pixel[1] - area_[1]) + (pixel[0] - area_[0])];
+
+    value.color += weight * color;
+    value.weight_sum += weight;
+}
+
+Tile_buffer::Pixel const* Tile_buffer::row(int32_t y) const noexcept {
+    return pixels_ + width_ * y;
+}
+
+}  // namespace rendering::sensor
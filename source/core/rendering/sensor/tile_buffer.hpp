@@ -0,0 +1,44 @@
+#ifndef SU_CORE_RENDERING_SENSOR_TILE_BUFFER_HPP
+#define SU_CORE_RENDERING_SENSOR_TILE_BUFFER_HPP
+
+#include "base/math/vector4.hpp"
+
+namespace rendering::sensor {
+
+// Private accumulation buffer of a worker, that covers a tile together with the apron that the
+// filter footprints of its samples reach into. Sensor::merge() adds it to the sensor afterwards.
+class Tile_buffer {
+  public:
+    struct Pixel {
+        float4 color;
+        float  weight_sum;
+    };
+
+    Tile_buffer() noexcept;
+
+    ~Tile_buffer() noexcept;
+
+    // Clears the buffer for the area, which is [x_lo, y_lo, x_hi, y_hi] in sensor coordinates
+    void start(int4 const& area) noexcept;
+
+    int4 const& area() const noexcept;
+
+    // The pixel must be inside of the area
+    void add(int2 pixel, float4 const& color, float weight) noexcept;
+
+    // Row of the area, relative to its first row
+    Pixel const* row(int32_t y) const noexcept;
+
+  private:
+    int4 area_;
+
+    int32_t width_;
+
+    uint32_t capacity_;
+
+    Pixel* pixels_;
+};
+
+}  // namespace rendering::sensor
+
+#endif
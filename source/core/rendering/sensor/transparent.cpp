@@ -1,8 +1,10 @@
 #include "transparent.hpp"
-#include "base/atomic/atomic.hpp"
+#include <istream>
+#include <ostream>
 #include "base/math/vector4.inl"
 #include "base/memory/align.hpp"
 #include "image/typed_image.inl"
+#include "tile_buffer.hpp"
 
 namespace rendering::sensor {
 
@@ -31,23 +33,20 @@ size_t Transparent::num_bytes() const noexcept {
     return d[0] * d[1] * sizeof(Pixel);
 }
 
-void Transparent::add_pixel(int2 pixel, float4 const& color, float weight) noexcept {
+void Transparent::merge(Tile_buffer const& buffer) noexcept {
     auto const d = dimensions();
 
-    auto& value = pixels_[d[0] * pixel[1] + pixel[0]];
-    value.color += weight * color;
-    value.weight_sum += weight;
-}
+    int4 const& area = buffer.area();
 
-void Transparent::add_pixel_atomic(int2 pixel, float4 const& color, float weight) noexcept {
-    auto const d = dimensions();
+    for (int32_t y = area[1], y_len = area[3] + 1; y < y_len; ++y) {
+        Tile_buffer::Pixel const* row = buffer.row(y - area[1]);
 
-    auto& value = pixels_[d[0] * pixel[1] + pixel[0]];
-    atomic::add_assign(value.color[0], weight * color[0]);
-    atomic::add_assign(value.color[1], weight * color[1]);
-    atomic::add_assign(value.color[2], weight * color[2]);
-    atomic::add_assign(value.color[3], weight * color[3]);
-    atomic::add_assign(value.weight_sum, weight);
+        for (int32_t x = area[0], x_len = area[2] + 1; x < x_len; ++x, ++row) {
+            auto& value = pixels_[d[0] * y + x];
+            value.color += row->color;
+            value.weight_sum += row->weight_sum;
+        }
+    }
 }
 
 void Transparent::resolve(int32_t begin, int32_t end, image::Float4& target) const noexcept {
@@ -62,4 +61,25 @@ void Transparent::resolve(int32_t begin, int32_t end, image::Float4& target) con
     }
 }
 
+void Transparent::write_pixels(std::ostream& stream) const noexcept {
+    auto const d = dimensions();
+    stream.write(reinterpret_cast<char const*>(pixels_), d[0] * d[1] * sizeof(Pixel));
+}
+
+void Transparent::read_pixels(std::istream& stream) noexcept {
+    auto const d = dimensions();
+    stream.read(reinterpret_cast<char*>(pixels_), d[0] * d[1] * sizeof(Pixel));
+}
+
+void Transparent::clear_pixels(int4 const& area) noexcept {
+    auto const d = dimensions();
+
+    for (int32_t y = area[1]; y <= area[3]; ++y) {
+        for (int32_t x = area[0]; x <= area[2]; ++x) {
+            pixels_[d[0] * y + x].color      = float4(0.f);
+            pixels_[d[0] * y + x].weight_sum = 0.f;
+        }
+    }
+}
+
 }  // namespace rendering::sensor
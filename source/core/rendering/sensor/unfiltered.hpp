@@ -9,6 +9,8 @@ struct Camera_sample;
 
 namespace rendering::sensor {
 
+class Tile_buffer;
+
 template <class Base, class Clamp>
 class Unfiltered : public Base {
   public:
@@ -16,11 +18,10 @@ class Unfiltered : public Base {
 
     virtual int32_t filter_radius_int() const noexcept override final;
 
-    virtual int4 isolated_tile(int4 const& tile) const noexcept override final;
+    virtual int4 footprint(int4 const& tile) const noexcept override final;
 
     virtual void add_sample(sampler::Camera_sample const& sample, float4 const& color,
-                            int4 const& isolated_bounds,
-                            int4 const& bounds) noexcept override final;
+                            Tile_buffer& buffer, int4 const& bounds) noexcept override final;
 
   private:
     Clamp clamp_;
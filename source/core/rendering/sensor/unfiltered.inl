@@ -2,6 +2,7 @@
 #define SU_CORE_RENDERING_SENSOR_UNFILTERED_INL
 
 #include "sampler/camera_sample.hpp"
+#include "tile_buffer.hpp"
 #include "unfiltered.hpp"
 
 namespace rendering::sensor {
@@ -16,15 +17,18 @@ int32_t Unfiltered<Base, Clamp>::filter_radius_int() const noexcept {
 }
 
 template <class Base, class Clamp>
-int4 Unfiltered<Base, Clamp>::isolated_tile(int4 const& tile) const noexcept {
+int4 Unfiltered<Base, Clamp>::footprint(int4 const& tile) const noexcept {
     return tile;
 }
 
 template <class Base, class Clamp>
 void Unfiltered<Base, Clamp>::add_sample(sampler::Camera_sample const& sample, float4 const& color,
-                                         int4 const& /*isolated_bounds*/,
-                                         int4 const& bounds) noexcept {
-    Base::add_pixel(bounds.xy() + sample.pixel, clamp_.clamp(color), 1.f);
+                                         Tile_buffer& buffer, int4 const& bounds) noexcept {
+    int2 const   pixel         = bounds.xy() + sample.pixel;
+    float4 const clamped_color = clamp_.clamp(color);
+
+    Base::add_statistics(pixel, clamped_color);
+    buffer.add(pixel, clamped_color, 1.f);
 }
 
 }  // namespace rendering::sensor
@@ -1,4 +1,5 @@
 #include "tile_queue.hpp"
+#include <algorithm>
 #include "base/math/vector4.inl"
 #include "base/memory/align.hpp"
 
@@ -12,6 +13,7 @@ Tile_queue::Tile_queue(int2 resolution, int2 tile_dimensions, int32_t filter_rad
                                                  static_cast<float>(tile_dimensions[0]))) *
                  static_cast<uint32_t>(std::ceil(static_cast<float>(resolution[1]) /
                                                  static_cast<float>(tile_dimensions[1])))),
+      num_active_(num_tiles_),
       tiles_(memory::allocate_aligned<int4>(num_tiles_)),
       current_consume_(num_tiles_) {
     int2 current_pixel(0, 0);
@@ -59,6 +61,29 @@ uint32_t Tile_queue::size() const noexcept {
 }
 
 void Tile_queue::restart() noexcept {
+    num_active_ = num_tiles_;
+
+    current_consume_ = 0;
+}
+
+void Tile_queue::restart(bool const* active) noexcept {
+    int4* const end = std::partition(tiles_, tiles_ + num_tiles_, [this, active](int4 const& tile) {
+        return active[index(tile)];
+    });
+
+    num_active_ = static_cast<uint32_t>(end - tiles_);
+
+    current_consume_ = 0;
+}
+
+void Tile_queue::restart(bool const* active, uint32_t phase) noexcept {
+    int4* const end = std::partition(
+        tiles_, tiles_ + num_tiles_, [this, active, phase](int4 const& tile) {
+            return (!active || active[index(tile)]) && phase == Tile_queue::phase(tile);
+        });
+
+    num_active_ = static_cast<uint32_t>(end - tiles_);
+
     current_consume_ = 0;
 }
 
@@ -66,7 +91,7 @@ bool Tile_queue::pop(int4& tile) noexcept {
     // uint32_t const current = current_consume_++;
     uint32_t const current = current_consume_.fetch_add(1, std::memory_order_relaxed);
 
-    if (current < num_tiles_) {
+    if (current < num_active_) {
         tile = tiles_[current];
         return true;
     }
@@ -81,6 +106,13 @@ uint32_t Tile_queue::index(int4 const& tile) const noexcept {
     return static_cast<uint32_t>(y * tiles_per_row_ + x);
 }
 
+uint32_t Tile_queue::phase(int4 const& tile) const noexcept {
+    int32_t const x = std::max(tile[0], 0) / tile_dimensions_[0];
+    int32_t const y = std::max(tile[1], 0) / tile_dimensions_[1];
+
+    return static_cast<uint32_t>((x & 1) | ((y & 1) << 1));
+}
+
 void Tile_queue::push(int4 const& tile) noexcept {
     uint32_t const current = num_tiles_ - current_consume_--;
 
@@ -10,6 +10,11 @@ namespace rendering {
 
 class Tile_queue {
   public:
+    // Tiles of the same phase are at least one tile apart, so that their filter footprints
+    // do not overlap. Rendering one phase after the other allows workers to merge their tiles
+    // into the sensor without atomics, and in an order that does not depend on the scheduling.
+    static uint32_t constexpr Num_phases = 4;
+
     Tile_queue(int2 resolution, int2 tile_dimensions, int32_t filter_radius) noexcept;
 
     ~Tile_queue() noexcept;
@@ -18,10 +23,18 @@ class Tile_queue {
 
     void restart() noexcept;
 
+    // Restarts with only the tiles that are flagged in active, which is indexed by index()
+    void restart(bool const* active) noexcept;
+
+    // Restarts with only the tiles of the phase, that are flagged in active if it is not null
+    void restart(bool const* active, uint32_t phase) noexcept;
+
     bool pop(int4& tile) noexcept;
 
     uint32_t index(int4 const& tile) const noexcept;
 
+    uint32_t phase(int4 const& tile) const noexcept;
+
   private:
     void push(int4 const& tile) noexcept;
 
@@ -31,6 +44,8 @@ class Tile_queue {
 
     uint32_t const num_tiles_;
 
+    uint32_t num_active_;
+
     int4* tiles_;
 
     std::atomic<uint32_t> current_consume_;
@@ -32,6 +32,8 @@ class Typed_cache : public Cache {
     void store(std::string const& name, memory::Variant_map const& options,
                std::shared_ptr<T> const& resource) noexcept;
 
+    void erase(std::string const& name, memory::Variant_map const& options) noexcept;
+
     size_t num_bytes() const noexcept;
 
   private:
@@ -81,6 +81,11 @@ void Typed_cache<T>::store(std::string const& name, memory::Variant_map const& o
     resources_[key] = resource;
 }
 
+template <typename T>
+void Typed_cache<T>::erase(std::string const& name, memory::Variant_map const& options) noexcept {
+    resources_.erase(std::make_pair(name, options));
+}
+
 template <typename T>
 size_t Typed_cache<T>::num_bytes() const noexcept {
     size_t num_bytes = 0;
@@ -53,6 +53,11 @@ class Manager {
     void store(std::string const& name, std::shared_ptr<T> resource,
                memory::Variant_map const& options = memory::Variant_map()) noexcept;
 
+    // The resource itself stays alive as long as it is still referenced elsewhere
+    template <typename T>
+    void erase(std::string const&         name,
+               memory::Variant_map const& options = memory::Variant_map()) noexcept;
+
     template <typename T>
     size_t num_bytes() const noexcept;
 
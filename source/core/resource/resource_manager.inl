@@ -88,6 +88,18 @@ void Manager::store(std::string const& name, std::shared_ptr<T> resource,
     return cache->store(name, options, resource);
 }
 
+template <typename T>
+void Manager::erase(std::string const& name, memory::Variant_map const& options) noexcept {
+    Typed_cache<T>* cache = typed_cache<T>();
+
+    // a provider for this resource type was never registered
+    if (!cache) {
+        return;
+    }
+
+    cache->erase(name, options);
+}
+
 template <typename T>
 size_t Manager::num_bytes() const noexcept {
     const Typed_cache<T>* cache = typed_cache<T>();
@@ -39,9 +39,11 @@ void Sampler::resize(uint32_t num_iterations, uint32_t num_samples_per_iteration
     }
 }
 
-void Sampler::start_pixel() noexcept {
+void Sampler::start_pixel(uint32_t sample_begin) noexcept {
+    uint32_t const current = sample_begin * num_samples_per_iteration_;
+
     for (uint32_t i = 0, len = num_dimensions_2D_ + num_dimensions_1D_; i < len; ++i) {
-        current_sample_2D_[i] = 0;
+        current_sample_2D_[i] = current;
     }
 
     on_start_pixel();
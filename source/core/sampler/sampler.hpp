@@ -21,7 +21,9 @@ class Sampler {
     void resize(uint32_t num_iterations, uint32_t num_samples_per_iteration,
                 uint32_t num_dimensions_2D, uint32_t num_dimensions_1D) noexcept;
 
-    void start_pixel() noexcept;
+    // Continues the sequences of the pixel at sample_begin, which lets a pixel be rendered in
+    // several passes without repeating the samples of the earlier ones
+    void start_pixel(uint32_t sample_begin = 0) noexcept;
 
     rnd::Generator& rng() noexcept;
 
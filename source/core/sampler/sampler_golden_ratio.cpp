@@ -11,20 +11,24 @@
 namespace sampler {
 
 Golden_ratio::Golden_ratio(rnd::Generator& rng) noexcept
-    : Sampler(rng), samples_2D_(nullptr), samples_1D_(nullptr) {}
+    : Sampler(rng),
+      seed_(0),
+      samples_2D_(nullptr),
+      samples_1D_(nullptr),
+      generated_2D_(nullptr),
+      generated_1D_(nullptr) {}
 
 Golden_ratio::~Golden_ratio() noexcept {
+    memory::free_aligned(generated_2D_);
     memory::free_aligned(samples_2D_);
 }
 
 Camera_sample Golden_ratio::generate_camera_sample(int2 pixel, uint32_t index) noexcept {
     SOFT_ASSERT(index < num_samples_);
 
-    if (0 == index) {
-        generate_2D(0);
-        generate_2D(1);
-        generate_1D(0);
-    }
+    generate_2D(0);
+    generate_2D(1);
+    generate_1D(0);
 
     return Camera_sample{pixel, samples_2D_[index], samples_2D_[num_samples_ + index],
                          samples_1D_[index]};
@@ -35,9 +39,7 @@ float2 Golden_ratio::generate_sample_2D(uint32_t dimension) noexcept {
 
     uint32_t const current = current_sample_2D_[dimension]++;
 
-    if (0 == current) {
-        generate_2D(dimension);
-    }
+    generate_2D(dimension);
 
     return samples_2D_[dimension * num_samples_ + current];
 }
@@ -47,16 +49,15 @@ float Golden_ratio::generate_sample_1D(uint32_t dimension) noexcept {
 
     uint32_t const current = current_sample_1D_[dimension]++;
 
-    if (0 == current) {
-        generate_1D(dimension);
-    }
+    generate_1D(dimension);
 
     return samples_1D_[dimension * num_samples_ + current];
 }
 
 size_t Golden_ratio::num_bytes() const noexcept {
     return num_samples_ * num_dimensions_2D_ * sizeof(float2) +
-           num_samples_ * num_dimensions_1D_ * sizeof(float);
+           num_samples_ * num_dimensions_1D_ * sizeof(float) +
+           (num_dimensions_2D_ + num_dimensions_1D_) * sizeof(bool);
 }
 
 void Golden_ratio::on_resize() noexcept {
@@ -67,24 +68,51 @@ void Golden_ratio::on_resize() noexcept {
 
     samples_2D_ = reinterpret_cast<float2*>(buffer);
     samples_1D_ = buffer + num_samples_ * 2 * num_dimensions_2D_;
+
+    memory::free_aligned(generated_2D_);
+
+    generated_2D_ = memory::allocate_aligned<bool>(num_dimensions_2D_ + num_dimensions_1D_);
+    generated_1D_ = generated_2D_ + num_dimensions_2D_;
 }
 
-void Golden_ratio::on_start_pixel() noexcept {}
+void Golden_ratio::on_start_pixel() noexcept {
+    seed_ = rng_.random_uint();
+
+    for (uint32_t i = 0, len = num_dimensions_2D_ + num_dimensions_1D_; i < len; ++i) {
+        generated_2D_[i] = false;
+    }
+}
 
 void Golden_ratio::generate_2D(uint32_t dimension) noexcept {
-    float2 const r(rng_.random_float(), rng_.random_float());
+    if (generated_2D_[dimension]) {
+        return;
+    }
+
+    generated_2D_[dimension] = true;
+
+    rnd::Generator rng(seed_, dimension);
+
+    float2 const r(rng.random_float(), rng.random_float());
 
     float2* begin = samples_2D_ + dimension * num_samples_;
     math::golden_ratio(begin, num_samples_, r);
-    rnd::biased_shuffle(begin, num_samples_, rng_);
+    rnd::biased_shuffle(begin, num_samples_, rng);
 }
 
 void Golden_ratio::generate_1D(uint32_t dimension) noexcept {
-    float const r = rng_.random_float();
+    if (generated_1D_[dimension]) {
+        return;
+    }
+
+    generated_1D_[dimension] = true;
+
+    rnd::Generator rng(seed_, num_dimensions_2D_ + dimension);
+
+    float const r = rng.random_float();
 
     float* begin = samples_1D_ + dimension * num_samples_;
     math::golden_ratio(begin, num_samples_, r);
-    rnd::biased_shuffle(begin, num_samples_, rng_);
+    rnd::biased_shuffle(begin, num_samples_, rng);
 }
 
 Golden_ratio_factory::Golden_ratio_factory(uint32_t num_samplers) noexcept
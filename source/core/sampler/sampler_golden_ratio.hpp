@@ -27,8 +27,14 @@ class alignas(64) Golden_ratio final : public Sampler {
     void generate_2D(uint32_t dimension) noexcept;
     void generate_1D(uint32_t dimension) noexcept;
 
+    // The sets are derived from the seed alone, so that every pass over a pixel gets the same ones
+    uint32_t seed_;
+
     float2* samples_2D_;
     float*  samples_1D_;
+
+    bool* generated_2D_;
+    bool* generated_1D_;
 };
 
 class Golden_ratio_factory final : public Factory {
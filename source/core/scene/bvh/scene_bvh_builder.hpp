@@ -4,8 +4,10 @@
 #include <cstddef>
 #include <vector>
 #include "base/math/aabb.hpp"
-#include "base/math/plane.hpp"
-#include "scene_bvh_split_candidate.hpp"
+
+namespace thread {
+class Pool;
+}
 
 namespace scene::bvh {
 
@@ -20,7 +22,11 @@ class Builder {
 
     ~Builder() noexcept;
 
-    void build(Tree<T>& tree, std::vector<T*>& finite_props) noexcept;
+    void build(Tree<T>& tree, std::vector<T*>& finite_props, thread::Pool& pool) noexcept;
+
+    // Only refits the tree if it was built from the same props before,
+    // as long as the quality of the refitted tree does not degrade too much
+    void update(Tree<T>& tree, std::vector<T*>& finite_props, thread::Pool& pool) noexcept;
 
   private:
     struct Build_node {
@@ -42,10 +48,10 @@ class Builder {
 
     using index = typename std::vector<T*>::iterator;
 
-    void split(Build_node* node, index begin, index end, uint32_t max_shapes,
-               std::vector<T*>& out_props) noexcept;
+    uint32_t split(Build_node* node, index begin, index end, uint32_t max_shapes, uint32_t depth,
+                   thread::Pool& pool) noexcept;
 
-    Split_candidate<T> splitting_plane(math::AABB const& aabb, index begin, index end) noexcept;
+    static index partition(Build_node* node, index begin, index end) noexcept;
 
     void serialize(Build_node* node) noexcept;
 
@@ -53,15 +59,14 @@ class Builder {
 
     uint32_t current_node_index() const noexcept;
 
-    static void assign(Build_node* node, index begin, index end,
-                       std::vector<T*>& out_data) noexcept;
+    void assign(Build_node* node, index begin, index end) const noexcept;
 
     static math::AABB aabb(index begin, index end) noexcept;
 
-    std::vector<Split_candidate<T>> split_candidates_;
-
     Build_node* root_;
 
+    index props_begin_;
+
     uint32_t num_nodes_;
     uint32_t current_node_;
 
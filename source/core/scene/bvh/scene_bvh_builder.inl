@@ -1,11 +1,12 @@
 #ifndef SU_CORE_SCENE_BVH_BUILDER_INL
 #define SU_CORE_SCENE_BVH_BUILDER_INL
 
+#include <algorithm>
+#include <limits>
 #include "base/math/aabb.inl"
-#include "base/math/plane.inl"
+#include "base/thread/thread_pool.hpp"
 #include "scene_bvh_builder.hpp"
 #include "scene_bvh_node.inl"
-#include "scene_bvh_split_candidate.inl"
 #include "scene_bvh_tree.inl"
 
 namespace scene::bvh {
@@ -21,16 +22,19 @@ Builder<T>::~Builder() noexcept {
 }
 
 template <typename T>
-void Builder<T>::build(Tree<T>& tree, std::vector<T*>& finite_props) noexcept {
+void Builder<T>::build(Tree<T>& tree, std::vector<T*>& finite_props,
+                       thread::Pool& pool) noexcept {
     tree.clear();
 
-    tree.data_.reserve(finite_props.size());
-
     if (finite_props.empty()) {
         nodes_ = tree.allocate_nodes(0);
     } else {
-        num_nodes_ = 1;
-        split(root_, finite_props.begin(), finite_props.end(), 4, tree.data_);
+        props_begin_ = finite_props.begin();
+
+        num_nodes_ = split(root_, finite_props.begin(), finite_props.end(), 4, 0, pool);
+
+        // The props are partitioned in place, so every leaf references a contiguous range of them
+        tree.data_.assign(finite_props.begin(), finite_props.end());
 
         nodes_ = tree.allocate_nodes(num_nodes_);
 
@@ -40,9 +44,28 @@ void Builder<T>::build(Tree<T>& tree, std::vector<T*>& finite_props) noexcept {
 
     tree.aabb_ = root_->aabb;
 
+    tree.build_cost_ = tree.sah_cost();
+
     root_->clear();
 }
 
+template <typename T>
+void Builder<T>::update(Tree<T>& tree, std::vector<T*>& finite_props,
+                        thread::Pool& pool) noexcept {
+    // Props are never removed, so the same number of props means the same props
+    if (0 != tree.num_nodes_ && tree.data_.size() == finite_props.size()) {
+        static float constexpr Max_refit_cost_ratio = 1.5f;
+
+        tree.refit();
+
+        if (tree.sah_cost() <= Max_refit_cost_ratio * tree.build_cost_) {
+            return;
+        }
+    }
+
+    build(tree, finite_props, pool);
+}
+
 template <typename T>
 Builder<T>::Build_node::~Build_node() noexcept {
     delete children[0];
@@ -65,61 +88,157 @@ void Builder<T>::Build_node::clear() noexcept {
 }
 
 template <typename T>
-void Builder<T>::split(Build_node* node, index begin, index end, uint32_t max_shapes,
-                       std::vector<T*>& out_data) noexcept {
+uint32_t Builder<T>::split(Build_node* node, index begin, index end, uint32_t max_shapes,
+                           uint32_t depth, thread::Pool& pool) noexcept {
+    // Subtrees with at least this many props are built in parallel, up to the given depth
+    static uint32_t constexpr Parallel_depth     = 6;
+    static int64_t constexpr  Parallel_num_props = 1024;
+
     node->aabb = aabb(begin, end);
 
     if (static_cast<uint32_t>(std::distance(begin, end)) <= max_shapes) {
-        assign(node, begin, end, out_data);
+        assign(node, begin, end);
+        return 1;
+    }
+
+    index const props1_begin = partition(node, begin, end);
+
+    node->children[0] = new Build_node;
+    node->children[1] = new Build_node;
+
+    uint32_t num_nodes[2];
+
+    if (depth < Parallel_depth && std::distance(begin, end) >= Parallel_num_props) {
+        pool.fork_join(
+            [this, node, begin, props1_begin, max_shapes, depth, &pool,
+             &num_nodes](uint32_t /*id*/) noexcept {
+                num_nodes[0] = split(node->children[0], begin, props1_begin, max_shapes,
+                                     depth + 1, pool);
+            },
+            [this, node, props1_begin, end, max_shapes, depth, &pool,
+             &num_nodes](uint32_t /*id*/) noexcept {
+                num_nodes[1] = split(node->children[1], props1_begin, end, max_shapes, depth + 1,
+                                     pool);
+            });
     } else {
-        Split_candidate<T> sp = splitting_plane(node->aabb, begin, end);
-        node->axis            = sp.axis();
+        num_nodes[0] = split(node->children[0], begin, props1_begin, max_shapes, depth + 1, pool);
+        num_nodes[1] = split(node->children[1], props1_begin, end, max_shapes, depth + 1, pool);
+    }
 
-        index props1_begin = std::partition(begin, end, [&sp](T* b) {
-            bool const mib = math::plane::behind(sp.plane(), b->aabb().min());
-            bool const mab = math::plane::behind(sp.plane(), b->aabb().max());
+    return 1 + num_nodes[0] + num_nodes[1];
+}
 
-            return mib && mab;
-        });
+template <typename T>
+typename Builder<T>::index Builder<T>::partition(Build_node* node, index begin,
+                                                 index end) noexcept {
+    // Binned surface area heuristic over the centroids of the props
+    static uint32_t constexpr Num_bins = 16;
 
-        if (begin == props1_begin) {
-            assign(node, props1_begin, end, out_data);
-        } else {
-            node->children[0] = new Build_node;
-            split(node->children[0], begin, props1_begin, max_shapes, out_data);
+    math::AABB centroids = math::AABB::empty();
 
-            node->children[1] = new Build_node;
-            split(node->children[1], props1_begin, end, max_shapes, out_data);
+    for (index i = begin; i != end; ++i) {
+        centroids.insert((*i)->aabb().position());
+    }
 
-            num_nodes_ += 2;
+    float3 const extent = centroids.max() - centroids.min();
+
+    float    best_cost = std::numeric_limits<float>::max();
+    uint8_t  best_axis = 0;
+    uint32_t best_bin  = 0;
+
+    for (uint8_t a = 0; a < 3; ++a) {
+        if (extent[a] <= 0.f) {
+            continue;
         }
-    }
-}
 
-template <typename T>
-Split_candidate<T> Builder<T>::splitting_plane(math::AABB const& /*aabb*/, index begin,
-                                               index end) noexcept {
-    split_candidates_.clear();
+        float const min   = centroids.min()[a];
+        float const scale = static_cast<float>(Num_bins) / extent[a];
 
-    float3 average = float3::identity();
+        math::AABB boxes[Num_bins];
+        uint32_t   counts[Num_bins];
 
-    for (index i = begin; i != end; ++i) {
-        average += (*i)->aabb().position();
+        for (uint32_t b = 0; b < Num_bins; ++b) {
+            boxes[b]  = math::AABB::empty();
+            counts[b] = 0;
+        }
+
+        for (index i = begin; i != end; ++i) {
+            math::AABB const& box = (*i)->aabb();
+
+            uint32_t const b = std::min(
+                static_cast<uint32_t>((box.position()[a] - min) * scale), Num_bins - 1);
+
+            boxes[b].merge_assign(box);
+            ++counts[b];
+        }
+
+        // Cost of the right side when splitting after bin b, negative if the side is empty
+        float right_costs[Num_bins - 1];
+
+        math::AABB right_box   = math::AABB::empty();
+        uint32_t   right_count = 0;
+
+        for (uint32_t b = Num_bins - 1; b > 0; --b) {
+            right_box.merge_assign(boxes[b]);
+            right_count += counts[b];
+
+            right_costs[b - 1] = right_count
+                                     ? static_cast<float>(right_count) * right_box.surface_area()
+                                     : -1.f;
+        }
+
+        math::AABB left_box   = math::AABB::empty();
+        uint32_t   left_count = 0;
+
+        for (uint32_t b = 0; b < Num_bins - 1; ++b) {
+            left_box.merge_assign(boxes[b]);
+            left_count += counts[b];
+
+            if (0 == left_count || right_costs[b] < 0.f) {
+                continue;
+            }
+
+            float const cost = static_cast<float>(left_count) * left_box.surface_area() +
+                               right_costs[b];
+
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_axis = a;
+                best_bin  = b;
+            }
+        }
     }
 
-    average /= static_cast<float>(std::distance(begin, end));
+    if (best_cost < std::numeric_limits<float>::max()) {
+        float const min   = centroids.min()[best_axis];
+        float const scale = static_cast<float>(Num_bins) / extent[best_axis];
 
-    split_candidates_.push_back(Split_candidate<T>(0, average, begin, end));
+        index const middle = std::partition(begin, end, [best_axis, best_bin, min, scale](T* p) {
+            uint32_t const b = std::min(
+                static_cast<uint32_t>((p->aabb().position()[best_axis] - min) * scale),
+                Num_bins - 1);
 
-    split_candidates_.push_back(Split_candidate<T>(1, average, begin, end));
+            return b <= best_bin;
+        });
+
+        if (middle != begin && middle != end) {
+            node->axis = best_axis;
+            return middle;
+        }
+    }
 
-    split_candidates_.push_back(Split_candidate<T>(2, average, begin, end));
+    // All centroids coincide, so split at the median instead
+    uint8_t const axis = static_cast<uint8_t>(math::index_max_component(node->aabb.extent()));
 
-    std::sort(
-        split_candidates_.begin(), split_candidates_.end(),
-        [](const Split_candidate<T>& a, const Split_candidate<T>& b) { return a.key() < b.key(); });
+    index const middle = begin + std::distance(begin, end) / 2;
 
-    return split_candidates_[0];
+    std::nth_element(begin, middle, end, [axis](T* a, T* b) {
+        return a->aabb().position()[axis] < b->aabb().position()[axis];
+    });
+
+    node->axis = axis;
+
+    return middle;
 }
 
 template <typename T>
@@ -150,15 +269,9 @@ uint32_t Builder<T>::current_node_index() const noexcept {
 }
 
 template <typename T>
-void Builder<T>::assign(Build_node* node, index begin, index end,
-                        std::vector<T*>& out_props) noexcept {
-    node->offset = static_cast<uint32_t>(out_props.size());
-
-    for (index i = begin; i != end; ++i) {
-        out_props.push_back(*i);
-    }
-
-    node->props_end = static_cast<uint32_t>(out_props.size());
+void Builder<T>::assign(Build_node* node, index begin, index end) const noexcept {
+    node->offset    = static_cast<uint32_t>(std::distance(props_begin_, begin));
+    node->props_end = static_cast<uint32_t>(std::distance(props_begin_, end));
 }
 
 template <typename T>
@@ -0,0 +1,57 @@
+#ifndef SU_CORE_SCENE_BVH_COMPRESSED_NODE4_HPP
+#define SU_CORE_SCENE_BVH_COMPRESSED_NODE4_HPP
+
+#include "base/math/aabb.hpp"
+#include "base/math/vector3.hpp"
+#include "base/simd/simd.hpp"
+#include "scene_bvh_node4.hpp"
+
+namespace scene::bvh {
+
+// Node4 with the bounds of the children quantized to 8 bits relative to the bounds of the node.
+// The quantization step is a power of two per axis, so that the decoded child bounds
+// always contain the original ones. Half the size of a Node4.
+class alignas(64) Compressed_node4 {
+  public:
+    using Ray = Node4::Ray;
+
+    Compressed_node4() noexcept = default;
+
+    math::AABB aabb() const noexcept;
+
+    uint32_t child(uint32_t slot) const noexcept;
+
+    uint8_t num_primitives(uint32_t slot) const noexcept;
+
+    uint32_t indices_start(uint32_t slot) const noexcept;
+
+    uint32_t indices_end(uint32_t slot) const noexcept;
+
+    void compress(Node4 const& node) noexcept;
+
+    uint32_t intersect_p(Ray const& ray, FVector ray_min_t, FVector ray_max_t,
+                         uint32_t const ray_signs[4], uint32_t slots[4]) const noexcept;
+
+  private:
+    Vector decode(uint32_t bound, uint32_t axis) const noexcept;
+
+    float scale(uint32_t axis) const noexcept;
+
+    float origin_[3];
+
+    uint32_t children_[4];
+
+    // Biased exponents of the quantization steps
+    uint8_t exponents_[3];
+
+    uint8_t axes_[3];
+
+    uint8_t num_primitives_[4];
+
+    // min x, min y, min z, max x, max y, max z
+    uint8_t bounds_[6][4];
+};
+
+}  // namespace scene::bvh
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef SU_CORE_SCENE_BVH_COMPRESSED_NODE4_INL
+#define SU_CORE_SCENE_BVH_COMPRESSED_NODE4_INL
+
+#include <cmath>
+#include <cstring>
+#include "base/math/aabb.inl"
+#include "base/math/simd_vector.inl"
+#include "base/math/vector3.inl"
+#include "scene_bvh_compressed_node4.hpp"
+#include "scene_bvh_node4.inl"
+
+namespace scene::bvh {
+
+inline math::AABB Compressed_node4::aabb() const noexcept {
+    math::AABB aabb = math::AABB::empty();
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (bounds_[0][i] > bounds_[3][i]) {
+            continue;
+        }
+
+        float3 min;
+        float3 max;
+
+        for (uint32_t a = 0; a < 3; ++a) {
+            min[a] = origin_[a] + static_cast<float>(bounds_[a][i]) * scale(a);
+            max[a] = origin_[a] + static_cast<float>(bounds_[a + 3][i]) * scale(a);
+        }
+
+        aabb.merge_assign(math::AABB(min, max));
+    }
+
+    return aabb;
+}
+
+inline uint32_t Compressed_node4::child(uint32_t slot) const noexcept {
+    return children_[slot];
+}
+
+inline uint8_t Compressed_node4::num_primitives(uint32_t slot) const noexcept {
+    return num_primitives_[slot];
+}
+
+inline uint32_t Compressed_node4::indices_start(uint32_t slot) const noexcept {
+    return children_[slot];
+}
+
+inline uint32_t Compressed_node4::indices_end(uint32_t slot) const noexcept {
+    return children_[slot] + static_cast<uint32_t>(num_primitives_[slot]);
+}
+
+static inline float exponent_to_float(uint32_t exponent) noexcept {
+    uint32_t const bits = exponent << 23;
+
+    float f;
+    std::memcpy(&f, &bits, sizeof(float));
+    return f;
+}
+
+static inline bool quantize(float origin, float scale, float min, float max, uint8_t& q_min,
+                            uint8_t& q_max) noexcept {
+    float const s_max = std::ceil((max - origin) / scale);
+
+    if (!(s_max <= 255.f)) {
+        return false;
+    }
+
+    int32_t lo = std::max(static_cast<int32_t>(std::floor((min - origin) / scale)), 0);
+    int32_t hi = std::max(static_cast<int32_t>(s_max), 0);
+
+    // Correct for the rounding of the decoding, which is done in exactly the same way
+    while (lo > 0 && origin + static_cast<float>(lo) * scale > min) {
+        --lo;
+    }
+
+    while (hi <= 255 && origin + static_cast<float>(hi) * scale < max) {
+        ++hi;
+    }
+
+    if (hi > 255) {
+        return false;
+    }
+
+    q_min = static_cast<uint8_t>(lo);
+    q_max = static_cast<uint8_t>(hi);
+
+    return true;
+}
+
+inline void Compressed_node4::compress(Node4 const& node) noexcept {
+    math::AABB const box = node.aabb();
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        children_[i]       = node.child(i);
+        num_primitives_[i] = node.num_primitives(i);
+
+        // Inverted on every axis, so that empty slots are never hit
+        for (uint32_t a = 0; a < 3; ++a) {
+            bounds_[a][i]     = 255;
+            bounds_[a + 3][i] = 0;
+        }
+    }
+
+    for (uint32_t a = 0; a < 3; ++a) {
+        axes_[a] = node.axis(a);
+
+        float const origin = box.min()[a];
+        float const extent = box.max()[a] - origin;
+
+        origin_[a] = origin;
+
+        // Smallest power of two step that covers the extent with 255 steps,
+        // which might still be increased if the rounding of the decoding requires it
+        int32_t exponent = 1;
+        if (extent > 0.f) {
+            exponent = std::max(static_cast<int32_t>(std::ceil(std::log2(extent / 255.f))) + 127,
+                                1);
+        }
+
+        for (; exponent < 255; ++exponent) {
+            float const s = exponent_to_float(static_cast<uint32_t>(exponent));
+
+            bool valid = true;
+
+            for (uint32_t i = 0; i < 4; ++i) {
+                if (node.is_empty(i)) {
+                    continue;
+                }
+
+                if (!quantize(origin, s, node.min(i)[a], node.max(i)[a], bounds_[a][i],
+                              bounds_[a + 3][i])) {
+                    valid = false;
+                    break;
+                }
+            }
+
+            if (valid) {
+                break;
+            }
+        }
+
+        exponents_[a] = static_cast<uint8_t>(exponent);
+    }
+}
+
+inline uint32_t Compressed_node4::intersect_p(Ray const& ray, FVector ray_min_t,
+                                              FVector ray_max_t, uint32_t const ray_signs[4],
+                                              uint32_t slots[4]) const noexcept {
+    uint32_t const sx = ray_signs[0] * 3;
+    uint32_t const sy = ray_signs[1] * 3;
+    uint32_t const sz = ray_signs[2] * 3;
+
+    Vector const near_x = decode(0 + sx, 0);
+    Vector const near_y = decode(1 + sy, 1);
+    Vector const near_z = decode(2 + sz, 2);
+    Vector const far_x  = decode(3 - sx, 0);
+    Vector const far_y  = decode(4 - sy, 1);
+    Vector const far_z  = decode(5 - sz, 2);
+
+    Vector const near_tx = math::mul(math::sub(near_x, ray.origin[0]), ray.inv_direction[0]);
+    Vector const near_ty = math::mul(math::sub(near_y, ray.origin[1]), ray.inv_direction[1]);
+    Vector const near_tz = math::mul(math::sub(near_z, ray.origin[2]), ray.inv_direction[2]);
+    Vector const far_tx  = math::mul(math::sub(far_x, ray.origin[0]), ray.inv_direction[0]);
+    Vector const far_ty  = math::mul(math::sub(far_y, ray.origin[1]), ray.inv_direction[1]);
+    Vector const far_tz  = math::mul(math::sub(far_z, ray.origin[2]), ray.inv_direction[2]);
+
+    Vector const min_t = math::max(near_tx,
+                                   math::max(near_ty, math::max(near_tz, math::splat_x(ray_min_t))));
+    Vector const max_t = math::min(far_tx,
+                                   math::min(far_ty, math::min(far_tz, math::splat_x(ray_max_t))));
+
+    uint32_t const mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(min_t, max_t)));
+
+    if (0 == mask) {
+        return 0;
+    }
+
+    return Node4::order_slots(mask, axes_, ray_signs, slots);
+}
+
+inline Vector Compressed_node4::decode(uint32_t bound, uint32_t axis) const noexcept {
+    int32_t packed;
+    std::memcpy(&packed, bounds_[bound], sizeof(int32_t));
+
+    __m128i const zero = _mm_setzero_si128();
+
+    __m128i const q = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero),
+                                         zero);
+
+    Vector const origin = _mm_set1_ps(origin_[axis]);
+    Vector const step   = _mm_set1_ps(scale(axis));
+
+    return math::add(origin, math::mul(_mm_cvtepi32_ps(q), step));
+}
+
+inline float Compressed_node4::scale(uint32_t axis) const noexcept {
+    return exponent_to_float(exponents_[axis]);
+}
+
+}  // namespace scene::bvh
+
+#endif
@@ -5,6 +5,10 @@
 //#include "base/math/ray.hpp"
 #include "base/simd/simd.hpp"
 
+namespace math {
+struct Ray_packet;
+}
+
 namespace scene::bvh {
 
 class Node {
@@ -50,6 +54,9 @@ class Node {
     bool intersect_p(FVector origin, FVector inv_direction, FVector min_t, FVector max_t) const
         noexcept;
 
+    // Returns the mask of the lanes whose rays hit the node
+    uint32_t intersect_p(math::Ray_packet const& packet) const noexcept;
+
   private:
     struct alignas(16) Min {
         float    v[3];
@@ -1,6 +1,7 @@
 #ifndef SU_CORE_SCENE_BVH_NODE_INL
 #define SU_CORE_SCENE_BVH_NODE_INL
 
+#include "base/math/ray_packet.inl"
 #include "base/math/simd_vector.inl"
 #include "base/math/vector3.inl"
 #include "scene_bvh_node.hpp"
@@ -106,6 +107,35 @@ inline bool Node::intersect_p(FVector ray_origin, FVector ray_inv_direction, FVe
                  _mm_comige_ss(max_t, min_t));
 }
 
+inline uint32_t Node::intersect_p(math::Ray_packet const& packet) const noexcept {
+    // Same slab test as above, but with one ray per lane
+    Vector min_t = simd::Neg_infinity;
+    Vector max_t = simd::Infinity;
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        Vector const origin        = packet.origin_v(i);
+        Vector const inv_direction = packet.inv_direction_v(i);
+
+        Vector const l1 = math::mul(math::sub(simd::set_float4(min_.v[i]), origin), inv_direction);
+        Vector const l2 = math::mul(math::sub(simd::set_float4(max_.v[i]), origin), inv_direction);
+
+        Vector const filtered_l1a = math::min(l1, simd::Infinity);
+        Vector const filtered_l2a = math::min(l2, simd::Infinity);
+
+        Vector const filtered_l1b = math::max(l1, simd::Neg_infinity);
+        Vector const filtered_l2b = math::max(l2, simd::Neg_infinity);
+
+        max_t = math::min(max_t, math::max(filtered_l1a, filtered_l2a));
+        min_t = math::max(min_t, math::min(filtered_l1b, filtered_l2b));
+    }
+
+    Vector const hit = _mm_and_ps(
+        _mm_and_ps(_mm_cmpge_ps(max_t, packet.min_t_v()), _mm_cmpge_ps(packet.max_t_v(), min_t)),
+        _mm_cmpge_ps(max_t, min_t));
+
+    return static_cast<uint32_t>(_mm_movemask_ps(hit));
+}
+
 }  // namespace scene::bvh
 
 #endif
@@ -0,0 +1,76 @@
+#ifndef SU_CORE_SCENE_BVH_NODE4_HPP
+#define SU_CORE_SCENE_BVH_NODE4_HPP
+
+#include "base/math/aabb.hpp"
+#include "base/math/vector3.hpp"
+#include "base/simd/simd.hpp"
+
+namespace scene::bvh {
+
+// Node of a 4-wide BVH, that is collapsed from two levels of a binary BVH.
+// The bounds of the children are stored as structure of arrays,
+// so that all children can be tested against a ray at once.
+// Slots 0 and 1 hold the children of the left binary child, slots 2 and 3 those of the right one.
+// The axes of the three collapsed binary nodes are kept to visit the children in order.
+class alignas(64) Node4 {
+  public:
+    // Ray with every component splatted over all four lanes
+    struct Ray {
+        Vector origin[3];
+        Vector inv_direction[3];
+    };
+
+    static Ray splat(FVector origin, FVector inv_direction) noexcept;
+
+    Node4() noexcept = default;
+
+    math::AABB aabb() const noexcept;
+
+    bool is_empty(uint32_t slot) const noexcept;
+
+    float3 min(uint32_t slot) const noexcept;
+    float3 max(uint32_t slot) const noexcept;
+
+    uint8_t axis(uint32_t i) const noexcept;
+
+    uint32_t child(uint32_t slot) const noexcept;
+
+    uint8_t num_primitives(uint32_t slot) const noexcept;
+
+    uint32_t indices_start(uint32_t slot) const noexcept;
+
+    uint32_t indices_end(uint32_t slot) const noexcept;
+
+    void clear() noexcept;
+
+    void set_inner_child(uint32_t slot, float3 const& min, float3 const& max,
+                         uint32_t node) noexcept;
+
+    void set_leaf_child(uint32_t slot, float3 const& min, float3 const& max,
+                        uint32_t start_primitive, uint8_t num_primitives) noexcept;
+
+    void set_axes(uint8_t root, uint8_t left, uint8_t right) noexcept;
+
+    // Writes the slots of all children that are hit by the ray to slots,
+    // ordered by the ray direction. Returns the number of hit children.
+    uint32_t intersect_p(Ray const& ray, FVector ray_min_t, FVector ray_max_t,
+                         uint32_t const ray_signs[4], uint32_t slots[4]) const noexcept;
+
+    // Writes the slots set in mask to slots, in the order given by the collapsed axes
+    static uint32_t order_slots(uint32_t mask, uint8_t const axes[3], uint32_t const ray_signs[4],
+                                uint32_t slots[4]) noexcept;
+
+  private:
+    // min x, min y, min z, max x, max y, max z
+    float bounds_[6][4];
+
+    uint32_t children_[4];
+
+    uint8_t num_primitives_[4];
+
+    uint8_t axes_[3];
+};
+
+}  // namespace scene::bvh
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef SU_CORE_SCENE_BVH_NODE4_INL
+#define SU_CORE_SCENE_BVH_NODE4_INL
+
+#include <limits>
+#include "base/math/aabb.inl"
+#include "base/math/simd_vector.inl"
+#include "base/math/vector3.inl"
+#include "scene_bvh_node4.hpp"
+
+namespace scene::bvh {
+
+inline Node4::Ray Node4::splat(FVector origin, FVector inv_direction) noexcept {
+    return Ray{{SU_PERMUTE_PS(origin, _MM_SHUFFLE(0, 0, 0, 0)),
+                SU_PERMUTE_PS(origin, _MM_SHUFFLE(1, 1, 1, 1)),
+                SU_PERMUTE_PS(origin, _MM_SHUFFLE(2, 2, 2, 2))},
+               {SU_PERMUTE_PS(inv_direction, _MM_SHUFFLE(0, 0, 0, 0)),
+                SU_PERMUTE_PS(inv_direction, _MM_SHUFFLE(1, 1, 1, 1)),
+                SU_PERMUTE_PS(inv_direction, _MM_SHUFFLE(2, 2, 2, 2))}};
+}
+
+inline math::AABB Node4::aabb() const noexcept {
+    math::AABB aabb = math::AABB::empty();
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (!is_empty(i)) {
+            aabb.merge_assign(math::AABB(min(i), max(i)));
+        }
+    }
+
+    return aabb;
+}
+
+inline bool Node4::is_empty(uint32_t slot) const noexcept {
+    return bounds_[0][slot] > bounds_[3][slot];
+}
+
+inline float3 Node4::min(uint32_t slot) const noexcept {
+    return float3(bounds_[0][slot], bounds_[1][slot], bounds_[2][slot]);
+}
+
+inline float3 Node4::max(uint32_t slot) const noexcept {
+    return float3(bounds_[3][slot], bounds_[4][slot], bounds_[5][slot]);
+}
+
+inline uint8_t Node4::axis(uint32_t i) const noexcept {
+    return axes_[i];
+}
+
+inline uint32_t Node4::child(uint32_t slot) const noexcept {
+    return children_[slot];
+}
+
+inline uint8_t Node4::num_primitives(uint32_t slot) const noexcept {
+    return num_primitives_[slot];
+}
+
+inline uint32_t Node4::indices_start(uint32_t slot) const noexcept {
+    return children_[slot];
+}
+
+inline uint32_t Node4::indices_end(uint32_t slot) const noexcept {
+    return children_[slot] + static_cast<uint32_t>(num_primitives_[slot]);
+}
+
+inline void Node4::clear() noexcept {
+    // Empty slots have inverted bounds, which are never hit
+    float constexpr Max = std::numeric_limits<float>::max();
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        bounds_[0][i] = Max;
+        bounds_[1][i] = Max;
+        bounds_[2][i] = Max;
+        bounds_[3][i] = -Max;
+        bounds_[4][i] = -Max;
+        bounds_[5][i] = -Max;
+
+        children_[i]       = 0;
+        num_primitives_[i] = 0;
+    }
+
+    axes_[0] = 0;
+    axes_[1] = 0;
+    axes_[2] = 0;
+}
+
+inline void Node4::set_inner_child(uint32_t slot, float3 const& min, float3 const& max,
+                                   uint32_t node) noexcept {
+    bounds_[0][slot] = min[0];
+    bounds_[1][slot] = min[1];
+    bounds_[2][slot] = min[2];
+    bounds_[3][slot] = max[0];
+    bounds_[4][slot] = max[1];
+    bounds_[5][slot] = max[2];
+
+    children_[slot]       = node;
+    num_primitives_[slot] = 0;
+}
+
+inline void Node4::set_leaf_child(uint32_t slot, float3 const& min, float3 const& max,
+                                  uint32_t start_primitive, uint8_t num_primitives) noexcept {
+    bounds_[0][slot] = min[0];
+    bounds_[1][slot] = min[1];
+    bounds_[2][slot] = min[2];
+    bounds_[3][slot] = max[0];
+    bounds_[4][slot] = max[1];
+    bounds_[5][slot] = max[2];
+
+    children_[slot]       = start_primitive;
+    num_primitives_[slot] = num_primitives;
+}
+
+inline void Node4::set_axes(uint8_t root, uint8_t left, uint8_t right) noexcept {
+    axes_[0] = root;
+    axes_[1] = left;
+    axes_[2] = right;
+}
+
+inline uint32_t Node4::intersect_p(Ray const& ray, FVector ray_min_t, FVector ray_max_t,
+                                   uint32_t const ray_signs[4], uint32_t slots[4]) const
+    noexcept {
+    // The near plane is the min plane for positive directions and the max plane otherwise
+    uint32_t const sx = ray_signs[0] * 3;
+    uint32_t const sy = ray_signs[1] * 3;
+    uint32_t const sz = ray_signs[2] * 3;
+
+    Vector const near_x = simd::load_float4(bounds_[0 + sx]);
+    Vector const near_y = simd::load_float4(bounds_[1 + sy]);
+    Vector const near_z = simd::load_float4(bounds_[2 + sz]);
+    Vector const far_x  = simd::load_float4(bounds_[3 - sx]);
+    Vector const far_y  = simd::load_float4(bounds_[4 - sy]);
+    Vector const far_z  = simd::load_float4(bounds_[5 - sz]);
+
+    Vector const near_tx = math::mul(math::sub(near_x, ray.origin[0]), ray.inv_direction[0]);
+    Vector const near_ty = math::mul(math::sub(near_y, ray.origin[1]), ray.inv_direction[1]);
+    Vector const near_tz = math::mul(math::sub(near_z, ray.origin[2]), ray.inv_direction[2]);
+    Vector const far_tx  = math::mul(math::sub(far_x, ray.origin[0]), ray.inv_direction[0]);
+    Vector const far_ty  = math::mul(math::sub(far_y, ray.origin[1]), ray.inv_direction[1]);
+    Vector const far_tz  = math::mul(math::sub(far_z, ray.origin[2]), ray.inv_direction[2]);
+
+    // min/max return the second operand if the first one is NaN,
+    // which happens for inf * 0. The ray limits are always last, so the NaNs are filtered out.
+    Vector const min_t = math::max(near_tx,
+                                   math::max(near_ty, math::max(near_tz, math::splat_x(ray_min_t))));
+    Vector const max_t = math::min(far_tx,
+                                   math::min(far_ty, math::min(far_tz, math::splat_x(ray_max_t))));
+
+    uint32_t const mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(min_t, max_t)));
+
+    if (0 == mask) {
+        return 0;
+    }
+
+    return order_slots(mask, axes_, ray_signs, slots);
+}
+
+inline uint32_t Node4::order_slots(uint32_t mask, uint8_t const axes[3],
+                                   uint32_t const ray_signs[4], uint32_t slots[4]) noexcept {
+    // Same order as the binary traversal: the child on the negative side of the axis first,
+    // unless the ray points in negative direction
+    uint32_t const first = ray_signs[axes[0]];
+
+    uint32_t const pair_0 = first << 1;
+    uint32_t const pair_1 = 2 - pair_0;
+
+    uint32_t const sign_0 = ray_signs[axes[1 + first]];
+    uint32_t const sign_1 = ray_signs[axes[2 - first]];
+
+    uint32_t const order[4] = {pair_0 + sign_0, pair_0 + 1 - sign_0, pair_1 + sign_1,
+                               pair_1 + 1 - sign_1};
+
+    uint32_t num_hits = 0;
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint32_t const slot = order[i];
+
+        if (mask & (1u << slot)) {
+            slots[num_hits++] = slot;
+        }
+    }
+
+    return num_hits;
+}
+
+}  // namespace scene::bvh
+
+#endif
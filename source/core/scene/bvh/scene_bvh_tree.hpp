@@ -20,12 +20,21 @@ struct Tree {
 
     Node* allocate_nodes(uint32_t num_nodes) noexcept;
 
+    // Recalculates the bounds of all nodes from the current bounds of the data
+    void refit() noexcept;
+
+    // SAH cost of the tree, relative to the surface area of the root
+    float sah_cost() const noexcept;
+
     uint32_t num_nodes_ = 0;
     Node*    nodes_     = nullptr;
 
     std::vector<T*> data_;
 
     math::AABB aabb_;
+
+    // SAH cost right after the last build, refitted trees are compared against it
+    float build_cost_ = 0.f;
 };
 
 }  // namespace scene::bvh
@@ -1,8 +1,9 @@
 #ifndef SU_CORE_SCENE_BVH_TREE_INL
 #define SU_CORE_SCENE_BVH_TREE_INL
 
+#include "base/math/aabb.inl"
 #include "base/memory/align.hpp"
-#include "scene_bvh_node.hpp"
+#include "scene_bvh_node.inl"
 #include "scene_bvh_tree.hpp"
 
 namespace scene::bvh {
@@ -29,6 +30,59 @@ bvh::Node* Tree<T>::allocate_nodes(uint32_t num_nodes) noexcept {
     return nodes_;
 }
 
+template <typename T>
+void Tree<T>::refit() noexcept {
+    // Children are always stored after their parent, so a reverse pass visits them first
+    for (uint32_t i = num_nodes_; i > 0; --i) {
+        Node& node = nodes_[i - 1];
+
+        math::AABB aabb = math::AABB::empty();
+
+        if (0 == node.num_primitives()) {
+            Node const& c0 = nodes_[i];
+            Node const& c1 = nodes_[node.next()];
+
+            aabb.merge_assign(math::AABB(c0.min(), c0.max()));
+            aabb.merge_assign(math::AABB(c1.min(), c1.max()));
+        } else {
+            for (uint32_t p = node.indices_start(), len = node.indices_end(); p < len; ++p) {
+                aabb.merge_assign(data_[p]->aabb());
+            }
+        }
+
+        node.set_aabb(aabb.min().v, aabb.max().v);
+    }
+
+    if (num_nodes_ > 0) {
+        aabb_ = math::AABB(nodes_[0].min(), nodes_[0].max());
+    }
+}
+
+template <typename T>
+float Tree<T>::sah_cost() const noexcept {
+    if (0 == num_nodes_) {
+        return 0.f;
+    }
+
+    float cost = 0.f;
+
+    for (uint32_t i = 0; i < num_nodes_; ++i) {
+        Node const& node = nodes_[i];
+
+        float const area = math::AABB(node.min(), node.max()).surface_area();
+
+        if (0 == node.num_primitives()) {
+            cost += 2.f * area;
+        } else {
+            cost += static_cast<float>(node.num_primitives()) * area;
+        }
+    }
+
+    float const root_area = math::AABB(nodes_[0].min(), nodes_[0].max()).surface_area();
+
+    return root_area > 0.f ? cost / root_area : 0.f;
+}
+
 }  // namespace scene::bvh
 
 #endif
@@ -113,8 +113,13 @@ uint64_t Camera::absolute_time(uint32_t frame, float frame_delta) const noexcept
 
 void Camera::on_set_transformation() noexcept {}
 
-Ray Camera::create_ray(float3 const& origin, float3 const& direction, uint64_t time) noexcept {
-    return Ray(origin, direction, 0.f, Ray_max_t, 0, time, 0.f);
+Ray Camera::create_ray(float3 const& origin, float3 const& direction, uint64_t time) const
+    noexcept {
+    Ray ray(origin, direction, 0.f, Ray_max_t, 0, time, 0.f);
+
+    ray.cone_spread = pixel_spread_angle();
+
+    return ray;
 }
 
 }  // namespace scene::camera
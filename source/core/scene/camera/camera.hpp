@@ -42,6 +42,10 @@ class Camera : public entity::Entity {
 
     virtual float pixel_solid_angle() const noexcept = 0;
 
+    // Angle between the rays through neighboring pixels of a view,
+    // which is how fast the footprints of camera rays grow with distance
+    virtual float pixel_spread_angle() const noexcept = 0;
+
     void update(Scene const& scene, uint64_t time, Worker& worker) noexcept;
 
     virtual bool generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t view,
@@ -69,7 +73,8 @@ class Camera : public entity::Entity {
 
     void on_set_transformation() noexcept override final;
 
-    static Ray create_ray(float3 const& origin, float3 const& direction, uint64_t time) noexcept;
+    // The ray cone starts with the angle of one pixel
+    Ray create_ray(float3 const& origin, float3 const& direction, uint64_t time) const noexcept;
 
     int2 resolution_;
 
@@ -75,6 +75,10 @@ float Cubic::pixel_solid_angle() const noexcept {
     return 1.f;
 }
 
+float Cubic::pixel_spread_angle() const noexcept {
+    return (0.5f * math::Pi) / static_cast<float>(resolution_[0]);
+}
+
 bool Cubic::generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t view, Ray& ray) const
     noexcept {
     float2 coordinates = float2(sample.pixel) + sample.pixel_uv;
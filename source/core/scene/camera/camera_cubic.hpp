@@ -19,6 +19,8 @@ class Cubic : public Camera {
 
     float pixel_solid_angle() const noexcept override final;
 
+    float pixel_spread_angle() const noexcept override final;
+
     bool generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t view, Ray& ray) const
         noexcept override final;
 
@@ -73,6 +73,10 @@ float Cubic_stereoscopic::pixel_solid_angle() const noexcept {
     return 1.f;
 }
 
+float Cubic_stereoscopic::pixel_spread_angle() const noexcept {
+    return (0.5f * math::Pi) / static_cast<float>(resolution_[0]);
+}
+
 bool Cubic_stereoscopic::generate_ray(sampler::Camera_sample const& sample, uint32_t frame,
                                       uint32_t view, scene::Ray& ray) const noexcept {
     float2 const coordinates = float2(sample.pixel) + sample.pixel_uv;
@@ -33,6 +33,10 @@ float Hemispherical::pixel_solid_angle() const noexcept {
     return 1.f;
 }
 
+float Hemispherical::pixel_spread_angle() const noexcept {
+    return math::Pi * d_x_;
+}
+
 bool Hemispherical::generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t /*view*/,
                                  Ray& ray) const noexcept {
     float2 coordinates = float2(sample.pixel) + sample.pixel_uv;
@@ -55,12 +59,8 @@ bool Hemispherical::generate_ray(Camera_sample const& sample, uint32_t frame, ui
     Transformation temp;
     auto&          transformation = transformation_at(time, temp);
 
-    ray.origin = transformation.position;
-    ray.set_direction(math::transform_vector(transformation.rotation, dir));
-    ray.min_t = 0.f;
-    ray.max_t = Ray_max_t;
-    ray.time  = time;
-    ray.depth = 0;
+    ray = create_ray(transformation.position, math::transform_vector(transformation.rotation, dir),
+                     time);
 
     return true;
 }
@@ -34,6 +34,10 @@ float Perspective::pixel_solid_angle() const noexcept {
     return fov_ / static_cast<float>(resolution_[0]);
 }
 
+float Perspective::pixel_spread_angle() const noexcept {
+    return fov_ / static_cast<float>(resolution_[0]);
+}
+
 bool Perspective::generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t /*view*/,
                                Ray& ray) const noexcept {
     float2 const coordinates = float2(sample.pixel) + sample.pixel_uv;
@@ -13,7 +13,7 @@ namespace scene::camera {
 
 Perspective_stereoscopic::Perspective_stereoscopic(int2 resolution) noexcept
     : Stereoscopic(resolution) {
-    set_fov(90.f);
+    set_fov(math::degrees_to_radians(90.f));
 
     view_bounds_[0] = int4(int2(0, 0), resolution - int2(1, 1));
     view_bounds_[1] = int4(int2(resolution[0], 0),
@@ -36,6 +36,10 @@ float Perspective_stereoscopic::pixel_solid_angle() const noexcept {
     return 1.f;
 }
 
+float Perspective_stereoscopic::pixel_spread_angle() const noexcept {
+    return fov_ / static_cast<float>(resolution_[0]);
+}
+
 bool Perspective_stereoscopic::generate_ray(sampler::Camera_sample const& sample, uint32_t frame,
                                             uint32_t view, scene::Ray& ray) const noexcept {
     float2 coordinates = float2(sample.pixel) + sample.pixel_uv;
@@ -55,6 +59,8 @@ bool Perspective_stereoscopic::generate_ray(sampler::Camera_sample const& sample
 }
 
 void Perspective_stereoscopic::set_fov(float fov) noexcept {
+    fov_ = fov;
+
     float2 fr(resolution_);
     float  ratio = fr[0] / fr[1];
 
@@ -17,6 +17,8 @@ class Perspective_stereoscopic : public Stereoscopic {
 
     float pixel_solid_angle() const noexcept override final;
 
+    float pixel_spread_angle() const noexcept override final;
+
     bool generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t view, Ray& ray) const
         noexcept override final;
 
@@ -31,6 +33,8 @@ class Perspective_stereoscopic : public Stereoscopic {
     float3 d_x_;
     float3 d_y_;
 
+    float fov_;
+
     int4 view_bounds_[2];
 };
 
@@ -32,6 +32,10 @@ float Spherical::pixel_solid_angle() const noexcept {
     return 1.f;
 }
 
+float Spherical::pixel_spread_angle() const noexcept {
+    return (2.f * math::Pi) * d_x_;
+}
+
 bool Spherical::generate_ray(Camera_sample const& sample, uint32_t frame, uint32_t /*view*/,
                              Ray& ray) const noexcept {
     float2 coordinates = float2(sample.pixel) + sample.pixel_uv;
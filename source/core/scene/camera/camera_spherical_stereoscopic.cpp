@@ -41,6 +41,10 @@ float Spherical_stereoscopic::pixel_solid_angle() const noexcept {
     return 1.f;
 }
 
+float Spherical_stereoscopic::pixel_spread_angle() const noexcept {
+    return (2.f * math::Pi) * d_x_;
+}
+
 bool Spherical_stereoscopic::generate_ray(Camera_sample const& sample, uint32_t frame,
                                           uint32_t view, Ray& ray) const noexcept {
     float2 const coordinates = float2(sample.pixel) + sample.pixel_uv;
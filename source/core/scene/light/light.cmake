@@ -4,6 +4,10 @@ target_sources(core
     "${CMAKE_CURRENT_LIST_DIR}/emittance.hpp"
     "${CMAKE_CURRENT_LIST_DIR}/light.cpp"
     "${CMAKE_CURRENT_LIST_DIR}/light.hpp"
+    "${CMAKE_CURRENT_LIST_DIR}/light_tree.cpp"
+    "${CMAKE_CURRENT_LIST_DIR}/light_tree.hpp"
+    "${CMAKE_CURRENT_LIST_DIR}/light_tree_builder.cpp"
+    "${CMAKE_CURRENT_LIST_DIR}/light_tree_builder.hpp"
     "${CMAKE_CURRENT_LIST_DIR}/null_light.cpp"
     "${CMAKE_CURRENT_LIST_DIR}/null_light.hpp"
     "${CMAKE_CURRENT_LIST_DIR}/prop_image_light.cpp"
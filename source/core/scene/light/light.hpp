@@ -90,6 +90,14 @@ class Light {
 
     virtual float3 power(math::AABB const& scene_bb) const noexcept = 0;
 
+    // Finite lights are sampled with the light tree, based on their bounds, cone and power
+    virtual bool is_finite() const noexcept = 0;
+
+    virtual math::AABB aabb() const noexcept = 0;
+
+    // Axis and cosine of the opening angle of a cone around all directions the light emits into
+    virtual float4 cone(uint64_t time) const noexcept = 0;
+
     virtual void prepare_sampling(uint32_t light_id, uint64_t time,
                                   thread::Pool& pool) noexcept = 0;
 
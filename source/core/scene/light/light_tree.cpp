@@ -0,0 +1,173 @@
+#include "light_tree.hpp"
+#include <algorithm>
+#include "base/math/vector3.inl"
+
+namespace scene::light {
+
+// cos(max(0, a - b)), given the sines and cosines of both angles
+static inline float cos_sub_clamped(float sin_a, float cos_a, float sin_b, float cos_b) noexcept {
+    if (cos_a > cos_b) {
+        return 1.f;
+    }
+
+    return cos_a * cos_b + sin_a * sin_b;
+}
+
+// sin(max(0, a - b)), given the sines and cosines of both angles
+static inline float sin_sub_clamped(float sin_a, float cos_a, float sin_b, float cos_b) noexcept {
+    if (cos_a > cos_b) {
+        return 0.f;
+    }
+
+    return sin_a * cos_b - cos_a * sin_b;
+}
+
+static inline float sin_from_cos(float c) noexcept {
+    return std::sqrt(std::max(1.f - c * c, 0.f));
+}
+
+// Upper bound for the contribution of all lights in the node to the shading point,
+// assuming that every light emits diffusely into the hemisphere around its normal
+static float importance(Tree::Node const& node, float3 const& p, float3 const& n,
+                        bool total_sphere) noexcept {
+    float3 const axis = p - float3(node.center);
+
+    float const sl = math::squared_length(axis);
+
+    float const r2 = node.radius * node.radius;
+
+    float3 const wi = sl > 0.f ? axis / std::sqrt(sl) : float3(0.f, 0.f, 1.f);
+
+    // The cone of directions from the shading point to the bounding sphere
+    float cos_b = -1.f;
+    float sin_b = 0.f;
+
+    if (sl > r2) {
+        float const sin2_b = r2 / sl;
+
+        cos_b = std::sqrt(1.f - sin2_b);
+        sin_b = std::sqrt(sin2_b);
+    }
+
+    float const cos_w = math::dot(float3(node.axis), wi);
+    float const sin_w = sin_from_cos(cos_w);
+
+    float const cos_a = node.cos_a;
+    float const sin_a = sin_from_cos(cos_a);
+
+    // Smallest angle between wi and any emitted direction
+    float const cos_x = cos_sub_clamped(sin_w, cos_w, sin_a, cos_a);
+    float const sin_x = sin_sub_clamped(sin_w, cos_w, sin_a, cos_a);
+
+    float const cos_p = cos_sub_clamped(sin_x, cos_x, sin_b, cos_b);
+
+    if (cos_p <= 0.f) {
+        return 0.f;
+    }
+
+    float importance = node.power * cos_p / std::max(sl, r2);
+
+    if (!total_sphere) {
+        float const cos_i = std::abs(math::dot(wi, n));
+        float const sin_i = sin_from_cos(cos_i);
+
+        importance *= cos_sub_clamped(sin_i, cos_i, sin_b, cos_b);
+    }
+
+    return std::max(importance, 0.f);
+}
+
+Tree::Tree() noexcept {}
+
+Tree::~Tree() noexcept {}
+
+Tree::Result Tree::random_light(float3 const& p, float3 const& n, bool total_sphere,
+                                float random) const noexcept {
+    float const ip = infinite_probability_;
+
+    if (random < ip) {
+        uint32_t const num_infinite = static_cast<uint32_t>(infinite_lights_.size());
+
+        uint32_t const l = std::min(static_cast<uint32_t>(random / ip * float(num_infinite)),
+                                    num_infinite - 1);
+
+        return {infinite_lights_[l], ip / float(num_infinite)};
+    }
+
+    if (nodes_.empty()) {
+        return {0, 0.f};
+    }
+
+    float constexpr One_minus_epsilon = 0x1.fffffep-1;
+
+    random = std::min((random - ip) / (1.f - ip), One_minus_epsilon);
+
+    float pdf = 1.f - ip;
+
+    for (uint32_t id = 0;;) {
+        Node const& node = nodes_[id];
+
+        if (node.num_lights <= 1) {
+            return {node.children_or_light, pdf};
+        }
+
+        uint32_t const c0 = node.children_or_light;
+
+        float const i0 = importance(nodes_[c0], p, n, total_sphere);
+        float const i1 = importance(nodes_[c0 + 1], p, n, total_sphere);
+
+        if (0.f == i0 && 0.f == i1) {
+            return {0, 0.f};
+        }
+
+        float const p0 = i0 / (i0 + i1);
+
+        if (random < p0) {
+            id = c0;
+            pdf *= p0;
+            random = std::min(random / p0, One_minus_epsilon);
+        } else {
+            id = c0 + 1;
+            pdf *= 1.f - p0;
+            random = std::min((random - p0) / (1.f - p0), One_minus_epsilon);
+        }
+    }
+}
+
+float Tree::pdf(uint32_t id, float3 const& p, float3 const& n, bool total_sphere) const noexcept {
+    uint32_t const leaf = light_nodes_[id];
+
+    if (Infinite == leaf) {
+        return infinite_probability_ / float(infinite_lights_.size());
+    }
+
+    float pdf = 1.f - infinite_probability_;
+
+    for (uint32_t c = leaf; 0 != c;) {
+        uint32_t const parent = nodes_[c].parent;
+
+        uint32_t const c0 = nodes_[parent].children_or_light;
+
+        float const i0 = importance(nodes_[c0], p, n, total_sphere);
+        float const i1 = importance(nodes_[c0 + 1], p, n, total_sphere);
+
+        float const i = c == c0 ? i0 : i1;
+
+        if (0.f == i) {
+            return 0.f;
+        }
+
+        pdf *= i / (i0 + i1);
+
+        c = parent;
+    }
+
+    return pdf;
+}
+
+size_t Tree::num_bytes() const noexcept {
+    return sizeof(*this) + nodes_.size() * sizeof(Node) +
+           (light_nodes_.size() + infinite_lights_.size()) * sizeof(uint32_t);
+}
+
+}  // namespace scene::light
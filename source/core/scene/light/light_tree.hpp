@@ -0,0 +1,64 @@
+#ifndef SU_CORE_SCENE_LIGHT_LIGHT_TREE_HPP
+#define SU_CORE_SCENE_LIGHT_LIGHT_TREE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "base/math/vector3.hpp"
+
+namespace scene::light {
+
+// Bounding volume hierarchy over the finite lights, with one light per leaf.
+// Every node bounds the positions, emitted directions and power of its lights,
+// so that a light can be importance sampled for a shading point by one stochastic descent.
+// Infinite lights are not part of the hierarchy and are picked uniformly instead.
+class Tree {
+  public:
+    struct Node {
+        packed_float3 center;
+        float         radius;
+
+        packed_float3 axis;
+        float         cos_a;
+
+        float power;
+
+        uint32_t parent;
+        uint32_t children_or_light;
+        uint32_t num_lights;
+    };
+
+    struct Result {
+        uint32_t offset;
+        float    pdf;
+    };
+
+    Tree() noexcept;
+
+    ~Tree() noexcept;
+
+    // The pdf is 0 if none of the lights can contribute to the shading point
+    Result random_light(float3 const& p, float3 const& n, bool total_sphere, float random) const
+        noexcept;
+
+    float pdf(uint32_t id, float3 const& p, float3 const& n, bool total_sphere) const noexcept;
+
+    size_t num_bytes() const noexcept;
+
+  private:
+    static uint32_t constexpr Infinite = 0xFFFFFFFF;
+
+    std::vector<Node> nodes_;
+
+    // The leaf of every light, or Infinite
+    std::vector<uint32_t> light_nodes_;
+
+    std::vector<uint32_t> infinite_lights_;
+
+    float infinite_probability_ = 0.f;
+
+    friend class Tree_builder;
+};
+
+}  // namespace scene::light
+
+#endif
@@ -0,0 +1,293 @@
+#include "light_tree_builder.hpp"
+#include <algorithm>
+#include <limits>
+#include "base/math/aabb.inl"
+#include "base/math/math.hpp"
+#include "base/math/vector4.inl"
+#include "base/spectrum/rgb.hpp"
+#include "light.hpp"
+#include "light_tree.hpp"
+
+namespace scene::light {
+
+static float4 constexpr Total_sphere(0.f, 0.f, 1.f, -1.f);
+
+// Rotates v by angle around the normalized axis
+static float3 rotate(float3 const& v, float3 const& axis, float angle) noexcept {
+    float const s = std::sin(angle);
+    float const c = std::cos(angle);
+
+    return c * v + s * math::cross(axis, v) + ((1.f - c) * math::dot(axis, v)) * axis;
+}
+
+// The smallest cone that contains both cones
+static float4 merge_cones(float4 const& a, float4 const& b) noexcept {
+    float const theta_a = std::acos(std::clamp(a[3], -1.f, 1.f));
+    float const theta_b = std::acos(std::clamp(b[3], -1.f, 1.f));
+
+    float3 const axis_a = a.xyz();
+    float3 const axis_b = b.xyz();
+
+    float const theta_d = std::acos(std::clamp(math::dot(axis_a, axis_b), -1.f, 1.f));
+
+    if (std::min(theta_d + theta_b, math::Pi) <= theta_a) {
+        return a;
+    }
+
+    if (std::min(theta_d + theta_a, math::Pi) <= theta_b) {
+        return b;
+    }
+
+    float const theta_o = 0.5f * (theta_a + theta_d + theta_b);
+
+    if (theta_o >= math::Pi) {
+        return Total_sphere;
+    }
+
+    float3 const w = math::cross(axis_a, axis_b);
+
+    float const sl = math::squared_length(w);
+
+    if (sl < 1.e-12f) {
+        return Total_sphere;
+    }
+
+    float3 const axis = rotate(axis_a, w / std::sqrt(sl), theta_o - theta_a);
+
+    return float4(axis, std::cos(theta_o));
+}
+
+// Solid angle measure of the directions emitted by a cone of diffuse emitters
+static float cone_measure(float cos_a) noexcept {
+    float const theta_a = std::acos(std::clamp(cos_a, -1.f, 1.f));
+    float const theta_w = std::min(theta_a + 0.5f * math::Pi, math::Pi);
+
+    float const sin_a = std::sin(theta_a);
+
+    return 2.f * math::Pi * (1.f - cos_a) +
+           0.5f * math::Pi *
+               (2.f * theta_w * sin_a - std::cos(theta_a - 2.f * theta_w) -
+                2.f * theta_a * sin_a + cos_a);
+}
+
+struct Bucket {
+    math::AABB aabb = math::AABB::empty();
+
+    float4 cone;
+
+    float power = 0.f;
+
+    uint32_t num_lights = 0;
+
+    void insert(math::AABB const& other_aabb, float4 const& other_cone,
+                float other_power) noexcept {
+        aabb.merge_assign(other_aabb);
+
+        cone = 0 == num_lights ? other_cone : merge_cones(cone, other_cone);
+
+        power += other_power;
+
+        ++num_lights;
+    }
+
+    void merge(Bucket const& other) noexcept {
+        if (0 == other.num_lights) {
+            return;
+        }
+
+        aabb.merge_assign(other.aabb);
+
+        cone = 0 == num_lights ? other.cone : merge_cones(cone, other.cone);
+
+        power += other.power;
+
+        num_lights += other.num_lights;
+    }
+
+    float cost() const noexcept {
+        return power * cone_measure(cone[3]) * aabb.surface_area();
+    }
+};
+
+Tree_builder::Tree_builder() noexcept {}
+
+Tree_builder::~Tree_builder() noexcept {}
+
+void Tree_builder::build(Tree& tree, std::vector<Light*> const& lights, math::AABB const& scene_bb,
+                         uint64_t time) noexcept {
+    lights_.clear();
+
+    tree.nodes_.clear();
+    tree.infinite_lights_.clear();
+    tree.light_nodes_.assign(lights.size(), Tree::Infinite);
+
+    float finite_power   = 0.f;
+    float infinite_power = 0.f;
+
+    for (uint32_t i = 0, len = static_cast<uint32_t>(lights.size()); i < len; ++i) {
+        auto const l = lights[i];
+
+        float const power = spectrum::luminance(l->power(scene_bb));
+
+        if (l->is_finite()) {
+            lights_.push_back({l->aabb(), l->cone(time), power, i});
+
+            finite_power += power;
+        } else {
+            tree.infinite_lights_.push_back(i);
+
+            infinite_power += power;
+        }
+    }
+
+    // Infinite lights as a whole compete with the tree according to their power
+    if (lights_.empty()) {
+        tree.infinite_probability_ = 1.f;
+        return;
+    } else if (tree.infinite_lights_.empty()) {
+        tree.infinite_probability_ = 0.f;
+    } else if (float const total_power = finite_power + infinite_power; total_power > 0.f) {
+        tree.infinite_probability_ = infinite_power / total_power;
+    } else {
+        tree.infinite_probability_ = 0.5f;
+    }
+
+    uint32_t const num_lights = static_cast<uint32_t>(lights_.size());
+
+    tree.nodes_.resize(2 * num_lights - 1);
+    tree.nodes_[0].parent = 0;
+
+    current_node_ = 1;
+
+    split(tree, 0, 0, num_lights);
+}
+
+void Tree_builder::split(Tree& tree, uint32_t node_id, uint32_t begin, uint32_t end) noexcept {
+    Bucket bounds;
+
+    for (uint32_t i = begin; i < end; ++i) {
+        Build_light const& l = lights_[i];
+
+        bounds.insert(l.aabb, l.cone, l.power);
+    }
+
+    Tree::Node& node = tree.nodes_[node_id];
+
+    node.center     = packed_float3(bounds.aabb.position());
+    node.radius     = math::length(bounds.aabb.halfsize());
+    node.axis       = packed_float3(bounds.cone.xyz());
+    node.cos_a      = bounds.cone[3];
+    node.power      = bounds.power;
+    node.num_lights = end - begin;
+
+    if (1 == end - begin) {
+        uint32_t const id = lights_[begin].id;
+
+        node.children_or_light = id;
+
+        tree.light_nodes_[id] = node_id;
+        return;
+    }
+
+    uint32_t const middle = partition(bounds.aabb, begin, end);
+
+    uint32_t const child = current_node_;
+    current_node_ += 2;
+
+    node.children_or_light = child;
+
+    tree.nodes_[child].parent     = node_id;
+    tree.nodes_[child + 1].parent = node_id;
+
+    split(tree, child, begin, middle);
+    split(tree, child + 1, middle, end);
+}
+
+uint32_t Tree_builder::partition(math::AABB const& aabb, uint32_t begin, uint32_t end) noexcept {
+    static uint32_t constexpr Num_buckets = 12;
+
+    math::AABB centroids = math::AABB::empty();
+
+    for (uint32_t i = begin; i < end; ++i) {
+        centroids.insert(lights_[i].aabb.position());
+    }
+
+    float3 const extent = centroids.extent();
+
+    float3 const aabb_extent = aabb.extent();
+
+    float const max_extent = math::max_component(aabb_extent);
+
+    float    min_cost  = std::numeric_limits<float>::max();
+    uint32_t min_axis  = 3;
+    uint32_t min_split = 0;
+
+    for (uint32_t a = 0; a < 3; ++a) {
+        if (extent[a] <= 0.f) {
+            continue;
+        }
+
+        float const begin_c = centroids.min()[a];
+        float const scale   = float(Num_buckets) / extent[a];
+
+        Bucket buckets[Num_buckets];
+
+        for (uint32_t i = begin; i < end; ++i) {
+            Build_light const& l = lights_[i];
+
+            uint32_t const b = std::min(
+                static_cast<uint32_t>((l.aabb.position()[a] - begin_c) * scale), Num_buckets - 1);
+
+            buckets[b].insert(l.aabb, l.cone, l.power);
+        }
+
+        // Penalizes thin slabs, which tend to have large cones
+        float const regularization = max_extent / aabb_extent[a];
+
+        for (uint32_t s = 1; s < Num_buckets; ++s) {
+            Bucket left;
+            Bucket right;
+
+            for (uint32_t b = 0; b < s; ++b) {
+                left.merge(buckets[b]);
+            }
+
+            for (uint32_t b = s; b < Num_buckets; ++b) {
+                right.merge(buckets[b]);
+            }
+
+            if (0 == left.num_lights || 0 == right.num_lights) {
+                continue;
+            }
+
+            float const cost = regularization * (left.cost() + right.cost());
+
+            if (cost < min_cost) {
+                min_cost  = cost;
+                min_axis  = a;
+                min_split = s;
+            }
+        }
+    }
+
+    if (3 == min_axis) {
+        return begin + (end - begin) / 2;
+    }
+
+    float const begin_c = centroids.min()[min_axis];
+    float const scale   = float(Num_buckets) / extent[min_axis];
+
+    auto const middle = std::partition(
+        lights_.begin() + begin, lights_.begin() + end,
+        [min_axis, min_split, begin_c, scale](Build_light const& l) {
+            uint32_t const b = std::min(
+                static_cast<uint32_t>((l.aabb.position()[min_axis] - begin_c) * scale),
+                Num_buckets - 1);
+
+            return b < min_split;
+        });
+
+    return static_cast<uint32_t>(middle - lights_.begin());
+}
+
+}  // namespace scene::light
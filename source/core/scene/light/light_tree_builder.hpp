@@ -0,0 +1,47 @@
+#ifndef SU_CORE_SCENE_LIGHT_LIGHT_TREE_BUILDER_HPP
+#define SU_CORE_SCENE_LIGHT_LIGHT_TREE_BUILDER_HPP
+
+#include <vector>
+#include "base/math/aabb.hpp"
+#include "base/math/vector4.hpp"
+
+namespace scene::light {
+
+class Light;
+class Tree;
+
+class Tree_builder {
+  public:
+    Tree_builder() noexcept;
+
+    ~Tree_builder() noexcept;
+
+    // Rebuilds the tree from scratch, with the lights as they are at the given time
+    void build(Tree& tree, std::vector<Light*> const& lights, math::AABB const& scene_bb,
+               uint64_t time) noexcept;
+
+  private:
+    struct Build_light {
+        math::AABB aabb;
+
+        float4 cone;
+
+        float power;
+
+        uint32_t id;
+    };
+
+    void split(Tree& tree, uint32_t node_id, uint32_t begin, uint32_t end) noexcept;
+
+    // Splits the lights along the axis and bucket boundary with the lowest
+    // surface area orientation heuristic, or in the middle if all of them are in the same place
+    uint32_t partition(math::AABB const& aabb, uint32_t begin, uint32_t end) noexcept;
+
+    std::vector<Build_light> lights_;
+
+    uint32_t current_node_;
+};
+
+}  // namespace scene::light
+
+#endif
@@ -1,5 +1,7 @@
 #include "null_light.hpp"
+#include "base/math/aabb.inl"
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 
 namespace scene::light {
 
@@ -48,6 +50,18 @@ float3 Null_light::power(math::AABB const& /*scene_bb*/) const noexcept {
     return float3::identity();
 }
 
+bool Null_light::is_finite() const noexcept {
+    return false;
+}
+
+math::AABB Null_light::aabb() const noexcept {
+    return math::AABB::empty();
+}
+
+float4 Null_light::cone(uint64_t /*time*/) const noexcept {
+    return float4(0.f, 0.f, 1.f, -1.f);
+}
+
 void Null_light::prepare_sampling(uint32_t /*light_id*/, uint64_t /*time*/,
                                   thread::Pool& /*pool*/) noexcept {}
 
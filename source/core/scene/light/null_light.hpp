@@ -39,6 +39,12 @@ class Null_light : public Light {
 
     float3 power(math::AABB const& scene_bb) const noexcept override final;
 
+    bool is_finite() const noexcept override final;
+
+    math::AABB aabb() const noexcept override final;
+
+    float4 cone(uint64_t time) const noexcept override final;
+
     void prepare_sampling(uint32_t light_id, uint64_t time, thread::Pool& pool) noexcept override;
 
     bool equals(Prop const* prop, uint32_t part) const noexcept override final;
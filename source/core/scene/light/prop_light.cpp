@@ -2,6 +2,7 @@
 #include "base/math/aabb.inl"
 #include "base/math/matrix4x4.inl"
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 #include "scene/material/material.hpp"
 #include "scene/prop/prop.hpp"
 #include "scene/scene_ray.hpp"
@@ -126,6 +127,25 @@ float3 Prop_light::power(math::AABB const& scene_bb) const noexcept {
     }
 }
 
+bool Prop_light::is_finite() const noexcept {
+    return prop_->shape()->is_finite();
+}
+
+math::AABB Prop_light::aabb() const noexcept {
+    return prop_->aabb();
+}
+
+float4 Prop_light::cone(uint64_t time) const noexcept {
+    if (prop_->material(part_)->is_two_sided()) {
+        return float4(0.f, 0.f, 1.f, -1.f);
+    }
+
+    Transformation temp;
+    auto const&    transformation = prop_->transformation_at(time, temp);
+
+    return prop_->shape()->cone(part_, transformation);
+}
+
 void Prop_light::prepare_sampling(uint32_t light_id, uint64_t time, thread::Pool& pool) noexcept {
     prop_->prepare_sampling(part_, light_id, time, false, pool);
 }
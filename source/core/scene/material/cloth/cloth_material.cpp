@@ -21,7 +21,7 @@ material::Sample const& Material::sample(float3 const& wo, Renderstate const& rs
     sample.set_basis(rs.geo_n, wo);
 
     if (normal_map_.is_valid()) {
-        float3 nm = normal_map_.sample_3(sampler, rs.uv);
+        float3 nm = normal_map_.sample_3(sampler, rs.uv, rs.duv);
         float3 n  = math::normalize(rs.tangent_to_world(nm));
         sample.layer_.set_tangent_frame(rs.t, rs.b, n);
     } else {
@@ -30,7 +30,7 @@ material::Sample const& Material::sample(float3 const& wo, Renderstate const& rs
 
     float3 color;
     if (color_map_.is_valid()) {
-        color = color_map_.sample_3(sampler, rs.uv);
+        color = color_map_.sample_3(sampler, rs.uv, rs.duv);
     } else {
         color = color_;
     }
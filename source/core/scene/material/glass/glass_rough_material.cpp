@@ -32,7 +32,7 @@ material::Sample const& Glass_rough::sample(float3 const& wo, Renderstate const&
 
     float alpha;
     if (roughness_map_.is_valid()) {
-        float const r = ggx::map_roughness(roughness_map_.sample_1(sampler, rs.uv));
+        float const r = ggx::map_roughness(roughness_map_.sample_1(sampler, rs.uv, rs.duv));
 
         alpha = r * r;
     } else {
@@ -28,6 +28,10 @@ void Sample::sample(sampler::Sampler& sampler, bxdf::Sample& result) const noexc
     result.wavelength = 0.f;
 }
 
+bool Sample::is_specular() const noexcept {
+    return true;
+}
+
 void Sample::set(float3 const& refraction_color, float ior, float ior_outside) noexcept {
     color_       = refraction_color;
     ior_         = ior;
@@ -13,6 +13,8 @@ class Sample : public material::Sample {
 
     void sample(sampler::Sampler& sampler, bxdf::Sample& result) const noexcept override;
 
+    bool is_specular() const noexcept override final;
+
     void set(float3 const& refraction_color, float ior, float ior_outside) noexcept;
 
     void sample(float ior, float p, bxdf::Sample& result) const noexcept;
@@ -36,6 +36,10 @@ bool Sample_thin::is_translucent() const noexcept {
     return true;
 }
 
+bool Sample_thin::is_specular() const noexcept {
+    return true;
+}
+
 void Sample_thin::set(float3 const& refraction_color, float3 const& absorption_coefficient,
                       float ior, float ior_outside, float thickness) noexcept {
     color_                  = refraction_color;
@@ -14,6 +14,8 @@ class Sample_thin : public material::Sample {
 
     bool is_translucent() const noexcept override final;
 
+    bool is_specular() const noexcept override final;
+
     void set(float3 const& refraction_color, float3 const& absorption_coefficient, float ior,
              float ior_outside, float thickess) noexcept;
 
@@ -29,7 +29,7 @@ material::Sample const& Emissionmap::sample(float3 const& wo, Renderstate const&
 
     sample.layer_.set_tangent_frame(rs.t, rs.b, rs.n);
 
-    float3 const radiance = emission_map_.sample_3(sampler, rs.uv);
+    float3 const radiance = emission_map_.sample_3(sampler, rs.uv, rs.duv);
 
     sample.set(emission_factor_ * radiance);
 
@@ -2,6 +2,7 @@
 #define SU_CORE_SCENE_MATERIAL_MATERIAL_HPP
 
 #include <memory>
+#include <string_view>
 #include <vector>
 #include "base/json/json_types.hpp"
 #include "base/math/vector3.hpp"
@@ -128,7 +128,7 @@ Material_ptr Provider::load(json::Value const& value, std::string_view mount_fol
 }
 
 Material_ptr Provider::load_cloth(json::Value const& cloth_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(cloth_value);
 
     Texture_adapter color_map;
     Texture_adapter normal_map;
@@ -153,17 +153,17 @@ Material_ptr Provider::load_cloth(json::Value const& cloth_value, resource::Mana
                 memory::Variant_map options;
                 if ("Color" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Color);
-                    color_map = create_texture(texture_description, options, manager);
+                    color_map = create_texture(texture_description, sampler_settings, options,
+                                               manager);
                 } else if ("Normal" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Normal);
-                    normal_map = create_texture(texture_description, options, manager);
+                    normal_map = create_texture(texture_description, sampler_settings, options,
+                                                manager);
                 } else if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -179,7 +179,7 @@ Material_ptr Provider::load_cloth(json::Value const& cloth_value, resource::Mana
 }
 
 Material_ptr Provider::load_debug(json::Value const& debug_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(debug_value);
 
     Texture_adapter mask;
 
@@ -196,11 +196,9 @@ Material_ptr Provider::load_debug(json::Value const& debug_value, resource::Mana
                 memory::Variant_map options;
                 if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -212,7 +210,7 @@ Material_ptr Provider::load_debug(json::Value const& debug_value, resource::Mana
 }
 
 Material_ptr Provider::load_display(json::Value const& display_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(display_value);
 
     Texture_adapter mask;
     Texture_adapter emission_map;
@@ -252,14 +250,13 @@ Material_ptr Provider::load_display(json::Value const& display_value, resource::
 
                 if ("Emission" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Color);
-                    emission_map = create_texture(texture_description, options, manager);
+                    emission_map = create_texture(texture_description, sampler_settings, options,
+                                                  manager);
                 } else if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -291,7 +288,7 @@ Material_ptr Provider::load_display(json::Value const& display_value, resource::
 }
 
 Material_ptr Provider::load_glass(json::Value const& glass_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(glass_value);
 
     Texture_adapter normal_map;
     Texture_adapter roughness_map;
@@ -332,14 +329,14 @@ Material_ptr Provider::load_glass(json::Value const& glass_value, resource::Mana
                 memory::Variant_map options;
                 if ("Normal" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Normal);
-                    normal_map = create_texture(texture_description, options, manager);
+                    normal_map = create_texture(texture_description, sampler_settings, options,
+                                                manager);
                 } else if ("Roughness" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Roughness);
-                    roughness_map = create_texture(texture_description, options, manager);
+                    roughness_map = create_texture(texture_description, sampler_settings, options,
+                                                   manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -381,7 +378,7 @@ Material_ptr Provider::load_glass(json::Value const& glass_value, resource::Mana
 }
 
 Material_ptr Provider::load_light(json::Value const& light_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(light_value);
 
     std::string quantity;
     float3      color(1.f);
@@ -427,14 +424,13 @@ Material_ptr Provider::load_light(json::Value const& light_value, resource::Mana
 
                 if ("Emission" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Color);
-                    emission_map = create_texture(texture_description, options, manager);
+                    emission_map = create_texture(texture_description, sampler_settings, options,
+                                                  manager);
                 } else if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -474,7 +470,7 @@ Material_ptr Provider::load_light(json::Value const& light_value, resource::Mana
 }
 
 Material_ptr Provider::load_matte(json::Value const& matte_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(matte_value);
 
     //	Texture_ptr normal_map;
     Texture_adapter mask;
@@ -503,11 +499,9 @@ Material_ptr Provider::load_matte(json::Value const& matte_value, resource::Mana
                 } else*/
                 if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -521,7 +515,7 @@ Material_ptr Provider::load_matte(json::Value const& matte_value, resource::Mana
 }
 
 Material_ptr Provider::load_metal(json::Value const& metal_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(metal_value);
 
     Texture_adapter normal_map;
     //	Texture_ptr surface_map;
@@ -560,21 +554,21 @@ Material_ptr Provider::load_metal(json::Value const& metal_value, resource::Mana
                 memory::Variant_map options;
                 if ("Normal" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Normal);
-                    normal_map = create_texture(texture_description, options, manager);
+                    normal_map = create_texture(texture_description, sampler_settings, options,
+                                                manager);
                     /*	} else if ("Surface" == usage) {
                                     surface_map = texture_cache_.load(filename,
                                                                                                       static_cast<uint32_t>(
                                                                                                              image::texture::Provider::Flags::Use_as_surface));*/
                 } else if ("Anisotropy" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Anisotropy);
-                    direction_map = create_texture(texture_description, options, manager);
+                    direction_map = create_texture(texture_description, sampler_settings, options,
+                                                   manager);
                 } else if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -608,7 +602,7 @@ Material_ptr Provider::load_metal(json::Value const& metal_value, resource::Mana
 
 Material_ptr Provider::load_metallic_paint(json::Value const& paint_value,
                                            resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(paint_value);
 
     Texture_adapter mask;
     Texture_adapter flakes_normal_map;
@@ -665,11 +659,9 @@ Material_ptr Provider::load_metallic_paint(json::Value const& paint_value,
                 memory::Variant_map options;
                 if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -682,11 +674,11 @@ Material_ptr Provider::load_metallic_paint(json::Value const& paint_value,
 
     texture_description.filename = "proc:flakes";
     options.set("usage", image::texture::Provider::Usage::Normal);
-    flakes_normal_map = create_texture(texture_description, options, manager);
+    flakes_normal_map = create_texture(texture_description, sampler_settings, options, manager);
 
     texture_description.filename = "proc:flakes_mask";
     options.set("usage", image::texture::Provider::Usage::Mask);
-    flakes_mask = create_texture(texture_description, options, manager);
+    flakes_mask = create_texture(texture_description, sampler_settings, options, manager);
 
     auto material = std::make_shared<metallic_paint::Material>(sampler_settings, two_sided);
 
@@ -710,7 +702,7 @@ Material_ptr Provider::load_metallic_paint(json::Value const& paint_value,
 }
 
 Material_ptr Provider::load_mix(json::Value const& mix_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(mix_value);
 
     Texture_adapter mask;
 
@@ -741,11 +733,9 @@ Material_ptr Provider::load_mix(json::Value const& mix_value, resource::Manager&
                 memory::Variant_map options;
                 if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -767,7 +757,7 @@ Material_ptr Provider::load_mix(json::Value const& mix_value, resource::Manager&
 }
 
 Material_ptr Provider::load_sky(json::Value const& sky_value, resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(sky_value);
 
     Texture_adapter mask;
 
@@ -792,11 +782,9 @@ Material_ptr Provider::load_sky(json::Value const& sky_value, resource::Manager&
                 memory::Variant_map options;
                 if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -810,7 +798,7 @@ Material_ptr Provider::load_sky(json::Value const& sky_value, resource::Manager&
 
 Material_ptr Provider::load_substitute(json::Value const& substitute_value,
                                        resource::Manager& manager) {
-    Sampler_settings sampler_settings;
+    Sampler_settings const sampler_settings = find_sampler_settings(substitute_value);
 
     Texture_adapter color_map;
     Texture_adapter normal_map;
@@ -875,32 +863,37 @@ Material_ptr Provider::load_substitute(json::Value const& substitute_value,
                 memory::Variant_map options;
                 if ("Color" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Color);
-                    color_map = create_texture(texture_description, options, manager);
+                    color_map = create_texture(texture_description, sampler_settings, options,
+                                               manager);
                 } else if ("Normal" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Normal);
-                    normal_map = create_texture(texture_description, options, manager);
+                    normal_map = create_texture(texture_description, sampler_settings, options,
+                                                manager);
                 } else if ("Surface" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Surface);
-                    surface_map = create_texture(texture_description, options, manager);
+                    surface_map = create_texture(texture_description, sampler_settings, options,
+                                                 manager);
                 } else if ("Roughness" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Roughness);
-                    surface_map = create_texture(texture_description, options, manager);
+                    surface_map = create_texture(texture_description, sampler_settings, options,
+                                                 manager);
                 } else if ("Specularity" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Specularity);
-                    surface_map = create_texture(texture_description, options, manager);
+                    surface_map = create_texture(texture_description, sampler_settings, options,
+                                                 manager);
                 } else if ("Emission" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Color);
-                    emission_map = create_texture(texture_description, options, manager);
+                    emission_map = create_texture(texture_description, sampler_settings, options,
+                                                  manager);
                 } else if ("Mask" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    mask = create_texture(texture_description, options, manager);
+                    mask = create_texture(texture_description, sampler_settings, options, manager);
                 } else if ("Density" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    density_map = create_texture(texture_description, options, manager);
+                    density_map = create_texture(texture_description, sampler_settings, options,
+                                                 manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -929,14 +922,15 @@ Material_ptr Provider::load_substitute(json::Value const& substitute_value,
         if (!coating.thickness_map_description.filename.empty()) {
             memory::Variant_map options;
             options.set("usage", image::texture::Provider::Usage::Mask);
-            coating_thickness_map = create_texture(coating.thickness_map_description, options,
-                                                   manager);
+            coating_thickness_map = create_texture(coating.thickness_map_description,
+                                                   sampler_settings, options, manager);
         }
 
         if (!coating.normal_map_description.filename.empty()) {
             memory::Variant_map options;
             options.set("usage", image::texture::Provider::Usage::Normal);
-            coating_normal_map = create_texture(coating.normal_map_description, options, manager);
+            coating_normal_map = create_texture(coating.normal_map_description, sampler_settings,
+                                                options, manager);
         }
 
         if (coating.in_nm) {
@@ -1027,9 +1021,10 @@ Material_ptr Provider::load_substitute(json::Value const& substitute_value,
 
 Material_ptr Provider::load_volumetric(json::Value const& volumetric_value,
                                        resource::Manager& manager) {
-    Sampler_settings sampler_settings(Sampler_settings::Filter::Linear,
-                                      Sampler_settings::Address::Clamp,
-                                      Sampler_settings::Address::Clamp);
+    Sampler_settings const sampler_settings = find_sampler_settings(
+        volumetric_value, Sampler_settings(Sampler_settings::Filter::Linear,
+                                           Sampler_settings::Address::Clamp,
+                                           Sampler_settings::Address::Clamp));
 
     Texture_adapter density_map;
     Texture_adapter emission_map;
@@ -1074,14 +1069,14 @@ Material_ptr Provider::load_volumetric(json::Value const& volumetric_value,
                 memory::Variant_map options;
                 if ("Density" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Mask);
-                    density_map = create_texture(texture_description, options, manager);
+                    density_map = create_texture(texture_description, sampler_settings, options,
+                                                 manager);
                 } else if ("Emission" == texture_description.usage) {
                     options.set("usage", image::texture::Provider::Usage::Color);
-                    emission_map = create_texture(texture_description, options, manager);
+                    emission_map = create_texture(texture_description, sampler_settings, options,
+                                                  manager);
                 }
             }
-        } else if ("sampler" == n.name) {
-            read_sampler_settings(n.value, sampler_settings);
         }
     }
 
@@ -1137,6 +1132,10 @@ void Provider::read_sampler_settings(json::Value const& sampler_value, Sampler_s
                 settings.filter = Sampler_settings::Filter::Nearest;
             } else if ("Linear" == filter) {
                 settings.filter = Sampler_settings::Filter::Linear;
+            } else if ("Trilinear" == filter) {
+                settings.filter = Sampler_settings::Filter::Trilinear;
+            } else if ("Anisotropic" == filter) {
+                settings.filter = Sampler_settings::Filter::Anisotropic;
             }
         } else if ("address" == n.name) {
             if (n.value.IsArray()) {
@@ -1155,6 +1154,19 @@ void Provider::read_sampler_settings(json::Value const& sampler_value, Sampler_s
     }
 }
 
+Sampler_settings Provider::find_sampler_settings(json::Value const& material_value) {
+    return find_sampler_settings(material_value, Sampler_settings());
+}
+
+Sampler_settings Provider::find_sampler_settings(json::Value const& material_value,
+                                                 Sampler_settings   defaults) {
+    if (auto const s = material_value.FindMember("sampler"); material_value.MemberEnd() != s) {
+        read_sampler_settings(s->value, defaults);
+    }
+
+    return defaults;
+}
+
 void Provider::read_texture_description(json::Value const&   texture_value,
                                         Texture_description& description) {
     description.filename     = "";
@@ -1182,7 +1194,13 @@ void Provider::read_texture_description(json::Value const&   texture_value,
 }
 
 Texture_adapter Provider::create_texture(const Texture_description& description,
+                                         Sampler_settings const&    sampler_settings,
                                          memory::Variant_map& options, resource::Manager& manager) {
+    if (Sampler_settings::Filter::Trilinear == sampler_settings.filter ||
+        Sampler_settings::Filter::Anisotropic == sampler_settings.filter) {
+        options.set("mip_maps", true);
+    }
+
     if (description.num_elements > 1) {
         options.set("num_elements", description.num_elements);
     }
@@ -76,10 +76,17 @@ class Provider final : public resource::Provider<Material> {
 
     static void read_sampler_settings(json::Value const& sampler_value, Sampler_settings& settings);
 
+    // The sampler of a material is needed before its textures, which are only mip mapped for it
+    static Sampler_settings find_sampler_settings(json::Value const& material_value);
+
+    static Sampler_settings find_sampler_settings(json::Value const& material_value,
+                                                  Sampler_settings   defaults);
+
     static void read_texture_description(json::Value const&   texture_value,
                                          Texture_description& description);
 
     static Texture_adapter create_texture(const Texture_description& description,
+                                          Sampler_settings const&    sampler_settings,
                                           memory::Variant_map& options, resource::Manager& manager);
 
     struct Coating_description {
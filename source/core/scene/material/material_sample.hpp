@@ -61,6 +61,9 @@ class Sample {
 
     virtual bool ior_greater_one() const noexcept;
 
+    // Only singular lobes, so that evaluate() is always zero
+    virtual bool is_specular() const noexcept;
+
     virtual bool do_evaluate_back(bool previously, bool same_side) const noexcept;
 
     float3 const& wo() const noexcept;
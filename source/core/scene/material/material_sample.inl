@@ -92,6 +92,10 @@ inline bool Sample::ior_greater_one() const noexcept {
     return true;
 }
 
+inline bool Sample::is_specular() const noexcept {
+    return false;
+}
+
 inline bool Sample::do_evaluate_back(bool /*previously*/, bool /*same_side*/) const noexcept {
     return true;
 }
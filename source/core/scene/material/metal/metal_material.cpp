@@ -81,12 +81,12 @@ material::Sample const& Material_anisotropic::sample(float3 const& wo, Rendersta
     sample.set_basis(rs.geo_n, wo);
 
     if (normal_map_.is_valid()) {
-        float3 nm = normal_map_.sample_3(sampler, rs.uv);
+        float3 nm = normal_map_.sample_3(sampler, rs.uv, rs.duv);
         float3 n  = math::normalize(rs.tangent_to_world(nm));
 
         sample.layer_.set_tangent_frame(n);
     } else if (direction_map_.is_valid()) {
-        float2 tm = direction_map_.sample_2(sampler, rs.uv);
+        float2 tm = direction_map_.sample_2(sampler, rs.uv, rs.duv);
         float3 t  = math::normalize(rs.tangent_to_world(tm));
         float3 b  = math::cross(rs.n, t);
 
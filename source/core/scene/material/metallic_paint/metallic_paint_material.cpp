@@ -43,7 +43,7 @@ material::Sample const& Material::sample(float3 const& wo, Renderstate const& rs
     if (flakes_mask_.is_valid()) {
         auto const& sampler = worker.sampler_2D(sampler_key(), filter);
 
-        flakes_weight = flakes_mask_.sample_1(sampler, rs.uv);
+        flakes_weight = flakes_mask_.sample_1(sampler, rs.uv, rs.duv);
     } else {
         flakes_weight = 1.f;
     }
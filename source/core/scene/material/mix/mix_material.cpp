@@ -14,7 +14,7 @@ material::Sample const& Material::sample(float3 const& wo, Renderstate const& rs
                                          uint32_t depth) const noexcept {
     auto& texture_sampler = worker.sampler_2D(sampler_key(), filter);
 
-    float const mask = mask_.sample_1(texture_sampler, rs.uv);
+    float const mask = mask_.sample_1(texture_sampler, rs.uv, rs.duv);
 
     if (mask > sampler.generate_sample_1D(1)) {
         return material_a_->sample(wo, rs, filter, sampler, worker, depth);
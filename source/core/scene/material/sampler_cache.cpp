@@ -1,7 +1,9 @@
 #include "sampler_cache.hpp"
+#include <algorithm>
 #include "image/texture/sampler/address_mode.hpp"
 #include "image/texture/sampler/sampler_linear_2d.inl"
 #include "image/texture/sampler/sampler_linear_3d.inl"
+#include "image/texture/sampler/sampler_mipmap_2d.inl"
 #include "image/texture/sampler/sampler_nearest_2d.inl"
 #include "image/texture/sampler/sampler_nearest_3d.inl"
 
@@ -13,14 +15,22 @@ using Texture_sampler_3D = image::texture::sampler::Sampler_3D;
 Sampler_cache::Sampler_cache() noexcept {
     using namespace image::texture::sampler;
 
-    samplers_2D_[0] = new Nearest_2D<Address_mode_clamp, Address_mode_clamp>;
-    samplers_2D_[1] = new Nearest_2D<Address_mode_clamp, Address_mode_repeat>;
-    samplers_2D_[2] = new Nearest_2D<Address_mode_repeat, Address_mode_clamp>;
-    samplers_2D_[3] = new Nearest_2D<Address_mode_repeat, Address_mode_repeat>;
-    samplers_2D_[4] = new Linear_2D<Address_mode_clamp, Address_mode_clamp>;
-    samplers_2D_[5] = new Linear_2D<Address_mode_clamp, Address_mode_repeat>;
-    samplers_2D_[6] = new Linear_2D<Address_mode_repeat, Address_mode_clamp>;
-    samplers_2D_[7] = new Linear_2D<Address_mode_repeat, Address_mode_repeat>;
+    samplers_2D_[0]  = new Nearest_2D<Address_mode_clamp, Address_mode_clamp>;
+    samplers_2D_[1]  = new Nearest_2D<Address_mode_clamp, Address_mode_repeat>;
+    samplers_2D_[2]  = new Nearest_2D<Address_mode_repeat, Address_mode_clamp>;
+    samplers_2D_[3]  = new Nearest_2D<Address_mode_repeat, Address_mode_repeat>;
+    samplers_2D_[4]  = new Linear_2D<Address_mode_clamp, Address_mode_clamp>;
+    samplers_2D_[5]  = new Linear_2D<Address_mode_clamp, Address_mode_repeat>;
+    samplers_2D_[6]  = new Linear_2D<Address_mode_repeat, Address_mode_clamp>;
+    samplers_2D_[7]  = new Linear_2D<Address_mode_repeat, Address_mode_repeat>;
+    samplers_2D_[8]  = new Mipmap_2D<Address_mode_clamp, Address_mode_clamp>(1);
+    samplers_2D_[9]  = new Mipmap_2D<Address_mode_clamp, Address_mode_repeat>(1);
+    samplers_2D_[10] = new Mipmap_2D<Address_mode_repeat, Address_mode_clamp>(1);
+    samplers_2D_[11] = new Mipmap_2D<Address_mode_repeat, Address_mode_repeat>(1);
+    samplers_2D_[12] = new Mipmap_2D<Address_mode_clamp, Address_mode_clamp>(Max_anisotropy);
+    samplers_2D_[13] = new Mipmap_2D<Address_mode_clamp, Address_mode_repeat>(Max_anisotropy);
+    samplers_2D_[14] = new Mipmap_2D<Address_mode_repeat, Address_mode_clamp>(Max_anisotropy);
+    samplers_2D_[15] = new Mipmap_2D<Address_mode_repeat, Address_mode_repeat>(Max_anisotropy);
 
     samplers_3D_[0] = new Nearest_3D<Address_mode_clamp /*,  Address_mode_clamp*/>;
     samplers_3D_[1] = new Nearest_3D<Address_mode_clamp /*,  Address_mode_repeat*/>;
@@ -35,28 +45,45 @@ Sampler_cache::Sampler_cache() noexcept {
 Sampler_cache::~Sampler_cache() noexcept {
     for (uint32_t i = 0; i < Num_samplers; ++i) {
         delete samplers_2D_[i];
+    }
+
+    for (uint32_t i = 0; i < Num_samplers_3D; ++i) {
         delete samplers_3D_[i];
     }
 }
 
+static uint32_t constexpr Address_mask = static_cast<uint32_t>(
+    Sampler_settings::Address_flat::Mask);
+
+static uint32_t constexpr Filter_mask = ~Address_mask;
+
 Texture_sampler_2D const& Sampler_cache::sampler_2D(uint32_t key, Filter filter) const noexcept {
     if (Filter::Undefined == filter) {
         return *samplers_2D_[key];
     } else {
-        uint32_t const address = key & static_cast<uint32_t>(Sampler_settings::Address_flat::Mask);
+        uint32_t const address = key & Address_mask;
+
+        // The cheap filter for mip mapped lookups is the trilinear one,
+        // because it can use the coarse levels for the wide footprints of incoherent rays
+        if (Filter::Nearest == filter &&
+            (key & Filter_mask) >= static_cast<uint32_t>(Filter::Trilinear)) {
+            return *samplers_2D_[static_cast<uint32_t>(Filter::Trilinear) | address];
+        }
+
         uint32_t const override_key = static_cast<uint32_t>(filter) | address;
         return *samplers_2D_[override_key];
     }
 }
 
 Texture_sampler_3D const& Sampler_cache::sampler_3D(uint32_t key, Filter filter) const noexcept {
-    if (Filter::Undefined == filter) {
-        return *samplers_3D_[key];
-    } else {
-        uint32_t const address = key & static_cast<uint32_t>(Sampler_settings::Address_flat::Mask);
-        uint32_t const override_key = static_cast<uint32_t>(filter) | address;
-        return *samplers_3D_[override_key];
-    }
+    uint32_t const address = key & Address_mask;
+
+    uint32_t const key_filter = Filter::Undefined == filter ? key & Filter_mask
+                                                            : static_cast<uint32_t>(filter);
+
+    uint32_t const clamped_filter = std::min(key_filter, static_cast<uint32_t>(Filter::Linear));
+
+    return *samplers_3D_[clamped_filter | address];
 }
 
 }  // namespace scene::material
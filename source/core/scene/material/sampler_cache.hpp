@@ -26,10 +26,15 @@ class Sampler_cache {
     Texture_sampler_3D const& sampler_3D(uint32_t key, Filter filter) const noexcept;
 
   private:
-    static uint32_t constexpr Num_samplers = 8;
+    static uint32_t constexpr Num_samplers = 16;
+
+    // Volumes are not mip mapped, so only Nearest and Linear exist for 3D
+    static uint32_t constexpr Num_samplers_3D = 8;
+
+    static uint32_t constexpr Max_anisotropy = 8;
 
     Texture_sampler_2D* samplers_2D_[Num_samplers];
-    Texture_sampler_3D* samplers_3D_[Num_samplers];
+    Texture_sampler_3D* samplers_3D_[Num_samplers_3D];
 };
 
 }  // namespace scene::material
@@ -16,7 +16,14 @@ struct Sampler_settings {
         Mask          = 0x00000003
     };
 
-    enum class Filter : uint32_t { Nearest = 0 << 2, Linear = 1 << 2, Undefined = 0xFFFFFFFF };
+    // Trilinear and Anisotropic use the mip chain according to the footprint of the lookup
+    enum class Filter : uint32_t {
+        Nearest     = 0 << 2,
+        Linear      = 1 << 2,
+        Trilinear   = 2 << 2,
+        Anisotropic = 3 << 2,
+        Undefined   = 0xFFFFFFFF
+    };
 
     Sampler_settings(Filter filter = Filter::Linear, Address address_u = Address::Repeat,
                      Address address_v = Address::Repeat);
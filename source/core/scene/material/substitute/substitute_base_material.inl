@@ -27,14 +27,14 @@ void Material_base::set_sample(float3 const& wo, Renderstate const& rs, float io
 
     float3 color;
     if (color_map_.is_valid()) {
-        color = color_map_.sample_3(sampler, rs.uv);
+        color = color_map_.sample_3(sampler, rs.uv, rs.duv);
     } else {
         color = color_;
     }
 
     float2 surface;
     if (surface_map_.is_valid()) {
-        surface = surface_map_.sample_2(sampler, rs.uv);
+        surface = surface_map_.sample_2(sampler, rs.uv, rs.duv);
 
         const float r = ggx::map_roughness(surface[0]);
 
@@ -46,7 +46,7 @@ void Material_base::set_sample(float3 const& wo, Renderstate const& rs, float io
 
     float3 radiance;
     if (emission_map_.is_valid()) {
-        radiance = emission_factor_ * emission_map_.sample_3(sampler, rs.uv);
+        radiance = emission_factor_ * emission_map_.sample_3(sampler, rs.uv, rs.duv);
     } else {
         radiance = float3::identity();
     }
@@ -23,7 +23,7 @@ material::Sample const& Material_clearcoat::sample(float3 const& wo, Renderstate
     float thickness;
     float weight;
     if (coating_thickness_map_.is_valid()) {
-        float const relative_thickness = coating_thickness_map_.sample_1(sampler, rs.uv);
+        float const relative_thickness = coating_thickness_map_.sample_1(sampler, rs.uv, rs.duv);
 
         thickness = coating_.thickness * relative_thickness;
         weight    = relative_thickness > 0.1f ? 1.f : relative_thickness;
@@ -8,4 +8,6 @@ target_sources(core
 	"${CMAKE_CURRENT_LIST_DIR}/prop_bvh_wrapper.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/prop_intersection.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/prop_intersection.inl"
+	"${CMAKE_CURRENT_LIST_DIR}/prop_test.cpp"
+	"${CMAKE_CURRENT_LIST_DIR}/prop_test.hpp"
 	)  
@@ -2,6 +2,7 @@
 #include "base/math/aabb.inl"
 #include "base/math/matrix4x4.inl"
 #include "base/math/quaternion.inl"
+#include "base/math/ray_packet.hpp"
 #include "base/math/transformation.inl"
 #include "base/math/vector3.inl"
 #include "scene/entity/composed_transformation.hpp"
@@ -9,6 +10,7 @@
 #include "scene/scene_worker.hpp"
 #include "scene/shape/morphable_shape.hpp"
 #include "scene/shape/shape.hpp"
+#include "scene/shape/shape_intersection.hpp"
 
 namespace scene::prop {
 
@@ -56,7 +58,21 @@ bool Prop::intersect(Ray& ray, Node_stack& node_stack, shape::Intersection& inte
     Transformation temp;
     auto const&    transformation = transformation_at(ray.time, temp);
 
-    return shape_->intersect(ray, transformation, node_stack, intersection);
+    // Only some shapes have differentials, and a miss must keep those of the closest hit so far
+    float3 const dpdu = intersection.dpdu;
+    float3 const dpdv = intersection.dpdv;
+
+    intersection.dpdu = float3(0.f);
+    intersection.dpdv = float3(0.f);
+
+    if (shape_->intersect(ray, transformation, node_stack, intersection)) {
+        return true;
+    }
+
+    intersection.dpdu = dpdu;
+    intersection.dpdv = dpdv;
+
+    return false;
 }
 
 bool Prop::intersect_fast(Ray& ray, Node_stack& node_stack, shape::Intersection& intersection) const
@@ -72,7 +88,21 @@ bool Prop::intersect_fast(Ray& ray, Node_stack& node_stack, shape::Intersection&
     Transformation temp;
     auto const&    transformation = transformation_at(ray.time, temp);
 
-    return shape_->intersect_fast(ray, transformation, node_stack, intersection);
+    // Only some shapes have differentials, and a miss must keep those of the closest hit so far
+    float3 const dpdu = intersection.dpdu;
+    float3 const dpdv = intersection.dpdv;
+
+    intersection.dpdu = float3(0.f);
+    intersection.dpdv = float3(0.f);
+
+    if (shape_->intersect_fast(ray, transformation, node_stack, intersection)) {
+        return true;
+    }
+
+    intersection.dpdu = dpdu;
+    intersection.dpdv = dpdv;
+
+    return false;
 }
 
 bool Prop::intersect(Ray& ray, Node_stack& node_stack, float& epsilon) const noexcept {
@@ -109,6 +139,101 @@ bool Prop::intersect_p(Ray const& ray, Node_stack& node_stack) const noexcept {
     return shape_->intersect_p(ray, transformation, node_stack);
 }
 
+uint32_t Prop::intersect(Ray* rays, uint32_t mask, Node_stack& node_stack,
+                         shape::Intersection* intersections) const noexcept {
+    uint32_t active = 0;
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if ((mask & (1u << i)) && visible(rays[i].depth) &&
+            (!shape_->is_complex() || aabb_.intersect_p(rays[i]))) {
+            active |= 1u << i;
+        }
+    }
+
+    if (0 == active) {
+        return 0;
+    }
+
+    // Same as for single rays, but lanes that already hit another prop might not be active here
+    float3 dpdu[math::Ray_packet::Size];
+    float3 dpdv[math::Ray_packet::Size];
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if (active & (1u << i)) {
+            dpdu[i] = intersections[i].dpdu;
+            dpdv[i] = intersections[i].dpdv;
+
+            intersections[i].dpdu = float3(0.f);
+            intersections[i].dpdv = float3(0.f);
+        }
+    }
+
+    uint32_t hits = 0;
+
+    if (1 == num_world_frames_) {
+        hits = shape_->intersect(rays, active, world_transformation_, node_stack, intersections);
+    } else {
+        // Animated props have a different transformation for every ray
+        for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+            if (active & (1u << i)) {
+                Transformation temp;
+                auto const&    transformation = transformation_at(rays[i].time, temp);
+
+                if (shape_->intersect(rays[i], transformation, node_stack, intersections[i])) {
+                    hits |= 1u << i;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if ((active & ~hits) & (1u << i)) {
+            intersections[i].dpdu = dpdu[i];
+            intersections[i].dpdv = dpdv[i];
+        }
+    }
+
+    return hits;
+}
+
+uint32_t Prop::intersect_p(Ray const* rays, uint32_t mask, Node_stack& node_stack) const
+    noexcept {
+    if (!visible_in_shadow()) {
+        return 0;
+    }
+
+    uint32_t active = 0;
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if ((mask & (1u << i)) && (!shape_->is_complex() || aabb_.intersect_p(rays[i]))) {
+            active |= 1u << i;
+        }
+    }
+
+    if (0 == active) {
+        return 0;
+    }
+
+    if (1 == num_world_frames_) {
+        return shape_->intersect_p(rays, active, world_transformation_, node_stack);
+    }
+
+    uint32_t hits = 0;
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if (active & (1u << i)) {
+            Transformation temp;
+            auto const&    transformation = transformation_at(rays[i].time, temp);
+
+            if (shape_->intersect_p(rays[i], transformation, node_stack)) {
+                hits |= 1u << i;
+            }
+        }
+    }
+
+    return hits;
+}
+
 // bool Prop::intersect_p(FVector ray_origin, FVector ray_direction,
 //					   FVector ray_inv_direction, FVector ray_min_t, FVector
 // ray_max_t, 					   float ray_time, shape::Node_stack& node_stack)
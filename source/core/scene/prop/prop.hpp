@@ -46,6 +46,12 @@ class Prop : public entity::Entity {
 
     bool intersect_p(Ray const& ray, shape::Node_stack& node_stack) const noexcept;
 
+    // Packet versions for the rays selected by mask, returning the mask of the rays that hit
+    uint32_t intersect(Ray* rays, uint32_t mask, Node_stack& node_stack,
+                       shape::Intersection* intersections) const noexcept;
+
+    uint32_t intersect_p(Ray const* rays, uint32_t mask, Node_stack& node_stack) const noexcept;
+
     //	bool intersect_p(FVector ray_origin, FVector ray_direction,
     //					 FVector ray_inv_direction, FVector ray_mint_, FVector
     // ray_max_t, 					 float ray_time, shape::Node_stack&
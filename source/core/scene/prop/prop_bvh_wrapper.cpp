@@ -1,4 +1,5 @@
 #include "prop_bvh_wrapper.hpp"
+#include "base/math/ray_packet.inl"
 #include "prop.hpp"
 #include "prop_intersection.hpp"
 #include "scene/bvh/scene_bvh_node.inl"
@@ -264,6 +265,173 @@ bool BVH_wrapper::intersect_p(Ray const& ray, shape::Node_stack& node_stack) con
     return false;
 }
 
+uint32_t BVH_wrapper::intersect(Ray* rays, uint32_t mask, shape::Node_stack& node_stack,
+                                Intersection* intersections) const noexcept {
+    Prop const* hit_props[math::Ray_packet::Size] = {nullptr, nullptr, nullptr, nullptr};
+
+    shape::Intersection geos[math::Ray_packet::Size];
+
+    uint32_t hits = 0;
+
+    math::Ray_packet packet;
+
+    // The first active ray decides the order in which the children are visited
+    uint32_t lead = math::Ray_packet::Size;
+
+    for (uint32_t i = math::Ray_packet::Size; i > 0; --i) {
+        uint32_t const l = i - 1;
+
+        if (mask & (1u << l)) {
+            packet.set(l, rays[l]);
+            lead = l;
+        } else {
+            packet.set(l, simd::Zero, simd::Zero, simd::Zero, 0.f, 0.f);
+        }
+    }
+
+    node_stack.clear();
+    if (0 != tree_.num_nodes_ && 0 != mask) {
+        node_stack.push(0);
+    }
+
+    uint32_t n = 0;
+
+    bvh::Node*   nodes = tree_.nodes_;
+    Prop* const* props = tree_.data_.data();
+
+    while (!node_stack.empty()) {
+        auto const& node = nodes[n];
+
+        if (uint32_t const active = mask & node.intersect_p(packet); 0 != active) {
+            if (0 == node.num_primitives()) {
+                if (0 == packet.sign(lead, node.axis())) {
+                    node_stack.push(node.next());
+                    ++n;
+                } else {
+                    node_stack.push(n + 1);
+                    n = node.next();
+                }
+
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(), len = node.indices_end(); i < len; ++i) {
+                auto const p = props[i];
+
+                uint32_t const h = p->intersect(rays, active, node_stack, geos);
+
+                for (uint32_t l = 0; l < math::Ray_packet::Size; ++l) {
+                    if (h & (1u << l)) {
+                        hit_props[l]     = p;
+                        packet.max_t[l] = rays[l].max_t;
+                    }
+                }
+
+                hits |= h;
+            }
+        }
+
+        n = node_stack.pop();
+    }
+
+    for (uint32_t l = 0; l < math::Ray_packet::Size; ++l) {
+        if (0 == (mask & (1u << l))) {
+            continue;
+        }
+
+        for (uint32_t i = 0, len = num_infinite_props_; i < len; ++i) {
+            auto const p = infinite_props_[i];
+            if (p->intersect(rays[l], node_stack, geos[l])) {
+                hit_props[l] = p;
+                hits |= 1u << l;
+            }
+        }
+
+        if (hits & (1u << l)) {
+            intersections[l].geo = geos[l];
+        }
+
+        intersections[l].prop       = hit_props[l];
+        intersections[l].subsurface = false;
+    }
+
+    return hits;
+}
+
+uint32_t BVH_wrapper::intersect_p(Ray const* rays, uint32_t mask,
+                                  shape::Node_stack& node_stack) const noexcept {
+    uint32_t hits = 0;
+
+    math::Ray_packet packet;
+
+    uint32_t lead = math::Ray_packet::Size;
+
+    for (uint32_t i = math::Ray_packet::Size; i > 0; --i) {
+        uint32_t const l = i - 1;
+
+        if (mask & (1u << l)) {
+            packet.set(l, rays[l]);
+            lead = l;
+        } else {
+            packet.set(l, simd::Zero, simd::Zero, simd::Zero, 0.f, 0.f);
+        }
+    }
+
+    node_stack.clear();
+    if (0 != tree_.num_nodes_ && 0 != mask) {
+        node_stack.push(0);
+    }
+
+    uint32_t n = 0;
+
+    bvh::Node*   nodes = tree_.nodes_;
+    Prop* const* props = tree_.data_.data();
+
+    while (!node_stack.empty()) {
+        auto const& node = nodes[n];
+
+        // Rays that are already occluded don't take part anymore
+        if (uint32_t const active = (mask & ~hits) & node.intersect_p(packet); 0 != active) {
+            if (0 == node.num_primitives()) {
+                if (0 == packet.sign(lead, node.axis())) {
+                    node_stack.push(node.next());
+                    ++n;
+                } else {
+                    node_stack.push(n + 1);
+                    n = node.next();
+                }
+
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(), len = node.indices_end(); i < len; ++i) {
+                // Shapes return early once all their rays are occluded, leaving nodes behind
+                uint32_t const size = node_stack.size();
+
+                hits |= props[i]->intersect_p(rays, active & ~hits, node_stack);
+
+                node_stack.restore(size);
+            }
+
+            if (hits == mask) {
+                return hits;
+            }
+        }
+
+        n = node_stack.pop();
+    }
+
+    for (uint32_t i = 0, len = num_infinite_props_; i < len; ++i) {
+        uint32_t const size = node_stack.size();
+
+        hits |= infinite_props_[i]->intersect_p(rays, mask & ~hits, node_stack);
+
+        node_stack.restore(size);
+    }
+
+    return hits;
+}
+
 bool BVH_wrapper::opacity(Ray const& ray, Filter filter, Worker const& worker, float& o) const
     noexcept {
     auto& node_stack = worker.node_stack();
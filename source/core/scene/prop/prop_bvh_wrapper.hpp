@@ -38,6 +38,14 @@ class BVH_wrapper {
 
     bool intersect_p(Ray const& ray, shape::Node_stack& node_stack) const noexcept;
 
+    // Packet versions for the rays selected by mask, that share the node visits.
+    // Return the mask of the rays that hit a prop.
+    uint32_t intersect(Ray* rays, uint32_t mask, shape::Node_stack& node_stack,
+                       Intersection* intersections) const noexcept;
+
+    uint32_t intersect_p(Ray const* rays, uint32_t mask, shape::Node_stack& node_stack) const
+        noexcept;
+
     bool opacity(Ray const& ray, Filter filter, Worker const& worker, float& o) const noexcept;
 
     bool thin_absorption(Ray const& ray, Filter filter, Worker const& worker, float3& ta) const
@@ -1,6 +1,7 @@
 #ifndef SU_CORE_SCENE_PROP_INTERSECTION_HPP
 #define SU_CORE_SCENE_PROP_INTERSECTION_HPP
 
+#include "base/math/vector4.hpp"
 #include "scene/material/sampler_settings.hpp"
 #include "scene/shape/shape_intersection.hpp"
 
@@ -48,6 +49,9 @@ struct Intersection {
 
     bool same_hemisphere(float3 const& v) const noexcept;
 
+    // Footprint of the ray cone in texture space, as expected by the texture samplers
+    float4 texture_footprint(Ray const& ray) const noexcept;
+
     Prop const* prop;
 
     shape::Intersection geo;
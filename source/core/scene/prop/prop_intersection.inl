@@ -1,7 +1,10 @@
 #ifndef SU_CORE_SCENE_PROP_INTERSECTION_INL
 #define SU_CORE_SCENE_PROP_INTERSECTION_INL
 
+#include <algorithm>
+#include <cmath>
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 #include "prop.hpp"
 #include "prop_intersection.hpp"
 #include "scene/material/material.hpp"
@@ -59,6 +62,7 @@ inline material::Sample const& Intersection::sample(float3 const& wo, Ray const&
     rs.time = ray.time;
 
     rs.uv             = geo.uv;
+    rs.duv            = texture_footprint(ray);
     rs.area           = area();
     rs.ior            = worker.ior_outside(wo, *this);
     rs.wavelength     = ray.wavelength;
@@ -72,6 +76,42 @@ inline bool Intersection::same_hemisphere(float3 const& v) const noexcept {
     return math::dot(geo.geo_n, v) > 0.f;
 }
 
+inline float4 Intersection::texture_footprint(Ray const& ray) const noexcept {
+    float const width = ray.cone_width + ray.cone_spread * ray.max_t;
+
+    float const a = math::dot(geo.dpdu, geo.dpdu);
+    float const b = math::dot(geo.dpdu, geo.dpdv);
+    float const c = math::dot(geo.dpdv, geo.dpdv);
+
+    float const determinant = a * c - b * b;
+
+    if (width <= 0.f || determinant <= 0.f) {
+        return float4(0.f);
+    }
+
+    // The axes of the cone are projected along the ray onto the tangent plane,
+    // the cosine is bounded to keep grazing footprints finite
+    auto const [x, y] = math::orthonormal_basis(ray.direction);
+
+    float const n_dot_d = math::dot(geo.geo_n, ray.direction);
+    float const clamped = std::max(std::abs(n_dot_d), 0.01f);
+    float const id      = n_dot_d < 0.f ? -1.f / clamped : 1.f / clamped;
+
+    float3 const px = width * (x - (math::dot(geo.geo_n, x) * id) * ray.direction);
+    float3 const py = width * (y - (math::dot(geo.geo_n, y) * id) * ray.direction);
+
+    // Least squares solution of p = du * dpdu + dv * dpdv
+    float const ideterminant = 1.f / determinant;
+
+    float const xu = math::dot(geo.dpdu, px);
+    float const xv = math::dot(geo.dpdv, px);
+    float const yu = math::dot(geo.dpdu, py);
+    float const yv = math::dot(geo.dpdv, py);
+
+    return ideterminant *
+           float4(c * xu - b * xv, a * xv - b * xu, c * yu - b * yv, a * yv - b * yu);
+}
+
 }  // namespace scene::prop
 
 #endif
@@ -0,0 +1,105 @@
+#include "prop_test.hpp"
+#include <iostream>
+#include <memory>
+#include "base/math/print.hpp"
+#include "base/math/quaternion.inl"
+#include "base/math/ray_packet.hpp"
+#include "base/math/vector3.inl"
+#include "prop.hpp"
+#include "scene/scene_constants.hpp"
+#include "scene/scene_ray.inl"
+#include "scene/shape/infinite_sphere.hpp"
+#include "scene/shape/node_stack.inl"
+#include "scene/shape/plane.hpp"
+#include "scene/shape/shape_intersection.hpp"
+#include "scene/shape/sphere.hpp"
+
+namespace scene::prop::testing {
+
+static void init(Prop& prop, std::shared_ptr<shape::Shape> const& shape, float3 const& position) {
+    prop.set_shape_and_materials(shape, {});
+
+    math::Transformation transformation;
+    transformation.position = position;
+    transformation.scale    = float3(1.f);
+    transformation.rotation = math::quaternion::identity();
+
+    prop.allocate_local_frame();
+    prop.set_transformation(transformation);
+    prop.propagate_frame_allocation();
+    prop.calculate_world_transformation();
+}
+
+static Ray ray_to_plane(float x) {
+    Ray ray;
+    ray.origin = float3(x, 0.f, 5.f);
+    ray.set_direction(float3(0.f, 0.f, -1.f));
+    ray.min_t = 0.f;
+    ray.max_t = scene::Ray_max_t;
+    ray.depth = 0;
+    ray.time  = 0;
+
+    return ray;
+}
+
+static bool check(char const* name, shape::Intersection const& intersection) {
+    bool const passed = math::squared_length(intersection.dpdu) > 0.f &&
+                        math::squared_length(intersection.dpdv) > 0.f;
+
+    std::cout << name << ": dpdu " << intersection.dpdu << " dpdv " << intersection.dpdv
+              << (passed ? "" : " FAILED") << std::endl;
+
+    return passed;
+}
+
+void differentials() {
+    std::cout << "scene::prop::testing::differentials()" << std::endl;
+
+    // The plane is hit first, the sphere lies behind it and the sky is always missed after a hit
+    Prop plane;
+    init(plane, std::make_shared<shape::Plane>(), float3(0.f));
+
+    Prop sphere;
+    init(sphere, std::make_shared<shape::Sphere>(), float3(0.f, 0.f, -10.f));
+
+    Prop sky;
+    init(sky, std::make_shared<shape::Infinite_sphere>(), float3(0.f));
+
+    Prop const* props[] = {&plane, &sphere, &sky};
+
+    shape::Node_stack node_stack(128);
+
+    bool passed = true;
+
+    {
+        Ray                 ray = ray_to_plane(0.f);
+        shape::Intersection intersection;
+
+        for (auto p : props) {
+            p->intersect(ray, node_stack, intersection);
+        }
+
+        passed &= check("intersect", intersection);
+    }
+
+    {
+        Ray                 rays[math::Ray_packet::Size];
+        shape::Intersection intersections[math::Ray_packet::Size];
+
+        for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+            rays[i] = ray_to_plane(0.25f * static_cast<float>(i));
+        }
+
+        for (auto p : props) {
+            p->intersect(rays, math::Ray_packet::All, node_stack, intersections);
+        }
+
+        for (auto const& intersection : intersections) {
+            passed &= check("packet", intersection);
+        }
+    }
+
+    std::cout << (passed ? "All differentials passed" : "Some differentials FAILED") << std::endl;
+}
+
+}  // namespace scene::prop::testing
@@ -0,0 +1,11 @@
+#ifndef SU_CORE_SCENE_PROP_TEST_HPP
+#define SU_CORE_SCENE_PROP_TEST_HPP
+
+namespace scene::prop::testing {
+
+// The differentials of the closest hit must survive the props that are tested after it
+void differentials();
+
+}  // namespace scene::prop::testing
+
+#endif
@@ -127,6 +127,16 @@ bool Scene::intersect_p(Ray const& ray, Node_stack& node_stack) const noexcept {
     return prop_bvh_.intersect_p(ray, node_stack);
 }
 
+uint32_t Scene::intersect(Ray* rays, uint32_t mask, Node_stack& node_stack,
+                          prop::Intersection* intersections) const noexcept {
+    return prop_bvh_.intersect(rays, mask, node_stack, intersections);
+}
+
+uint32_t Scene::intersect_p(Ray const* rays, uint32_t mask, Node_stack& node_stack) const
+    noexcept {
+    return prop_bvh_.intersect_p(rays, mask, node_stack);
+}
+
 bool Scene::opacity(Ray const& ray, Filter filter, Worker const& worker, float& o) const noexcept {
     if (has_masked_material_) {
         return prop_bvh_.opacity(ray, filter, worker, o);
@@ -193,6 +203,24 @@ Scene::Light Scene::random_light(float random) const noexcept {
     return {*lights_[l.offset], l.pdf};
 }
 
+Scene::Light Scene::random_light(float3 const& p, float3 const& n, bool total_sphere,
+                                 float random) const noexcept {
+    SOFT_ASSERT(!lights_.empty());
+
+    auto const l = light_tree_.random_light(p, n, total_sphere, random);
+
+    SOFT_ASSERT(l.offset < static_cast<uint32_t>(lights_.size()));
+
+    return {*lights_[l.offset], l.pdf};
+}
+
+Scene::Light Scene::light(uint32_t id, float3 const& p, float3 const& n, bool total_sphere) const
+    noexcept {
+    SOFT_ASSERT(!lights_.empty() && light::Light::is_light(id));
+
+    return {*lights_[id], light_tree_.pdf(id, p, n, total_sphere)};
+}
+
 void Scene::simulate(uint64_t start, uint64_t end, thread::Pool& thread_pool) noexcept {
     uint64_t const frames_start = start - (start % tick_duration_);
     uint64_t const end_rem      = end % tick_duration_;
@@ -242,12 +270,12 @@ void Scene::compile(uint64_t time, thread::Pool& pool) noexcept {
         v->set_visible_in_shadow(false);
     }
 
-    // rebuild prop BVH
-    bvh_builder_.build(prop_bvh_.tree(), finite_props_);
+    // refit or rebuild prop BVH
+    bvh_builder_.update(prop_bvh_.tree(), finite_props_, pool);
     prop_bvh_.set_infinite_props(infinite_props_);
 
-    // rebuild volume BVH
-    bvh_builder_.build(volume_bvh_.tree(), volumes_);
+    // refit or rebuild volume BVH
+    bvh_builder_.update(volume_bvh_.tree(), volumes_, pool);
     volume_bvh_.set_infinite_props(infinite_volumes_);
 
     // resort lights PDF
@@ -259,7 +287,9 @@ void Scene::compile(uint64_t time, thread::Pool& pool) noexcept {
         light_powers_.push_back(std::sqrt(spectrum::luminance(l->power(prop_bvh_.aabb()))));
     }
 
-    light_distribution_.init(light_powers_.data(), light_powers_.size());
+    light_distribution_.init(light_powers_.data(), static_cast<uint32_t>(light_powers_.size()));
+
+    light_tree_builder_.build(light_tree_, lights_, prop_bvh_.aabb(), time);
 
     has_volumes_ = !volumes_.empty() || !infinite_volumes_.empty();
 }
@@ -369,7 +399,7 @@ size_t Scene::num_bytes() const noexcept {
         num_bytes += p->num_bytes();
     }
 
-    return num_bytes + sizeof(*this);
+    return num_bytes + light_tree_.num_bytes() + sizeof(*this);
 }
 
 void Scene::add_named_entity(Entity* entity, std::string const& name) noexcept {
@@ -3,9 +3,13 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 #include "base/math/distribution/distribution_1d.hpp"
 #include "bvh/scene_bvh_builder.hpp"
+#include "light/light_tree.hpp"
+#include "light/light_tree_builder.hpp"
 #include "light/null_light.hpp"
 #include "material/material.hpp"
 #include "prop/prop_bvh_wrapper.hpp"
@@ -87,6 +91,11 @@ class Scene {
 
     bool intersect_p(Ray const& ray, Node_stack& node_stack) const noexcept;
 
+    uint32_t intersect(Ray* rays, uint32_t mask, Node_stack& node_stack,
+                       prop::Intersection* intersections) const noexcept;
+
+    uint32_t intersect_p(Ray const* rays, uint32_t mask, Node_stack& node_stack) const noexcept;
+
     bool opacity(Ray const& ray, Filter filter, Worker const& worker, float& o) const noexcept;
 
     bool thin_absorption(Ray const& ray, Filter filter, Worker const& worker, float3& ta) const
@@ -105,6 +114,14 @@ class Scene {
 
     Light random_light(float random) const noexcept;
 
+    // Importance sampled for the shading point with the light tree, instead of by power alone.
+    // The pdf is 0 if no light can contribute.
+    Light random_light(float3 const& p, float3 const& n, bool total_sphere, float random) const
+        noexcept;
+
+    // The pdf of picking the light with the light tree
+    Light light(uint32_t id, float3 const& p, float3 const& n, bool total_sphere) const noexcept;
+
     void simulate(uint64_t start, uint64_t end, thread::Pool& thread_pool) noexcept;
 
     void compile(uint64_t time, thread::Pool& pool) noexcept;
@@ -170,7 +187,11 @@ class Scene {
 
     std::vector<float> light_powers_;
 
-    math::Distribution_1D light_distribution_;
+    math::Distribution_alias_1D light_distribution_;
+
+    light::Tree_builder light_tree_builder_;
+
+    light::Tree light_tree_;
 
     std::vector<Material_ptr> materials_;
 
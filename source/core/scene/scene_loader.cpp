@@ -27,6 +27,7 @@
 #include "shape/sphere.hpp"
 #include "shape/triangle/triangle_mesh.hpp"
 #include "shape/triangle/triangle_mesh_generator.hpp"
+#include "shape/triangle/triangle_mesh_provider.hpp"
 #include "take/take.hpp"
 
 namespace scene {
@@ -317,7 +318,17 @@ Scene::Shape_ptr Loader::load_shape(json::Value const& shape_value) {
     }
 
     if (std::string const file = json::read_string(shape_value, "file"); !file.empty()) {
-        return resource_manager_.load<shape::Shape>(file);
+        memory::Variant_map options;
+
+        if (std::string const bvh = json::read_string(shape_value, "bvh"); "Wide" == bvh) {
+            options.set("bvh_preset", shape::triangle::Provider::BVH_preset::Wide);
+        } else if ("Compressed" == bvh) {
+            options.set("bvh_preset", shape::triangle::Provider::BVH_preset::Compressed);
+        } else if ("Binary" == bvh) {
+            options.set("bvh_preset", shape::triangle::Provider::BVH_preset::Binary);
+        }
+
+        return resource_manager_.load<shape::Shape>(file, options);
     }
 
     logging::error("Cannot create shape: Neither shape nor type.");
@@ -14,6 +14,11 @@ struct Ray : public math::Ray {
     uint64_t time;
 
     float wavelength;
+
+    // Ray cone for the footprint of texture lookups:
+    // The width at the origin and the angle by which it grows with the distance
+    float cone_width;
+    float cone_spread;
 };
 
 }  // namespace scene
@@ -11,7 +11,9 @@ inline Ray::Ray(float3 const& origin, float3 const& direction, float min_t, floa
                 float wavelength /*, Properties properties*/) noexcept
     : math::Ray(origin, direction, min_t, max_t, depth),
       time(time),
-      wavelength(wavelength) /*, properties(properties)*/ {}
+      wavelength(wavelength),
+      cone_width(0.f),
+      cone_spread(0.f) /*, properties(properties)*/ {}
 }  // namespace scene
 
 #endif
@@ -2,6 +2,7 @@
 #define SU_CORE_SCENE_RENDERSTATE_HPP
 
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 
 namespace scene {
 
@@ -21,6 +22,7 @@ struct Renderstate {
     float3 t, b, n;  // interpolated tangent frame in world space
     float3 geo_n;    // geometry normal in world space
     float2 uv;       // texture coordinates
+    float4 duv;      // footprint of the texture lookup, (du/dx, dv/dx, du/dy, dv/dy)
 
     uint64_t time;
 
@@ -86,6 +86,14 @@ bool Worker::visibility(Ray const& ray) const noexcept {
     return !scene_->intersect_p(ray, node_stack_);
 }
 
+uint32_t Worker::intersect(Ray* rays, uint32_t mask, Intersection* intersections) const noexcept {
+    return scene_->intersect(rays, mask, node_stack_, intersections);
+}
+
+uint32_t Worker::visibility(Ray const* rays, uint32_t mask) const noexcept {
+    return mask & ~scene_->intersect_p(rays, mask, node_stack_);
+}
+
 bool Worker::masked_visibility(Ray const& ray, Filter filter, float& mv) const noexcept {
     if (float o; scene_->opacity(ray, filter, *this, o)) {
         mv = 1.f - o;
@@ -55,6 +55,12 @@ class Worker {
 
     bool visibility(Ray const& ray) const noexcept;
 
+    // Packet versions for the rays selected by mask, returning the mask of the rays that hit
+    uint32_t intersect(Ray* rays, uint32_t mask, Intersection* intersections) const noexcept;
+
+    // Returns the mask of the rays that are not occluded
+    uint32_t visibility(Ray const* rays, uint32_t mask) const noexcept;
+
     bool masked_visibility(Ray const& ray, Filter filter, float& mv) const noexcept;
 
     Scene const& scene() const noexcept;
@@ -3,6 +3,7 @@
 #include "base/math/matrix3x3.inl"
 #include "base/math/sampling.inl"
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 #include "sampler/sampler.hpp"
 #include "scene/entity/composed_transformation.hpp"
 #include "scene/scene_ray.inl"
@@ -328,6 +329,10 @@ float Disk::area(uint32_t /*part*/, float3 const& scale) const noexcept {
     return math::Pi * scale[0] * scale[0];
 }
 
+float4 Disk::cone(uint32_t /*part*/, Transformation const& transformation) const noexcept {
+    return float4(transformation.rotation.r[2], 1.f);
+}
+
 size_t Disk::num_bytes() const noexcept {
     return sizeof(*this);
 }
@@ -60,6 +60,8 @@ class Disk final : public Shape {
 
     float area(uint32_t part, float3 const& scale) const noexcept override final;
 
+    float4 cone(uint32_t part, Transformation const& transformation) const noexcept override final;
+
     size_t num_bytes() const noexcept override final;
 };
 
@@ -20,6 +20,12 @@ class Node_stack {
 
     uint32_t pop() noexcept;
 
+    // Traversals that return early leave their nodes on the stack,
+    // which can be discarded by restoring the size from before the traversal
+    uint32_t size() const noexcept;
+
+    void restore(uint32_t size) noexcept;
+
     size_t num_bytes() const noexcept;
 
   private:
@@ -32,6 +32,15 @@ inline uint32_t Node_stack::pop() noexcept {
     return stack_[--end_];
 }
 
+inline uint32_t Node_stack::size() const noexcept {
+    return end_;
+}
+
+inline void Node_stack::restore(uint32_t size) noexcept {
+    SOFT_ASSERT(size <= end_);
+    end_ = size;
+}
+
 inline size_t Node_stack::num_bytes() const noexcept {
     return sizeof(*this) + static_cast<size_t>(num_elements_) * sizeof(uint32_t);
 }
@@ -36,6 +36,8 @@ bool Plane::intersect(Ray& ray, Transformation const& transformation, Node_stack
         intersection.geo_n = normal;
         intersection.uv[0] = math::dot(t, p) * transformation.scale[0];
         intersection.uv[1] = math::dot(b, p) * transformation.scale[1];
+        intersection.dpdu  = t / transformation.scale[0];
+        intersection.dpdv  = b / transformation.scale[1];
 
         intersection.part = 0;
 
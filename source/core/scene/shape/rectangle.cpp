@@ -3,6 +3,7 @@
 #include "base/math/matrix3x3.inl"
 #include "base/math/sampling.inl"
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
 #include "sampler/sampler.hpp"
 #include "scene/entity/composed_transformation.hpp"
 #include "scene/scene_ray.inl"
@@ -378,6 +379,10 @@ float Rectangle::area(uint32_t /*part*/, float3 const& scale) const noexcept {
     return 4.f * scale[0] * scale[1];
 }
 
+float4 Rectangle::cone(uint32_t /*part*/, Transformation const& transformation) const noexcept {
+    return float4(transformation.rotation.r[2], 1.f);
+}
+
 size_t Rectangle::num_bytes() const noexcept {
     return sizeof(*this);
 }
@@ -1,7 +1,11 @@
 #include "shape.hpp"
 #include "base/math/aabb.inl"
 #include "base/math/matrix3x3.inl"
+#include "base/math/ray_packet.hpp"
 #include "base/math/vector3.inl"
+#include "base/math/vector4.inl"
+#include "scene/scene_ray.hpp"
+#include "shape_intersection.hpp"
 
 namespace scene::shape {
 
@@ -32,6 +36,33 @@ uint32_t Shape::num_parts() const noexcept {
     return 1;
 }
 
+uint32_t Shape::intersect(Ray* rays, uint32_t mask, Transformation const& transformation,
+                          Node_stack& node_stack, Intersection* intersections) const noexcept {
+    uint32_t hits = 0;
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if ((mask & (1u << i)) &&
+            intersect(rays[i], transformation, node_stack, intersections[i])) {
+            hits |= 1u << i;
+        }
+    }
+
+    return hits;
+}
+
+uint32_t Shape::intersect_p(Ray const* rays, uint32_t mask, Transformation const& transformation,
+                            Node_stack& node_stack) const noexcept {
+    uint32_t hits = 0;
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if ((mask & (1u << i)) && intersect_p(rays[i], transformation, node_stack)) {
+            hits |= 1u << i;
+        }
+    }
+
+    return hits;
+}
+
 // bool Shape::intersect_p(FVector ray_origin, FVector ray_direction,
 //						FVector ray_min_t, FVector ray_max_t,
 //						Transformation const& transformation,
@@ -43,6 +74,10 @@ bool Shape::is_complex() const noexcept {
     return false;
 }
 
+float4 Shape::cone(uint32_t /*part*/, Transformation const& /*transformation*/) const noexcept {
+    return float4(0.f, 0.f, 1.f, -1.f);
+}
+
 bool Shape::is_finite() const noexcept {
     return true;
 }
@@ -61,6 +61,15 @@ class Shape {
     virtual bool intersect_p(Ray const& ray, Transformation const& transformation,
                              Node_stack& node_stack) const noexcept = 0;
 
+    // Packet versions for the rays selected by mask, returning the mask of the rays that hit.
+    // By default the rays are traced one by one.
+    virtual uint32_t intersect(Ray* rays, uint32_t mask, Transformation const& transformation,
+                               Node_stack& node_stack, Intersection* intersections) const noexcept;
+
+    virtual uint32_t intersect_p(Ray const* rays, uint32_t mask,
+                                 Transformation const& transformation,
+                                 Node_stack& node_stack) const noexcept;
+
     //	virtual bool intersect_p(FVector ray_origin, FVector ray_direction,
     //							 FVector ray_min_t, FVector ray_max_t,
     //							 Transformation const& transformation,
@@ -113,6 +122,10 @@ class Shape {
 
     virtual float area(uint32_t part, float3 const& scale) const noexcept = 0;
 
+    // Axis and cosine of the opening angle of a cone around the normals of the given part.
+    // By default the cone covers the whole sphere.
+    virtual float4 cone(uint32_t part, Transformation const& transformation) const noexcept;
+
     virtual bool is_complex() const noexcept;
     virtual bool is_finite() const noexcept;
     virtual bool is_analytical() const noexcept;
@@ -11,6 +11,8 @@ struct Intersection {
     float3 geo_n;    // geometry normal in world space
     float3 t, b, n;  // interpolated tangent frame in world space
     float2 uv;       // texture coordinates
+    float3 dpdu;     // derivatives of the position in world space, zero if not supported
+    float3 dpdv;
 
     float    epsilon;
     uint32_t part;
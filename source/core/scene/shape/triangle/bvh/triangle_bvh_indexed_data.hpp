@@ -1,8 +1,11 @@
 #ifndef SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_INDEXED_DATA_HPP
 #define SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_INDEXED_DATA_HPP
 
+#include <iosfwd>
 #include <vector>
+#include "base/math/aabb.hpp"
 #include "base/math/ray.hpp"
+#include "base/math/ray_packet.hpp"
 #include "base/math/vector3.hpp"
 #include "base/simd/simd.hpp"
 
@@ -44,6 +47,12 @@ class Indexed_data {
     bool intersect_p(FVector origin, FVector direction, FVector min_t, FVector max_t,
                      uint32_t index) const noexcept;
 
+    uint32_t intersect(math::Ray_packet& packet, uint32_t mask, uint32_t index, float u[4],
+                       float v[4]) const noexcept;
+
+    uint32_t intersect_p(math::Ray_packet const& packet, uint32_t mask, uint32_t index) const
+        noexcept;
+
     void interpolate_data(uint32_t index, float2 uv, float3& n, float3& t, float2& tc) const
         noexcept;
 
@@ -69,6 +78,10 @@ class Indexed_data {
 
     float area(uint32_t index, float3 const& scale) const noexcept;
 
+    // Partial derivatives of the position with respect to the texture coordinates,
+    // zero for triangles with degenerate texture coordinates
+    void differentials(uint32_t index, float3& dpdu, float3& dpdv) const noexcept;
+
     void sample(uint32_t index, float2 r2, float3& p, float2& tc) const noexcept;
 
     void allocate_triangles(uint32_t num_triangles, Vertices const& vertices) noexcept;
@@ -78,6 +91,15 @@ class Indexed_data {
 
     size_t num_bytes() const noexcept;
 
+    math::AABB aabb(uint32_t index) const noexcept;
+
+    // Replaces the vertices in [begin, end), while the triangles stay as they are
+    void update_vertices(Vertices const& vertices, uint32_t begin, uint32_t end) noexcept;
+
+    void write(std::ostream& stream) const noexcept;
+
+    bool read(std::istream& stream, Vertices const& vertices) noexcept;
+
     struct alignas(16) Index_triangle {
         Index_triangle(uint32_t a, uint32_t b, uint32_t c, float bitangent_sign,
                        uint32_t material_index) noexcept;
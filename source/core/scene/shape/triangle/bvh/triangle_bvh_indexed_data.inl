@@ -1,6 +1,10 @@
 #ifndef SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_INDEXED_DATA_INL
 #define SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_INDEXED_DATA_INL
 
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include "base/math/aabb.inl"
 #include "base/math/sampling.inl"
 #include "base/memory/align.hpp"
 #include "scene/shape/triangle/triangle_primitive_mt.inl"
@@ -94,6 +98,30 @@ bool Indexed_data<SV>::intersect_p(FVector origin, FVector direction, FVector mi
     return triangle::intersect_p(origin, direction, min_t, max_t, a, b, c);
 }
 
+template <typename SV>
+uint32_t Indexed_data<SV>::intersect(math::Ray_packet& packet, uint32_t mask, uint32_t index,
+                                     float u[4], float v[4]) const noexcept {
+    auto const tri = triangles_[index];
+
+    float const* a = intersection_vertices_[tri.a].v;
+    float const* b = intersection_vertices_[tri.b].v;
+    float const* c = intersection_vertices_[tri.c].v;
+
+    return triangle::intersect(packet, mask, a, b, c, u, v);
+}
+
+template <typename SV>
+uint32_t Indexed_data<SV>::intersect_p(math::Ray_packet const& packet, uint32_t mask,
+                                       uint32_t index) const noexcept {
+    auto const tri = triangles_[index];
+
+    float const* a = intersection_vertices_[tri.a].v;
+    float const* b = intersection_vertices_[tri.b].v;
+    float const* c = intersection_vertices_[tri.c].v;
+
+    return triangle::intersect_p(packet, mask, a, b, c);
+}
+
 template <typename SV>
 void Indexed_data<SV>::interpolate_data(uint32_t index, float2 uv, float3& n, float3& t,
                                         float2& tc) const noexcept {
@@ -213,6 +241,42 @@ float Indexed_data<SV>::area(uint32_t index, float3 const& scale) const noexcept
     return triangle::area(a, b, c, scale);
 }
 
+template <typename SV>
+void Indexed_data<SV>::differentials(uint32_t index, float3& dpdu, float3& dpdv) const noexcept {
+    auto const tri = triangles_[index];
+
+    float3 const a = intersection_vertices_[tri.a];
+    float3 const b = intersection_vertices_[tri.b];
+    float3 const c = intersection_vertices_[tri.c];
+
+    SV const& sa = shading_vertices_[tri.a];
+    SV const& sb = shading_vertices_[tri.b];
+    SV const& sc = shading_vertices_[tri.c];
+
+    float2 const uva = triangle::interpolate_uv(sa, sb, sc, float2(0.f, 0.f));
+    float2 const uvb = triangle::interpolate_uv(sa, sb, sc, float2(1.f, 0.f));
+    float2 const uvc = triangle::interpolate_uv(sa, sb, sc, float2(0.f, 1.f));
+
+    float2 const duvac = uva - uvc;
+    float2 const duvbc = uvb - uvc;
+
+    float const determinant = duvac[0] * duvbc[1] - duvac[1] * duvbc[0];
+
+    if (std::abs(determinant) < 1e-12f) {
+        dpdu = float3(0.f);
+        dpdv = float3(0.f);
+        return;
+    }
+
+    float3 const dpac = a - c;
+    float3 const dpbc = b - c;
+
+    float const id = 1.f / determinant;
+
+    dpdu = id * (duvbc[1] * dpac - duvac[1] * dpbc);
+    dpdv = id * (duvac[0] * dpbc - duvbc[0] * dpac);
+}
+
 template <typename SV>
 void Indexed_data<SV>::sample(uint32_t index, float2 r2, float3& p, float2& tc) const noexcept {
     SOFT_ASSERT(index < num_triangles_);
@@ -282,6 +346,64 @@ size_t Indexed_data<SV>::num_bytes() const noexcept {
            num_vertices_ * (sizeof(float3) + sizeof(SV));
 }
 
+template <typename SV>
+math::AABB Indexed_data<SV>::aabb(uint32_t index) const noexcept {
+    auto const tri = triangles_[index];
+
+    float3 const a = intersection_vertices_[tri.a];
+    float3 const b = intersection_vertices_[tri.b];
+    float3 const c = intersection_vertices_[tri.c];
+
+    return math::AABB(math::min(a, math::min(b, c)), math::max(a, math::max(b, c)));
+}
+
+template <typename SV>
+void Indexed_data<SV>::update_vertices(Vertices const& vertices, uint32_t begin,
+                                       uint32_t end) noexcept {
+    for (uint32_t i = begin; i < end; ++i) {
+        intersection_vertices_[i] = float3(vertices[i].p);
+
+        shading_vertices_[i] = SV(vertices[i].n, vertices[i].t, vertices[i].uv);
+    }
+}
+
+template <typename SV>
+void Indexed_data<SV>::write(std::ostream& stream) const noexcept {
+    stream.write(reinterpret_cast<char const*>(&num_triangles_), sizeof(uint32_t));
+    stream.write(reinterpret_cast<char const*>(triangles_),
+                 num_triangles_ * sizeof(Index_triangle));
+}
+
+template <typename SV>
+bool Indexed_data<SV>::read(std::istream& stream, Vertices const& vertices) noexcept {
+    uint32_t num_triangles = 0;
+    stream.read(reinterpret_cast<char*>(&num_triangles), sizeof(uint32_t));
+
+    if (!stream) {
+        return false;
+    }
+
+    allocate_triangles(num_triangles, vertices);
+
+    stream.read(reinterpret_cast<char*>(triangles_), num_triangles * sizeof(Index_triangle));
+
+    if (!stream) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < num_triangles; ++i) {
+        auto const& tri = triangles_[i];
+
+        if (tri.a >= num_vertices_ || tri.b >= num_vertices_ || tri.c >= num_vertices_) {
+            return false;
+        }
+    }
+
+    current_triangle_ = num_triangles;
+
+    return true;
+}
+
 template <typename SV>
 Indexed_data<SV>::Index_triangle::Index_triangle(uint32_t a, uint32_t b, uint32_t c,
                                                  float    bitangent_sign,
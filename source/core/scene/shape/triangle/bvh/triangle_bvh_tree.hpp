@@ -1,19 +1,28 @@
 #ifndef SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_TREE_HPP
 #define SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_TREE_HPP
 
+#include <iosfwd>
+#include <vector>
 #include "base/math/aabb.hpp"
 #include "base/math/vector3.hpp"
 #include "scene/material/material.hpp"
 
 namespace math {
 struct Ray;
+struct Ray_packet;
+}  // namespace math
+
+namespace thread {
+class Pool;
 }
 
 namespace scene {
 
 namespace bvh {
 class Node;
-}
+class Node4;
+class Compressed_node4;
+}  // namespace bvh
 
 class Worker;
 
@@ -39,10 +48,20 @@ class Tree {
 
     ~Tree() noexcept;
 
-    using Node = scene::bvh::Node;
+    using Node  = scene::bvh::Node;
+    using Node4            = scene::bvh::Node4;
+    using Compressed_node4 = scene::bvh::Compressed_node4;
 
     Node* allocate_nodes(uint32_t num_nodes) noexcept;
 
+    // Collapses the binary hierarchy into 4-wide nodes, which are used for traversal afterwards
+    void collapse() noexcept;
+
+    // Collapses the binary hierarchy as above, and quantizes the bounds of the 4-wide nodes
+    void compress() noexcept;
+
+    bool is_wide() const noexcept;
+
     math::AABB aabb() const noexcept;
 
     uint32_t num_parts() const noexcept;
@@ -71,6 +90,14 @@ class Tree {
                      FVector ray_min_t, FVector ray_max_t, uint32_t ray_signs[4],
                      Node_stack& node_stack) const noexcept;
 
+    // Packet versions for the rays selected by mask, that share the node visits.
+    // Return the mask of the rays that hit a triangle.
+    uint32_t intersect(math::Ray_packet& packet, uint32_t mask, Node_stack& node_stack,
+                       Intersection intersections[4]) const noexcept;
+
+    uint32_t intersect_p(math::Ray_packet const& packet, uint32_t mask,
+                         Node_stack& node_stack) const noexcept;
+
     float opacity(math::Ray& ray, uint64_t time, Materials const& materials,
                   material::Sampler_settings::Filter filter, Worker const& worker) const noexcept;
 
@@ -101,6 +128,8 @@ class Tree {
     float triangle_area(uint32_t index) const noexcept;
     float triangle_area(uint32_t index, float3 const& scale) const noexcept;
 
+    void triangle_differentials(uint32_t index, float3& dpdu, float3& dpdv) const noexcept;
+
     void sample(uint32_t index, float2 r2, float3& p, float3& n, float2& tc) const noexcept;
     void sample(uint32_t index, float2 r2, float3& p, float2& tc) const noexcept;
     void sample(uint32_t index, float2 r2, float3& p) const noexcept;
@@ -114,10 +143,61 @@ class Tree {
 
     size_t num_bytes() const noexcept;
 
+    // Fits the bounds of the binary hierarchy to the new vertices, without changing its topology
+    void refit(std::vector<Vertex> const& vertices, thread::Pool& pool) noexcept;
+
+    // Surface area heuristic cost of the binary hierarchy, relative to the area of the root
+    float sah_cost() const noexcept;
+
+    // Serializes the binary hierarchy together with the triangle data in its final order
+    void write(std::ostream& stream) const noexcept;
+
+    // Counterpart of write(), the vertices must be the ones the hierarchy was built with
+    bool read(std::istream& stream, std::vector<Vertex> const& vertices) noexcept;
+
   private:
+    void collapse(uint32_t source, uint32_t target, std::vector<Node4>& wide_nodes) const noexcept;
+
+    template <typename Wide_node>
+    bool intersect_4(Wide_node const* nodes, FVector ray_origin, FVector ray_direction,
+                     FVector ray_inv_direction, FVector ray_min_t, Vector& ray_max_t,
+                     uint32_t const ray_signs[4], Node_stack& node_stack,
+                     Intersection& intersection) const noexcept;
+
+    template <typename Wide_node>
+    bool intersect_4(Wide_node const* nodes, FVector ray_origin, FVector ray_direction,
+                     FVector ray_inv_direction, FVector ray_min_t, Vector& ray_max_t,
+                     uint32_t const ray_signs[4], Node_stack& node_stack) const noexcept;
+
+    template <typename Wide_node>
+    bool intersect_p_4(Wide_node const* nodes, FVector ray_origin, FVector ray_direction,
+                       FVector ray_inv_direction, FVector ray_min_t, FVector ray_max_t,
+                       uint32_t const ray_signs[4], Node_stack& node_stack) const noexcept;
+
+    template <typename Wide_node>
+    float opacity_4(Wide_node const* nodes, math::Ray& ray, uint64_t time,
+                    Materials const& materials, material::Sampler_settings::Filter filter,
+                    Worker const& worker) const noexcept;
+
+    template <typename Wide_node>
+    float3 absorption_4(Wide_node const* nodes, math::Ray& ray, uint64_t time,
+                        Materials const& materials, material::Sampler_settings::Filter filter,
+                        Worker const& worker) const noexcept;
+
+    math::AABB refit(uint32_t n, uint32_t depth, thread::Pool& pool) noexcept;
+
+    static uint32_t next_node(uint32_t const* inner, uint32_t num_inner,
+                              Node_stack& node_stack) noexcept;
+
     uint32_t num_nodes_;
     Node*    nodes_;
 
+    uint32_t num_wide_nodes_;
+    Node4*   wide_nodes_;
+
+    uint32_t          num_compressed_nodes_;
+    Compressed_node4* compressed_nodes_;
+
     uint32_t  num_parts_;
     uint32_t* num_part_triangles_;
 
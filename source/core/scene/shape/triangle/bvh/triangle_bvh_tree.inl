@@ -1,11 +1,18 @@
 #ifndef SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_TREE_INL
 #define SU_CORE_SCENE_SHAPE_TRIANGLE_BVH_TREE_INL
 
+#include <algorithm>
+#include <istream>
+#include <ostream>
 #include "base/math/aabb.inl"
 #include "base/math/ray.hpp"
+#include "base/math/ray_packet.inl"
 #include "base/math/vector3.inl"
 #include "base/memory/align.hpp"
+#include "base/thread/thread_pool.hpp"
+#include "scene/bvh/scene_bvh_compressed_node4.inl"
 #include "scene/bvh/scene_bvh_node.inl"
+#include "scene/bvh/scene_bvh_node4.inl"
 #include "scene/scene_worker.hpp"
 #include "scene/shape/node_stack.inl"
 #include "scene/shape/triangle/triangle_intersection.hpp"
@@ -15,17 +22,35 @@ namespace scene::shape::triangle::bvh {
 
 template <typename Data>
 Tree<Data>::Tree() noexcept
-    : num_nodes_(0), nodes_(nullptr), num_parts_(0), num_part_triangles_(nullptr) {}
+    : num_nodes_(0),
+      nodes_(nullptr),
+      num_wide_nodes_(0),
+      wide_nodes_(nullptr),
+      num_compressed_nodes_(0),
+      compressed_nodes_(nullptr),
+      num_parts_(0),
+      num_part_triangles_(nullptr) {}
 
 template <typename Data>
 Tree<Data>::~Tree() noexcept {
     delete[] num_part_triangles_;
 
+    memory::free_aligned(compressed_nodes_);
+    memory::free_aligned(wide_nodes_);
     memory::free_aligned(nodes_);
 }
 
 template <typename Data>
 scene::bvh::Node* Tree<Data>::allocate_nodes(uint32_t num_nodes) noexcept {
+    // A new binary hierarchy invalidates a previously collapsed one
+    memory::free_aligned(wide_nodes_);
+    num_wide_nodes_ = 0;
+    wide_nodes_     = nullptr;
+
+    memory::free_aligned(compressed_nodes_);
+    num_compressed_nodes_ = 0;
+    compressed_nodes_     = nullptr;
+
     if (num_nodes != num_nodes_) {
         num_nodes_ = num_nodes;
 
@@ -36,9 +61,65 @@ scene::bvh::Node* Tree<Data>::allocate_nodes(uint32_t num_nodes) noexcept {
     return nodes_;
 }
 
+template <typename Data>
+void Tree<Data>::collapse() noexcept {
+    if (!nodes_ || wide_nodes_) {
+        return;
+    }
+
+    std::vector<Node4> wide_nodes;
+    wide_nodes.reserve(num_nodes_ / 4 + 1);
+
+    wide_nodes.emplace_back();
+    collapse(0, 0, wide_nodes);
+
+    num_wide_nodes_ = static_cast<uint32_t>(wide_nodes.size());
+    wide_nodes_     = memory::allocate_aligned<Node4>(num_wide_nodes_);
+
+    std::copy(wide_nodes.begin(), wide_nodes.end(), wide_nodes_);
+
+    // The binary nodes are not needed for traversal anymore
+    memory::free_aligned(nodes_);
+    num_nodes_ = 0;
+    nodes_     = nullptr;
+}
+
+template <typename Data>
+void Tree<Data>::compress() noexcept {
+    if (compressed_nodes_) {
+        return;
+    }
+
+    collapse();
+
+    if (!wide_nodes_) {
+        return;
+    }
+
+    num_compressed_nodes_ = num_wide_nodes_;
+    compressed_nodes_     = memory::allocate_aligned<Compressed_node4>(num_compressed_nodes_);
+
+    for (uint32_t i = 0, len = num_wide_nodes_; i < len; ++i) {
+        compressed_nodes_[i].compress(wide_nodes_[i]);
+    }
+
+    memory::free_aligned(wide_nodes_);
+    num_wide_nodes_ = 0;
+    wide_nodes_     = nullptr;
+}
+
+template <typename Data>
+bool Tree<Data>::is_wide() const noexcept {
+    return nullptr != wide_nodes_ || nullptr != compressed_nodes_;
+}
+
 template <typename Data>
 math::AABB Tree<Data>::aabb() const noexcept {
-    if (nodes_) {
+    if (wide_nodes_) {
+        return wide_nodes_[0].aabb();
+    } else if (compressed_nodes_) {
+        return compressed_nodes_[0].aabb();
+    } else if (nodes_) {
         return math::AABB(float3(nodes_[0].min()), float3(nodes_[0].max()));
     } else {
         return math::AABB::empty();
@@ -68,6 +149,21 @@ uint32_t Tree<Data>::current_triangle() const noexcept {
 template <typename Data>
 bool Tree<Data>::intersect(math::Ray& ray, Node_stack& node_stack, Intersection& intersection) const
     noexcept {
+    if (is_wide()) {
+        alignas(16) uint32_t ray_signs[4] = {ray.signs[0], ray.signs[1], ray.signs[2], 0};
+
+        Vector ray_max_t = simd::load_float(&ray.max_t);
+
+        if (intersect(simd::load_float4(ray.origin.v), simd::load_float4(ray.direction.v),
+                      simd::load_float4(ray.inv_direction.v), simd::load_float(&ray.min_t),
+                      ray_max_t, ray_signs, node_stack, intersection)) {
+            _mm_store_ss(&ray.max_t, ray_max_t);
+            return true;
+        }
+
+        return false;
+    }
+
     node_stack.push(0xFFFFFFFF);
     uint32_t n = 0;
 
@@ -121,6 +217,21 @@ bool Tree<Data>::intersect(math::Ray& ray, Node_stack& node_stack, Intersection&
 
 template <typename Data>
 bool Tree<Data>::intersect(math::Ray& ray, Node_stack& node_stack) const noexcept {
+    if (is_wide()) {
+        alignas(16) uint32_t ray_signs[4] = {ray.signs[0], ray.signs[1], ray.signs[2], 0};
+
+        Vector ray_max_t = simd::load_float(&ray.max_t);
+
+        if (intersect(simd::load_float4(ray.origin.v), simd::load_float4(ray.direction.v),
+                      simd::load_float4(ray.inv_direction.v), simd::load_float(&ray.min_t),
+                      ray_max_t, ray_signs, node_stack)) {
+            _mm_store_ss(&ray.max_t, ray_max_t);
+            return true;
+        }
+
+        return false;
+    }
+
     node_stack.push(0xFFFFFFFF);
     uint32_t n = 0;
 
@@ -170,6 +281,16 @@ template <typename Data>
 bool Tree<Data>::intersect(FVector ray_origin, FVector ray_direction, FVector ray_inv_direction,
                            FVector ray_min_t, Vector& ray_max_t, uint32_t ray_signs[4],
                            Node_stack& node_stack, Intersection& intersection) const noexcept {
+    if (wide_nodes_) {
+        return intersect_4(wide_nodes_, ray_origin, ray_direction, ray_inv_direction, ray_min_t,
+                           ray_max_t, ray_signs, node_stack, intersection);
+    }
+
+    if (compressed_nodes_) {
+        return intersect_4(compressed_nodes_, ray_origin, ray_direction, ray_inv_direction,
+                           ray_min_t, ray_max_t, ray_signs, node_stack, intersection);
+    }
+
     node_stack.push(0xFFFFFFFF);
     uint32_t n = 0;
 
@@ -218,6 +339,16 @@ template <typename Data>
 bool Tree<Data>::intersect(FVector ray_origin, FVector ray_direction, FVector ray_inv_direction,
                            FVector ray_min_t, Vector& ray_max_t, uint32_t ray_signs[4],
                            Node_stack& node_stack) const noexcept {
+    if (wide_nodes_) {
+        return intersect_4(wide_nodes_, ray_origin, ray_direction, ray_inv_direction, ray_min_t,
+                           ray_max_t, ray_signs, node_stack);
+    }
+
+    if (compressed_nodes_) {
+        return intersect_4(compressed_nodes_, ray_origin, ray_direction, ray_inv_direction,
+                           ray_min_t, ray_max_t, ray_signs, node_stack);
+    }
+
     node_stack.push(0xFFFFFFFF);
     uint32_t n = 0;
 
@@ -258,6 +389,14 @@ bool Tree<Data>::intersect(FVector ray_origin, FVector ray_direction, FVector ra
 
 template <typename Data>
 bool Tree<Data>::intersect_p(math::Ray const& ray, Node_stack& node_stack) const noexcept {
+    if (is_wide()) {
+        alignas(16) uint32_t ray_signs[4] = {ray.signs[0], ray.signs[1], ray.signs[2], 0};
+
+        return intersect_p(simd::load_float4(ray.origin.v), simd::load_float4(ray.direction.v),
+                           simd::load_float4(ray.inv_direction.v), simd::load_float(&ray.min_t),
+                           simd::load_float(&ray.max_t), ray_signs, node_stack);
+    }
+
     node_stack.push(0xFFFFFFFF);
     uint32_t n = 0;
 
@@ -300,6 +439,16 @@ template <typename Data>
 bool Tree<Data>::intersect_p(FVector ray_origin, FVector ray_direction, FVector ray_inv_direction,
                              FVector ray_min_t, FVector ray_max_t, uint32_t ray_signs[4],
                              Node_stack& node_stack) const noexcept {
+    if (wide_nodes_) {
+        return intersect_p_4(wide_nodes_, ray_origin, ray_direction, ray_inv_direction, ray_min_t,
+                             ray_max_t, ray_signs, node_stack);
+    }
+
+    if (compressed_nodes_) {
+        return intersect_p_4(compressed_nodes_, ray_origin, ray_direction, ray_inv_direction,
+                             ray_min_t, ray_max_t, ray_signs, node_stack);
+    }
+
     node_stack.push(0xFFFFFFFF);
     uint32_t n = 0;
 
@@ -332,10 +481,178 @@ bool Tree<Data>::intersect_p(FVector ray_origin, FVector ray_direction, FVector
     return false;
 }
 
+template <typename Data>
+uint32_t Tree<Data>::intersect(math::Ray_packet& packet, uint32_t mask, Node_stack& node_stack,
+                               Intersection intersections[4]) const noexcept {
+    if (is_wide()) {
+        // The 4-wide nodes are already tested in parallel, so their rays are traced one by one
+        uint32_t hits = 0;
+
+        for (uint32_t l = 0; l < math::Ray_packet::Size; ++l) {
+            if (0 == (mask & (1u << l))) {
+                continue;
+            }
+
+            Vector ray_origin;
+            Vector ray_direction;
+            Vector ray_inv_direction;
+            packet.get(l, ray_origin, ray_direction, ray_inv_direction);
+
+            alignas(16) uint32_t ray_signs[4];
+            math::sign(ray_inv_direction, ray_signs);
+
+            Vector const ray_min_t = simd::load_float(&packet.min_t[l]);
+            Vector       ray_max_t = simd::load_float(&packet.max_t[l]);
+
+            if (intersect(ray_origin, ray_direction, ray_inv_direction, ray_min_t, ray_max_t,
+                          ray_signs, node_stack, intersections[l])) {
+                packet.max_t[l] = simd::get_x(ray_max_t);
+                hits |= 1u << l;
+            }
+        }
+
+        return hits;
+    }
+
+    // The first active ray decides the order in which the children are visited
+    uint32_t lead = 0;
+    for (; 0 == (mask & (1u << lead)); ++lead) {
+    }
+
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    uint32_t hits = 0;
+
+    float u[4];
+    float v[4];
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes_[n];
+
+        if (uint32_t const active = mask & node.intersect_p(packet); 0 != active) {
+            if (0 == node.num_primitives()) {
+                if (0 == packet.sign(lead, node.axis())) {
+                    node_stack.push(node.next());
+                    ++n;
+                } else {
+                    node_stack.push(n + 1);
+                    n = node.next();
+                }
+
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(), len = node.indices_end(); i < len; ++i) {
+                if (uint32_t const h = data_.intersect(packet, active, i, u, v); 0 != h) {
+                    for (uint32_t l = 0; l < math::Ray_packet::Size; ++l) {
+                        if (h & (1u << l)) {
+                            intersections[l].index = i;
+                        }
+                    }
+
+                    hits |= h;
+                }
+            }
+        }
+
+        n = node_stack.pop();
+    }
+
+    for (uint32_t l = 0; l < math::Ray_packet::Size; ++l) {
+        if (hits & (1u << l)) {
+            intersections[l].u = simd::set_float4(u[l]);
+            intersections[l].v = simd::set_float4(v[l]);
+        }
+    }
+
+    return hits;
+}
+
+template <typename Data>
+uint32_t Tree<Data>::intersect_p(math::Ray_packet const& packet, uint32_t mask,
+                                 Node_stack& node_stack) const noexcept {
+    if (is_wide()) {
+        uint32_t hits = 0;
+
+        for (uint32_t l = 0; l < math::Ray_packet::Size; ++l) {
+            if (0 == (mask & (1u << l))) {
+                continue;
+            }
+
+            Vector ray_origin;
+            Vector ray_direction;
+            Vector ray_inv_direction;
+            packet.get(l, ray_origin, ray_direction, ray_inv_direction);
+
+            alignas(16) uint32_t ray_signs[4];
+            math::sign(ray_inv_direction, ray_signs);
+
+            Vector const ray_min_t = simd::load_float(&packet.min_t[l]);
+            Vector const ray_max_t = simd::load_float(&packet.max_t[l]);
+
+            if (intersect_p(ray_origin, ray_direction, ray_inv_direction, ray_min_t, ray_max_t,
+                            ray_signs, node_stack)) {
+                hits |= 1u << l;
+            }
+        }
+
+        return hits;
+    }
+
+    uint32_t lead = 0;
+    for (; 0 == (mask & (1u << lead)); ++lead) {
+    }
+
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    uint32_t hits = 0;
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes_[n];
+
+        // Rays that are already occluded don't take part anymore
+        if (uint32_t const active = (mask & ~hits) & node.intersect_p(packet); 0 != active) {
+            if (0 == node.num_primitives()) {
+                if (0 == packet.sign(lead, node.axis())) {
+                    node_stack.push(node.next());
+                    ++n;
+                } else {
+                    node_stack.push(n + 1);
+                    n = node.next();
+                }
+
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(), len = node.indices_end(); i < len; ++i) {
+                hits |= data_.intersect_p(packet, active & ~hits, i);
+            }
+
+            if (hits == mask) {
+                return hits;
+            }
+        }
+
+        n = node_stack.pop();
+    }
+
+    return hits;
+}
+
 template <typename Data>
 float Tree<Data>::opacity(math::Ray& ray, uint64_t time, Materials const& materials,
                           material::Sampler_settings::Filter filter, Worker const& worker) const
     noexcept {
+    if (wide_nodes_) {
+        return opacity_4(wide_nodes_, ray, time, materials, filter, worker);
+    }
+
+    if (compressed_nodes_) {
+        return opacity_4(compressed_nodes_, ray, time, materials, filter, worker);
+    }
+
     auto& node_stack = worker.node_stack();
     //	node_stack.clear();
     //	node_stack.push(0);
@@ -400,6 +717,14 @@ template <typename Data>
 float3 Tree<Data>::absorption(math::Ray& ray, uint64_t time, Materials const& materials,
                               material::Sampler_settings::Filter filter, Worker const& worker) const
     noexcept {
+    if (wide_nodes_) {
+        return absorption_4(wide_nodes_, ray, time, materials, filter, worker);
+    }
+
+    if (compressed_nodes_) {
+        return absorption_4(compressed_nodes_, ray, time, materials, filter, worker);
+    }
+
     auto& node_stack = worker.node_stack();
     //	node_stack.clear();
     //	node_stack.push(0);
@@ -464,6 +789,398 @@ float3 Tree<Data>::absorption(math::Ray& ray, uint64_t time, Materials const& ma
     return absorption;
 }
 
+template <typename Data>
+void Tree<Data>::collapse(uint32_t source, uint32_t target, std::vector<Node4>& wide_nodes) const
+    noexcept {
+    wide_nodes[target].clear();
+
+    Node const& node = nodes_[source];
+
+    if (0 != node.num_primitives()) {
+        // Only happens if the root itself is a leaf
+        wide_nodes[target].set_leaf_child(0, node.min(), node.max(), node.indices_start(),
+                                          node.num_primitives());
+        return;
+    }
+
+    uint8_t axes[3] = {node.axis(), 0, 0};
+
+    uint32_t const children[2] = {source + 1, node.next()};
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        Node const& c = nodes_[children[i]];
+
+        if (0 != c.num_primitives()) {
+            wide_nodes[target].set_leaf_child(2 * i, c.min(), c.max(), c.indices_start(),
+                                              c.num_primitives());
+            continue;
+        }
+
+        axes[1 + i] = c.axis();
+
+        uint32_t const grandchildren[2] = {children[i] + 1, c.next()};
+
+        for (uint32_t j = 0; j < 2; ++j) {
+            uint32_t const slot = 2 * i + j;
+
+            Node const& g = nodes_[grandchildren[j]];
+
+            if (0 != g.num_primitives()) {
+                wide_nodes[target].set_leaf_child(slot, g.min(), g.max(), g.indices_start(),
+                                                  g.num_primitives());
+            } else {
+                uint32_t const w = static_cast<uint32_t>(wide_nodes.size());
+
+                wide_nodes[target].set_inner_child(slot, g.min(), g.max(), w);
+
+                // This invalidates references into wide_nodes, hence the indexing everywhere
+                wide_nodes.emplace_back();
+                collapse(grandchildren[j], w, wide_nodes);
+            }
+        }
+    }
+
+    wide_nodes[target].set_axes(axes[0], axes[1], axes[2]);
+}
+
+template <typename Data>
+template <typename Wide_node>
+bool Tree<Data>::intersect_4(Wide_node const* nodes, FVector ray_origin, FVector ray_direction,
+                             FVector ray_inv_direction, FVector ray_min_t, Vector& ray_max_t,
+                             uint32_t const ray_signs[4], Node_stack& node_stack,
+                             Intersection& intersection) const noexcept {
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    uint32_t index = 0xFFFFFFFF;
+
+    Vector u = simd::Zero;
+    Vector v = simd::Zero;
+
+    typename Wide_node::Ray const ray = Node4::splat(ray_origin, ray_inv_direction);
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes[n];
+
+        uint32_t       slots[4];
+        uint32_t const num_hits = node.intersect_p(ray, ray_min_t, ray_max_t, ray_signs, slots);
+
+        uint32_t inner[4];
+        uint32_t num_inner = 0;
+
+        for (uint32_t s = 0; s < num_hits; ++s) {
+            uint32_t const slot = slots[s];
+
+            if (0 == node.num_primitives(slot)) {
+                inner[num_inner++] = node.child(slot);
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(slot), len = node.indices_end(slot); i < len;
+                 ++i) {
+                if (data_.intersect(ray_origin, ray_direction, ray_min_t, ray_max_t, i, u, v)) {
+                    index = i;
+                }
+            }
+        }
+
+        n = next_node(inner, num_inner, node_stack);
+    }
+
+    if (index != 0xFFFFFFFF) {
+        intersection.u     = math::splat_x(u);
+        intersection.v     = math::splat_x(v);
+        intersection.index = index;
+        return true;
+    }
+
+    return false;
+}
+
+template <typename Data>
+template <typename Wide_node>
+bool Tree<Data>::intersect_4(Wide_node const* nodes, FVector ray_origin, FVector ray_direction,
+                             FVector ray_inv_direction, FVector ray_min_t, Vector& ray_max_t,
+                             uint32_t const ray_signs[4], Node_stack& node_stack) const noexcept {
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    uint32_t index = 0xFFFFFFFF;
+
+    typename Wide_node::Ray const ray = Node4::splat(ray_origin, ray_inv_direction);
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes[n];
+
+        uint32_t       slots[4];
+        uint32_t const num_hits = node.intersect_p(ray, ray_min_t, ray_max_t, ray_signs, slots);
+
+        uint32_t inner[4];
+        uint32_t num_inner = 0;
+
+        for (uint32_t s = 0; s < num_hits; ++s) {
+            uint32_t const slot = slots[s];
+
+            if (0 == node.num_primitives(slot)) {
+                inner[num_inner++] = node.child(slot);
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(slot), len = node.indices_end(slot); i < len;
+                 ++i) {
+                if (data_.intersect(ray_origin, ray_direction, ray_min_t, ray_max_t, i)) {
+                    index = i;
+                }
+            }
+        }
+
+        n = next_node(inner, num_inner, node_stack);
+    }
+
+    return index != 0xFFFFFFFF;
+}
+
+template <typename Data>
+template <typename Wide_node>
+bool Tree<Data>::intersect_p_4(Wide_node const* nodes, FVector ray_origin, FVector ray_direction,
+                               FVector ray_inv_direction, FVector ray_min_t, FVector ray_max_t,
+                               uint32_t const ray_signs[4], Node_stack& node_stack) const
+    noexcept {
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    typename Wide_node::Ray const ray = Node4::splat(ray_origin, ray_inv_direction);
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes[n];
+
+        uint32_t       slots[4];
+        uint32_t const num_hits = node.intersect_p(ray, ray_min_t, ray_max_t, ray_signs, slots);
+
+        uint32_t inner[4];
+        uint32_t num_inner = 0;
+
+        for (uint32_t s = 0; s < num_hits; ++s) {
+            uint32_t const slot = slots[s];
+
+            if (0 == node.num_primitives(slot)) {
+                inner[num_inner++] = node.child(slot);
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(slot), len = node.indices_end(slot); i < len;
+                 ++i) {
+                if (data_.intersect_p(ray_origin, ray_direction, ray_min_t, ray_max_t, i)) {
+                    return true;
+                }
+            }
+        }
+
+        n = next_node(inner, num_inner, node_stack);
+    }
+
+    return false;
+}
+
+template <typename Data>
+template <typename Wide_node>
+float Tree<Data>::opacity_4(Wide_node const* nodes, math::Ray& ray, uint64_t time,
+                            Materials const& materials, material::Sampler_settings::Filter filter,
+                            Worker const& worker) const noexcept {
+    auto& node_stack = worker.node_stack();
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    float opacity = 0.f;
+
+    alignas(16) uint32_t const ray_signs[4] = {ray.signs[0], ray.signs[1], ray.signs[2], 0};
+
+    Vector const ray_origin        = simd::load_float4(ray.origin.v);
+    Vector const ray_direction     = simd::load_float4(ray.direction.v);
+    Vector const ray_inv_direction = simd::load_float4(ray.inv_direction.v);
+    Vector const ray_min_t         = simd::load_float(&ray.min_t);
+    Vector       ray_max_t         = simd::load_float(&ray.max_t);
+    Vector const max_t             = ray_max_t;
+
+    Vector u = simd::Zero;
+    Vector v = simd::Zero;
+
+    typename Wide_node::Ray const simd_ray = Node4::splat(ray_origin, ray_inv_direction);
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes[n];
+
+        uint32_t       slots[4];
+        uint32_t const num_hits = node.intersect_p(simd_ray, ray_min_t, ray_max_t, ray_signs,
+                                                   slots);
+
+        uint32_t inner[4];
+        uint32_t num_inner = 0;
+
+        for (uint32_t s = 0; s < num_hits; ++s) {
+            uint32_t const slot = slots[s];
+
+            if (0 == node.num_primitives(slot)) {
+                inner[num_inner++] = node.child(slot);
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(slot), len = node.indices_end(slot); i < len;
+                 ++i) {
+                if (data_.intersect(ray_origin, ray_direction, ray_min_t, ray_max_t, i, u, v)) {
+                    u         = math::splat_x(u);
+                    v         = math::splat_x(v);
+                    float2 uv = data_.interpolate_uv(u, v, i);
+
+                    auto const material = materials[data_.material_index(i)];
+
+                    opacity += (1.f - opacity) * material->opacity(uv, time, filter, worker);
+                    if (opacity >= 1.f) {
+                        return 1.f;
+                    }
+
+                    // ray_max_t has changed if intersect() returns true!
+                    ray_max_t = max_t;
+                }
+            }
+        }
+
+        n = next_node(inner, num_inner, node_stack);
+    }
+
+    return opacity;
+}
+
+template <typename Data>
+template <typename Wide_node>
+float3 Tree<Data>::absorption_4(Wide_node const* nodes, math::Ray& ray, uint64_t time,
+                                Materials const&                   materials,
+                                material::Sampler_settings::Filter filter,
+                                Worker const&                      worker) const noexcept {
+    auto& node_stack = worker.node_stack();
+    node_stack.push(0xFFFFFFFF);
+    uint32_t n = 0;
+
+    float3 absorption(0.f);
+
+    alignas(16) uint32_t const ray_signs[4] = {ray.signs[0], ray.signs[1], ray.signs[2], 0};
+
+    Vector const ray_origin        = simd::load_float4(ray.origin.v);
+    Vector const ray_direction     = simd::load_float4(ray.direction.v);
+    Vector const ray_inv_direction = simd::load_float4(ray.inv_direction.v);
+    Vector const ray_min_t         = simd::load_float(&ray.min_t);
+    Vector       ray_max_t         = simd::load_float(&ray.max_t);
+    Vector const max_t             = ray_max_t;
+
+    Vector u = simd::Zero;
+    Vector v = simd::Zero;
+
+    typename Wide_node::Ray const simd_ray = Node4::splat(ray_origin, ray_inv_direction);
+
+    while (0xFFFFFFFF != n) {
+        auto const& node = nodes[n];
+
+        uint32_t       slots[4];
+        uint32_t const num_hits = node.intersect_p(simd_ray, ray_min_t, ray_max_t, ray_signs,
+                                                   slots);
+
+        uint32_t inner[4];
+        uint32_t num_inner = 0;
+
+        for (uint32_t s = 0; s < num_hits; ++s) {
+            uint32_t const slot = slots[s];
+
+            if (0 == node.num_primitives(slot)) {
+                inner[num_inner++] = node.child(slot);
+                continue;
+            }
+
+            for (uint32_t i = node.indices_start(slot), len = node.indices_end(slot); i < len;
+                 ++i) {
+                if (data_.intersect(ray_origin, ray_direction, ray_min_t, ray_max_t, i, u, v)) {
+                    u         = math::splat_x(u);
+                    v         = math::splat_x(v);
+                    float2 uv = data_.interpolate_uv(u, v, i);
+
+                    float3 const normal = data_.normal(i);
+
+                    auto const material = materials[data_.material_index(i)];
+
+                    float3 const ta = material->thin_absorption(ray.direction, normal, uv, time,
+                                                                filter, worker);
+                    absorption += (1.f - absorption) * ta;
+                    if (math::all_greater_equal(absorption, 1.f)) {
+                        return float3(1.f);
+                    }
+
+                    // ray_max_t has changed if intersect() returns true!
+                    ray_max_t = max_t;
+                }
+            }
+        }
+
+        n = next_node(inner, num_inner, node_stack);
+    }
+
+    return absorption;
+}
+
+template <typename Data>
+math::AABB Tree<Data>::refit(uint32_t n, uint32_t depth, thread::Pool& pool) noexcept {
+    // Subtrees above this depth are refitted in parallel
+    static uint32_t constexpr Parallel_depth = 6;
+
+    auto& node = nodes_[n];
+
+    math::AABB aabb = math::AABB::empty();
+
+    if (0 == node.num_primitives()) {
+        uint32_t const a = n + 1;
+        uint32_t const b = node.next();
+
+        math::AABB aabb_a;
+        math::AABB aabb_b;
+
+        if (depth < Parallel_depth) {
+            pool.fork_join(
+                [this, a, depth, &pool, &aabb_a](uint32_t /*id*/) noexcept {
+                    aabb_a = refit(a, depth + 1, pool);
+                },
+                [this, b, depth, &pool, &aabb_b](uint32_t /*id*/) noexcept {
+                    aabb_b = refit(b, depth + 1, pool);
+                });
+        } else {
+            aabb_a = refit(a, depth + 1, pool);
+            aabb_b = refit(b, depth + 1, pool);
+        }
+
+        aabb = aabb_a.merge(aabb_b);
+    } else {
+        for (uint32_t i = node.indices_start(), len = node.indices_end(); i < len; ++i) {
+            aabb.merge_assign(data_.aabb(i));
+        }
+    }
+
+    node.set_aabb(aabb.min().v, aabb.max().v);
+
+    return aabb;
+}
+
+template <typename Data>
+uint32_t Tree<Data>::next_node(uint32_t const* inner, uint32_t num_inner,
+                               Node_stack& node_stack) noexcept {
+    if (0 == num_inner) {
+        return node_stack.pop();
+    }
+
+    // The remaining children are pushed back to front, so that they are popped in order
+    for (uint32_t i = num_inner - 1; i > 0; --i) {
+        node_stack.push(inner[i]);
+    }
+
+    return inner[0];
+}
+
 template <typename Data>
 void Tree<Data>::interpolate_triangle_data(uint32_t index, float2 uv, float3& n, float3& t,
                                            float2& tc) const noexcept {
@@ -522,6 +1239,12 @@ float Tree<Data>::triangle_area(uint32_t index, float3 const& scale) const noexc
     return data_.area(index, scale);
 }
 
+template <typename Data>
+void Tree<Data>::triangle_differentials(uint32_t index, float3& dpdu, float3& dpdv) const
+    noexcept {
+    data_.differentials(index, dpdu, dpdv);
+}
+
 template <typename Data>
 void Tree<Data>::sample(uint32_t index, float2 r2, float3& p, float3& n, float2& tc) const
     noexcept {
@@ -567,10 +1290,123 @@ void Tree<Data>::add_triangle(uint32_t a, uint32_t b, uint32_t c, uint32_t mater
 
 template <typename Data>
 size_t Tree<Data>::num_bytes() const noexcept {
-    return sizeof(*this) + num_nodes_ * sizeof(Node) + num_parts_ * sizeof(uint32_t) +
+    return sizeof(*this) + num_nodes_ * sizeof(Node) + num_wide_nodes_ * sizeof(Node4) +
+           num_compressed_nodes_ * sizeof(Compressed_node4) + num_parts_ * sizeof(uint32_t) +
            data_.num_bytes();
 }
 
+template <typename Data>
+void Tree<Data>::refit(std::vector<Vertex> const& vertices, thread::Pool& pool) noexcept {
+    if (!nodes_) {
+        return;
+    }
+
+    pool.run_range(
+        [this, &vertices](uint32_t /*id*/, int32_t begin, int32_t end) noexcept {
+            data_.update_vertices(vertices, static_cast<uint32_t>(begin),
+                                  static_cast<uint32_t>(end));
+        },
+        0, static_cast<int32_t>(vertices.size()));
+
+    refit(0, 0, pool);
+}
+
+template <typename Data>
+float Tree<Data>::sah_cost() const noexcept {
+    if (!nodes_) {
+        return 0.f;
+    }
+
+    // Same costs as used by the builder
+    float cost = 0.f;
+
+    for (uint32_t i = 0; i < num_nodes_; ++i) {
+        auto const& node = nodes_[i];
+
+        float const area = math::AABB(node.min(), node.max()).surface_area();
+
+        if (0 == node.num_primitives()) {
+            cost += 2.f * area;
+        } else {
+            cost += static_cast<float>(node.num_primitives()) * area;
+        }
+    }
+
+    float const root_area = math::AABB(nodes_[0].min(), nodes_[0].max()).surface_area();
+
+    return root_area > 0.f ? cost / root_area : 0.f;
+}
+
+template <typename Data>
+void Tree<Data>::write(std::ostream& stream) const noexcept {
+    stream.write(reinterpret_cast<char const*>(&num_nodes_), sizeof(uint32_t));
+    stream.write(reinterpret_cast<char const*>(nodes_), num_nodes_ * sizeof(Node));
+
+    stream.write(reinterpret_cast<char const*>(&num_parts_), sizeof(uint32_t));
+    stream.write(reinterpret_cast<char const*>(num_part_triangles_),
+                 num_parts_ * sizeof(uint32_t));
+
+    data_.write(stream);
+}
+
+template <typename Data>
+bool Tree<Data>::read(std::istream& stream, std::vector<Vertex> const& vertices) noexcept {
+    uint32_t num_nodes = 0;
+    stream.read(reinterpret_cast<char*>(&num_nodes), sizeof(uint32_t));
+
+    if (!stream || 0 == num_nodes) {
+        return false;
+    }
+
+    uint32_t num_parts = 0;
+
+    {
+        Node* nodes = allocate_nodes(num_nodes);
+        stream.read(reinterpret_cast<char*>(nodes), num_nodes * sizeof(Node));
+
+        stream.read(reinterpret_cast<char*>(&num_parts), sizeof(uint32_t));
+    }
+
+    if (!stream || num_parts != num_parts_) {
+        return false;
+    }
+
+    // The part counts are only replaced on success, because a failed read is followed by a build
+    std::vector<uint32_t> num_part_triangles(num_parts);
+    stream.read(reinterpret_cast<char*>(num_part_triangles.data()), num_parts * sizeof(uint32_t));
+
+    if (!stream || !data_.read(stream, vertices)) {
+        return false;
+    }
+
+    // A corrupt file must not lead to traversals outside of the nodes or triangles
+    uint32_t const num_triangles = data_.num_triangles();
+
+    for (uint32_t i = 0; i < num_nodes; ++i) {
+        auto const& node = nodes_[i];
+
+        if (0 == node.num_primitives()) {
+            // Children are always stored after their parent, which also rules out cycles
+            if (node.next() <= i + 1 || node.next() >= num_nodes || node.axis() > 2) {
+                return false;
+            }
+        } else if (node.indices_start() >= num_triangles ||
+                   node.num_primitives() > num_triangles - node.indices_start()) {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < num_triangles; ++i) {
+        if (data_.material_index(i) >= num_parts) {
+            return false;
+        }
+    }
+
+    std::copy(num_part_triangles.begin(), num_part_triangles.end(), num_part_triangles_);
+
+    return true;
+}
+
 }  // namespace scene::shape::triangle::bvh
 
 #endif
@@ -5,11 +5,12 @@
 // #include "bvh/triangle_bvh_data_interleaved.inl"
 #include "base/math/distribution/distribution_1d.inl"
 #include "base/math/matrix3x3.inl"
+#include "base/math/ray_packet.inl"
 #include "base/math/simd_matrix.inl"
 #include "base/math/vector3.inl"
 #include "bvh/triangle_bvh_tree.inl"
 #include "sampler/sampler.hpp"
-#include "scene/entity/composed_transformation.hpp"
+#include "scene/entity/composed_transformation.inl"
 #include "scene/scene_constants.hpp"
 #include "scene/scene_ray.inl"
 #include "scene/shape/shape_intersection.hpp"
@@ -101,39 +102,9 @@ bool Mesh::intersect(Ray& ray, Transformation const& transformation, Node_stack&
     Intersection pi;
     if (tree_.intersect(ray_origin, ray_direction, ray_inv_direction, ray_min_t, ray_max_t,
                         ray_signs, node_stack, pi)) {
-        float tray_max_t = simd::get_x(ray_max_t);
-        ray.max_t        = tray_max_t;
-
-        float epsilon = 3e-3f * tray_max_t;
-
-        float3 p_w = ray.point(tray_max_t);
-
-        Vector n;
-        Vector t;
-        float2 uv;
-        tree_.interpolate_triangle_data(pi.u, pi.v, pi.index, n, t, uv);
-
-        Vector geo_n = tree_.triangle_normal_v(pi.index);
-
-        Vector bitangent_sign = simd::set_float4(tree_.triangle_bitangent_sign(pi.index));
-
-        uint32_t material_index = tree_.triangle_material_index(pi.index);
-
-        Matrix3 rotation = math::load_float3x3(transformation.rotation);
+        ray.max_t = simd::get_x(ray_max_t);
 
-        Vector geo_n_w = math::transform_vector(rotation, geo_n);
-        Vector n_w     = math::transform_vector(rotation, n);
-        Vector t_w     = math::transform_vector(rotation, t);
-        Vector b_w     = math::mul(bitangent_sign, math::cross3(n_w, t_w));
-
-        intersection.p = p_w;
-        simd::store_float4(intersection.t.v, t_w);
-        simd::store_float4(intersection.b.v, b_w);
-        simd::store_float4(intersection.n.v, n_w);
-        simd::store_float4(intersection.geo_n.v, geo_n_w);
-        intersection.uv      = uv;
-        intersection.epsilon = epsilon;
-        intersection.part    = material_index;
+        resolve(ray, transformation, pi, intersection);
 
         return true;
     }
@@ -249,6 +220,35 @@ bool Mesh::intersect_p(Ray const& ray, Transformation const& transformation,
                              ray_signs, node_stack);
 }
 
+uint32_t Mesh::intersect(Ray* rays, uint32_t mask, Transformation const& transformation,
+                         Node_stack& node_stack, shape::Intersection* intersections) const
+    noexcept {
+    math::Ray_packet packet;
+    world_to_object(rays, mask, transformation, packet);
+
+    Intersection pis[math::Ray_packet::Size];
+
+    uint32_t const hits = tree_.intersect(packet, mask, node_stack, pis);
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if (hits & (1u << i)) {
+            rays[i].max_t = packet.max_t[i];
+
+            resolve(rays[i], transformation, pis[i], intersections[i]);
+        }
+    }
+
+    return hits;
+}
+
+uint32_t Mesh::intersect_p(Ray const* rays, uint32_t mask, Transformation const& transformation,
+                           Node_stack& node_stack) const noexcept {
+    math::Ray_packet packet;
+    world_to_object(rays, mask, transformation, packet);
+
+    return tree_.intersect_p(packet, mask, node_stack);
+}
+
 // bool Mesh::intersect_p(FVector ray_origin, FVector ray_direction,
 //					   FVector ray_min_t, FVector ray_max_t,
 //					   Transformation const& transformation,
@@ -432,6 +432,71 @@ size_t Mesh::num_bytes() const noexcept {
     return sizeof(*this) + tree_.num_bytes() + num_bytes;
 }
 
+void Mesh::world_to_object(Ray const* rays, uint32_t mask, Transformation const& transformation,
+                           math::Ray_packet& packet) noexcept {
+    Matrix4 world_to_object = math::load_float4x4(transformation.world_to_object);
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if (0 == (mask & (1u << i))) {
+            // Inactive lanes are masked out, but should not contain garbage either
+            packet.set(i, simd::Zero, simd::Zero, simd::Zero, 0.f, 0.f);
+            continue;
+        }
+
+        Ray const& ray = rays[i];
+
+        Vector ray_origin = simd::load_float4(ray.origin.v);
+        ray_origin        = math::transform_point(world_to_object, ray_origin);
+
+        Vector ray_direction = simd::load_float4(ray.direction.v);
+        ray_direction        = math::transform_vector(world_to_object, ray_direction);
+
+        Vector const ray_inv_direction = math::reciprocal3(ray_direction);
+
+        packet.set(i, ray_origin, ray_direction, ray_inv_direction, ray.min_t, ray.max_t);
+    }
+}
+
+void Mesh::resolve(Ray const& ray, Transformation const& transformation, Intersection const& pi,
+                   shape::Intersection& intersection) const noexcept {
+    float const epsilon = 3e-3f * ray.max_t;
+
+    float3 const p_w = ray.point(ray.max_t);
+
+    Vector n;
+    Vector t;
+    float2 uv;
+    tree_.interpolate_triangle_data(pi.u, pi.v, pi.index, n, t, uv);
+
+    Vector geo_n = tree_.triangle_normal_v(pi.index);
+
+    Vector bitangent_sign = simd::set_float4(tree_.triangle_bitangent_sign(pi.index));
+
+    uint32_t material_index = tree_.triangle_material_index(pi.index);
+
+    Matrix3 rotation = math::load_float3x3(transformation.rotation);
+
+    Vector geo_n_w = math::transform_vector(rotation, geo_n);
+    Vector n_w     = math::transform_vector(rotation, n);
+    Vector t_w     = math::transform_vector(rotation, t);
+    Vector b_w     = math::mul(bitangent_sign, math::cross3(n_w, t_w));
+
+    float3 dpdu;
+    float3 dpdv;
+    tree_.triangle_differentials(pi.index, dpdu, dpdv);
+
+    intersection.p = p_w;
+    simd::store_float4(intersection.t.v, t_w);
+    simd::store_float4(intersection.b.v, b_w);
+    simd::store_float4(intersection.n.v, n_w);
+    simd::store_float4(intersection.geo_n.v, geo_n_w);
+    intersection.uv      = uv;
+    intersection.dpdu    = transformation.object_to_world_vector(dpdu);
+    intersection.dpdv    = transformation.object_to_world_vector(dpdv);
+    intersection.epsilon = epsilon;
+    intersection.part    = material_index;
+}
+
 void Mesh::Distribution::init(uint32_t part, const Tree& tree) noexcept {
     uint32_t const num_triangles = tree.num_triangles(part);
 
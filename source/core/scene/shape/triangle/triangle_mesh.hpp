@@ -43,6 +43,13 @@ class Mesh : public Shape {
     bool intersect_p(Ray const& ray, Transformation const& transformation,
                      Node_stack& node_stack) const noexcept override final;
 
+    uint32_t intersect(Ray* rays, uint32_t mask, Transformation const& transformation,
+                       Node_stack& node_stack, shape::Intersection* intersections) const
+        noexcept override final;
+
+    uint32_t intersect_p(Ray const* rays, uint32_t mask, Transformation const& transformation,
+                         Node_stack& node_stack) const noexcept override final;
+
     //	virtual bool intersect_p(FVector ray_origin, FVector ray_direction,
     //							 FVector ray_min_t, FVector ray_max_t,
     //							 Transformation const& transformation,
@@ -98,6 +105,14 @@ class Mesh : public Shape {
     size_t num_bytes() const noexcept override final;
 
   private:
+    static void world_to_object(Ray const* rays, uint32_t mask,
+                                Transformation const& transformation,
+                                math::Ray_packet& packet) noexcept;
+
+    // Fills in the intersection for a hit found by the tree, ray.max_t is the hit distance
+    void resolve(Ray const& ray, Transformation const& transformation, Intersection const& pi,
+                 shape::Intersection& intersection) const noexcept;
+
     Tree tree_;
 
     struct Distribution {
@@ -1,4 +1,5 @@
 #include "triangle_mesh_provider.hpp"
+#include "base/crypto/sha1.hpp"
 #include "base/json/json.hpp"
 #include "base/math/aabb.inl"
 #include "base/math/vector3.inl"
@@ -21,6 +22,13 @@
 #include "triangle_primitive.hpp"
 #include "triangle_type.hpp"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
 #include "base/debug/assert.hpp"
 #ifdef SU_DEBUG
 #include <iostream>
@@ -29,6 +37,15 @@
 
 namespace scene::shape::triangle {
 
+static uint32_t constexpr BVH_num_slices      = 16;
+static uint32_t constexpr BVH_sweep_threshold = 64;
+static uint32_t constexpr BVH_max_primitives  = 4;
+
+// Must change whenever the layout of the cached data changes
+static uint32_t constexpr BVH_cache_version = 1;
+
+static char const BVH_cache_header[] = "SUBV";
+
 #ifdef SU_DEBUG
 bool check(const std::vector<Vertex>& vertices, std::string const& filename);
 bool check_and_fix(std::vector<Vertex>& vertices, std::string const& filename);
@@ -39,13 +56,16 @@ Provider::Provider() noexcept : resource::Provider<Shape>("Mesh") {}
 Provider::~Provider() noexcept {}
 
 std::shared_ptr<Shape> Provider::load(std::string const& filename,
-                                      memory::Variant_map const& /*options*/,
-                                      resource::Manager& manager) {
+                                      memory::Variant_map const& options,
+                                      resource::Manager&         manager) {
+    BVH_preset bvh_preset = BVH_preset::Undefined;
+    options.query("bvh_preset", bvh_preset);
+
     auto stream_pointer = manager.filesystem().read_stream(filename);
 
     file::Type type = file::query_type(*stream_pointer);
     if (file::Type::SUM == type) {
-        return load_binary(*stream_pointer, manager.thread_pool());
+        return load_binary(*stream_pointer, bvh_preset, bvh_cache_folder_, manager.thread_pool());
     }
 
     Json_handler handler;
@@ -108,7 +128,8 @@ std::shared_ptr<Shape> Provider::load(std::string const& filename,
 
     manager.thread_pool().run_async([mesh, parts = std::move(handler.parts()),
                                      triangles = std::move(handler.triangles()),
-                                     vertices = std::move(handler.vertices()), &manager]() mutable {
+                                     vertices = std::move(handler.vertices()), bvh_preset,
+                                     cache_folder = bvh_cache_folder_, &manager]() mutable {
         logging::verbose("Started asynchronously building triangle mesh BVH.");
 
         for (auto& p : parts) {
@@ -120,7 +141,7 @@ std::shared_ptr<Shape> Provider::load(std::string const& filename,
             }
         }
 
-        build_bvh(*mesh, triangles, vertices, manager.thread_pool());
+        build_bvh(*mesh, triangles, vertices, bvh_preset, cache_folder, manager.thread_pool());
 
         logging::verbose("Finished asynchronously building triangle mesh BVH.");
     });
@@ -135,7 +156,15 @@ std::shared_ptr<Shape> Provider::load(void const* /*data*/, std::string_view /*m
 }
 
 size_t Provider::num_bytes() const noexcept {
-    return sizeof(*this);
+    return sizeof(*this) + bvh_cache_folder_.capacity();
+}
+
+void Provider::set_bvh_cache_folder(std::string_view folder) {
+    bvh_cache_folder_ = folder;
+
+    if (!bvh_cache_folder_.empty() && '/' != bvh_cache_folder_.back()) {
+        bvh_cache_folder_.push_back('/');
+    }
 }
 
 std::shared_ptr<Shape> Provider::create_mesh(Triangles const& triangles, Vertices const& vertices,
@@ -150,9 +179,9 @@ std::shared_ptr<Shape> Provider::create_mesh(Triangles const& triangles, Vertice
 
     thread_pool.run_async(
         [mesh, triangles_in = std::move(triangles), vertices_in = std::move(vertices),
-         &thread_pool]() { build_bvh(*mesh, triangles_in, vertices_in, thread_pool); });
-
-    //	build_bvh(*mesh, triangles, vertices, bvh_preset, thread_pool);
+         &thread_pool]() {
+            build_bvh(*mesh, triangles_in, vertices_in, BVH_preset::Undefined, "", thread_pool);
+        });
 
     return mesh;
 }
@@ -231,13 +260,108 @@ std::shared_ptr<Shape> Provider::load_morphable_mesh(std::string const& filename
 }
 
 void Provider::build_bvh(Mesh& mesh, Triangles const& triangles, Vertices const& vertices,
+                         BVH_preset bvh_preset, std::string const& cache_folder,
                          thread::Pool& thread_pool) {
-    bvh::Builder_SAH builder(16, 64);
-    builder.build(mesh.tree(), triangles, vertices, 4, thread_pool);
+    std::string const cache_name = cache_folder.empty()
+                                       ? std::string()
+                                       : cache_folder + bvh_cache_name(triangles, vertices);
+
+    if (cache_name.empty() || !read_bvh_cache(mesh, cache_name, vertices)) {
+        bvh::Builder_SAH builder(BVH_num_slices, BVH_sweep_threshold);
+        builder.build(mesh.tree(), triangles, vertices, BVH_max_primitives, thread_pool);
+
+        if (!cache_name.empty()) {
+            write_bvh_cache(mesh, cache_name);
+        }
+    }
+
+    if (BVH_preset::Wide == bvh_preset) {
+        mesh.tree().collapse();
+    } else if (BVH_preset::Compressed == bvh_preset) {
+        mesh.tree().compress();
+    }
 
     mesh.init();
 }
 
+std::string Provider::bvh_cache_name(Triangles const& triangles, Vertices const& vertices) {
+    // Everything that has an influence on the resulting BVH is part of the key
+    uint32_t const settings[] = {BVH_cache_version, BVH_num_slices, BVH_sweep_threshold,
+                                 BVH_max_primitives, static_cast<uint32_t>(sizeof(Vertex)),
+                                 static_cast<uint32_t>(sizeof(Index_triangle))};
+
+    crypto::sha1::SHA1 hash;
+
+    hash.update(reinterpret_cast<char const*>(settings), sizeof(settings));
+    hash.update(reinterpret_cast<char const*>(vertices.data()), vertices.size() * sizeof(Vertex));
+    hash.update(reinterpret_cast<char const*>(triangles.data()),
+                triangles.size() * sizeof(Index_triangle));
+
+    std::ostringstream name;
+    name << std::hex << std::setfill('0');
+
+    for (uint8_t const b : hash.final()) {
+        name << std::setw(2) << static_cast<uint32_t>(b);
+    }
+
+    name << ".bvh";
+
+    return name.str();
+}
+
+bool Provider::read_bvh_cache(Mesh& mesh, std::string const& filename, Vertices const& vertices) {
+    std::ifstream stream(filename, std::ios::binary);
+
+    if (!stream) {
+        return false;
+    }
+
+    char header[4];
+    stream.read(header, sizeof(header));
+
+    if (!stream || 0 != std::memcmp(header, BVH_cache_header, sizeof(header))) {
+        return false;
+    }
+
+    if (!mesh.tree().read(stream, vertices)) {
+        logging::warning("Could not read BVH cache \"" + filename + "\".");
+        return false;
+    }
+
+    logging::verbose("Loaded triangle mesh BVH from cache \"" + filename + "\".");
+
+    return true;
+}
+
+void Provider::write_bvh_cache(Mesh& mesh, std::string const& filename) {
+    // Written under a temporary name first, so that other processes never see incomplete files.
+    // The name is unique, because several processes might build the same mesh at the same time.
+    std::ostringstream temp_stream;
+    temp_stream << filename << "." << std::hex << std::random_device()() << ".tmp";
+
+    std::string const temp_name = temp_stream.str();
+
+    {
+        std::ofstream stream(temp_name, std::ios::binary);
+
+        if (stream) {
+            stream.write(BVH_cache_header, 4);
+
+            mesh.tree().write(stream);
+        }
+
+        if (!stream) {
+            logging::warning("Could not write BVH cache \"" + filename + "\".");
+            std::remove(temp_name.c_str());
+            return;
+        }
+    }
+
+    if (0 != std::rename(temp_name.c_str(), filename.c_str())) {
+        std::remove(temp_name.c_str());
+    }
+}
+
 template <typename Index>
 void fill_triangles(const std::vector<Part>& parts, Index const* indices,
                     std::vector<Index_triangle>& triangles) {
@@ -255,7 +379,9 @@ void fill_triangles(const std::vector<Part>& parts, Index const* indices,
     }
 }
 
-std::shared_ptr<Shape> Provider::load_binary(std::istream& stream, thread::Pool& thread_pool) {
+std::shared_ptr<Shape> Provider::load_binary(std::istream& stream, BVH_preset bvh_preset,
+                                             std::string const& cache_folder,
+                                             thread::Pool&      thread_pool) {
     stream.seekg(4);
 
     uint64_t json_size = 0;
@@ -335,7 +461,7 @@ std::shared_ptr<Shape> Provider::load_binary(std::istream& stream, thread::Pool&
 
     thread_pool.run_async([mesh, local_parts = std::move(parts), local_indices = std::move(indices),
                            num_indices, local_vertices = std::move(vertices), index_bytes,
-                           &thread_pool]() {
+                           bvh_preset, cache_folder, &thread_pool]() {
         std::vector<Index_triangle> triangles(num_indices / 3);
 
         if (4 == index_bytes) {
@@ -348,7 +474,7 @@ std::shared_ptr<Shape> Provider::load_binary(std::istream& stream, thread::Pool&
 
         delete[] local_indices;
 
-        build_bvh(*mesh, triangles, local_vertices, thread_pool);
+        build_bvh(*mesh, triangles, local_vertices, bvh_preset, cache_folder, thread_pool);
     });
 
     return mesh;
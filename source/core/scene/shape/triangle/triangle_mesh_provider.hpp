@@ -25,6 +25,8 @@ class Provider : public resource::Provider<Shape> {
     using Vertices  = std::vector<Vertex>;
     using Strings   = std::vector<std::string>;
 
+    enum class BVH_preset { Undefined, Binary, Wide, Compressed };
+
     Provider() noexcept;
 
     ~Provider() noexcept override;
@@ -38,6 +40,9 @@ class Provider : public resource::Provider<Shape> {
 
     size_t num_bytes() const noexcept override final;
 
+    // Built BVHs are cached in this folder, an empty folder disables caching
+    void set_bvh_cache_folder(std::string_view folder);
+
     static std::shared_ptr<Shape> create_mesh(Triangles const& triangles, Vertices const& vertices,
                                               uint32_t num_parts, thread::Pool& thread_pool);
 
@@ -47,12 +52,20 @@ class Provider : public resource::Provider<Shape> {
                                                resource::Manager& manager);
 
     static void build_bvh(Mesh& mesh, Triangles const& triangles, Vertices const& vertices,
+                          BVH_preset bvh_preset, std::string const& cache_folder,
                           thread::Pool& thread_pool);
 
-    //	static void build_bvh(Mesh& mesh, Triangles const& triangles, Vertices const& vertices,
-    //						  BVH_preset bvh_preset, thread::Pool& thread_pool);
+    static std::shared_ptr<Shape> load_binary(std::istream& stream, BVH_preset bvh_preset,
+                                              std::string const& cache_folder,
+                                              thread::Pool&      thread_pool);
+
+    static std::string bvh_cache_name(Triangles const& triangles, Vertices const& vertices);
+
+    static bool read_bvh_cache(Mesh& mesh, std::string const& filename, Vertices const& vertices);
+
+    static void write_bvh_cache(Mesh& mesh, std::string const& filename);
 
-    static std::shared_ptr<Shape> load_binary(std::istream& stream, thread::Pool& thread_pool);
+    std::string bvh_cache_folder_;
 };
 
 }  // namespace triangle
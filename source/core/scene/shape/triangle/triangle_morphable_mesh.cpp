@@ -10,13 +10,16 @@
 #include "base/math/vector3.inl"
 #include "bvh/triangle_bvh_tree.inl"
 #include "sampler/sampler.hpp"
-#include "scene/entity/composed_transformation.hpp"
+#include "scene/entity/composed_transformation.inl"
 #include "scene/scene_ray.inl"
 #include "scene/shape/shape_intersection.hpp"
 #include "scene/shape/shape_sample.hpp"
 
 namespace scene::shape::triangle {
 
+// The hierarchy is only rebuilt after refitting made it this much more expensive to traverse
+static float constexpr Max_refit_cost_ratio = 1.5f;
+
 Morphable_mesh::Morphable_mesh(std::shared_ptr<Morph_target_collection> collection,
                                uint32_t                                 num_parts) noexcept
     : collection_(collection) {
@@ -64,12 +67,18 @@ bool Morphable_mesh::intersect(Ray& ray, Transformation const& transformation,
         float3 t_w     = math::transform_vector(transformation.rotation, t);
         float3 b_w     = bitangent_sign * math::cross(n_w, t_w);
 
+        float3 dpdu;
+        float3 dpdv;
+        tree_.triangle_differentials(pi.index, dpdu, dpdv);
+
         intersection.p       = p_w;
         intersection.t       = t_w;
         intersection.b       = b_w;
         intersection.n       = n_w;
         intersection.geo_n   = geo_n_w;
         intersection.uv      = uv;
+        intersection.dpdu    = transformation.object_to_world_vector(dpdu);
+        intersection.dpdv    = transformation.object_to_world_vector(dpdv);
         intersection.epsilon = epsilon;
         intersection.part    = material_index;
 
@@ -242,9 +251,23 @@ Morphable_shape* Morphable_mesh::morphable_shape() noexcept {
 void Morphable_mesh::morph(uint32_t a, uint32_t b, float weight, thread::Pool& pool) noexcept {
     collection_->morph(a, b, weight, pool, vertices_);
 
+    if (0 != tree_.num_triangles()) {
+        tree_.refit(vertices_, pool);
+
+        if (tree_.sah_cost() <= Max_refit_cost_ratio * build_cost_) {
+            init();
+            return;
+        }
+    }
+
+    // The builder counts the triangles of each part anew
+    tree_.allocate_parts(tree_.num_parts());
+
     bvh::Builder_SAH builder(16, 64);
     builder.build(tree_, collection_->triangles(), vertices_, 4, pool);
 
+    build_cost_ = tree_.sah_cost();
+
     init();
 }
 
@@ -93,6 +93,9 @@ class Morphable_mesh : public Shape, public Morphable_shape {
 
     Tree tree_;
 
+    // Cost of the hierarchy right after it was built, to detect when refitting degraded it too much
+    float build_cost_ = 0.f;
+
     std::shared_ptr<Morph_target_collection> collection_;
 
     std::vector<Vertex> vertices_;
@@ -3,6 +3,7 @@
 
 #include "base/encoding/encoding.inl"
 #include "base/math/ray.hpp"
+#include "base/math/ray_packet.inl"
 #include "base/math/simd_vector.inl"
 #include "triangle_primitive_mt.hpp"
 
@@ -363,6 +364,101 @@ static inline bool intersect_p(FVector origin, FVector direction, FVector min_t,
                  _mm_ucomige_ss(hit_t, min_t) & _mm_ucomige_ss(max_t, hit_t));
 }
 
+// Same operations as the single ray versions above, with one ray of the packet per lane.
+// Returns the lane mask of the rays that hit the triangle.
+static inline uint32_t intersect(math::Ray_packet const& packet, float const* a, float const* b,
+                                 float const* c, Vector& u_out, Vector& v_out,
+                                 Vector& hit_t_out) noexcept {
+    using namespace math;
+
+    Vector e1[3];
+    Vector e2[3];
+    Vector tvec[3];
+    Vector direction[3];
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        e1[i]        = simd::set_float4(b[i] - a[i]);
+        e2[i]        = simd::set_float4(c[i] - a[i]);
+        tvec[i]      = sub(packet.origin_v(i), simd::set_float4(a[i]));
+        direction[i] = packet.direction_v(i);
+    }
+
+    // cross3(direction, e2) and cross3(tvec, e1)
+    Vector const pvec[3] = {sub(mul(direction[1], e2[2]), mul(direction[2], e2[1])),
+                            sub(mul(direction[2], e2[0]), mul(direction[0], e2[2])),
+                            sub(mul(direction[0], e2[1]), mul(direction[1], e2[0]))};
+
+    Vector const qvec[3] = {sub(mul(tvec[1], e1[2]), mul(tvec[2], e1[1])),
+                            sub(mul(tvec[2], e1[0]), mul(tvec[0], e1[2])),
+                            sub(mul(tvec[0], e1[1]), mul(tvec[1], e1[0]))};
+
+    Vector const e1_d_pv = add(add(mul(e1[0], pvec[0]), mul(e1[1], pvec[1])), mul(e1[2], pvec[2]));
+    Vector const tv_d_pv = add(add(mul(tvec[0], pvec[0]), mul(tvec[1], pvec[1])),
+                               mul(tvec[2], pvec[2]));
+    Vector const di_d_qv = add(add(mul(direction[0], qvec[0]), mul(direction[1], qvec[1])),
+                               mul(direction[2], qvec[2]));
+    Vector const e2_d_qv = add(add(mul(e2[0], qvec[0]), mul(e2[1], qvec[1])), mul(e2[2], qvec[2]));
+
+    Vector const inv_det = rcp(e1_d_pv);
+
+    Vector const u     = mul(tv_d_pv, inv_det);
+    Vector const v     = mul(di_d_qv, inv_det);
+    Vector const hit_t = mul(e2_d_qv, inv_det);
+
+    Vector const uv = add(u, v);
+
+    Vector const hit = _mm_and_ps(
+        _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(u, simd::Zero), _mm_cmpge_ps(simd::One, u)),
+                   _mm_and_ps(_mm_cmpge_ps(v, simd::Zero), _mm_cmpge_ps(simd::One, uv))),
+        _mm_and_ps(_mm_cmpge_ps(hit_t, packet.min_t_v()), _mm_cmpge_ps(packet.max_t_v(), hit_t)));
+
+    u_out     = u;
+    v_out     = v;
+    hit_t_out = hit_t;
+
+    return static_cast<uint32_t>(_mm_movemask_ps(hit));
+}
+
+static inline uint32_t intersect(math::Ray_packet& packet, uint32_t mask, float const* a,
+                                 float const* b, float const* c, float u_out[4],
+                                 float v_out[4]) noexcept {
+    Vector u;
+    Vector v;
+    Vector hit_t;
+
+    uint32_t const hits = mask & intersect(packet, a, b, c, u, v, hit_t);
+
+    if (0 == hits) {
+        return 0;
+    }
+
+    alignas(16) float us[4];
+    alignas(16) float vs[4];
+    alignas(16) float ts[4];
+    simd::store_float4(us, u);
+    simd::store_float4(vs, v);
+    simd::store_float4(ts, hit_t);
+
+    for (uint32_t i = 0; i < math::Ray_packet::Size; ++i) {
+        if (hits & (1u << i)) {
+            packet.max_t[i] = ts[i];
+            u_out[i]        = us[i];
+            v_out[i]        = vs[i];
+        }
+    }
+
+    return hits;
+}
+
+static inline uint32_t intersect_p(math::Ray_packet const& packet, uint32_t mask, float const* a,
+                                   float const* b, float const* c) noexcept {
+    Vector u;
+    Vector v;
+    Vector hit_t;
+
+    return mask & intersect(packet, a, b, c, u, v, hit_t);
+}
+
 static inline void interpolate_p(float3 const& a, float3 const& b, float3 const& c, float2 uv,
                                  float3& p) noexcept {
     float const w = 1.f - uv[0] - uv[1];
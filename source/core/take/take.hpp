@@ -38,6 +38,8 @@ struct Take {
 
     Photon_settings photon_settings;
 
+    Guiding_settings guiding_settings;
+
     std::shared_ptr<scene::animation::Animation> camera_animation;
 
     std::shared_ptr<rendering::integrator::surface::Factory> surface_integrator_factory;
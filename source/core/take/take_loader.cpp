@@ -19,6 +19,7 @@
 #include "rendering/integrator/surface/pathtracer.hpp"
 #include "rendering/integrator/surface/pathtracer_dl.hpp"
 #include "rendering/integrator/surface/pathtracer_mis.hpp"
+#include "rendering/integrator/surface/pathtracer_wf.hpp"
 #include "rendering/integrator/surface/whitted.hpp"
 #include "rendering/integrator/volume/emission.hpp"
 #include "rendering/integrator/volume/tracking_multi.hpp"
@@ -81,8 +82,7 @@ std::unique_ptr<Take> Loader::load(std::istream& stream, resource::Manager& mana
         } else if ("postprocessors" == n.name) {
             postprocessors_value = &n.value;
         } else if ("sampler" == n.name) {
-            take->sampler_factory = load_sampler_factory(n.value, num_threads,
-                                                         take->view.num_samples_per_pixel);
+            take->sampler_factory = load_sampler_factory(n.value, num_threads, take->view);
         } else if ("scene" == n.name) {
             take->scene_filename = n.value.GetString();
         } else if ("settings" == n.name) {
@@ -108,7 +108,8 @@ std::unique_ptr<Take> Loader::load(std::istream& stream, resource::Manager& mana
 
             using namespace image;
 
-            std::unique_ptr<Writer> writer = std::make_unique<encoding::png::Writer>(d);
+            std::unique_ptr<Writer> writer = std::make_unique<encoding::png::Writer>(
+                d, 6, encoding::png::Filter::Fast);
 
             take->exporters.push_back(
                 std::make_unique<exporting::Image_sequence>("output_", std::move(writer)));
@@ -356,13 +357,23 @@ rendering::sensor::filter::Filter const* Loader::load_filter(json::Value const&
 }
 
 std::shared_ptr<sampler::Factory> Loader::load_sampler_factory(json::Value const& sampler_value,
-                                                               uint32_t           num_workers,
-                                                               uint32_t& num_samples_per_pixel) {
+                                                               uint32_t num_workers, View& view) {
     for (auto& n : sampler_value.GetObject()) {
-        num_samples_per_pixel = json::read_uint(n.value, "samples_per_pixel");
+        uint32_t const num_samples_per_pixel = json::read_uint(n.value, "samples_per_pixel");
+
+        view.num_samples_per_pixel = num_samples_per_pixel;
+
+        uint32_t const default_min_samples = std::max(num_samples_per_pixel / 8, 1u);
+
+        view.min_samples_per_pixel = std::min(
+            json::read_uint(n.value, "min_samples_per_pixel", default_min_samples),
+            num_samples_per_pixel);
+
+        view.noise_threshold = json::read_float(n.value, "noise_threshold", 0.f);
 
         if ("Uniform" == n.name) {
-            num_samples_per_pixel = 1;
+            view.num_samples_per_pixel = 1;
+            view.noise_threshold       = 0.f;
             return std::make_shared<sampler::Uniform_factory>(num_workers);
         } else if ("Random" == n.name) {
             return std::make_shared<sampler::Random_factory>(num_workers);
@@ -391,6 +402,8 @@ void Loader::load_integrator_factories(json::Value const& integrator_value, uint
                                                                             num_workers);
         } else if ("photon" == n.name) {
             load_photon_settings(n.value, take.photon_settings);
+        } else if ("guiding" == n.name) {
+            load_guiding_settings(n.value, take.guiding_settings);
         }
     }
 }
@@ -466,6 +479,24 @@ std::shared_ptr<rendering::integrator::surface::Factory> Loader::load_surface_in
             return std::make_shared<Pathtracer_DL_factory>(
                 settings, num_workers, min_bounces, max_bounces, path_termination_probability,
                 num_light_samples, enable_caustics);
+        } else if ("PTWF" == n.name) {
+            uint32_t const min_bounces = json::read_uint(n.value, "min_bounces",
+                                                         default_min_bounces);
+
+            uint32_t const max_bounces = json::read_uint(n.value, "max_bounces",
+                                                         default_max_bounces);
+
+            float const path_termination_probability = json::read_float(
+                n.value, "path_termination_probability", default_path_termination_probability);
+
+            uint32_t const num_light_samples = json::read_uint(n.value, "num_light_samples",
+                                                               light_sampling.num_samples);
+
+            bool const enable_caustics = json::read_bool(n.value, "caustics", default_caustics);
+
+            return std::make_shared<Pathtracer_WF_factory>(
+                settings, num_workers, min_bounces, max_bounces, path_termination_probability,
+                num_light_samples, enable_caustics);
         } else if ("PTMIS" == n.name) {
             uint32_t const num_samples = json::read_uint(n.value, "num_samples", 1);
 
@@ -538,9 +569,18 @@ void Loader::load_photon_settings(json::Value const& value, Photon_settings& set
     settings.iteration_threshold    = json::read_float(value, "iteration_threshold", 0.f);
     settings.radius                 = json::read_float(value, "radius", 0.05f);
     settings.indirect_radius_factor = json::read_float(value, "indirect_radius_factor", 4.f);
+    settings.alpha                  = math::saturate(json::read_float(value, "alpha", 0.7f));
     settings.indirect_caustics      = json::read_bool(value, "indirect_caustics", false);
     settings.separate_caustics      = json::read_bool(value, "separate_caustics", true);
     settings.full_light_path        = json::read_bool(value, "full_light_path", false);
+    settings.progressive            = json::read_bool(value, "progressive", false);
+}
+
+void Loader::load_guiding_settings(json::Value const& value, Guiding_settings& settings) {
+    settings.num_training_samples = json::read_uint(value, "num_training_samples", 0);
+    settings.max_megabytes        = json::read_uint(value, "max_megabytes", 64);
+    settings.bsdf_probability     = math::saturate(
+        json::read_float(value, "bsdf_probability", 0.5f));
 }
 
 void Loader::load_postprocessors(json::Value const& pp_value, resource::Manager& manager,
@@ -689,13 +729,21 @@ std::vector<std::unique_ptr<exporting::Sink>> Loader::load_exporters(
             if ("RGBE" == format) {
                 writer = std::make_unique<image::encoding::rgbe::Writer>();
             } else {
+                using image::encoding::png::Filter;
+
+                uint32_t const compression = json::read_uint(n.value, "compression", 6);
+
+                Filter const filter = "Adaptive" == json::read_string(n.value, "filter", "Fast")
+                                          ? Filter::Adaptive
+                                          : Filter::Fast;
+
                 bool const transparent_sensor = camera.sensor().has_alpha_transparency();
                 if (view.pipeline.has_alpha_transparency(transparent_sensor)) {
                     writer = std::make_unique<image::encoding::png::Writer_alpha>(
-                        camera.sensor().dimensions());
+                        camera.sensor().dimensions(), compression, filter);
                 } else {
                     writer = std::make_unique<image::encoding::png::Writer>(
-                        camera.sensor().dimensions());
+                        camera.sensor().dimensions(), compression, filter);
                 }
             }
 
@@ -62,6 +62,7 @@ struct Take;
 struct View;
 struct Settings;
 struct Photon_settings;
+struct Guiding_settings;
 
 class Loader {
   public:
@@ -85,8 +86,7 @@ class Loader {
     static Sensor_filter const* load_filter(rapidjson::Value const& filter_value);
 
     static Sampler_factory_ptr load_sampler_factory(json::Value const& sampler_value,
-                                                    uint32_t           num_workers,
-                                                    uint32_t&          num_samples_per_pixel);
+                                                    uint32_t num_workers, View& view);
 
     static void load_integrator_factories(json::Value const& integrator_value, uint32_t num_workers,
                                           Take& take);
@@ -101,6 +101,8 @@ class Loader {
 
     static void load_photon_settings(json::Value const& value, Photon_settings& settings);
 
+    static void load_guiding_settings(json::Value const& value, Guiding_settings& settings);
+
     static void load_postprocessors(json::Value const& pp_value, resource::Manager& manager,
                                     Take& take);
 
@@ -17,9 +17,25 @@ struct Photon_settings {
     float radius                 = 0.05f;
     float indirect_radius_factor = 4.f;
 
+    // Fraction of the gathered photons that is kept when the radius of a pixel shrinks
+    float alpha = 0.7f;
+
     bool indirect_caustics = false;
     bool separate_caustics = true;
     bool full_light_path;
+
+    // Traces new photons for every sample per pixel, with a radius that shrinks per pixel
+    bool progressive = false;
+};
+
+struct Guiding_settings {
+    // Samples per pixel that are used to learn the incident radiance, 0 disables guiding
+    uint32_t num_training_samples = 0;
+
+    uint32_t max_megabytes = 64;
+
+    // Chance of sampling the BSDF instead of the learned distribution
+    float bsdf_probability = 0.5f;
 };
 
 }  // namespace take
@@ -23,6 +23,12 @@ struct View {
 
     uint32_t num_samples_per_pixel = 1;
 
+    // Adaptive sampling is enabled by a noise threshold larger than zero,
+    // num_samples_per_pixel is then the maximum number of samples.
+    // Renders that can be interrupted use min_samples_per_pixel as the size of their passes.
+    uint32_t min_samples_per_pixel = 1;
+    float    noise_threshold       = 0.f;
+
     rendering::postprocessor::Pipeline pipeline;
 
     uint32_t start_frame = 0;
@@ -2,6 +2,8 @@ target_sources(core
 	PRIVATE
 	"${CMAKE_CURRENT_LIST_DIR}/testing_cdf.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/testing_cdf.hpp"
+	"${CMAKE_CURRENT_LIST_DIR}/testing_fft.cpp"
+	"${CMAKE_CURRENT_LIST_DIR}/testing_fft.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/testing_simd.cpp"
 	"${CMAKE_CURRENT_LIST_DIR}/testing_simd.hpp"
 	"${CMAKE_CURRENT_LIST_DIR}/testing_size.cpp"
@@ -31,7 +31,7 @@ template <typename T, typename U>
 void assert_distributions(T const& a, const U& b, const std::vector<float2>& samples);
 
 template <typename T>
-void init(T& distribution, const image::texture::Float3& texture);
+void init(T& distribution, const image::texture::Float3<image::Float3>& texture);
 
 void test_1D() {
     std::cout << "testing::cdf::test_1D()" << std::endl;
@@ -132,7 +132,7 @@ void test_2D() {
 
     auto image = reader.read(stream);
 
-    const image::texture::Float3 texture(image);
+    const image::texture::Float3<image::Float3> texture(image);
 
     math::Distribution_t_2D<math::Distribution_1D> a;
     init(a, texture);
@@ -146,6 +146,9 @@ void test_2D() {
     math::Distribution_t_2D<math::Distribution_implicit_pdf_lut_lin_1D> d;
     init(d, texture);
 
+    math::Distribution_t_2D<math::Distribution_alias_1D> e;
+    init(e, texture);
+
     std::cout << "Distribution_2D" << std::endl;
     test_distribution(a, samples);
 
@@ -158,6 +161,9 @@ void test_2D() {
     std::cout << "Distribution_implicit_pdf_lut_lin_2D" << std::endl;
     test_distribution(d, samples);
 
+    std::cout << "Distribution_alias_2D" << std::endl;
+    test_distribution(e, samples);
+
     //	assert_distributions(a, d, samples);
 
     std::cout << "Done" << std::endl;
@@ -256,7 +262,7 @@ void assert_distributions(T const& a, const U& b, const std::vector<float2>& sam
 }
 
 template <typename T>
-void init(T& distribution, const image::texture::Float3& texture) {
+void init(T& distribution, const image::texture::Float3<image::Float3>& texture) {
     auto const d = texture.dimensions_2();
 
     std::vector<typename T::Distribution_impl> conditional(d[1]);
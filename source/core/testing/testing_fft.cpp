@@ -0,0 +1,162 @@
+#include "testing_fft.hpp"
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <vector>
+#include "base/math/fourier/fft.hpp"
+#include "base/math/vector2.inl"
+#include "base/memory/align.hpp"
+#include "base/random/generator.inl"
+
+namespace testing {
+namespace fft {
+
+using Complex = std::complex<double>;
+
+static double constexpr Two_pi = 6.283185307179586476925;
+
+// The error of a float FFT grows with log(size), the tolerance leaves room for that
+static double constexpr Tolerance = 1.0e-5;
+
+static std::vector<Complex> dft(std::vector<Complex> const& source, double sign) {
+    size_t const num = source.size();
+
+    std::vector<Complex> result(num);
+
+    for (size_t k = 0; k < num; ++k) {
+        Complex sum(0.0);
+
+        for (size_t n = 0; n < num; ++n) {
+            double const angle = sign * Two_pi * static_cast<double>((k * n) % num) /
+                                 static_cast<double>(num);
+
+            sum += source[n] * Complex(std::cos(angle), std::sin(angle));
+        }
+
+        result[k] = sum;
+    }
+
+    return result;
+}
+
+// Largest difference relative to the largest magnitude of the expected values
+template <typename T>
+static double error(T const* values, std::vector<Complex> const& expected, size_t num) {
+    double max_magnitude  = 0.0;
+    double max_difference = 0.0;
+
+    for (size_t i = 0; i < num; ++i) {
+        max_magnitude  = std::max(max_magnitude, std::abs(expected[i]));
+        max_difference = std::max(max_difference, std::abs(Complex(values[i]) - expected[i]));
+    }
+
+    return max_difference / std::max(max_magnitude, 1.0);
+}
+
+static Complex to_complex(float2 v) {
+    return Complex(v[0], v[1]);
+}
+
+static bool check(char const* name, int32_t size, double e) {
+    bool const passed = e < Tolerance;
+
+    std::cout << name << " " << size << ": " << e << (passed ? "" : " FAILED") << std::endl;
+
+    return passed;
+}
+
+static bool complex_transforms(int32_t size, rnd::Generator& rng) {
+    auto const& plan = math::fft::plan(size);
+
+    float2* data    = memory::allocate_aligned<float2>(size);
+    float2* scratch = memory::allocate_aligned<float2>(size);
+
+    std::vector<Complex> source(size);
+
+    for (int32_t i = 0; i < size; ++i) {
+        data[i]   = float2(rng.random_float() - 0.5f, rng.random_float() - 0.5f);
+        source[i] = to_complex(data[i]);
+    }
+
+    math::fft::forward(plan, data, scratch);
+
+    std::vector<Complex> result(size);
+
+    for (int32_t i = 0; i < size; ++i) {
+        result[i] = to_complex(data[i]);
+    }
+
+    bool passed = check("forward", size, error(result.data(), dft(source, -1.0), size));
+
+    math::fft::inverse(plan, data, scratch);
+
+    for (int32_t i = 0; i < size; ++i) {
+        result[i] = to_complex(data[i]) / static_cast<double>(size);
+    }
+
+    passed &= check("inverse", size, error(result.data(), source, size));
+
+    memory::free_aligned(scratch);
+    memory::free_aligned(data);
+
+    return passed;
+}
+
+static bool real_transforms(int32_t size, rnd::Generator& rng) {
+    int32_t const real_size = math::fft::real_size(size);
+
+    std::vector<float>  data(size);
+    std::vector<float2> transformed(real_size);
+
+    std::vector<Complex> source(size);
+
+    for (int32_t i = 0; i < size; ++i) {
+        data[i]   = rng.random_float() - 0.5f;
+        source[i] = Complex(data[i]);
+    }
+
+    math::fft::forward_real(transformed.data(), data.data(), size);
+
+    std::vector<Complex> result(real_size);
+
+    for (int32_t i = 0; i < real_size; ++i) {
+        result[i] = to_complex(transformed[i]);
+    }
+
+    bool passed = check("forward_real", size, error(result.data(), dft(source, -1.0), real_size));
+
+    math::fft::inverse_real(data.data(), transformed.data(), size);
+
+    for (int32_t i = 0; i < size; ++i) {
+        data[i] /= static_cast<float>(size);
+    }
+
+    passed &= check("inverse_real", size, error(data.data(), source, size));
+
+    return passed;
+}
+
+void transforms() {
+    std::cout << "testing::fft::transforms()" << std::endl;
+
+    rnd::Generator rng(0, 0);
+
+    int32_t const sizes[] = {// Powers of two
+                             1, 2, 4, 8, 32, 256, 1024,
+                             // Mixed radix
+                             6, 12, 30, 60, 90, 360, 1000, 1920,
+                             // Primes and sizes with large prime factors
+                             3, 5, 7, 11, 13, 97, 2 * 97, 6 * 101};
+
+    bool passed = true;
+
+    for (int32_t const size : sizes) {
+        passed &= complex_transforms(size, rng);
+        passed &= real_transforms(size, rng);
+    }
+
+    std::cout << (passed ? "All transforms passed" : "Some transforms FAILED") << std::endl;
+}
+
+}  // namespace fft
+}  // namespace testing
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace testing {
+namespace fft {
+
+// Compares the transforms against a direct DFT, for power of two, mixed radix and prime sizes
+void transforms();
+
+}  // namespace fft
+}  // namespace testing
@@ -8,7 +8,6 @@
 #include "rendering/rendering_camera_worker.hpp"
 #include "scene/bvh/scene_bvh_builder.hpp"
 #include "scene/bvh/scene_bvh_node.inl"
-#include "scene/bvh/scene_bvh_split_candidate.hpp"
 #include "scene/entity/composed_transformation.hpp"
 #include "scene/entity/entity.hpp"
 #include "scene/entity/keyframe.hpp"
@@ -79,8 +78,6 @@ void size() {
 
     print_size<image::texture::Adapter>("texture::Adapter", 24);
 
-    print_size<scene::bvh::Split_candidate<scene::prop::Prop>>("Split_candidate", 32);
-
     print_size<scene::Worker>("scene::Worker", 232);
     print_size<rendering::Camera_worker>("rendering::Camera_worker", 320);
 
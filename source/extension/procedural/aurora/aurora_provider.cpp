@@ -61,7 +61,7 @@ entity::Entity* Provider::create_extension(json::Value const& /*extension_value*
 
     render(*target, manager.thread_pool());
 
-    auto texture = std::make_shared<texture::Byte3_sRGB>(target);
+    auto texture = std::make_shared<texture::Byte3_sRGB<Byte3>>(target);
 
     std::shared_ptr<Material> material = std::make_shared<volumetric::Emission_grid>(
         Sampler_settings(), Texture_adapter(texture));
@@ -112,7 +112,7 @@ float Sky_baked_material::emission_pdf(float2 uv, Filter filter, Worker const& w
 void Sky_baked_material::prepare_sampling(Shape const& shape, uint32_t /*part*/, uint64_t /*time*/,
                                           Transformation const& transformation, float /*area*/,
                                           bool                  importance_sampling,
-                                          thread::Pool& /*pool*/) noexcept {
+                                          thread::Pool&         pool) noexcept {
     using namespace image;
 
     if (!sky_.sky_changed_since_last_check()) {
@@ -147,7 +147,7 @@ void Sky_baked_material::prepare_sampling(Shape const& shape, uint32_t /*part*/,
         }
     }
 
-    auto cache_texture = std::make_shared<texture::Float3>(cache);
+    auto cache_texture = std::make_shared<texture::Float3<Float3>>(cache);
 
     emission_map_ = Texture_adapter(cache_texture);
 
@@ -185,7 +185,7 @@ void Sky_baked_material::prepare_sampling(Shape const& shape, uint32_t /*part*/,
 
         total_weight_ = total_weight;
 
-        distribution_.init(luminance.data(), d);
+        distribution_.init(luminance.data(), d, pool);
     } else {
         // This controls how often the sky will be sampled,
         // Zenith sample cause less variance in one test (favoring the sun)...
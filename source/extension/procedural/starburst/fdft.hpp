@@ -1,5 +1,6 @@
 #pragma once
 
+#include "base/math/fourier/fft.hpp"
 #include "base/math/math.hpp"
 #include "base/math/vector2.inl"
 #include "base/thread/thread_pool.hpp"
@@ -58,101 +59,140 @@ static T sample(const T* source, int32_t w, int32_t b, float tc, int32_t y) {
     return _s * c0 + s * c1;
 }
 
+// The fractional DFT of a row is evaluated as a convolution with a chirp (Bluestein),
+// which turns the O(N * M) sum over the samples into FFTs of size O(N + M)
 class Row {
   public:
     Row(uint32_t width, float alpha, thread::Pool& pool)
         : width_(width),
           num_samples_(uint32_t(float(width) * std::floor(1.f / alpha)) + 1),
-          cos_sin_(new float2[width * num_samples_]),
-          s_(new float2[width]) {
-        float const m        = float(width_);
-        float const half_m   = 0.5f * m;
-        float const sqrt_m   = std::sqrt(m);
-        float const i_sqrt_m = 1.f / sqrt_m;
-        float const iss      = std::floor(1.f / alpha);
-        float const dk       = 1.f / (m * iss);
-
-        float const ucot = 1.f / std::tan(alpha * (math::Pi * 0.5f));
-        float const cot  = math::Pi * ucot;
-        float const csc  = (2.f * math::Pi) / std::sin(alpha * (math::Pi * 0.5f));
-
-        float2 const sx = sqrtc(float2(1.f, -ucot));
-        /*
-                                float coordinates = 0.5f;
-                                for (uint32_t x = 0, block = 0, len = width_, num_samples =
-           num_samples_; x < len;
-                                         ++x, ++coordinates, block += num_samples) {
-                                        float const u = (coordinates - half_m) * i_sqrt_m;
-                                        float const cscu = csc * u;
-                                        uint32_t ss = 0;
-                                        for (float k = -0.5f; k <= 0.5f; k += dk, ++ss) {
-                                                float const v = k * sqrt_m;
-                                                float const t = v * (cot * v - cscu);
-                                                uint32_t const i = block + ss;
-                                                cos_sin_[i][0] = std::cos(t);
-                                                cos_sin_[i][1] = std::sin(t);
-                                        }
-
-                                        s_[x] = math::mulc(sx, cot * u * u);
-                                }
-                                */
-
-        pool.run_range(
-            [this, half_m, sqrt_m, i_sqrt_m, dk, cot, csc, sx](uint32_t /*id*/, int32_t begin,
-                                                               int32_t end) {
-                for (int32_t x = begin, num_samples = num_samples_; x < end; ++x) {
-                    float const coordinates = static_cast<float>(x) + 0.5f;
-                    float const u           = (coordinates - half_m) * i_sqrt_m;
-                    float const cscu        = csc * u;
-                    uint32_t    ss          = 0;
-                    for (float k = -0.5f; k <= 0.5f; k += dk, ++ss) {
-                        float const    v = k * sqrt_m;
-                        float const    t = v * (cot * v - cscu);
-                        uint32_t const i = x * num_samples + ss;
-                        cos_sin_[i][0]   = std::cos(t);
-                        cos_sin_[i][1]   = std::sin(t);
-                    }
-
-                    s_[x] = mulc(sx, cot * u * u);
-                }
-            },
-            0, width_);
-
-        samples_ = new char[pool.num_threads() * sizeof(float2) * num_samples_];
+          size_(fft_size(num_samples_ + width - 1)),
+          plan_(math::fft::plan(int32_t(size_))),
+          pre_(new float2[num_samples_]),
+          post_(new float2[width]),
+          chirp_(new float2[size_]) {
+        double const m      = double(width_);
+        double const sqrt_m = std::sqrt(m);
+        double const iss    = double(std::floor(1.f / alpha));
+        double const dk     = 1.0 / (m * iss);
+        double const norm   = 1.0 / (iss * sqrt_m);
+
+        double const ucot = 1.0 / std::tan(double(alpha) * (math::Pi * 0.5));
+        double const cot  = math::Pi * ucot;
+        double const csc  = (2.0 * math::Pi) / std::sin(double(alpha) * (math::Pi * 0.5));
+
+        // The phase v * (cot * v - csc * u) is split into a part that only depends on the sample,
+        // one that only depends on the pixel and the chirp w * (x - s)^2 / 2 in between
+        double const w = csc * dk;
+        double const c = 0.5 * m - 0.5;
+
+        float2 const sx = sqrtc(float2(1.f, -float(ucot)));
+
+        for (uint32_t ss = 0; ss < num_samples_; ++ss) {
+            double const v = (double(ss) * dk - 0.5) * sqrt_m;
+            double const s = double(ss);
+
+            pre_[ss] = cos_sin(cot * v * v - 0.5 * w * s * s);
+        }
+
+        for (uint32_t x = 0; x < width_; ++x) {
+            double const xc = double(x) - c;
+            double const u  = xc / sqrt_m;
+
+            float2 const s = mulc(sx, cos_sin(cot * u * u));
+
+            post_[x] = float(norm) * mulc(s, cos_sin(0.5 * csc * xc - 0.5 * w * xc * xc));
+        }
+
+        // Chirp for the offsets -(num_samples - 1) to width - 1, wrapped around
+        for (uint32_t i = 0; i < size_; ++i) {
+            chirp_[i] = float2(0.f);
+        }
+
+        for (int32_t j = 1 - int32_t(num_samples_); j < int32_t(width_); ++j) {
+            double const jc = double(j) - c;
+
+            chirp_[j < 0 ? j + int32_t(size_) : j] = cos_sin(0.5 * w * jc * jc);
+        }
+
+        float2* scratch = new float2[size_];
+
+        math::fft::forward(plan_, chirp_, scratch);
+
+        delete[] scratch;
+
+        float const scale = 1.f / float(size_);
+
+        for (uint32_t i = 0; i < size_; ++i) {
+            chirp_[i] *= scale;
+        }
+
+        buffers_ = new float2[pool.num_threads() * 2 * size_];
     }
 
     ~Row() {
-        delete[] samples_;
+        delete[] buffers_;
 
-        delete[] s_;
-        delete[] cos_sin_;
+        delete[] chirp_;
+        delete[] post_;
+        delete[] pre_;
     }
 
     uint32_t num_samples() const {
         return num_samples_;
     }
 
-    float2 cos_sin(uint32_t x, uint32_t ss) const {
-        uint32_t i = x * num_samples_ + ss;
-        return cos_sin_[i];
+    uint32_t size() const {
+        return size_;
+    }
+
+    math::fft::Plan const& plan() const {
+        return plan_;
+    }
+
+    float2 pre(uint32_t ss) const {
+        return pre_[ss];
+    }
+
+    float2 post(uint32_t x) const {
+        return post_[x];
     }
 
-    float2 s(uint32_t x) const {
-        return s_[x];
+    // Transform of the chirp, scaled for the inverse transform
+    float2 chirp(uint32_t i) const {
+        return chirp_[i];
     }
 
-    template <typename T>
-    T* row_samples(uint32_t id) const {
-        return &reinterpret_cast<T*>(samples_)[id * num_samples_];
+    // Room for the data and the scratch space of one FFT
+    float2* buffer(uint32_t id) const {
+        return &buffers_[id * 2 * size_];
     }
 
   private:
+    static uint32_t fft_size(uint32_t num) {
+        uint32_t size = 1;
+        while (size < num) {
+            size *= 2;
+        }
+
+        return size;
+    }
+
+    static float2 cos_sin(double t) {
+        return float2(float(std::cos(t)), float(std::sin(t)));
+    }
+
     uint32_t width_;
     uint32_t num_samples_;
-    float2*  cos_sin_;
-    float2*  s_;
+    uint32_t size_;
+
+    math::fft::Plan const& plan_;
 
-    char* samples_;
+    float2* pre_;
+    float2* post_;
+    float2* chirp_;
+
+    float2* buffers_;
 };
 
 template <typename Source, typename T>
@@ -161,37 +201,36 @@ static void fdft(image::Float2& destination, const Source& source, const Row& ro
     int32_t const d = destination.description().dimensions[0];
     int32_t const b = d - 1;
 
-    float const m      = float(d);
-    float const sqrt_m = std::sqrt(m);
-    float const iss    = std::floor(1.f / alpha);  // 8.f;
-    float const norm   = 1.f / (iss * sqrt_m);
-    float const dk     = 1.f / (m * iss);
+    float const iss = std::floor(1.f / alpha);
+
+    uint32_t const num_samples = row.num_samples();
+    uint32_t const size        = row.size();
 
-    T* row_samples = row.row_samples<T>(id);
+    float2* data    = row.buffer(id);
+    float2* scratch = data + size;
 
     for (int32_t y = begin; y < end; ++y) {
-        uint32_t ss = 0;
-        for (float k = -0.5f; k <= 0.5f; k += dk, ++ss) {
-            float const tc  = (k + 0.5f) * m;
-            row_samples[ss] = sample<T>(source.data(), d, b, tc, y);
-        }
+        for (uint32_t ss = 0; ss < num_samples; ++ss) {
+            float const tc = float(ss) / iss;
+            T const     g  = sample<T>(source.data(), d, b, tc, y);
 
-        float coordinates = 0.5f;
-        for (int32_t x = 0; x < d; ++x, ++coordinates) {
-            float2 integration(0.f);
+            data[ss] = mulc_cos_sin(g, row.pre(ss));
+        }
 
-            for (uint32_t i = 0, len = row.num_samples(); i < len; ++i) {
-                const T g = row_samples[i];
+        for (uint32_t i = num_samples; i < size; ++i) {
+            data[i] = float2(0.f);
+        }
 
-                integration += mulc_cos_sin(g, row.cos_sin(x, i));
-            }
+        math::fft::forward(row.plan(), data, scratch);
 
-            //		float const  u = (coordinates - half_m) * i_sqrt_m;
-            //		float2 const s = math::mulc(sx, cot * u * u);
+        for (uint32_t i = 0; i < size; ++i) {
+            data[i] = mulc(data[i], row.chirp(i));
+        }
 
-            float2 const s = row.s(x);
+        math::fft::inverse(row.plan(), data, scratch);
 
-            destination.store(x, y, norm * mulc(s, integration));
+        for (int32_t x = 0; x < d; ++x) {
+            destination.store(x, y, mulc(row.post(uint32_t(x)), data[x]));
         }
     }
 }
@@ -1,7 +1,7 @@
 #include "starburst.hpp"
 #include "aperture.hpp"
 #include "base/encoding/encoding.inl"
-#include "base/math/fourier/dft.hpp"
+#include "base/math/fourier/fft.hpp"
 #include "base/math/sample_distribution.inl"
 #include "base/math/vector3.inl"
 #include "base/random/generator.inl"
@@ -59,7 +59,7 @@ void create(thread::Pool& pool) {
 
     Float1 signal(Image::Description(Image::Type::Float1, dimensions));
 
-    std::vector<float2> signal_f(resolution * math::dft_size(resolution));
+    std::vector<float2> signal_f(resolution * math::fft::real_size(resolution));
 
     Float3 float_image_a(Image::Description(Image::Type::Float3, dimensions));
 
@@ -155,7 +155,7 @@ void create(thread::Pool& pool) {
                         delete[] spectral_data;
                         */
     } else {
-        math::dft_2d(signal_f.data(), signal.data(), resolution, resolution, pool);
+        math::fft::forward_real_2d(signal_f.data(), signal.data(), resolution, resolution, pool);
 
         centered_squared_magnitude(signal.data(), signal_f.data(), resolution, resolution);
 
@@ -306,7 +306,7 @@ void render_aperture(const Aperture& aperture, Float1& signal) {
 
 void centered_squared_magnitude(float* result, float2 const* source, int32_t width,
                                 int32_t height) {
-    int32_t row_size = math::dft_size(width);
+    int32_t row_size = math::fft::real_size(width);
 
     float fr            = static_cast<float>(width);
     float normalization = 2.f / fr;